@@ -0,0 +1,781 @@
+#include "arrow.h"
+
+#include "base/bfloat16.h"
+#include "base/text_codec.h"
+#include "columns/array.h"
+#include "columns/date.h"
+#include "columns/decimal.h"
+#include "columns/lowcardinality.h"
+#include "columns/map.h"
+#include "columns/nothing.h"
+#include "columns/nullable.h"
+#include "columns/numeric.h"
+#include "columns/sparse.h"
+#include "columns/string.h"
+#include "columns/tuple.h"
+#include "columns/uuid.h"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clickhouse {
+
+namespace {
+
+template <typename T>
+inline void ReleaseIfAlive(T* value) {
+    // Consumers may move children out, leaving them released.
+    if (value && value->release) {
+        value->release(value);
+    }
+}
+
+/// Private data of exported schemas, owning strings and children referenced by the ArrowSchema.
+struct SchemaData {
+    std::string format;
+    std::string name;
+    std::vector<std::unique_ptr<ArrowSchema>> children;
+    std::vector<ArrowSchema*> child_ptrs;
+    std::unique_ptr<ArrowSchema> dictionary;
+
+    ~SchemaData() {
+        for (auto & child : children) {
+            ReleaseIfAlive(child.get());
+        }
+        ReleaseIfAlive(dictionary.get());
+    }
+
+    ArrowSchema* AddChild() {
+        children.push_back(std::make_unique<ArrowSchema>());
+        children.back()->release = nullptr;
+        return children.back().get();
+    }
+};
+
+/// Private data of exported arrays, owning columns whose data is shared, copies of data, buffers and children.
+struct ArrayData {
+    std::vector<ColumnRef> columns;
+    std::vector<std::vector<uint64_t>> copies;
+    std::vector<const void*> buffers;
+    std::vector<std::unique_ptr<ArrowArray>> children;
+    std::vector<ArrowArray*> child_ptrs;
+    std::unique_ptr<ArrowArray> dictionary;
+
+    ~ArrayData() {
+        for (auto & child : children) {
+            ReleaseIfAlive(child.get());
+        }
+        ReleaseIfAlive(dictionary.get());
+    }
+
+    ArrowArray* AddChild() {
+        children.push_back(std::make_unique<ArrowArray>());
+        children.back()->release = nullptr;
+        return children.back().get();
+    }
+
+    /// Allocates a buffer of `count` values of T, aligned to 8 bytes, and appends it to the buffers.
+    template <typename T>
+    T* AddCopy(size_t count) {
+        // Buffers are never null, even of empty arrays.
+        copies.emplace_back((std::max<size_t>(count, 1) * sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        buffers.push_back(copies.back().data());
+        return reinterpret_cast<T*>(copies.back().data());
+    }
+};
+
+void ReleaseSchema(ArrowSchema* schema) {
+    delete static_cast<SchemaData*>(schema->private_data);
+    schema->release = nullptr;
+}
+
+void ReleaseArray(ArrowArray* array) {
+    delete static_cast<ArrayData*>(array->private_data);
+    array->release = nullptr;
+}
+
+void FillSchema(std::unique_ptr<SchemaData> data, int64_t flags, ArrowSchema* out) {
+    for (const auto & child : data->children) {
+        data->child_ptrs.push_back(child.get());
+    }
+
+    out->format = data->format.c_str();
+    out->name = data->name.c_str();
+    out->metadata = nullptr;
+    out->flags = flags;
+    out->n_children = static_cast<int64_t>(data->child_ptrs.size());
+    out->children = data->child_ptrs.data();
+    out->dictionary = data->dictionary.get();
+    out->release = &ReleaseSchema;
+    out->private_data = data.release();
+}
+
+void FillArray(std::unique_ptr<ArrayData> data, size_t length, size_t null_count, ArrowArray* out) {
+    for (const auto & child : data->children) {
+        data->child_ptrs.push_back(child.get());
+    }
+
+    out->length = static_cast<int64_t>(length);
+    out->null_count = static_cast<int64_t>(null_count);
+    out->offset = 0;
+    out->n_buffers = static_cast<int64_t>(data->buffers.size());
+    out->buffers = data->buffers.data();
+    out->n_children = static_cast<int64_t>(data->child_ptrs.size());
+    out->children = data->child_ptrs.data();
+    out->dictionary = data->dictionary.get();
+    out->release = &ReleaseArray;
+    out->private_data = data.release();
+}
+
+/// Arrow time unit of DateTime64 of given precision, with the precision of the unit.
+std::pair<char, size_t> GetTimeUnit(size_t precision) {
+    if (precision == 0) {
+        return {'s', 0};
+    } else if (precision <= 3) {
+        return {'m', 3};
+    } else if (precision <= 6) {
+        return {'u', 6};
+    }
+    return {'n', 9};
+}
+
+void ExportSchema(const Type& type, const std::string& name, int64_t flags, ArrowSchema* out) {
+    auto data = std::make_unique<SchemaData>();
+    data->name = name;
+
+    switch (type.GetCode()) {
+        case Type::Void:       data->format = "n"; flags |= ARROW_FLAG_NULLABLE; break;
+        case Type::Int8:
+        case Type::Enum8:      data->format = "c"; break;
+        case Type::Int16:
+        case Type::Enum16:     data->format = "s"; break;
+        case Type::Int32:      data->format = "i"; break;
+        case Type::Int64:      data->format = "l"; break;
+        case Type::UInt8:      data->format = "C"; break;
+        case Type::UInt16:     data->format = "S"; break;
+        case Type::UInt32:
+        case Type::IPv4:       data->format = "I"; break;
+        case Type::UInt64:     data->format = "L"; break;
+        case Type::BFloat16:
+        case Type::Float32:    data->format = "f"; break;
+        case Type::Float64:    data->format = "g"; break;
+        case Type::String:     data->format = "z"; break;
+        case Type::FixedString:
+            data->format = "w:" + std::to_string(type.As<FixedStringType>()->GetSize());
+            break;
+        case Type::UUID:
+        case Type::IPv6:       data->format = "w:16"; break;
+        case Type::Date:
+        case Type::Date32:     data->format = "tdD"; break;
+        case Type::DateTime:
+            data->format = "tss:" + type.As<DateTimeType>()->Timezone();
+            break;
+        case Type::DateTime64: {
+            const auto datetime64 = type.As<DateTime64Type>();
+            data->format = std::string("ts") + GetTimeUnit(datetime64->GetPrecision()).first + ":" + datetime64->Timezone();
+            break;
+        }
+        case Type::Decimal:
+        case Type::Decimal32:
+        case Type::Decimal64:
+        case Type::Decimal128:
+        case Type::Decimal256: {
+            const auto decimal = type.As<DecimalType>();
+            data->format = "d:" + std::to_string(decimal->GetPrecision()) + "," + std::to_string(decimal->GetScale());
+            if (decimal->GetPrecision() > 38) {
+                data->format += ",256";
+            }
+            break;
+        }
+        case Type::Nullable:
+            ExportSchema(*type.As<NullableType>()->GetNestedType(), name, flags | ARROW_FLAG_NULLABLE, out);
+            return;
+        case Type::Array:
+            data->format = "+l";
+            ExportSchema(*type.As<ArrayType>()->GetItemType(), "item", 0, data->AddChild());
+            break;
+        case Type::Tuple: {
+            data->format = "+s";
+            const auto items = type.As<TupleType>()->GetTupleType();
+            for (size_t i = 0; i < items.size(); ++i) {
+                ExportSchema(*items[i], std::to_string(i + 1), 0, data->AddChild());
+            }
+            break;
+        }
+        case Type::Map: {
+            data->format = "+m";
+            const auto map = type.As<MapType>();
+            auto entries = std::make_unique<SchemaData>();
+            entries->format = "+s";
+            entries->name = "entries";
+            ExportSchema(*map->GetKeyType(), "key", 0, entries->AddChild());
+            ExportSchema(*map->GetValueType(), "value", 0, entries->AddChild());
+            FillSchema(std::move(entries), 0, data->AddChild());
+            break;
+        }
+        case Type::LowCardinality: {
+            auto nested = type.As<LowCardinalityType>()->GetNestedType();
+            if (nested->GetCode() == Type::Nullable) {
+                nested = nested->As<NullableType>()->GetNestedType();
+                flags |= ARROW_FLAG_NULLABLE;
+            }
+            data->format = "i";
+            data->dictionary = std::make_unique<ArrowSchema>();
+            data->dictionary->release = nullptr;
+            ExportSchema(*nested, "", 0, data->dictionary.get());
+            break;
+        }
+        default:
+            throw UnimplementedError("Type " + type.GetName() + " of column '" + name + "' has no Arrow counterpart");
+    }
+
+    FillSchema(std::move(data), flags, out);
+}
+
+/// Data of a column of values of fixed size, empty columns have a buffer of zeros.
+const void* GetRawData(const Column& column) {
+    static const uint64_t empty[4] = {};
+    return column.Size() ? static_cast<const void*>(column.GetItem(0).data.data()) : empty;
+}
+
+/// Copies offsets of ColumnArray or ColumnString items to int32 Arrow offsets, throws if they don't fit.
+template <typename GetEnd>
+void CopyOffsets(ArrayData& data, size_t rows, GetEnd&& get_end) {
+    auto offsets = data.AddCopy<int32_t>(rows + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        const uint64_t end = get_end(i);
+        if (end > static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) {
+            throw ValidationError("Column of " + std::to_string(end) + " items exceeds the limit of Arrow 32-bit offsets");
+        }
+        offsets[i + 1] = static_cast<int32_t>(end);
+    }
+}
+
+template <typename T, typename U>
+void CopyWidened(ArrayData& data, Span<const U> values) {
+    auto dest = data.AddCopy<T>(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        dest[i] = static_cast<T>(values[i]);
+    }
+}
+
+/// Sets `data.buffers[0]` to a validity bitmap, bit of a row is set unless `is_null(row)`, returns count of nulls.
+template <typename IsNull>
+size_t SetValidity(ArrayData& data, size_t rows, IsNull&& is_null) {
+    data.copies.emplace_back(std::max<size_t>((rows + 63) / 64, 1));
+    auto & bitmap = data.copies.back();
+    size_t null_count = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        if (is_null(i)) {
+            ++null_count;
+        } else {
+            bitmap[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+    data.buffers[0] = bitmap.data();
+    return null_count;
+}
+
+void ExportArray(ColumnRef column, ArrowArray* out) {
+    if (const auto sparse = column->AsPtr<ColumnSparse>()) {
+        column = sparse->Densify();
+    }
+
+    auto data = std::make_unique<ArrayData>();
+    data->columns.push_back(column);
+    data->buffers.push_back(nullptr);
+
+    const auto & type = column->GetType();
+    const size_t rows = column->Size();
+    size_t null_count = 0;
+
+    switch (type.GetCode()) {
+        case Type::Void:
+            data->buffers.clear();
+            null_count = rows;
+            break;
+        case Type::Int8:
+        case Type::Int16:
+        case Type::Int32:
+        case Type::Int64:
+        case Type::UInt8:
+        case Type::UInt16:
+        case Type::UInt32:
+        case Type::UInt64:
+        case Type::Float32:
+        case Type::Float64:
+        case Type::Enum8:
+        case Type::Enum16:
+        case Type::IPv4:
+        case Type::IPv6:
+        case Type::FixedString:
+        case Type::Date32:
+            data->buffers.push_back(GetRawData(*column));
+            break;
+        case Type::BFloat16: {
+            const auto values = column->AsRef<ColumnBFloat16>().GetData();
+            ConvertBFloat16ToFloat(values, Span<float>(data->AddCopy<float>(rows), rows));
+            break;
+        }
+        case Type::Date:
+            CopyWidened<int32_t>(*data, column->AsRef<ColumnDate>().GetData());
+            break;
+        case Type::DateTime:
+            CopyWidened<int64_t>(*data, column->AsRef<ColumnDateTime>().GetData());
+            break;
+        case Type::DateTime64: {
+            const auto & datetime64 = column->AsRef<ColumnDateTime64>();
+            const size_t precision = datetime64.GetPrecision();
+            const size_t unit_precision = GetTimeUnit(precision).second;
+            if (precision == unit_precision) {
+                data->buffers.push_back(GetRawData(*column));
+            } else {
+                auto values = data->AddCopy<Int64>(rows);
+                datetime64.CopyTo(Span<Int64>(values, rows));
+                Int64 multiplier = 1;
+                for (size_t p = precision; p < unit_precision; ++p) {
+                    multiplier *= 10;
+                }
+                for (size_t i = 0; i < rows; ++i) {
+                    values[i] *= multiplier;
+                }
+            }
+            break;
+        }
+        case Type::Decimal:
+        case Type::Decimal32:
+        case Type::Decimal64:
+        case Type::Decimal128:
+        case Type::Decimal256: {
+            const auto & decimal = column->AsRef<ColumnDecimal>();
+            if (decimal.GetPrecision() > 18) {
+                data->buffers.push_back(GetRawData(*column));
+            } else {
+                decimal.CopyTo(Span<Int128>(data->AddCopy<Int128>(rows), rows));
+            }
+            break;
+        }
+        case Type::UUID: {
+            std::vector<UUID> values(rows);
+            column->AsRef<ColumnUUID>().CopyTo(Span<UUID>(values));
+            auto dest = data->AddCopy<uint8_t>(rows * 16);
+            for (const auto & value : values) {
+                for (const uint64_t half : {value.first, value.second}) {
+                    for (int shift = 56; shift >= 0; shift -= 8) {
+                        *dest++ = static_cast<uint8_t>(half >> shift);
+                    }
+                }
+            }
+            break;
+        }
+        case Type::String: {
+            const auto values = column->AsRef<ColumnString>().GetData();
+            uint64_t end = 0;
+            CopyOffsets(*data, rows, [&values, &end](size_t i) { return end += values[i].size(); });
+            auto dest = data->AddCopy<char>(end);
+            for (const auto & value : values) {
+                if (!value.empty()) {
+                    std::memcpy(dest, value.data(), value.size());
+                    dest += value.size();
+                }
+            }
+            break;
+        }
+        case Type::Array: {
+            const auto & array = column->AsRef<ColumnArray>();
+            const auto offsets = array.GetOffsets();
+            CopyOffsets(*data, rows, [&offsets](size_t i) { return offsets[i]; });
+            ExportArray(array.GetNestedColumn(), data->AddChild());
+            break;
+        }
+        case Type::Tuple: {
+            const auto & tuple = column->AsRef<ColumnTuple>();
+            for (size_t i = 0; i < tuple.TupleSize(); ++i) {
+                ExportArray(tuple.At(i), data->AddChild());
+            }
+            break;
+        }
+        case Type::Map:
+            // Map is laid out as a list of struct entries in both ClickHouse and Arrow.
+            ExportArray(column->AsRef<ColumnMap>().GetEntries(), out);
+            static_cast<ArrayData*>(out->private_data)->columns.push_back(column);
+            return;
+        case Type::Nullable: {
+            const auto & nullable = column->AsRef<ColumnNullable>();
+            ExportArray(nullable.Nested(), out);
+            auto nested_data = static_cast<ArrayData*>(out->private_data);
+            nested_data->columns.push_back(column);
+            if (nested_data->buffers.empty()) {
+                // Nullable(Nothing), all values are nulls.
+                return;
+            }
+            out->null_count = static_cast<int64_t>(SetValidity(*nested_data, rows, [&nullable](size_t i) { return nullable.IsNull(i); }));
+            return;
+        }
+        case Type::LowCardinality: {
+            const auto & low_cardinality = column->AsRef<ColumnLowCardinality>();
+            const auto index = low_cardinality.GetIndexColumn();
+            data->columns.push_back(index);
+            if (index->AsPtr<ColumnUInt32>()) {
+                data->buffers.push_back(GetRawData(*index));
+            } else if (const auto index8 = index->AsPtr<ColumnUInt8>()) {
+                CopyWidened<int32_t>(*data, index8->GetData());
+            } else if (const auto index16 = index->AsPtr<ColumnUInt16>()) {
+                CopyWidened<int32_t>(*data, index16->GetData());
+            } else {
+                CopyWidened<int32_t>(*data, index->AsRef<ColumnUInt64>().GetData());
+            }
+
+            auto dictionary = low_cardinality.GetDictionaryColumn();
+            if (const auto nullable_dictionary = dictionary->AsPtr<ColumnNullable>()) {
+                dictionary = nullable_dictionary->Nested();
+            }
+            if (type.As<LowCardinalityType>()->GetNestedType()->GetCode() == Type::Nullable) {
+                // NULL is the first item of the dictionary.
+                const auto indices = static_cast<const int32_t*>(data->buffers[1]);
+                null_count = SetValidity(*data, rows, [indices](size_t i) { return indices[i] == 0; });
+            }
+            data->dictionary = std::make_unique<ArrowArray>();
+            data->dictionary->release = nullptr;
+            ExportArray(dictionary, data->dictionary.get());
+            break;
+        }
+        default:
+            throw UnimplementedError("Column of " + type.GetName() + " has no Arrow counterpart");
+    }
+
+    FillArray(std::move(data), rows, null_count, out);
+}
+
+/// Returns buffer of the array, which is null only if the array is empty or, for the validity bitmap, has no nulls.
+template <typename T>
+const T* GetBuffer(const ArrowArray& array, size_t index) {
+    if (static_cast<size_t>(array.n_buffers) <= index) {
+        throw ValidationError("Arrow array has " + std::to_string(array.n_buffers) + " buffers, expected at least "
+                + std::to_string(index + 1));
+    }
+    const auto buffer = static_cast<const T*>(array.buffers[index]);
+    if (!buffer && index != 0 && array.length != 0) {
+        throw ValidationError("Buffer " + std::to_string(index) + " of non-empty Arrow array is null");
+    }
+    return buffer;
+}
+
+void CheckChildren(const ArrowSchema& schema, const ArrowArray& array, int64_t count) {
+    if (schema.n_children != count || array.n_children != count) {
+        throw ValidationError("Arrow field '" + std::string(schema.name ? schema.name : "") + "' of format '" + schema.format
+                + "' has " + std::to_string(array.n_children) + " children, expected " + std::to_string(count));
+    }
+}
+
+/// Splits parameters of a format after its colon, e.g. "d:10,2" into {10, 2}, throws ValidationError if they are not numbers.
+std::vector<size_t> ParseFormatParameters(std::string_view format) {
+    std::vector<size_t> result;
+    for (size_t begin = format.find(':') + 1, end = begin; end != std::string_view::npos; begin = end + 1) {
+        end = format.find(',', begin);
+        uint64_t value = 0;
+        if (!ParseUInt64(format.substr(begin, end - begin), value) || value > std::numeric_limits<size_t>::max())
+            throw ValidationError("Arrow format '" + std::string(format) + "' has invalid parameters");
+
+        result.push_back(static_cast<size_t>(value));
+    }
+    return result;
+}
+
+/// Null flags of rows [begin, begin + length) of the array.
+std::shared_ptr<ColumnUInt8> ImportNulls(const ArrowArray& array, size_t begin, size_t length) {
+    auto nulls = std::make_shared<ColumnUInt8>();
+    auto & data = nulls->GetWritableData();
+
+    if (array.n_buffers == 0) {
+        // Array of the null type.
+        data.assign(length, 1);
+        return nulls;
+    }
+
+    data.assign(length, 0);
+    const auto validity = GetBuffer<uint8_t>(array, 0);
+    if (validity && array.null_count != 0) {
+        for (size_t i = 0; i < length; ++i) {
+            const size_t bit = begin + i;
+            data[i] = !((validity[bit / 8] >> (bit % 8)) & 1);
+        }
+    }
+    return nulls;
+}
+
+template <typename T>
+ColumnRef ImportNumbers(const ArrowArray& array, size_t begin, size_t length) {
+    auto column = std::make_shared<ColumnVector<T>>();
+    column->AppendMany(Span<const T>(GetBuffer<T>(array, 1) + begin, length));
+    return column;
+}
+
+ColumnRef ImportBooleans(const ArrowArray& array, size_t begin, size_t length) {
+    const auto bits = GetBuffer<uint8_t>(array, 1);
+    std::vector<uint8_t> values(length);
+    for (size_t i = 0; i < length; ++i) {
+        values[i] = (bits[(begin + i) / 8] >> ((begin + i) % 8)) & 1;
+    }
+    return std::make_shared<ColumnUInt8>(std::move(values));
+}
+
+template <typename OffsetType>
+ColumnRef ImportStrings(const ArrowArray& array, size_t begin, size_t length) {
+    const auto offsets = GetBuffer<OffsetType>(array, 1);
+    const auto chars = GetBuffer<char>(array, 2);
+
+    std::vector<std::string_view> values(length);
+    for (size_t i = 0; i < length; ++i) {
+        values[i] = std::string_view(chars + offsets[begin + i], static_cast<size_t>(offsets[begin + i + 1] - offsets[begin + i]));
+    }
+
+    auto column = std::make_shared<ColumnString>();
+    column->AppendMany(Span<const std::string_view>(values.data(), values.size()));
+    return column;
+}
+
+ColumnRef ImportFixedStrings(size_t size, const ArrowArray& array, size_t begin, size_t length) {
+    const auto chars = GetBuffer<char>(array, 1);
+
+    std::vector<std::string_view> values(length);
+    for (size_t i = 0; i < length; ++i) {
+        values[i] = std::string_view(chars + (begin + i) * size, size);
+    }
+
+    auto column = std::make_shared<ColumnFixedString>(size);
+    column->AppendMany(Span<const std::string_view>(values.data(), values.size()));
+    return column;
+}
+
+ColumnRef ImportColumn(const ArrowSchema& schema, const ArrowArray& array, size_t parent_offset, size_t length);
+
+template <typename OffsetType>
+ColumnRef ImportList(const ArrowSchema& schema, const ArrowArray& array, size_t begin, size_t length) {
+    CheckChildren(schema, array, 1);
+    const auto offsets = GetBuffer<OffsetType>(array, 1);
+    const auto first = length ? static_cast<uint64_t>(offsets[begin]) : 0;
+
+    auto column_offsets = std::make_shared<ColumnUInt64>();
+    auto & data = column_offsets->GetWritableData();
+    data.resize(length);
+    for (size_t i = 0; i < length; ++i) {
+        data[i] = static_cast<uint64_t>(offsets[begin + i + 1]) - first;
+    }
+
+    const size_t items = length ? data.back() : 0;
+    return std::make_shared<ColumnArray>(ImportColumn(*schema.children[0], *array.children[0], first, items), column_offsets);
+}
+
+ColumnRef ImportValues(const ArrowSchema& schema, const ArrowArray& array, size_t begin, size_t length) {
+    const std::string_view format(schema.format);
+
+    if (format == "n") return std::make_shared<ColumnNothing>(length);
+    if (format == "b") return ImportBooleans(array, begin, length);
+    if (format == "c") return ImportNumbers<int8_t>(array, begin, length);
+    if (format == "C") return ImportNumbers<uint8_t>(array, begin, length);
+    if (format == "s") return ImportNumbers<int16_t>(array, begin, length);
+    if (format == "S") return ImportNumbers<uint16_t>(array, begin, length);
+    if (format == "i") return ImportNumbers<int32_t>(array, begin, length);
+    if (format == "I") return ImportNumbers<uint32_t>(array, begin, length);
+    if (format == "l") return ImportNumbers<int64_t>(array, begin, length);
+    if (format == "L") return ImportNumbers<uint64_t>(array, begin, length);
+    if (format == "f") return ImportNumbers<float>(array, begin, length);
+    if (format == "g") return ImportNumbers<double>(array, begin, length);
+    if (format == "u" || format == "z") return ImportStrings<int32_t>(array, begin, length);
+    if (format == "U" || format == "Z") return ImportStrings<int64_t>(array, begin, length);
+    if (format.substr(0, 2) == "w:") {
+        return ImportFixedStrings(ParseFormatParameters(format).front(), array, begin, length);
+    }
+
+    if (format == "tdD") {
+        const auto days = GetBuffer<int32_t>(array, 1) + begin;
+        return std::make_shared<ColumnDate32>(std::vector<int32_t>(days, days + length));
+    }
+    if (format == "tdm") {
+        const auto milliseconds = GetBuffer<int64_t>(array, 1) + begin;
+        std::vector<int32_t> days(length);
+        for (size_t i = 0; i < length; ++i) {
+            // Dates before 1970 are rounded down as well.
+            const int64_t value = milliseconds[i];
+            days[i] = static_cast<int32_t>(value / 86400000 - (value % 86400000 < 0));
+        }
+        return std::make_shared<ColumnDate32>(std::move(days));
+    }
+    if (format.size() >= 4 && format.substr(0, 2) == "ts" && format[3] == ':') {
+        const std::string timezone(format.substr(4));
+        const auto values = GetBuffer<int64_t>(array, 1) + begin;
+        if (format[2] == 's') {
+            // DateTime holds seconds as UInt32, values of NULL rows are arbitrary and are not checked.
+            const auto nulls = ImportNulls(array, begin, length);
+            std::vector<uint32_t> seconds(length);
+            for (size_t i = 0; i < length; ++i) {
+                if (nulls->At(i)) {
+                    continue;
+                }
+                if (values[i] < 0 || values[i] > std::numeric_limits<uint32_t>::max()) {
+                    throw ValidationError("Arrow timestamp " + std::to_string(values[i]) + " of field '"
+                            + std::string(schema.name ? schema.name : "") + "' is out of range of DateTime");
+                }
+                seconds[i] = static_cast<uint32_t>(values[i]);
+            }
+            return timezone.empty() ? std::make_shared<ColumnDateTime>(std::move(seconds))
+                                    : std::make_shared<ColumnDateTime>(timezone, std::move(seconds));
+        }
+
+        const size_t precision = format[2] == 'm' ? 3 : format[2] == 'u' ? 6 : format[2] == 'n' ? 9 : 0;
+        if (precision) {
+            auto column = timezone.empty() ? std::make_shared<ColumnDateTime64>(precision)
+                                           : std::make_shared<ColumnDateTime64>(precision, timezone);
+            column->AppendMany(Span<const Int64>(values, length));
+            return column;
+        }
+    }
+
+    if (format.substr(0, 2) == "d:") {
+        const auto parameters = ParseFormatParameters(format);
+        const size_t bit_width = parameters.size() > 2 ? parameters[2] : 128;
+        if (parameters.size() < 2 || (bit_width != 128 && bit_width != 256)) {
+            throw UnimplementedError("Arrow format '" + std::string(format) + "' has no ClickHouse counterpart");
+        }
+        if (bit_width == 256) {
+            auto column = std::make_shared<ColumnDecimal256>(parameters[0], parameters[1]);
+            column->AppendMany(Span<const Int256>(GetBuffer<Int256>(array, 1) + begin, length));
+            return column;
+        }
+        auto column = std::make_shared<ColumnDecimal>(parameters[0], parameters[1]);
+        column->AppendMany(Span<const Int128>(GetBuffer<Int128>(array, 1) + begin, length));
+        return column;
+    }
+
+    if (format == "+l") return ImportList<int32_t>(schema, array, begin, length);
+    if (format == "+L") return ImportList<int64_t>(schema, array, begin, length);
+    if (format == "+m") return std::make_shared<ColumnMap>(ImportList<int32_t>(schema, array, begin, length));
+    if (format == "+s") {
+        std::vector<ColumnRef> columns;
+        for (int64_t i = 0; i < array.n_children && i < schema.n_children; ++i) {
+            columns.push_back(ImportColumn(*schema.children[i], *array.children[i], begin, length));
+        }
+        CheckChildren(schema, array, static_cast<int64_t>(columns.size()));
+        return std::make_shared<ColumnTuple>(columns);
+    }
+
+    throw UnimplementedError("Arrow format '" + std::string(format) + "' of field '" + (schema.name ? schema.name : "")
+            + "' has no ClickHouse counterpart");
+}
+
+template <typename T>
+void ImportIndices(const ArrowArray& array, size_t begin, std::vector<uint64_t>& indices) {
+    const auto values = GetBuffer<T>(array, 1) + begin;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        // Negative indices, which are invalid, become too large ones and are rejected by AppendIndices().
+        indices[i] = static_cast<uint64_t>(values[i]);
+    }
+}
+
+ColumnRef ImportDictionaryEncoded(const ArrowSchema& schema, const ArrowArray& array, size_t begin, size_t length) {
+    if (!array.dictionary) {
+        throw ValidationError("Arrow array of dictionary-encoded field '" + std::string(schema.name ? schema.name : "")
+                + "' has no dictionary");
+    }
+    const auto & dictionary_array = *array.dictionary;
+    const auto dictionary = ImportValues(*schema.dictionary, dictionary_array,
+            static_cast<size_t>(dictionary_array.offset), static_cast<size_t>(dictionary_array.length));
+
+    std::vector<uint64_t> indices(length);
+    const std::string_view format(schema.format);
+    if (format == "c") ImportIndices<int8_t>(array, begin, indices);
+    else if (format == "C") ImportIndices<uint8_t>(array, begin, indices);
+    else if (format == "s") ImportIndices<int16_t>(array, begin, indices);
+    else if (format == "S") ImportIndices<uint16_t>(array, begin, indices);
+    else if (format == "i") ImportIndices<int32_t>(array, begin, indices);
+    else if (format == "I") ImportIndices<uint32_t>(array, begin, indices);
+    else if (format == "l") ImportIndices<int64_t>(array, begin, indices);
+    else if (format == "L") ImportIndices<uint64_t>(array, begin, indices);
+    else throw ValidationError("Arrow format '" + std::string(format) + "' is not of dictionary indices");
+
+    if (schema.flags & ARROW_FLAG_NULLABLE) {
+        auto result = std::make_shared<ColumnLowCardinality>(
+                std::make_shared<ColumnNullable>(dictionary->CloneEmpty(), std::make_shared<ColumnUInt8>()));
+        const auto nulls = ImportNulls(array, begin, length);
+        result->AppendIndices(*dictionary, indices, nulls->GetData());
+        return result;
+    }
+
+    auto result = std::make_shared<ColumnLowCardinality>(dictionary->CloneEmpty());
+    result->AppendIndices(*dictionary, indices);
+    return result;
+}
+
+ColumnRef ImportColumn(const ArrowSchema& schema, const ArrowArray& array, size_t parent_offset, size_t length) {
+    if (parent_offset + length > static_cast<size_t>(array.length)) {
+        throw ValidationError("Arrow array of " + std::to_string(array.length) + " rows doesn't hold rows ["
+                + std::to_string(parent_offset) + ", " + std::to_string(parent_offset + length) + ")");
+    }
+
+    const size_t begin = static_cast<size_t>(array.offset) + parent_offset;
+    if (schema.dictionary) {
+        return ImportDictionaryEncoded(schema, array, begin, length);
+    }
+
+    auto values = ImportValues(schema, array, begin, length);
+    switch (values->GetType().GetCode()) {
+        case Type::Array:
+        case Type::Tuple:
+        case Type::Map:
+            return values;
+        case Type::Void:
+            break;
+        default:
+            if (!(schema.flags & ARROW_FLAG_NULLABLE)) {
+                return values;
+            }
+    }
+    return std::make_shared<ColumnNullable>(values, ImportNulls(array, begin, length));
+}
+
+}
+
+void ExportArrowSchema(const Block& block, ArrowSchema* out) {
+    auto data = std::make_unique<SchemaData>();
+    data->format = "+s";
+    for (Block::Iterator bi(block); bi.IsValid(); bi.Next()) {
+        ExportSchema(*bi.Type(), bi.Name(), 0, data->AddChild());
+    }
+    FillSchema(std::move(data), 0, out);
+}
+
+void ExportArrowArray(const Block& block, ArrowArray* out) {
+    auto data = std::make_unique<ArrayData>();
+    data->buffers.push_back(nullptr);
+    for (Block::Iterator bi(block); bi.IsValid(); bi.Next()) {
+        if (bi.Column()->Size() != block.GetRowCount()) {
+            throw ValidationError("Column '" + bi.Name() + "' has " + std::to_string(bi.Column()->Size())
+                    + " rows, block has " + std::to_string(block.GetRowCount()));
+        }
+        ExportArray(bi.Column(), data->AddChild());
+    }
+    FillArray(std::move(data), block.GetRowCount(), 0, out);
+}
+
+Block ImportArrowArray(const ArrowSchema& schema, const ArrowArray& array) {
+    if (std::string_view(schema.format) != "+s") {
+        throw ValidationError("Arrow array of format '" + std::string(schema.format) + "' is not a struct array");
+    }
+    CheckChildren(schema, array, schema.n_children);
+
+    const auto rows = static_cast<size_t>(array.length);
+    Block block(static_cast<size_t>(schema.n_children), rows);
+    for (int64_t i = 0; i < schema.n_children; ++i) {
+        const auto & field = *schema.children[i];
+        block.AppendColumn(field.name ? field.name : "", ImportColumn(field, *array.children[i], static_cast<size_t>(array.offset), rows));
+    }
+    return block;
+}
+
+}
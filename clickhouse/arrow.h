@@ -0,0 +1,120 @@
+#pragma once
+
+#include "block.h"
+
+#include <cstdint>
+
+/// Structures of the Arrow C data and stream interfaces, see https://arrow.apache.org/docs/format/CDataInterface.html
+extern "C" {
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+#ifndef ARROW_C_STREAM_INTERFACE
+#define ARROW_C_STREAM_INTERFACE
+
+struct ArrowArrayStream {
+    // Callbacks providing stream functionality
+    int (*get_schema)(struct ArrowArrayStream*, struct ArrowSchema* out);
+    int (*get_next)(struct ArrowArrayStream*, struct ArrowArray* out);
+    const char* (*get_last_error)(struct ArrowArrayStream*);
+
+    // Release callback
+    void (*release)(struct ArrowArrayStream*);
+
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif  // ARROW_C_STREAM_INTERFACE
+
+}
+
+namespace clickhouse {
+
+/**
+ * Exports the schema of columns of the block as an Arrow struct type, with a field of each column.
+ *
+ * Types are mapped as follows:
+ *  - (U)Int8..64, Float32, Float64, IPv4 and Enum8/16 (as their integers) to integers and floats of the same width,
+ *    BFloat16 to float;
+ *  - String to binary, since its bytes need not be UTF-8, FixedString(N) to fixed_size_binary(N),
+ *    UUID (big-endian) and IPv6 to fixed_size_binary(16);
+ *  - Date and Date32 to date32, DateTime to timestamp[s] and DateTime64(P) to timestamp of the unit of P,
+ *    rounded up to ms, us or ns, with time zones;
+ *  - Decimal to decimal128 or, of precision above 38, to decimal256;
+ *  - Nullable(T) to nullable T, Nothing to null;
+ *  - Array(T) to list<T>, Tuple(...) to struct, Map(K, V) to map<K, V>;
+ *  - LowCardinality(T) to dictionary with int32 indices and values of T.
+ * Throws UnimplementedError on other types, e.g. Int128 or Variant.
+ */
+void ExportArrowSchema(const Block& block, ArrowSchema* out);
+
+/**
+ * Exports columns of the block as an Arrow struct array, of the schema of ExportArrowSchema().
+ *
+ * Data of columns is shared where Arrow has the same layout: numbers, FixedString, IPv4, IPv6, Date32,
+ * DateTime64 of precision 0, 3, 6 or 9, Decimal of precision above 18, LowCardinality with UInt32 indices,
+ * and items of arrays. Other data, i.e. strings, offsets, null bitmaps and values of other widths, is copied.
+ * The columns are kept alive until `out` is released, they must not be modified meanwhile.
+ */
+void ExportArrowArray(const Block& block, ArrowArray* out);
+
+/**
+ * Imports an Arrow struct array, e.g. a record batch, as a block with a column of each field of the schema.
+ *
+ * Formats are mapped as follows:
+ *  - integers and floats to (U)Int8..64, Float32 and Float64, bool to UInt8;
+ *  - utf8 and binary (also large ones) to String, fixed_size_binary(N) to FixedString(N);
+ *  - date32 and date64 to Date32, timestamp[s] to DateTime, timestamp[ms], [us] and [ns] to DateTime64(3), (6) and (9),
+ *    with time zones;
+ *  - decimal128 and decimal256 to Decimal of the same precision and scale;
+ *  - nullable fields to Nullable, null to Nullable(Nothing);
+ *  - list (also large one) to Array, struct to Tuple, map to Map, these are never Nullable and their nulls are empty values;
+ *  - dictionary-encoded arrays to LowCardinality of the type of the values, Nullable if the field is nullable.
+ * Throws UnimplementedError on other formats and ValidationError on arrays inconsistent with the schema.
+ *
+ * Values are copied into the columns in bulk, `array` remains owned by the caller.
+ */
+Block ImportArrowArray(const ArrowSchema& schema, const ArrowArray& array);
+
+}
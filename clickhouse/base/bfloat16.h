@@ -0,0 +1,71 @@
+#pragma once
+
+#include "span.h"
+#include "../exceptions.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace clickhouse {
+
+/** 16-bit "brain" floating point number: upper half of IEEE-754 Float32 (sign, 8 bits of exponent, 7 bits of mantissa).
+ *  Layout and conversions match ClickHouse's BFloat16, conversion from float drops lower 16 bits of mantissa.
+ */
+class BFloat16 {
+public:
+    constexpr BFloat16() noexcept
+        : bits_(0)
+    {}
+
+    explicit BFloat16(float value) noexcept {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits_ = static_cast<uint16_t>(bits >> 16);
+    }
+
+    static constexpr BFloat16 FromBits(uint16_t bits) noexcept {
+        BFloat16 result;
+        result.bits_ = bits;
+        return result;
+    }
+
+    inline uint16_t GetBits() const noexcept { return bits_; }
+
+    operator float() const noexcept {
+        const uint32_t bits = static_cast<uint32_t>(bits_) << 16;
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+private:
+    uint16_t bits_;
+};
+
+static_assert(sizeof(BFloat16) == 2, "BFloat16 must match wire layout");
+
+/// Converts `src` to `dest` element-wise, spans must be of the same size. Plain loop over bits, easy to vectorize.
+inline void ConvertBFloat16ToFloat(Span<const BFloat16> src, Span<float> dest) {
+    if (src.size() != dest.size()) {
+        throw ValidationError("Size mismatch on BFloat16 conversion: " + std::to_string(src.size())
+                + " vs " + std::to_string(dest.size()));
+    }
+
+    for (size_t i = 0; i < src.size(); ++i) {
+        dest[i] = src[i];
+    }
+}
+
+inline void ConvertFloatToBFloat16(Span<const float> src, Span<BFloat16> dest) {
+    if (src.size() != dest.size()) {
+        throw ValidationError("Size mismatch on BFloat16 conversion: " + std::to_string(src.size())
+                + " vs " + std::to_string(dest.size()));
+    }
+
+    for (size_t i = 0; i < src.size(); ++i) {
+        dest[i] = BFloat16(src[i]);
+    }
+}
+
+}
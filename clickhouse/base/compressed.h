@@ -4,7 +4,7 @@
 #include "output.h"
 #include "buffer.h"
 
-#include "clickhouse/client.h"
+#include "clickhouse/compression.h"
 
 namespace clickhouse {
 
@@ -0,0 +1,84 @@
+#include "hash_index.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace clickhouse {
+
+void HashIndex::Insert(std::uint64_t hash, std::uint64_t index) {
+    // Keep load factor under 1/2, so probe sequences stay short.
+    if ((size_ + 1) * 2 > slots_.size())
+        Rehash(std::max<size_t>(16, slots_.size() * 2));
+
+    const size_t mask = slots_.size() - 1;
+    size_t pos = static_cast<size_t>(hash) & mask;
+    while (slots_[pos].index != NotFound)
+        pos = (pos + 1) & mask;
+
+    slots_[pos] = Slot{hash, index};
+    ++size_;
+}
+
+void HashIndex::Erase(std::uint64_t hash, std::uint64_t index) {
+    if (slots_.empty())
+        return;
+
+    const size_t mask = slots_.size() - 1;
+    size_t hole = static_cast<size_t>(hash) & mask;
+    for (; slots_[hole].index != index || slots_[hole].hash != hash; hole = (hole + 1) & mask) {
+        if (slots_[hole].index == NotFound)
+            return;
+    }
+
+    // Backward shift deletion: move subsequent items of the probe sequence into the hole,
+    // so that there are no gaps between an item and its ideal position.
+    for (size_t pos = (hole + 1) & mask; slots_[pos].index != NotFound; pos = (pos + 1) & mask) {
+        const size_t ideal = static_cast<size_t>(slots_[pos].hash) & mask;
+        if (((pos - ideal) & mask) >= ((pos - hole) & mask)) {
+            slots_[hole] = slots_[pos];
+            hole = pos;
+        }
+    }
+
+    slots_[hole].index = NotFound;
+    --size_;
+}
+
+void HashIndex::Reserve(size_t items) {
+    size_t capacity = 16;
+    while (capacity < items * 2)
+        capacity *= 2;
+
+    if (capacity > slots_.size())
+        Rehash(capacity);
+}
+
+void HashIndex::Clear() {
+    slots_.clear();
+    size_ = 0;
+}
+
+void HashIndex::Swap(HashIndex & other) noexcept {
+    slots_.swap(other.slots_);
+    std::swap(size_, other.size_);
+}
+
+void HashIndex::Rehash(size_t new_capacity) {
+    std::vector<Slot> new_slots(new_capacity, Slot{0, NotFound});
+
+    const size_t mask = new_capacity - 1;
+    for (const auto & slot : slots_) {
+        if (slot.index == NotFound)
+            continue;
+
+        size_t pos = static_cast<size_t>(slot.hash) & mask;
+        while (new_slots[pos].index != NotFound)
+            pos = (pos + 1) & mask;
+
+        new_slots[pos] = slot;
+    }
+
+    slots_.swap(new_slots);
+}
+
+}
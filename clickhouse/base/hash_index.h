@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace clickhouse {
+
+/** Open-addressing (linear probing) hash index: hash of an item -> position of the item in some column.
+ *
+ * Slots are kept in a single flat array and store only the 64-bit hash of the item and its position,
+ * no copy of the value itself. Upon hash match the candidate is verified by the caller against the column,
+ * which is the only place where values are stored.
+ */
+class HashIndex {
+public:
+    static constexpr std::uint64_t NotFound = std::numeric_limits<std::uint64_t>::max();
+
+    /// Returns position of the first item with given hash for which `is_same(index)` is true,
+    /// or NotFound if there is no such item. Items with same hash are probed in order of insertion.
+    template <typename Predicate>
+    inline std::uint64_t Find(std::uint64_t hash, Predicate && is_same) const {
+        if (slots_.empty())
+            return NotFound;
+
+        const size_t mask = slots_.size() - 1;
+        for (size_t pos = static_cast<size_t>(hash) & mask; ; pos = (pos + 1) & mask) {
+            const auto & slot = slots_[pos];
+            if (slot.index == NotFound)
+                return NotFound;
+            if (slot.hash == hash && is_same(slot.index))
+                return slot.index;
+        }
+    }
+
+    /// Adds an item, there is no check if the item is already present.
+    void Insert(std::uint64_t hash, std::uint64_t index);
+
+    /// Removes an item previously added with Insert().
+    void Erase(std::uint64_t hash, std::uint64_t index);
+
+    /// Preallocates space to hold `items` items without rehashing.
+    void Reserve(size_t items);
+
+    void Clear();
+    void Swap(HashIndex & other) noexcept;
+
+    inline size_t Size() const { return size_; }
+
+private:
+    struct Slot {
+        std::uint64_t hash;
+        std::uint64_t index;
+    };
+
+    void Rehash(size_t new_capacity);
+
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+};
+
+}
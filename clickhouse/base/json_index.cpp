@@ -0,0 +1,127 @@
+#include "json_index.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define CLICKHOUSE_JSON_INDEX_SSE2 1
+#   include <emmintrin.h>
+#endif
+
+namespace clickhouse {
+namespace {
+
+constexpr size_t ChunkSize = 64;
+
+struct ChunkMasks {
+    uint64_t quote = 0;
+    uint64_t backslash = 0;
+    uint64_t structural = 0;
+};
+
+#if defined(CLICKHOUSE_JSON_INDEX_SSE2)
+
+inline uint64_t MatchMask(__m128i chars, char c) {
+    return static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8(c))));
+}
+
+inline ChunkMasks ClassifyChunk(const char* chunk) {
+    ChunkMasks masks;
+    for (size_t i = 0; i < ChunkSize / 16; ++i) {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk + i * 16));
+        // '[' and ']' differ from '{' and '}' only by 0x20 bit.
+        const __m128i folded = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+
+        masks.quote |= MatchMask(chars, '"') << (i * 16);
+        masks.backslash |= MatchMask(chars, '\\') << (i * 16);
+        masks.structural |= (MatchMask(folded, '{') | MatchMask(folded, '}') | MatchMask(chars, ':') | MatchMask(chars, ','))
+                << (i * 16);
+    }
+    return masks;
+}
+
+#else
+
+inline ChunkMasks ClassifyChunk(const char* chunk) {
+    ChunkMasks masks;
+    for (size_t i = 0; i < ChunkSize; ++i) {
+        const uint64_t bit = uint64_t(1) << i;
+        switch (chunk[i]) {
+            case '"': masks.quote |= bit; break;
+            case '\\': masks.backslash |= bit; break;
+            case '{': case '}': case '[': case ']': case ':': case ',': masks.structural |= bit; break;
+            default: break;
+        }
+    }
+    return masks;
+}
+
+#endif
+
+// Bit `i` of the result is XOR of bits [0, i] of `mask`, turns quote positions into a mask of string contents.
+inline uint64_t PrefixXor(uint64_t mask) {
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    mask ^= mask << 32;
+    return mask;
+}
+
+inline size_t CountTrailingZeros(uint64_t value) {
+    // De Bruijn sequence, portable and branchless, `value` must not be zero.
+    static constexpr uint8_t table[64] = {
+        0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+        62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+        63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+        46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6,
+    };
+    return table[((value & (0 - value)) * 0x03F79D71B4CB0A89ull) >> 58];
+}
+
+}
+
+void IndexJsonStructure(std::string_view json, std::vector<uint32_t>& positions) {
+    // Carried over between chunks: whether the chunk starts inside of a string (all bits set if so),
+    // and whether its first character is escaped by a backslash at the end of the previous chunk.
+    uint64_t in_string_carry = 0;
+    uint64_t escaped_carry = 0;
+
+    char tail[ChunkSize];
+    for (size_t offset = 0; offset < json.size(); offset += ChunkSize) {
+        const char* chunk = json.data() + offset;
+        if (json.size() - offset < ChunkSize) {
+            // Zero bytes are not structural.
+            std::memset(tail, 0, sizeof(tail));
+            std::memcpy(tail, chunk, json.size() - offset);
+            chunk = tail;
+        }
+
+        const ChunkMasks masks = ClassifyChunk(chunk);
+
+        uint64_t escaped = escaped_carry;
+        escaped_carry = 0;
+        // Backslashes are rare, so they are resolved one by one: each unescaped one escapes the next character.
+        for (uint64_t backslashes = masks.backslash & ~escaped; backslashes; backslashes &= backslashes - 1) {
+            const size_t i = CountTrailingZeros(backslashes);
+            if (escaped & (uint64_t(1) << i))
+                continue;
+
+            if (i + 1 == ChunkSize) {
+                escaped_carry = 1;
+            } else {
+                escaped |= uint64_t(1) << (i + 1);
+            }
+        }
+
+        const uint64_t quotes = masks.quote & ~escaped;
+        const uint64_t in_string = PrefixXor(quotes) ^ in_string_carry;
+        in_string_carry = (in_string >> (ChunkSize - 1)) ? ~uint64_t(0) : 0;
+
+        for (uint64_t structural = (masks.structural & ~in_string) | quotes; structural; structural &= structural - 1) {
+            positions.push_back(static_cast<uint32_t>(offset + CountTrailingZeros(structural)));
+        }
+    }
+}
+
+}
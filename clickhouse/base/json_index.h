@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace clickhouse {
+
+/** Appends positions (relative to the beginning of `json`) of structural characters of JSON text to `positions`:
+ *  braces, brackets, colons and commas outside of strings, and unescaped quotes delimiting strings.
+ *  Values of other kinds (numbers, true, false, null) have no structural characters and span the text
+ *  between the surrounding ones.
+ *
+ *  Text is scanned 64 bytes at a time, characters are classified with SSE2 when available,
+ *  and quoted strings are masked out with bit arithmetic, without branching per character.
+ *  Text is not validated, malformed JSON results in an index that fails to navigate.
+ */
+void IndexJsonStructure(std::string_view json, std::vector<uint32_t>& positions);
+
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace clickhouse {
+
+/**
+ * A lightweight non-owning view into a contiguous sequence of objects,
+ * a minimal subset of C++20's std::span.
+ *
+ * Used by the bulk column APIs (AppendMany, CopyTo, GetData) to pass data
+ * in and out of columns without copying it into intermediate containers.
+ */
+template <typename T>
+class Span {
+public:
+    using element_type    = T;
+    using value_type      = std::remove_cv_t<T>;
+    using size_type       = size_t;
+    using pointer         = T*;
+    using reference       = T&;
+    using iterator        = T*;
+    using const_iterator  = const T*;
+
+    constexpr Span() noexcept
+        : data_(nullptr)
+        , size_(0)
+    {}
+
+    constexpr Span(T* data, size_t size) noexcept
+        : data_(data)
+        , size_(size)
+    {}
+
+    constexpr Span(T* begin, T* end) noexcept
+        : data_(begin)
+        , size_(static_cast<size_t>(end - begin))
+    {}
+
+    template <size_t N>
+    constexpr Span(T (&array)[N]) noexcept
+        : Span(array, N)
+    {}
+
+    template <typename U, size_t N, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+    constexpr Span(std::array<U, N>& array) noexcept
+        : Span(array.data(), N)
+    {}
+
+    template <typename U, size_t N, typename = std::enable_if_t<std::is_convertible_v<const U(*)[], T(*)[]>>>
+    constexpr Span(const std::array<U, N>& array) noexcept
+        : Span(array.data(), N)
+    {}
+
+    template <typename U, typename A, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+    Span(std::vector<U, A>& vec) noexcept
+        : Span(vec.data(), vec.size())
+    {}
+
+    template <typename U, typename A, typename = std::enable_if_t<std::is_convertible_v<const U(*)[], T(*)[]>>>
+    Span(const std::vector<U, A>& vec) noexcept
+        : Span(vec.data(), vec.size())
+    {}
+
+    /// Span<T> -> Span<const T>
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept
+        : Span(other.data(), other.size())
+    {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end() const noexcept { return data_ + size_; }
+
+    constexpr T& operator[](size_t index) const noexcept { return data_[index]; }
+
+    constexpr T& front() const noexcept { return data_[0]; }
+    constexpr T& back() const noexcept { return data_[size_ - 1]; }
+
+    /// Returns a view on [offset, offset + count), clamped to the size of the span.
+    constexpr Span subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const noexcept {
+        if (offset > size_)
+            offset = size_;
+        if (count > size_ - offset)
+            count = size_ - offset;
+        return Span(data_ + offset, count);
+    }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+template <typename T, typename A>
+Span(std::vector<T, A>&) -> Span<T>;
+
+template <typename T, typename A>
+Span(const std::vector<T, A>&) -> Span<const T>;
+
+template <typename T, size_t N>
+Span(std::array<T, N>&) -> Span<T>;
+
+template <typename T, size_t N>
+Span(const std::array<T, N>&) -> Span<const T>;
+
+}
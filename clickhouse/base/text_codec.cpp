@@ -0,0 +1,453 @@
+#include "text_codec.h"
+#include "time_zone.h"
+
+#include <array>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define CLICKHOUSE_TEXT_CODEC_SSE2 1
+#   include <emmintrin.h>
+#endif
+
+namespace clickhouse {
+namespace {
+
+constexpr uint8_t InvalidHexDigit = 0xFF;
+
+constexpr std::array<uint8_t, 256> MakeHexDigitTable() {
+    std::array<uint8_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = InvalidHexDigit;
+    }
+    for (uint8_t i = 0; i < 10; ++i) {
+        table['0' + i] = i;
+    }
+    for (uint8_t i = 0; i < 6; ++i) {
+        table['a' + i] = 10 + i;
+        table['A' + i] = 10 + i;
+    }
+    return table;
+}
+
+constexpr auto HexDigitTable = MakeHexDigitTable();
+constexpr char HexChars[] = "0123456789abcdef";
+
+inline uint8_t HexDigitValue(char c) {
+    return HexDigitTable[static_cast<uint8_t>(c)];
+}
+
+inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+constexpr std::array<char, 200> MakeTwoDigitsTable() {
+    std::array<char, 200> table{};
+    for (size_t i = 0; i < 100; ++i) {
+        table[i * 2] = static_cast<char>('0' + i / 10);
+        table[i * 2 + 1] = static_cast<char>('0' + i % 10);
+    }
+    return table;
+}
+
+constexpr auto TwoDigitsTable = MakeTwoDigitsTable();
+
+inline char* WriteTwoDigits(unsigned value, char* out) {
+    std::memcpy(out, &TwoDigitsTable[value * 2], 2);
+    return out + 2;
+}
+
+/// Decimal text of every octet padded to 4 bytes, so that it is copied with a single 4-byte store.
+struct OctetText {
+    char text[4];
+    uint8_t size;
+};
+
+constexpr std::array<OctetText, 256> MakeOctetTable() {
+    std::array<OctetText, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        auto & octet = table[i];
+        if (i >= 100) {
+            octet.text[octet.size++] = static_cast<char>('0' + i / 100);
+        }
+        if (i >= 10) {
+            octet.text[octet.size++] = static_cast<char>('0' + i / 10 % 10);
+        }
+        octet.text[octet.size++] = static_cast<char>('0' + i % 10);
+    }
+    return table;
+}
+
+constexpr auto OctetTable = MakeOctetTable();
+
+inline uint64_t LoadBigEndian64(const uint8_t* bytes) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        result = (result << 8) | bytes[i];
+    }
+    return result;
+}
+
+inline void StoreBigEndian64(uint64_t value, uint8_t* bytes) {
+    for (size_t i = 8; i > 0; --i) {
+        bytes[i - 1] = static_cast<uint8_t>(value);
+        value >>= 8;
+    }
+}
+
+inline bool IsLeapYear(uint64_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+inline unsigned DaysInMonth(uint64_t year, uint64_t month) {
+    static constexpr unsigned days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return days[month - 1] + (month == 2 && IsLeapYear(year));
+}
+
+#if defined(CLICKHOUSE_TEXT_CODEC_SSE2)
+
+// Converts 16 hex digits to nibbles, clears bits of `valid` mask for invalid characters.
+inline __m128i HexToNibbles(__m128i chars, int& valid) {
+    const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+
+    // Letters are folded to lowercase, anything out of 'a'..'f' is above 5 as unsigned.
+    const __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+
+    valid &= _mm_movemask_epi8(_mm_or_si128(is_digit, is_letter));
+    return _mm_or_si128(
+            _mm_and_si128(is_digit, digit),
+            _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+// Merges pairs of nibbles (high one first) into 8 bytes, each stored in a 16-bit lane.
+inline __m128i MergeNibbles(__m128i nibbles) {
+    return _mm_or_si128(
+            _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4),
+            _mm_srli_epi16(nibbles, 8));
+}
+
+inline bool HexToBytes(const char* hex, uint8_t* bytes) {
+    int valid = 0xFFFF;
+    const __m128i low = HexToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex)), valid);
+    const __m128i high = HexToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 16)), valid);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), _mm_packus_epi16(MergeNibbles(low), MergeNibbles(high)));
+    return valid == 0xFFFF;
+}
+
+inline __m128i NibblesToHex(__m128i nibbles) {
+    const __m128i above_nine = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    return _mm_add_epi8(
+            _mm_add_epi8(nibbles, _mm_set1_epi8('0')),
+            _mm_and_si128(above_nine, _mm_set1_epi8('a' - '0' - 10)));
+}
+
+inline void BytesToHex(const uint8_t* bytes, char* hex) {
+    const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    const __m128i high = _mm_and_si128(_mm_srli_epi16(value, 4), _mm_set1_epi8(0x0F));
+    const __m128i low = _mm_and_si128(value, _mm_set1_epi8(0x0F));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(hex), NibblesToHex(_mm_unpacklo_epi8(high, low)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(hex + 16), NibblesToHex(_mm_unpackhi_epi8(high, low)));
+}
+
+#else
+
+inline bool HexToBytes(const char* hex, uint8_t* bytes) {
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < 16; ++i) {
+        const uint8_t high = HexDigitValue(hex[i * 2]);
+        const uint8_t low = HexDigitValue(hex[i * 2 + 1]);
+        invalid |= (high | low) & 0xF0;
+        bytes[i] = static_cast<uint8_t>((high << 4) | (low & 0x0F));
+    }
+    return invalid == 0;
+}
+
+inline void BytesToHex(const uint8_t* bytes, char* hex) {
+    for (size_t i = 0; i < 16; ++i) {
+        hex[i * 2] = HexChars[bytes[i] >> 4];
+        hex[i * 2 + 1] = HexChars[bytes[i] & 0x0F];
+    }
+}
+
+#endif
+
+}
+
+bool ParseUInt64(std::string_view text, uint64_t& value) {
+    if (text.empty())
+        return false;
+
+    uint64_t result = 0;
+    for (const char c : text) {
+        if (c < '0' || c > '9')
+            return false;
+
+        const auto digit = static_cast<uint64_t>(c - '0');
+        if (result > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+            return false;
+
+        result = result * 10 + digit;
+    }
+
+    value = result;
+    return true;
+}
+
+bool ParseIPv4(std::string_view text, uint32_t& value) {
+    const char* p = text.data();
+    const char* const end = p + text.size();
+
+    uint32_t result = 0;
+    for (size_t octet = 0; octet < 4; ++octet) {
+        if (octet != 0) {
+            if (p == end || *p != '.')
+                return false;
+            ++p;
+        }
+
+        if (p == end || !IsDigit(*p))
+            return false;
+
+        uint32_t octet_value = static_cast<uint32_t>(*p++ - '0');
+        // Leading zeros are not allowed, same as in inet_pton().
+        if (octet_value != 0) {
+            for (size_t i = 0; i < 2 && p != end && IsDigit(*p); ++i) {
+                octet_value = octet_value * 10 + static_cast<uint32_t>(*p++ - '0');
+            }
+            if (octet_value > 255)
+                return false;
+        }
+
+        result = (result << 8) | octet_value;
+    }
+
+    if (p != end)
+        return false;
+
+    value = result;
+    return true;
+}
+
+char* FormatIPv4(uint32_t value, char* out) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        const auto & octet = OctetTable[(value >> shift) & 0xFF];
+        std::memcpy(out, octet.text, sizeof(octet.text));
+        out += octet.size;
+        if (shift != 0)
+            *out++ = '.';
+    }
+    return out;
+}
+
+bool ParseIPv6(std::string_view text, uint8_t* bytes) {
+    uint16_t words[8] = {};
+    size_t count = 0;
+    // Position in `words` of the "::" gap, if any.
+    size_t gap = 8;
+    bool has_gap = false;
+
+    const char* p = text.data();
+    const char* const end = p + text.size();
+
+    if (end - p >= 2 && p[0] == ':' && p[1] == ':') {
+        has_gap = true;
+        gap = 0;
+        p += 2;
+    }
+
+    while (p != end) {
+        const char* const group_begin = p;
+        uint32_t group = 0;
+        for (size_t digits = 0; digits < 4 && p != end && HexDigitValue(*p) != InvalidHexDigit; ++digits) {
+            group = (group << 4) | HexDigitValue(*p++);
+        }
+
+        if (p != end && *p == '.') {
+            // Trailing dotted quad takes two groups.
+            uint32_t ipv4;
+            if (count > 6 || !ParseIPv4(std::string_view(group_begin, end - group_begin), ipv4))
+                return false;
+
+            words[count++] = static_cast<uint16_t>(ipv4 >> 16);
+            words[count++] = static_cast<uint16_t>(ipv4);
+            p = end;
+            break;
+        }
+
+        if (p == group_begin || count == 8)
+            return false;
+
+        words[count++] = static_cast<uint16_t>(group);
+        if (p == end)
+            break;
+
+        if (*p++ != ':' || p == end)
+            return false;
+
+        if (*p == ':') {
+            if (has_gap)
+                return false;
+            has_gap = true;
+            gap = count;
+            if (++p == end)
+                break;
+        }
+    }
+
+    if (has_gap) {
+        // "::" stands for at least one group of zeros.
+        if (count == 8)
+            return false;
+
+        const size_t tail = count - gap;
+        for (size_t i = 0; i < tail; ++i) {
+            words[7 - i] = words[count - 1 - i];
+            words[count - 1 - i] = 0;
+        }
+    } else if (count != 8) {
+        return false;
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+        bytes[i * 2] = static_cast<uint8_t>(words[i] >> 8);
+        bytes[i * 2 + 1] = static_cast<uint8_t>(words[i]);
+    }
+    return true;
+}
+
+char* FormatIPv6(const uint8_t* bytes, char* out) {
+    uint16_t words[8];
+    for (size_t i = 0; i < 8; ++i) {
+        words[i] = static_cast<uint16_t>((bytes[i * 2] << 8) | bytes[i * 2 + 1]);
+    }
+
+    // The longest run of at least two zero groups, the first one if there are several.
+    size_t best_begin = 8, best_size = 0;
+    for (size_t i = 0; i < 8;) {
+        if (words[i] != 0) {
+            ++i;
+            continue;
+        }
+
+        size_t j = i;
+        while (j < 8 && words[j] == 0)
+            ++j;
+
+        if (j - i > best_size && j - i >= 2) {
+            best_begin = i;
+            best_size = j - i;
+        }
+        i = j;
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+        if (i >= best_begin && i < best_begin + best_size) {
+            if (i == best_begin)
+                *out++ = ':';
+            continue;
+        }
+
+        if (i != 0)
+            *out++ = ':';
+
+        // IPv4-compatible and IPv4-mapped addresses end with a dotted quad, same as in inet_ntop().
+        if (i == 6 && best_begin == 0 && (best_size == 6 || (best_size == 5 && words[5] == 0xFFFF))) {
+            return FormatIPv4((uint32_t(words[6]) << 16) | words[7], out);
+        }
+
+        const uint16_t word = words[i];
+        for (int shift = (word >= 0x1000 ? 12 : word >= 0x100 ? 8 : word >= 0x10 ? 4 : 0); shift >= 0; shift -= 4) {
+            *out++ = HexChars[(word >> shift) & 0x0F];
+        }
+    }
+
+    if (best_size != 0 && best_begin + best_size == 8)
+        *out++ = ':';
+
+    return out;
+}
+
+bool ParseUUID(std::string_view text, UUID& value) {
+    if (text.size() != UUIDTextSize || text[8] != '-' || text[13] != '-' || text[18] != '-' || text[23] != '-')
+        return false;
+
+    char hex[32];
+    std::memcpy(hex, text.data(), 8);
+    std::memcpy(hex + 8, text.data() + 9, 4);
+    std::memcpy(hex + 12, text.data() + 14, 4);
+    std::memcpy(hex + 16, text.data() + 19, 4);
+    std::memcpy(hex + 20, text.data() + 24, 12);
+
+    uint8_t bytes[16];
+    if (!HexToBytes(hex, bytes))
+        return false;
+
+    value = UUID(LoadBigEndian64(bytes), LoadBigEndian64(bytes + 8));
+    return true;
+}
+
+char* FormatUUID(const UUID& value, char* out) {
+    uint8_t bytes[16];
+    StoreBigEndian64(value.first, bytes);
+    StoreBigEndian64(value.second, bytes + 8);
+
+    char hex[32];
+    BytesToHex(bytes, hex);
+
+    std::memcpy(out, hex, 8);
+    out[8] = '-';
+    std::memcpy(out + 9, hex + 8, 4);
+    out[13] = '-';
+    std::memcpy(out + 14, hex + 12, 4);
+    out[18] = '-';
+    std::memcpy(out + 19, hex + 16, 4);
+    out[23] = '-';
+    std::memcpy(out + 24, hex + 20, 12);
+    return out + UUIDTextSize;
+}
+
+bool ParseDate(std::string_view text, int64_t& days) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-')
+        return false;
+
+    // Collect "YYYYMMDD" into a single word to check and convert all digits at once.
+    char digits[8];
+    std::memcpy(digits, text.data(), 4);
+    std::memcpy(digits + 4, text.data() + 5, 2);
+    std::memcpy(digits + 6, text.data() + 8, 2);
+
+    uint64_t word;
+    std::memcpy(&word, digits, sizeof(word));
+    if (!IsEightDigits(word))
+        return false;
+
+    const uint64_t number = ParseEightDigits(word);
+    const uint64_t year = number / 10000;
+    const uint64_t month = number / 100 % 100;
+    const uint64_t day = number % 100;
+    if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month))
+        return false;
+
+    days = TimeZone::CivilDateToDays(static_cast<int64_t>(year), static_cast<unsigned>(month), static_cast<unsigned>(day));
+    return true;
+}
+
+char* FormatDate(uint16_t year, uint8_t month, uint8_t day, char* out) {
+    if (year >= 10000) {
+        *out++ = static_cast<char>('0' + year / 10000);
+        year %= 10000;
+    }
+
+    out = WriteTwoDigits(year / 100, out);
+    out = WriteTwoDigits(year % 100, out);
+    *out++ = '-';
+    out = WriteTwoDigits(month, out);
+    *out++ = '-';
+    return WriteTwoDigits(day, out);
+}
+
+}
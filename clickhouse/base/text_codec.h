@@ -0,0 +1,59 @@
+#pragma once
+
+#include "uuid.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace clickhouse {
+
+/** Parsers and formatters of the text representation of fixed-format values, as ClickHouse prints them.
+ *  Used by bulk AppendFromStrings() and FormatToStrings() of columns.
+ *
+ *  Parsers return false on malformed input instead of throwing, so that callers can report the offending value.
+ *  Formatters take a buffer of at least Max*TextSize bytes, may use all of it as scratch space,
+ *  and return the end of the written text.
+ *
+ *  UUID is parsed and formatted with SSE2 when available, other values with SWAR and lookup tables.
+ */
+
+constexpr size_t MaxIPv4TextSize = 16;
+constexpr size_t MaxIPv6TextSize = 48;
+constexpr size_t UUIDTextSize = 36;
+constexpr size_t MaxDateTextSize = 16;
+
+/// Checks that all 8 bytes of `word` are ASCII digits.
+inline bool IsEightDigits(uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0ull) | (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))
+            == 0x3333333333333333ull;
+}
+
+/// Converts 8 ASCII digits to a number, the first digit is the most significant one; host is expected to be little-endian.
+inline uint64_t ParseEightDigits(uint64_t word) {
+    word = ((word & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+    word = ((word & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+    return ((word & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+}
+
+/// Non-empty run of decimal digits without sign, fails on overflow instead of wrapping around.
+bool ParseUInt64(std::string_view text, uint64_t& value);
+
+/// Dotted quad, e.g. "192.168.0.1"; `value` is the numeric address, 0xC0A80001 for the example.
+bool ParseIPv4(std::string_view text, uint32_t& value);
+char* FormatIPv4(uint32_t value, char* out);
+
+/// RFC 4291 text form of 16 bytes of address in network byte order, including "::" and trailing dotted quad.
+bool ParseIPv6(std::string_view text, uint8_t* bytes);
+/// RFC 5952 form, same as inet_ntop(): lowercase, longest run of zero groups compressed to "::".
+char* FormatIPv6(const uint8_t* bytes, char* out);
+
+/// "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx", `first` holds the first 16 hex digits.
+bool ParseUUID(std::string_view text, UUID& value);
+char* FormatUUID(const UUID& value, char* out);
+
+/// "YYYY-MM-DD", `days` is the number of days since 1970-01-01.
+bool ParseDate(std::string_view text, int64_t& days);
+char* FormatDate(uint16_t year, uint8_t month, uint8_t day, char* out);
+
+}
@@ -0,0 +1,680 @@
+#include "time_zone.h"
+#include "platform.h"
+
+#include "../exceptions.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+namespace clickhouse {
+namespace {
+
+constexpr int64_t SecondsPerDay = 86400;
+constexpr int32_t MaxExpandedYear = 2300;
+
+inline int64_t FloorDiv(int64_t value, int64_t divisor) {
+    const int64_t quotient = value / divisor;
+    return quotient - ((value % divisor) < 0);
+}
+
+// Algorithms are from http://howardhinnant.github.io/date_algorithms.html, valid for the whole range of int32 days.
+inline int64_t DaysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int64_t era = FloorDiv(year, 400);
+    const unsigned year_of_era = static_cast<unsigned>(year - era * 400);
+    const unsigned day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + static_cast<int64_t>(day_of_era) - 719468;
+}
+
+struct CivilDate {
+    int64_t year;
+    unsigned month;
+    unsigned day;
+};
+
+inline CivilDate CivilFromDays(int64_t days) {
+    days += 719468;
+    const int64_t era = FloorDiv(days, 146097);
+    const unsigned day_of_era = static_cast<unsigned>(days - era * 146097);
+    const unsigned year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const unsigned day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const unsigned month_shifted = (5 * day_of_year + 2) / 153;
+    const unsigned day = day_of_year - (153 * month_shifted + 2) / 5 + 1;
+    const unsigned month = month_shifted < 10 ? month_shifted + 3 : month_shifted - 9;
+    return CivilDate{static_cast<int64_t>(year_of_era) + era * 400 + (month <= 2), month, day};
+}
+
+inline bool IsLeapYear(int64_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+inline unsigned DaysInMonth(int64_t year, unsigned month) {
+    static constexpr unsigned days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return days[month - 1] + (month == 2 && IsLeapYear(year));
+}
+
+void ValidateFieldsSize(const CivilTimeFields& fields, size_t size) {
+    const auto fields_size = fields.Size();
+    if (fields_size != 0 && fields_size != size) {
+        throw ValidationError("Civil time fields of size " + std::to_string(fields_size)
+                + " don't match input of size " + std::to_string(size));
+    }
+}
+
+// Writes fields of the local time given as seconds since local 1970-01-01 00:00:00.
+class CivilTimeWriter {
+public:
+    explicit CivilTimeWriter(const CivilTimeFields& fields)
+        : fields_(fields)
+        , need_date_(!fields.year.empty() || !fields.month.empty() || !fields.day.empty())
+        , need_time_(!fields.hour.empty() || !fields.minute.empty() || !fields.second.empty())
+    {}
+
+    inline void WriteDate(size_t i, int64_t days) {
+        if (!need_date_)
+            return;
+
+        const auto date = CivilFromDays(days);
+        if (!fields_.year.empty())
+            fields_.year[i] = static_cast<uint16_t>(date.year);
+        if (!fields_.month.empty())
+            fields_.month[i] = static_cast<uint8_t>(date.month);
+        if (!fields_.day.empty())
+            fields_.day[i] = static_cast<uint8_t>(date.day);
+    }
+
+    inline void WriteTime(size_t i, int64_t seconds_of_day) {
+        if (!need_time_)
+            return;
+
+        if (!fields_.hour.empty())
+            fields_.hour[i] = static_cast<uint8_t>(seconds_of_day / 3600);
+        if (!fields_.minute.empty())
+            fields_.minute[i] = static_cast<uint8_t>(seconds_of_day / 60 % 60);
+        if (!fields_.second.empty())
+            fields_.second[i] = static_cast<uint8_t>(seconds_of_day % 60);
+    }
+
+    inline void Write(size_t i, int64_t local_seconds) {
+        const int64_t days = FloorDiv(local_seconds, SecondsPerDay);
+        WriteDate(i, days);
+        WriteTime(i, local_seconds - days * SecondsPerDay);
+    }
+
+private:
+    const CivilTimeFields& fields_;
+    const bool need_date_;
+    const bool need_time_;
+};
+
+/// Rule of the POSIX TZ string (RFC 8536 footer) for a date of the DST start or end.
+struct PosixDateRule {
+    enum Kind {
+        JulianNoLeap,   // Jn: 1..365, February 29th is never counted
+        Julian,         // n: 0..365
+        MonthWeekDay,   // Mm.w.d
+    };
+
+    Kind kind = MonthWeekDay;
+    int day = 0;
+    int month = 0;
+    int week = 0;
+    int weekday = 0;
+    int32_t time = 2 * 3600;
+
+    int64_t DaysSinceEpoch(int64_t year) const {
+        const int64_t first_day_of_year = DaysFromCivil(year, 1, 1);
+        switch (kind) {
+            case JulianNoLeap:
+                return first_day_of_year + day - 1 + (IsLeapYear(year) && day >= 60);
+            case Julian:
+                return first_day_of_year + day;
+            case MonthWeekDay: {
+                const int64_t first_day = DaysFromCivil(year, month, 1);
+                // 1970-01-01 is Thursday, Sunday is 0.
+                const int64_t first_weekday = (first_day % 7 + 11) % 7;
+                int64_t result = first_day + (weekday - first_weekday + 7) % 7 + (week - 1) * 7;
+                while (result >= first_day + DaysInMonth(year, month))
+                    result -= 7;
+                return result;
+            }
+        }
+        return first_day_of_year;
+    }
+};
+
+struct PosixTimeZone {
+    int32_t std_offset = 0;
+    std::optional<int32_t> dst_offset;
+    PosixDateRule dst_start;
+    PosixDateRule dst_end;
+};
+
+class PosixTimeZoneParser {
+public:
+    explicit PosixTimeZoneParser(const std::string& spec)
+        : spec_(spec)
+    {}
+
+    std::optional<PosixTimeZone> Parse() {
+        PosixTimeZone result;
+        if (!SkipName())
+            return std::nullopt;
+
+        int32_t offset;
+        if (!ParseTime(offset))
+            return std::nullopt;
+        // POSIX offsets are positive to the west of Greenwich.
+        result.std_offset = -offset;
+
+        if (AtEnd())
+            return result;
+
+        if (!SkipName())
+            return std::nullopt;
+
+        result.dst_offset = result.std_offset + 3600;
+        if (!AtEnd() && Peek() != ',') {
+            if (!ParseTime(offset))
+                return std::nullopt;
+            result.dst_offset = -offset;
+        }
+
+        if (AtEnd()) {
+            // Default rules from POSIX, same as US rules.
+            result.dst_start.month = 3;
+            result.dst_start.week = 2;
+            result.dst_end.month = 11;
+            result.dst_end.week = 1;
+            return result;
+        }
+
+        if (!Consume(',') || !ParseDateRule(result.dst_start) || !Consume(',') || !ParseDateRule(result.dst_end) || !AtEnd())
+            return std::nullopt;
+
+        return result;
+    }
+
+private:
+    bool AtEnd() const { return pos_ >= spec_.size(); }
+    char Peek() const { return spec_[pos_]; }
+
+    bool Consume(char c) {
+        if (AtEnd() || Peek() != c)
+            return false;
+        ++pos_;
+        return true;
+    }
+
+    bool SkipName() {
+        if (Consume('<')) {
+            const auto end = spec_.find('>', pos_);
+            if (end == std::string::npos)
+                return false;
+            pos_ = end + 1;
+            return true;
+        }
+
+        const auto begin = pos_;
+        while (!AtEnd() && std::isalpha(static_cast<unsigned char>(Peek())))
+            ++pos_;
+        return pos_ - begin >= 3;
+    }
+
+    bool ParseNumber(int & value) {
+        const auto begin = pos_;
+        value = 0;
+        while (!AtEnd() && std::isdigit(static_cast<unsigned char>(Peek())) && pos_ - begin < 4) {
+            value = value * 10 + (Peek() - '0');
+            ++pos_;
+        }
+        return pos_ != begin;
+    }
+
+    // [+|-]hh[:mm[:ss]], hours can be up to 167 in rule times.
+    bool ParseTime(int32_t & result) {
+        const bool negative = Consume('-');
+        if (!negative)
+            Consume('+');
+
+        int hours = 0, minutes = 0, seconds = 0;
+        if (!ParseNumber(hours))
+            return false;
+        if (Consume(':')) {
+            if (!ParseNumber(minutes))
+                return false;
+            if (Consume(':') && !ParseNumber(seconds))
+                return false;
+        }
+
+        result = hours * 3600 + minutes * 60 + seconds;
+        if (negative)
+            result = -result;
+        return true;
+    }
+
+    bool ParseDateRule(PosixDateRule & rule) {
+        if (Consume('M')) {
+            rule.kind = PosixDateRule::MonthWeekDay;
+            if (!ParseNumber(rule.month) || !Consume('.') || !ParseNumber(rule.week) || !Consume('.') || !ParseNumber(rule.weekday))
+                return false;
+            if (rule.month < 1 || rule.month > 12 || rule.week < 1 || rule.week > 5 || rule.weekday > 6)
+                return false;
+        } else if (Consume('J')) {
+            rule.kind = PosixDateRule::JulianNoLeap;
+            if (!ParseNumber(rule.day) || rule.day < 1 || rule.day > 365)
+                return false;
+        } else {
+            rule.kind = PosixDateRule::Julian;
+            if (!ParseNumber(rule.day) || rule.day > 365)
+                return false;
+        }
+
+        if (Consume('/'))
+            return ParseTime(rule.time);
+        return true;
+    }
+
+    const std::string & spec_;
+    size_t pos_ = 0;
+};
+
+class BigEndianReader {
+public:
+    explicit BigEndianReader(const std::string & data)
+        : data_(data)
+    {}
+
+    template <typename T>
+    T Read() {
+        Require(sizeof(T));
+        uint64_t value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            value = (value << 8) | static_cast<uint8_t>(data_[pos_ + i]);
+        }
+        pos_ += sizeof(T);
+        return static_cast<T>(value);
+    }
+
+    void Skip(size_t bytes) {
+        Require(bytes);
+        pos_ += bytes;
+    }
+
+    size_t Position() const { return pos_; }
+    const std::string & Data() const { return data_; }
+
+private:
+    void Require(size_t bytes) const {
+        if (data_.size() - pos_ < bytes)
+            throw ValidationError("Unexpected end of time zone file");
+    }
+
+    const std::string & data_;
+    size_t pos_ = 0;
+};
+
+struct TzifData {
+    int32_t initial_offset = 0;
+    std::vector<std::pair<int64_t, int32_t>> transitions;
+    std::string footer;
+};
+
+// Parses TZif file (RFC 8536), version 2+ data block and footer are preferred when present.
+TzifData ParseTzif(const std::string & data) {
+    BigEndianReader reader(data);
+
+    auto read_block = [&reader](bool wide, TzifData & result) {
+        if (reader.Read<uint32_t>() != 0x545A6966) // "TZif"
+            throw ValidationError("Not a time zone file");
+        const auto version = reader.Read<uint8_t>();
+        reader.Skip(15);
+
+        const auto isutcnt = reader.Read<uint32_t>();
+        const auto isstdcnt = reader.Read<uint32_t>();
+        const auto leapcnt = reader.Read<uint32_t>();
+        const auto timecnt = reader.Read<uint32_t>();
+        const auto typecnt = reader.Read<uint32_t>();
+        const auto charcnt = reader.Read<uint32_t>();
+
+        std::vector<int64_t> times(timecnt);
+        for (auto & time : times) {
+            time = wide ? reader.Read<int64_t>() : reader.Read<int32_t>();
+        }
+
+        std::vector<uint8_t> type_indices(timecnt);
+        for (auto & index : type_indices) {
+            index = reader.Read<uint8_t>();
+        }
+
+        std::vector<int32_t> offsets(typecnt);
+        for (auto & offset : offsets) {
+            offset = reader.Read<int32_t>();
+            reader.Skip(2); // isdst and abbreviation index
+        }
+
+        reader.Skip(charcnt + leapcnt * (wide ? 12 : 8) + isstdcnt + isutcnt);
+
+        if (offsets.empty())
+            throw ValidationError("Time zone file has no local time types");
+
+        result.initial_offset = offsets[0];
+        result.transitions.clear();
+        for (size_t i = 0; i < times.size(); ++i) {
+            if (type_indices[i] >= offsets.size())
+                throw ValidationError("Time zone file has invalid local time type");
+            result.transitions.emplace_back(times[i], offsets[type_indices[i]]);
+        }
+
+        return version;
+    };
+
+    TzifData result;
+    const auto version = read_block(false, result);
+    if (version >= '2') {
+        read_block(true, result);
+
+        // Footer is "\n<POSIX TZ string>\n".
+        const auto & bytes = reader.Data();
+        const auto begin = reader.Position();
+        if (begin < bytes.size() && bytes[begin] == '\n') {
+            const auto end = bytes.find('\n', begin + 1);
+            if (end != std::string::npos)
+                result.footer = bytes.substr(begin + 1, end - begin - 1);
+        }
+    }
+
+    return result;
+}
+
+// Appends transitions produced by the POSIX rule after the last explicit transition.
+void ExpandPosixRule(const PosixTimeZone & rule, std::vector<std::pair<int64_t, int32_t>> & transitions) {
+    const int64_t last = transitions.empty() ? std::numeric_limits<int64_t>::min() : transitions.back().first;
+
+    if (!rule.dst_offset) {
+        if (transitions.empty() || transitions.back().second != rule.std_offset)
+            transitions.emplace_back(transitions.empty() ? std::numeric_limits<int64_t>::min() : last + 1, rule.std_offset);
+        return;
+    }
+
+    const int64_t first_year = transitions.empty() ? 1900 : CivilFromDays(FloorDiv(last, SecondsPerDay)).year;
+    for (int64_t year = first_year; year <= MaxExpandedYear; ++year) {
+        // Start of DST is given in standard time, end of DST in daylight saving time.
+        std::pair<int64_t, int32_t> year_transitions[] = {
+            {rule.dst_start.DaysSinceEpoch(year) * SecondsPerDay + rule.dst_start.time - rule.std_offset, *rule.dst_offset},
+            {rule.dst_end.DaysSinceEpoch(year) * SecondsPerDay + rule.dst_end.time - *rule.dst_offset, rule.std_offset},
+        };
+        if (year_transitions[1].first < year_transitions[0].first)
+            std::swap(year_transitions[0], year_transitions[1]);
+
+        for (const auto & transition : year_transitions) {
+            if (transition.first > last)
+                transitions.push_back(transition);
+        }
+    }
+}
+
+bool IsDirectory(const std::string & path) {
+#if defined(_win_)
+    struct _stat info;
+    return _stat(path.c_str(), &info) == 0 && (info.st_mode & _S_IFDIR) != 0;
+#else
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+#endif
+}
+
+std::string ReadTimeZoneFile(const std::string & name) {
+    if (name.find("..") != std::string::npos || name.front() == '/')
+        throw ValidationError("Invalid time zone name: " + name);
+
+    // $TZDIR takes precedence over the usual locations of the system database, there are none on Windows.
+    std::vector<std::string> directories;
+    if (const char * tzdir = std::getenv("TZDIR"); tzdir && *tzdir)
+        directories.emplace_back(tzdir);
+    directories.insert(directories.end(), {"/usr/share/zoneinfo", "/usr/lib/zoneinfo", "/usr/share/lib/zoneinfo", "/etc/zoneinfo"});
+
+    bool has_database = false;
+    for (const auto & directory : directories) {
+        if (!IsDirectory(directory))
+            continue;
+
+        has_database = true;
+        std::ifstream file(directory + "/" + name, std::ios::binary);
+        if (file) {
+            return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+    }
+
+    if (!has_database)
+        throw ValidationError("Time zone database is not found, set TZDIR to a directory of TZif files to use time zone " + name);
+    throw ValidationError("Unknown time zone: " + name);
+}
+
+}
+
+size_t CivilTimeFields::Size() const {
+    size_t result = 0;
+    auto check = [&result](size_t size) {
+        if (size == 0)
+            return;
+        if (result != 0 && result != size)
+            throw ValidationError("Civil time fields are of different sizes: " + std::to_string(result) + " and " + std::to_string(size));
+        result = size;
+    };
+
+    check(year.size());
+    check(month.size());
+    check(day.size());
+    check(hour.size());
+    check(minute.size());
+    check(second.size());
+
+    return result;
+}
+
+CivilTimeFields CivilTimeFields::Subspan(size_t offset, size_t count) const {
+    return CivilTimeFields{
+        year.subspan(offset, count),
+        month.subspan(offset, count),
+        day.subspan(offset, count),
+        hour.subspan(offset, count),
+        minute.subspan(offset, count),
+        second.subspan(offset, count),
+    };
+}
+
+TimeZone::TimeZone(std::string name, int32_t initial_offset, std::vector<Transition> transitions)
+    : name_(std::move(name))
+    , initial_offset_(initial_offset)
+    , transitions_(std::move(transitions))
+{}
+
+std::shared_ptr<const TimeZone> TimeZone::UTC() {
+    static const std::shared_ptr<const TimeZone> utc(new TimeZone("UTC", 0, {}));
+    return utc;
+}
+
+std::shared_ptr<const TimeZone> TimeZone::Get(const std::string& name) {
+    if (name.empty() || name == "UTC" || name == "GMT" || name == "Etc/UTC" || name == "Etc/GMT")
+        return UTC();
+
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::shared_ptr<const TimeZone>> cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto & time_zone = cache[name];
+    if (!time_zone) {
+        try {
+            time_zone = Load(name);
+        } catch (...) {
+            cache.erase(name);
+            throw;
+        }
+    }
+
+    return time_zone;
+}
+
+std::shared_ptr<const TimeZone> TimeZone::Load(const std::string& name) {
+    auto tzif = ParseTzif(ReadTimeZoneFile(name));
+
+    if (!tzif.footer.empty()) {
+        if (auto rule = PosixTimeZoneParser(tzif.footer).Parse()) {
+            if (tzif.transitions.empty())
+                tzif.initial_offset = rule->std_offset;
+            ExpandPosixRule(*rule, tzif.transitions);
+        }
+    }
+
+    // Keep only transitions that actually change the offset.
+    std::vector<Transition> transitions;
+    int32_t current_offset = tzif.initial_offset;
+    for (const auto & [utc_seconds, offset] : tzif.transitions) {
+        if (offset != current_offset && (transitions.empty() || utc_seconds > transitions.back().utc_seconds)) {
+            transitions.push_back(Transition{utc_seconds, offset});
+            current_offset = offset;
+        }
+    }
+
+    return std::shared_ptr<const TimeZone>(new TimeZone(name, tzif.initial_offset, std::move(transitions)));
+}
+
+size_t TimeZone::FindTransition(int64_t utc_seconds) const {
+    const auto it = std::upper_bound(transitions_.begin(), transitions_.end(), utc_seconds,
+            [](int64_t value, const Transition & transition) { return value < transition.utc_seconds; });
+    return static_cast<size_t>(it - transitions_.begin());
+}
+
+int32_t TimeZone::GetOffset(int64_t utc_seconds) const {
+    const auto index = FindTransition(utc_seconds);
+    return index == 0 ? initial_offset_ : transitions_[index - 1].offset;
+}
+
+namespace {
+
+// Offset lookup for a sequence of values: the table is searched only when a value leaves the interval of the previous one.
+class OffsetCursor {
+public:
+    template <typename FindTransition>
+    inline int32_t GetOffset(int64_t utc_seconds, FindTransition && find) {
+        if (utc_seconds < begin_ || utc_seconds >= end_) {
+            find(utc_seconds, begin_, end_, offset_);
+        }
+        return offset_;
+    }
+
+private:
+    int64_t begin_ = std::numeric_limits<int64_t>::max();
+    int64_t end_ = std::numeric_limits<int64_t>::min();
+    int32_t offset_ = 0;
+};
+
+}
+
+template <typename T>
+void TimeZone::ToLocalSecondsImpl(Span<const T> utc_seconds, Span<int64_t> dest) const {
+    if (utc_seconds.size() != dest.size()) {
+        throw ValidationError("Size mismatch on time zone conversion: " + std::to_string(utc_seconds.size())
+                + " vs " + std::to_string(dest.size()));
+    }
+
+    if (transitions_.empty()) {
+        for (size_t i = 0; i < utc_seconds.size(); ++i) {
+            dest[i] = static_cast<int64_t>(utc_seconds[i]) + initial_offset_;
+        }
+        return;
+    }
+
+    auto find = [this](int64_t value, int64_t & begin, int64_t & end, int32_t & offset) {
+        const auto index = FindTransition(value);
+        begin = index == 0 ? std::numeric_limits<int64_t>::min() : transitions_[index - 1].utc_seconds;
+        end = index == transitions_.size() ? std::numeric_limits<int64_t>::max() : transitions_[index].utc_seconds;
+        offset = index == 0 ? initial_offset_ : transitions_[index - 1].offset;
+    };
+
+    OffsetCursor cursor;
+    for (size_t i = 0; i < utc_seconds.size(); ++i) {
+        const auto value = static_cast<int64_t>(utc_seconds[i]);
+        dest[i] = value + cursor.GetOffset(value, find);
+    }
+}
+
+template <typename T>
+void TimeZone::ToCivilTimeImpl(Span<const T> utc_seconds, const CivilTimeFields& fields) const {
+    ValidateFieldsSize(fields, utc_seconds.size());
+    if (fields.Size() == 0)
+        return;
+
+    // Local time is computed in chunks to keep the offset lookup and the calendar math in separate tight loops.
+    constexpr size_t ChunkSize = 1024;
+    int64_t local_seconds[ChunkSize];
+
+    CivilTimeWriter writer(fields);
+    for (size_t chunk = 0; chunk < utc_seconds.size(); chunk += ChunkSize) {
+        const auto count = std::min(ChunkSize, utc_seconds.size() - chunk);
+        ToLocalSecondsImpl(utc_seconds.subspan(chunk, count), Span<int64_t>(local_seconds, count));
+
+        for (size_t i = 0; i < count; ++i) {
+            writer.Write(chunk + i, local_seconds[i]);
+        }
+    }
+}
+
+void TimeZone::ToLocalSeconds(Span<const int64_t> utc_seconds, Span<int64_t> dest) const {
+    ToLocalSecondsImpl(utc_seconds, dest);
+}
+
+void TimeZone::ToLocalSeconds(Span<const uint32_t> utc_seconds, Span<int64_t> dest) const {
+    ToLocalSecondsImpl(utc_seconds, dest);
+}
+
+void TimeZone::ToCivilTime(Span<const int64_t> utc_seconds, const CivilTimeFields& fields) const {
+    ToCivilTimeImpl(utc_seconds, fields);
+}
+
+void TimeZone::ToCivilTime(Span<const uint32_t> utc_seconds, const CivilTimeFields& fields) const {
+    ToCivilTimeImpl(utc_seconds, fields);
+}
+
+namespace {
+
+template <typename T>
+void DaysToCivilDateImpl(Span<const T> days, const CivilTimeFields& fields) {
+    ValidateFieldsSize(fields, days.size());
+    if (fields.Size() == 0)
+        return;
+
+    CivilTimeWriter writer(fields);
+    for (size_t i = 0; i < days.size(); ++i) {
+        writer.WriteDate(i, static_cast<int64_t>(days[i]));
+        writer.WriteTime(i, 0);
+    }
+}
+
+}
+
+void TimeZone::DaysToCivilDate(Span<const int32_t> days, const CivilTimeFields& fields) {
+    DaysToCivilDateImpl(days, fields);
+}
+
+void TimeZone::DaysToCivilDate(Span<const uint16_t> days, const CivilTimeFields& fields) {
+    DaysToCivilDateImpl(days, fields);
+}
+
+int64_t TimeZone::CivilDateToDays(int64_t year, unsigned month, unsigned day) {
+    return DaysFromCivil(year, month, day);
+}
+
+}
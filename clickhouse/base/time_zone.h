@@ -0,0 +1,98 @@
+#pragma once
+
+#include "span.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clickhouse {
+
+/** Civil (wall clock) time fields, one span per field, each either empty (the field is not needed)
+ *  or of the same size as the input of a conversion.
+ */
+struct CivilTimeFields {
+    Span<uint16_t> year;
+    Span<uint8_t> month;    ///< 1..12
+    Span<uint8_t> day;      ///< 1..31
+    Span<uint8_t> hour;
+    Span<uint8_t> minute;
+    Span<uint8_t> second;
+
+    /// Common size of non-empty fields, throws ValidationError if sizes differ.
+    size_t Size() const;
+
+    /// Same fields narrowed to [offset, offset + count).
+    CivilTimeFields Subspan(size_t offset, size_t count) const;
+};
+
+/** Time zone rules loaded from the system tz database (TZif files in $TZDIR or /usr/share/zoneinfo).
+ *  There is no such database on Windows, TZDIR must be set to one (e.g. of the IANA tzdata package) to use
+ *  time zones other than UTC there.
+ *
+ *  All UTC offset changes of the zone are precomputed into a single sorted table on load,
+ *  including ones produced by the POSIX TZ rule of the file for dates after the last explicit transition (up to year 2300).
+ *  Conversions of many values look the table up only when a value leaves the interval of the previous one,
+ *  so converting a column of close timestamps costs about the same as converting in UTC.
+ */
+class TimeZone {
+public:
+    /** Returns rules for the time zone with given IANA name, loaded once and cached for the lifetime of the process.
+     *  Empty name, "UTC" and "GMT" denote UTC and are always available, even without tz database.
+     *  Throws ValidationError if there is no such time zone, or no tz database to look it up in.
+     */
+    static std::shared_ptr<const TimeZone> Get(const std::string& name);
+
+    /// UTC time zone.
+    static std::shared_ptr<const TimeZone> UTC();
+
+    inline const std::string& Name() const { return name_; }
+
+    /// Offset of the local time from UTC in seconds (positive to the east of Greenwich) at given UTC moment.
+    int32_t GetOffset(int64_t utc_seconds) const;
+
+    /// Converts UTC seconds to local wall clock time, expressed as seconds since 1970-01-01 00:00:00 local time.
+    inline int64_t ToLocalSeconds(int64_t utc_seconds) const { return utc_seconds + GetOffset(utc_seconds); }
+
+    /// Same as ToLocalSeconds() for each value, `dest` must be of the same size as `utc_seconds`.
+    void ToLocalSeconds(Span<const int64_t> utc_seconds, Span<int64_t> dest) const;
+    void ToLocalSeconds(Span<const uint32_t> utc_seconds, Span<int64_t> dest) const;
+
+    /// Splits each UTC timestamp into civil time fields in this time zone.
+    void ToCivilTime(Span<const int64_t> utc_seconds, const CivilTimeFields& fields) const;
+    void ToCivilTime(Span<const uint32_t> utc_seconds, const CivilTimeFields& fields) const;
+
+    /// Splits number of days since 1970-01-01 into year, month and day; time zone independent, other fields are zeroed.
+    static void DaysToCivilDate(Span<const int32_t> days, const CivilTimeFields& fields);
+    static void DaysToCivilDate(Span<const uint16_t> days, const CivilTimeFields& fields);
+
+    /// Number of days since 1970-01-01 of the given proleptic Gregorian date, the date is not validated.
+    static int64_t CivilDateToDays(int64_t year, unsigned month, unsigned day);
+
+private:
+    struct Transition {
+        int64_t utc_seconds;
+        int32_t offset;     ///< offset in effect from `utc_seconds` on
+    };
+
+    TimeZone(std::string name, int32_t initial_offset, std::vector<Transition> transitions);
+
+    static std::shared_ptr<const TimeZone> Load(const std::string& name);
+
+    template <typename T>
+    void ToLocalSecondsImpl(Span<const T> utc_seconds, Span<int64_t> dest) const;
+
+    template <typename T>
+    void ToCivilTimeImpl(Span<const T> utc_seconds, const CivilTimeFields& fields) const;
+
+    /// Index of the first transition after `utc_seconds`.
+    size_t FindTransition(int64_t utc_seconds) const;
+
+private:
+    const std::string name_;
+    const int32_t initial_offset_;
+    const std::vector<Transition> transitions_;
+};
+
+}
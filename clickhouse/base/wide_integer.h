@@ -0,0 +1,205 @@
+#pragma once
+
+#include "absl/numeric/int128.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace clickhouse {
+namespace details {
+
+/** 256-bit integer with the same memory layout as ClickHouse's Int256 and UInt256:
+ *  four 64-bit limbs, least significant first. On little-endian hosts column data is
+ *  read from and written to the wire as-is, without per-value conversion.
+ *
+ *  Only arithmetic required to convert values to and from other types is provided.
+ */
+template <bool Signed>
+class WideInteger256 {
+public:
+    using Limbs = std::array<uint64_t, 4>;
+
+    constexpr WideInteger256() noexcept
+        : limbs_{}
+    {}
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    constexpr WideInteger256(T value) noexcept
+        : limbs_{static_cast<uint64_t>(value), SignFill(value), SignFill(value), SignFill(value)}
+    {}
+
+    constexpr WideInteger256(absl::int128 value) noexcept
+        : limbs_{absl::Int128Low64(value), static_cast<uint64_t>(absl::Int128High64(value)),
+                 SignFill(absl::Int128High64(value)), SignFill(absl::Int128High64(value))}
+    {}
+
+    constexpr WideInteger256(absl::uint128 value) noexcept
+        : limbs_{absl::Uint128Low64(value), absl::Uint128High64(value), 0, 0}
+    {}
+
+    static constexpr WideInteger256 FromLimbs(const Limbs & limbs) noexcept {
+        WideInteger256 result;
+        result.limbs_ = limbs;
+        return result;
+    }
+
+    inline const Limbs & GetLimbs() const noexcept { return limbs_; }
+
+    /// Conversions to narrower types keep the lowest bits, same as conversions between built-in integers.
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    explicit constexpr operator T() const noexcept {
+        return static_cast<T>(limbs_[0]);
+    }
+
+    explicit constexpr operator absl::int128() const noexcept {
+        return absl::MakeInt128(static_cast<int64_t>(limbs_[1]), limbs_[0]);
+    }
+
+    explicit constexpr operator absl::uint128() const noexcept {
+        return absl::MakeUint128(limbs_[1], limbs_[0]);
+    }
+
+    explicit operator double() const noexcept {
+        if (IsNegative())
+            return -static_cast<double>(-*this);
+
+        double result = 0;
+        for (size_t i = limbs_.size(); i > 0; --i) {
+            result = result * 18446744073709551616.0 + static_cast<double>(limbs_[i - 1]);
+        }
+        return result;
+    }
+
+    bool IsNegative() const noexcept {
+        return Signed && (limbs_[3] >> 63);
+    }
+
+    WideInteger256 operator~() const noexcept {
+        return FromLimbs({~limbs_[0], ~limbs_[1], ~limbs_[2], ~limbs_[3]});
+    }
+
+    WideInteger256 operator-() const noexcept {
+        return ~*this + WideInteger256(1);
+    }
+
+    friend WideInteger256 operator+(const WideInteger256 & left, const WideInteger256 & right) noexcept {
+        WideInteger256 result;
+        uint64_t carry = 0;
+        for (size_t i = 0; i < left.limbs_.size(); ++i) {
+            const uint64_t sum = left.limbs_[i] + carry;
+            carry = sum < carry;
+            result.limbs_[i] = sum + right.limbs_[i];
+            carry += result.limbs_[i] < sum;
+        }
+        return result;
+    }
+
+    friend WideInteger256 operator-(const WideInteger256 & left, const WideInteger256 & right) noexcept {
+        return left + -right;
+    }
+
+    /// Multiplication modulo 2^256.
+    friend WideInteger256 operator*(const WideInteger256 & left, const WideInteger256 & right) noexcept {
+        WideInteger256 result;
+        for (size_t i = 0; i < left.limbs_.size(); ++i) {
+            uint64_t carry = 0;
+            for (size_t j = 0; i + j < left.limbs_.size(); ++j) {
+                const absl::uint128 product = absl::uint128(left.limbs_[i]) * right.limbs_[j]
+                        + result.limbs_[i + j] + carry;
+                result.limbs_[i + j] = absl::Uint128Low64(product);
+                carry = absl::Uint128High64(product);
+            }
+        }
+        return result;
+    }
+
+    friend bool operator==(const WideInteger256 & left, const WideInteger256 & right) noexcept {
+        return left.limbs_ == right.limbs_;
+    }
+
+    friend bool operator!=(const WideInteger256 & left, const WideInteger256 & right) noexcept {
+        return !(left == right);
+    }
+
+    friend bool operator<(const WideInteger256 & left, const WideInteger256 & right) noexcept {
+        if (left.IsNegative() != right.IsNegative())
+            return left.IsNegative();
+
+        for (size_t i = left.limbs_.size(); i > 0; --i) {
+            if (left.limbs_[i - 1] != right.limbs_[i - 1])
+                return left.limbs_[i - 1] < right.limbs_[i - 1];
+        }
+        return false;
+    }
+
+    friend bool operator>(const WideInteger256 & left, const WideInteger256 & right) noexcept {
+        return right < left;
+    }
+
+    friend bool operator<=(const WideInteger256 & left, const WideInteger256 & right) noexcept {
+        return !(right < left);
+    }
+
+    friend bool operator>=(const WideInteger256 & left, const WideInteger256 & right) noexcept {
+        return !(left < right);
+    }
+
+    /// Decimal representation of the value.
+    std::string ToString() const {
+        Limbs magnitude = IsNegative() ? (-*this).limbs_ : limbs_;
+
+        std::string result;
+        do {
+            // Divide by 10^19, the largest power of 10 that fits into a limb, and print the remainder.
+            constexpr uint64_t Divisor = 10'000'000'000'000'000'000ull;
+            uint64_t remainder = 0;
+            for (size_t i = magnitude.size(); i > 0; --i) {
+                const absl::uint128 current = absl::MakeUint128(remainder, magnitude[i - 1]);
+                magnitude[i - 1] = absl::Uint128Low64(current / Divisor);
+                remainder = absl::Uint128Low64(current % Divisor);
+            }
+
+            const bool is_last = magnitude == Limbs{};
+            for (size_t digits = 0; digits < 19 && (remainder || !is_last || digits == 0); ++digits) {
+                result.push_back(static_cast<char>('0' + remainder % 10));
+                remainder /= 10;
+            }
+        } while (magnitude != Limbs{});
+
+        if (IsNegative())
+            result.push_back('-');
+
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    friend std::ostream & operator<<(std::ostream & stream, const WideInteger256 & value) {
+        return stream << value.ToString();
+    }
+
+private:
+    template <typename T>
+    static constexpr uint64_t SignFill(T value) noexcept {
+        // Negative values are sign-extended, same as conversions between built-in integers.
+        if constexpr (std::is_signed_v<T>) {
+            return value < 0 ? ~uint64_t(0) : 0;
+        } else {
+            return 0;
+        }
+    }
+
+    Limbs limbs_;
+};
+
+}
+
+using Int256 = details::WideInteger256<true>;
+using UInt256 = details::WideInteger256<false>;
+
+static_assert(sizeof(Int256) == 32 && sizeof(UInt256) == 32, "Int256 and UInt256 must match wire layout");
+
+}
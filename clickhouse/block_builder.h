@@ -0,0 +1,152 @@
+#pragma once
+
+#include "block.h"
+#include "columns/utils.h"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace clickhouse {
+
+/**
+ * Builds blocks of columns of known classes row by row, e.g.
+ *
+ *     TypedBlockBuilder<ColumnUInt64, ColumnString, ColumnNullableT<ColumnFloat64>> builder({"id", "name", "score"});
+ *     builder.Reserve(rows);
+ *     for (...) {
+ *         builder.AppendRow(id, name, std::optional<double>(score));
+ *     }
+ *     client.Insert("table", builder.Build());
+ *
+ * The schema is the list of column classes, which defines ClickHouse types and C++ types of values:
+ * a value is appended with the non-virtual Append() of its column class, so mistyped rows don't compile.
+ */
+template <typename... Columns>
+class TypedBlockBuilder {
+    static_assert(sizeof...(Columns) > 0, "TypedBlockBuilder must have at least one column");
+    static_assert((std::is_base_of_v<Column, Columns> && ...), "TypedBlockBuilder takes column classes");
+
+public:
+    static constexpr size_t ColumnCount = sizeof...(Columns);
+
+    using Names = std::array<std::string, ColumnCount>;
+
+    /// Columns are made by default constructors.
+    explicit TypedBlockBuilder(Names names)
+        : TypedBlockBuilder(std::move(names), std::make_shared<Columns>()...)
+    {}
+
+    /// Columns of parametrized types, e.g. ColumnDateTime64(3) or ColumnDecimal(18, 4), are given explicitly, they must be empty.
+    TypedBlockBuilder(Names names, std::shared_ptr<Columns>... columns)
+        : names_(std::move(names))
+        , columns_(std::move(columns)...)
+    {
+        ForEachColumn([this](const auto & column, size_t i) {
+            if (!column || column->Size() != 0) {
+                throw ValidationError("Column '" + names_[i] + "' of TypedBlockBuilder must be an empty column");
+            }
+        });
+    }
+
+    /// Reserves space for given count of rows in all columns.
+    void Reserve(size_t rows) {
+        ForEachColumn([rows](const auto & column, size_t) { column->Reserve(rows); });
+        capacity_ = rows;
+    }
+
+    /** Appends row, values are passed to Append() of respective columns.
+     *  If Append() throws, e.g. on a too long value of FixedString, the row is appended partially and the builder must be discarded.
+     */
+    template <typename... Values>
+    inline void AppendRow(Values&&... values) {
+        static_assert(sizeof...(Values) == ColumnCount, "Count of values must be equal to count of columns");
+        AppendRowImpl(std::index_sequence_for<Columns...>{}, std::forward<Values>(values)...);
+        ++rows_;
+    }
+
+    /// Appends row given as a tuple, e.g. of std::tuple or std::pair.
+    template <typename Tuple>
+    inline void AppendTuple(Tuple&& row) {
+        std::apply([this](auto&&... values) { AppendRow(std::forward<decltype(values)>(values)...); }, std::forward<Tuple>(row));
+    }
+
+    /// Returns count of rows appended since the last Build().
+    inline size_t Size() const { return rows_; }
+
+    /// Returns column by index.
+    template <size_t I>
+    inline const auto& GetColumn() const { return std::get<I>(columns_); }
+
+    inline const Names& GetNames() const { return names_; }
+
+    /** Checks that the header of the table or query, e.g. a block received by Client::Select() of "SELECT ... LIMIT 0",
+     *  has exactly the columns of the builder, of the same names and types in the same order,
+     *  throws ValidationError otherwise.
+     */
+    void Validate(const Block& header) const {
+        if (header.GetColumnCount() != ColumnCount) {
+            throw ValidationError("Header has " + std::to_string(header.GetColumnCount()) + " columns, builder has "
+                    + std::to_string(ColumnCount));
+        }
+        ForEachColumn([this, &header](const auto & column, size_t i) {
+            if (header.GetColumnName(i) != names_[i]) {
+                throw ValidationError("Column " + std::to_string(i) + " is '" + header.GetColumnName(i) + "' in header, '"
+                        + names_[i] + "' in builder");
+            }
+            if (!header[i]->Type()->IsEqual(column->Type())) {
+                throw ValidationError("Column '" + names_[i] + "' is of " + header[i]->Type()->GetName() + " in header, of "
+                        + column->Type()->GetName() + " in builder");
+            }
+        });
+    }
+
+    /// Returns block of appended rows and starts a new one, with the same space reserved.
+    Block Build() {
+        Block result(ColumnCount, rows_);
+        ForEachColumn([this, &result](auto & column, size_t i) {
+            using ColumnType = typename std::decay_t<decltype(column)>::element_type;
+
+            result.AppendColumn(names_[i], column);
+            column = WrapColumn<ColumnType>(column->CloneEmpty());
+            if (capacity_) {
+                column->Reserve(capacity_);
+            }
+        });
+        rows_ = 0;
+        return result;
+    }
+
+private:
+    template <size_t... I, typename... Values>
+    inline void AppendRowImpl(std::index_sequence<I...>, Values&&... values) {
+        (std::get<I>(columns_)->Append(std::forward<Values>(values)), ...);
+    }
+
+    template <typename Func>
+    void ForEachColumn(Func&& func) {
+        ForEachColumnImpl(std::forward<Func>(func), std::index_sequence_for<Columns...>{});
+    }
+
+    template <typename Func>
+    void ForEachColumn(Func&& func) const {
+        const_cast<TypedBlockBuilder*>(this)->ForEachColumnImpl([&func](const auto & column, size_t i) { func(column, i); },
+                std::index_sequence_for<Columns...>{});
+    }
+
+    template <typename Func, size_t... I>
+    void ForEachColumnImpl(Func&& func, std::index_sequence<I...>) {
+        (func(std::get<I>(columns_), I), ...);
+    }
+
+private:
+    Names names_;
+    std::tuple<std::shared_ptr<Columns>...> columns_;
+    size_t rows_ = 0;
+    size_t capacity_ = 0;
+};
+
+}
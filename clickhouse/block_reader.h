@@ -0,0 +1,190 @@
+#pragma once
+
+#include "block.h"
+#include "columns/enum.h"
+#include "columns/numeric.h"
+#include "columns/sparse.h"
+#include "columns/string.h"
+#include "columns/utils.h"
+
+#include <array>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace clickhouse {
+
+namespace details {
+
+/// Reads values of a column of class ColumnType by row number, rows must be in range.
+template <typename ColumnType>
+class TypedColumnAccessor {
+public:
+    explicit TypedColumnAccessor(const ColumnType& column) : column_(&column) {}
+
+    inline auto operator()(size_t row) const { return column_->At(row); }
+
+private:
+    const ColumnType* column_;
+};
+
+/// Columns with contiguous values are read from their data without bounds checks.
+template <typename T, typename ColumnType>
+class SpanColumnAccessor {
+public:
+    explicit SpanColumnAccessor(const ColumnType& column) : data_(column.GetData().data()) {}
+
+    inline const T& operator()(size_t row) const { return data_[row]; }
+
+private:
+    const T* data_;
+};
+
+template <typename T>
+class TypedColumnAccessor<ColumnVector<T>> : public SpanColumnAccessor<T, ColumnVector<T>> {
+    using SpanColumnAccessor<T, ColumnVector<T>>::SpanColumnAccessor;
+};
+
+template <typename T>
+class TypedColumnAccessor<ColumnEnum<T>> : public SpanColumnAccessor<T, ColumnEnum<T>> {
+    using SpanColumnAccessor<T, ColumnEnum<T>>::SpanColumnAccessor;
+};
+
+template <>
+class TypedColumnAccessor<ColumnString> : public SpanColumnAccessor<std::string_view, ColumnString> {
+    using SpanColumnAccessor<std::string_view, ColumnString>::SpanColumnAccessor;
+};
+
+}
+
+/**
+ * Reads rows of a block of columns of known classes, e.g. received by Client::Select():
+ *
+ *     TypedBlockReader<ColumnUInt64, ColumnString> reader(block);
+ *     for (const auto & [id, name] : reader) {
+ *         ...
+ *     }
+ *
+ * Classes of columns are checked once, by the constructor, then values are read without casts:
+ * ColumnVector, ColumnEnum and ColumnString values straight from their data, others with At() of their class.
+ * Columns of generic classes, e.g. ColumnNullable as created for a Select(), are read by typed wrappers
+ * like ColumnNullableT: the constructor wraps a copy of such column, the column of the block is left as is.
+ * Rows are views into the columns, the block must outlive the reader and the values read.
+ */
+template <typename... Columns>
+class TypedBlockReader {
+    static_assert(sizeof...(Columns) > 0, "TypedBlockReader must have at least one column");
+    static_assert((std::is_base_of_v<Column, Columns> && ...), "TypedBlockReader takes column classes");
+
+public:
+    static constexpr size_t ColumnCount = sizeof...(Columns);
+
+    /// Row of values of the columns.
+    using RowType = std::tuple<std::decay_t<decltype(std::declval<details::TypedColumnAccessor<Columns>>()(0))>...>;
+
+    /** Throws ValidationError if the block doesn't have exactly ColumnCount columns of the classes,
+     *  or of classes the wrappers can wrap. Sparse columns are made dense first.
+     */
+    explicit TypedBlockReader(const Block& block)
+        : TypedBlockReader(block, std::index_sequence_for<Columns...>{})
+    {}
+
+    /// Count of rows.
+    inline size_t Size() const { return rows_; }
+
+    /// Returns value of the I-th column in the row, the row must be less than Size().
+    template <size_t I>
+    inline decltype(auto) Get(size_t row) const {
+        return std::get<I>(accessors_)(row);
+    }
+
+    /// Returns values of all columns in the row, the row must be less than Size().
+    inline RowType operator[](size_t row) const {
+        return GetRow(row, std::index_sequence_for<Columns...>{});
+    }
+
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = RowType;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = RowType;
+
+        inline Iterator(const TypedBlockReader& reader, size_t row) : reader_(&reader), row_(row) {}
+
+        inline RowType operator*() const { return (*reader_)[row_]; }
+
+        inline Iterator& operator++() {
+            ++row_;
+            return *this;
+        }
+
+        inline bool operator==(const Iterator& other) const { return row_ == other.row_ && reader_ == other.reader_; }
+        inline bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        const TypedBlockReader* reader_;
+        size_t row_;
+    };
+
+    inline Iterator begin() const { return Iterator(*this, 0); }
+    inline Iterator end() const { return Iterator(*this, rows_); }
+
+private:
+    template <size_t... I>
+    TypedBlockReader(const Block& block, std::index_sequence<I...>)
+        : columns_{CheckColumnCount(block)[I]...}
+        , accessors_(details::TypedColumnAccessor<Columns>(CheckColumn<Columns>(block, I))...)
+        , rows_(block.GetRowCount())
+    {}
+
+    static const Block& CheckColumnCount(const Block& block) {
+        if (block.GetColumnCount() != ColumnCount) {
+            throw ValidationError("Block has " + std::to_string(block.GetColumnCount()) + " columns, reader has "
+                    + std::to_string(ColumnCount));
+        }
+        return block;
+    }
+
+    template <typename ColumnType>
+    const ColumnType& CheckColumn(const Block& block, size_t i) {
+        if (const auto sparse = columns_[i]->template AsPtr<ColumnSparse>()) {
+            columns_[i] = sparse->Densify();
+        }
+
+        if (const auto result = columns_[i]->template AsPtr<ColumnType>()) {
+            return *result;
+        }
+
+        if constexpr (HasWrapMethod<ColumnType>::value) {
+            // Wrap() takes over nested columns of the column it wraps, which are shared with the block.
+            try {
+                auto wrapped = ColumnType::Wrap(columns_[i]->Slice(0, columns_[i]->Size()));
+                columns_[i] = wrapped;
+                return *wrapped;
+            } catch (const ValidationError&) {
+            } catch (const std::bad_cast&) {
+            }
+        }
+
+        throw ValidationError("Column '" + block.GetColumnName(i) + "' of " + columns_[i]->Type()->GetName()
+                + " is not of the class of column " + std::to_string(i) + " of the reader");
+    }
+
+    template <size_t... I>
+    inline RowType GetRow(size_t row, std::index_sequence<I...>) const {
+        return RowType(std::get<I>(accessors_)(row)...);
+    }
+
+private:
+    /// Columns read: dense ones of sparse columns of the block, wrappers of copies of generic ones.
+    std::array<ColumnRef, ColumnCount> columns_;
+    std::tuple<details::TypedColumnAccessor<Columns>...> accessors_;
+    size_t rows_;
+};
+
+}
@@ -1,6 +1,8 @@
 #include "client.h"
 #include "clickhouse/version.h"
+#include "native.h"
 #include "protocol.h"
+#include "protocol_revisions.h"
 
 #include "base/compressed.h"
 #include "base/socket.h"
@@ -9,6 +11,8 @@
 #include "columns/factory.h"
 
 #include <assert.h>
+#include <cerrno>
+#include <limits>
 #include <system_error>
 #include <vector>
 #include <sstream>
@@ -19,28 +23,6 @@
 
 #define DBMS_NAME                                       "ClickHouse"
 
-#define DBMS_MIN_REVISION_WITH_TEMPORARY_TABLES         50264
-#define DBMS_MIN_REVISION_WITH_TOTAL_ROWS_IN_PROGRESS   51554
-#define DBMS_MIN_REVISION_WITH_BLOCK_INFO               51903
-#define DBMS_MIN_REVISION_WITH_CLIENT_INFO              54032
-#define DBMS_MIN_REVISION_WITH_SERVER_TIMEZONE          54058
-#define DBMS_MIN_REVISION_WITH_QUOTA_KEY_IN_CLIENT_INFO 54060
-//#define DBMS_MIN_REVISION_WITH_TABLES_STATUS            54226
-#define DBMS_MIN_REVISION_WITH_TIME_ZONE_PARAMETER_IN_DATETIME_DATA_TYPE 54337
-#define DBMS_MIN_REVISION_WITH_SERVER_DISPLAY_NAME      54372
-#define DBMS_MIN_REVISION_WITH_VERSION_PATCH            54401
-#define DBMS_MIN_REVISION_WITH_LOW_CARDINALITY_TYPE     54405
-#define DBMS_MIN_REVISION_WITH_COLUMN_DEFAULTS_METADATA 54410
-#define DBMS_MIN_REVISION_WITH_CLIENT_WRITE_INFO        54420
-#define DBMS_MIN_REVISION_WITH_SETTINGS_SERIALIZED_AS_STRINGS 54429
-#define DBMS_MIN_REVISION_WITH_INTERSERVER_SECRET       54441
-#define DBMS_MIN_REVISION_WITH_OPENTELEMETRY            54442
-#define DBMS_MIN_REVISION_WITH_DISTRIBUTED_DEPTH        54448
-#define DBMS_MIN_REVISION_WITH_INITIAL_QUERY_START_TIME 54449
-#define DBMS_MIN_REVISION_WITH_INCREMENTAL_PROFILE_EVENTS 54451
-
-#define DMBS_PROTOCOL_REVISION  DBMS_MIN_REVISION_WITH_INCREMENTAL_PROFILE_EVENTS
-
 namespace clickhouse {
 
 struct ClientInfo {
@@ -150,10 +132,17 @@ public:
 
     void ExecuteQuery(Query query);
 
+    void SelectArrowStream(const std::string& query, const std::string& query_id, ArrowArrayStream* out);
+
     void SendCancel();
 
     void Insert(const std::string& table_name, const std::string& query_id, const Block& block);
 
+    void InsertArrowStream(const std::string& table_name, const std::string& query_id, ArrowArrayStream* stream);
+
+    void InsertNative(const std::string& table_name, const std::string& query_id,
+            const std::function<bool(std::string_view&)>& next_block, bool compressed);
+
     void Ping();
 
     void ResetConnection();
@@ -169,10 +158,28 @@ private:
 
     bool ReceivePacket(uint64_t* server_packet = nullptr);
 
+    /// Sends blocks filled by `next_block` in one INSERT query, until it returns false.
+    void Insert(const std::string& table_name, const std::string& query_id,
+            const std::vector<std::string>& column_names, const std::function<bool(Block&)>& next_block);
+
+    /// Sends the INSERT query, receives its header and calls `send_data` to send data packets with it.
+    /// If `native_header` is set, names and types of columns of the header are read into it as they are, instead of
+    /// the header block, which is empty then.
+    /// The query is canceled if `send_data` throws, finished otherwise.
+    void ExecuteInsert(const std::string& query_text, const std::string& query_id,
+            const std::function<void(const Block& header)>& send_data,
+            std::vector<NativeColumnHeader>* native_header = nullptr);
+
+    /// Receives one packet of the query sent by SendQuery(), returns false at the end of the query.
+    bool ReceiveQueryPacket(Query& query);
+
     void SendQuery(const Query& query);
 
     void SendData(const Block& block);
 
+    /// Sends a block already serialized by WriteBlock(), and compressed if `compressed`.
+    void SendSerializedData(std::string_view data, bool compressed);
+
     bool SendHello();
 
     bool ReadBlock(InputStream& input, Block* block);
@@ -196,6 +203,10 @@ private:
         return options_.endpoints.size() * options_.send_retries;
     }
 
+private:
+    /// State of a query read by an ArrowArrayStream.
+    struct ArrowStreamState;
+
 private:
     /// In case of network errors tries to reconnect to server and
     /// call fuc several times.
@@ -228,6 +239,8 @@ private:
 
     const ClientOptions options_;
     QueryEvents* events_;
+    /// Set while the header of INSERT query is received by ExecuteInsert() to be read without creating columns.
+    std::vector<NativeColumnHeader>* native_header_ = nullptr;
     int compression_ = CompressionState::Disable;
 
     std::unique_ptr<SocketFactory> socket_factory_;
@@ -286,6 +299,132 @@ void Client::Impl::ExecuteQuery(Query query) {
     }
 }
 
+struct Client::Impl::ArrowStreamState {
+    ArrowStreamState(Impl* impl, const std::string& query, const std::string& query_id)
+        : impl(impl)
+        , query(query, query_id)
+    {
+        this->query
+            .OnData([this](const Block& block) { received = block; })
+            .OnException([this](const Exception& e) { error = e.display_text; });
+    }
+
+    /// Receives packets until the next block of data, returns false at the end of the query.
+    bool ReceiveBlock() {
+        received.reset();
+        while (!received) {
+            if (!impl->ReceiveQueryPacket(query)) {
+                finished = true;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static ArrowStreamState& Get(ArrowArrayStream* stream) {
+        return *static_cast<ArrowStreamState*>(stream->private_data);
+    }
+
+    static int GetSchema(ArrowArrayStream* stream, ArrowSchema* out) {
+        auto & state = Get(stream);
+        try {
+            ExportArrowSchema(state.header, out);
+            return 0;
+        } catch (const std::exception& e) {
+            state.error = e.what();
+            return EINVAL;
+        }
+    }
+
+    static int GetNext(ArrowArrayStream* stream, ArrowArray* out) {
+        auto & state = Get(stream);
+        try {
+            if (state.pending) {
+                ExportArrowArray(*state.pending, out);
+                state.pending.reset();
+                return 0;
+            }
+            // Empty blocks, e.g. of totals of queries without them, are skipped.
+            while (!state.finished && state.ReceiveBlock()) {
+                if (state.received->GetRowCount()) {
+                    ExportArrowArray(*state.received, out);
+                    return 0;
+                }
+            }
+        } catch (const std::exception& e) {
+            state.error = e.what();
+            state.finished = true;
+            return EIO;
+        }
+
+        if (!state.error.empty()) {
+            return EIO;
+        }
+        out->release = nullptr;
+        return 0;
+    }
+
+    static const char* GetLastError(ArrowArrayStream* stream) {
+        const auto & state = Get(stream);
+        return state.error.empty() ? nullptr : state.error.c_str();
+    }
+
+    static void Release(ArrowArrayStream* stream) {
+        std::unique_ptr<ArrowStreamState> state(&Get(stream));
+        if (!state->finished) {
+            try {
+                state->impl->SendCancel();
+                while (state->impl->ReceiveQueryPacket(state->query)) {
+                    ;
+                }
+            } catch (...) {
+                // Release can't fail, the connection is reset by the next query if it is broken.
+            }
+        }
+        stream->release = nullptr;
+    }
+
+    Impl* impl;
+    Query query;
+    /// Columns of the result, the first block received.
+    Block header;
+    /// Block received by the last packet.
+    std::optional<Block> received;
+    /// Block of rows received along with the header, not exported yet.
+    std::optional<Block> pending;
+    bool finished = false;
+    std::string error;
+};
+
+void Client::Impl::SelectArrowStream(const std::string& query, const std::string& query_id, ArrowArrayStream* out) {
+    auto state = std::make_unique<ArrowStreamState>(this, query, query_id);
+
+    if (options_.ping_before_query) {
+        RetryGuard([this]() { Ping(); });
+    }
+
+    SendQuery(state->query);
+
+    // Errors of the query are thrown here or, if rethrow_exceptions is off, reported by get_next().
+    if (state->ReceiveBlock()) {
+        state->header = *state->received;
+        if (state->header.GetRowCount()) {
+            state->pending = state->header;
+        }
+    }
+
+    out->get_schema = &ArrowStreamState::GetSchema;
+    out->get_next = &ArrowStreamState::GetNext;
+    out->get_last_error = &ArrowStreamState::GetLastError;
+    out->release = &ArrowStreamState::Release;
+    out->private_data = state.release();
+}
+
+bool Client::Impl::ReceiveQueryPacket(Query& query) {
+    EnsureNull en(static_cast<QueryEvents*>(&query), &events_);
+    return ReceivePacket();
+}
+
 std::string NameToQueryString(const std::string &input)
 {
     std::string output;
@@ -306,42 +445,94 @@ std::string NameToQueryString(const std::string &input)
 }
 
 void Client::Impl::Insert(const std::string& table_name, const std::string& query_id, const Block& block) {
-    if (options_.ping_before_query) {
-        RetryGuard([this]() { Ping(); });
+    std::vector<std::string> column_names;
+    for (Block::Iterator bi(block); bi.IsValid(); bi.Next()) {
+        column_names.push_back(bi.Name());
     }
 
+    bool sent = false;
+    Insert(table_name, query_id, column_names, [&block, &sent](Block& next) {
+        if (sent) {
+            return false;
+        }
+        next = block;
+        sent = true;
+        return true;
+    });
+}
+
+void Client::Impl::Insert(const std::string& table_name, const std::string& query_id,
+        const std::vector<std::string>& column_names, const std::function<bool(Block&)>& next_block) {
     std::stringstream fields_section;
-        const auto num_columns = block.GetColumnCount();
+    const auto num_columns = column_names.size();
 
     for (unsigned int i = 0; i < num_columns; ++i) {
         if (i == num_columns - 1) {
-            fields_section << NameToQueryString(block.GetColumnName(i));
+            fields_section << NameToQueryString(column_names[i]);
         } else {
-            fields_section << NameToQueryString(block.GetColumnName(i)) << ",";
+            fields_section << NameToQueryString(column_names[i]) << ",";
         }
     }
 
-    Query query("INSERT INTO " + table_name + " ( " + fields_section.str() + " ) VALUES", query_id);
-    SendQuery(query);
+    ExecuteInsert("INSERT INTO " + table_name + " ( " + fields_section.str() + " ) VALUES", query_id, [&](const Block&) {
+        Block block;
+        while (next_block(block)) {
+            // Empty block is the marker of end of data.
+            if (block.GetRowCount()) {
+                SendData(block);
+            }
+        }
+    });
+}
 
-    uint64_t server_packet;
-    // Receive data packet.
-    while (true) {
-        bool ret = ReceivePacket(&server_packet);
+void Client::Impl::ExecuteInsert(const std::string& query_text, const std::string& query_id,
+        const std::function<void(const Block& header)>& send_data, std::vector<NativeColumnHeader>* native_header) {
+    if (options_.ping_before_query) {
+        RetryGuard([this]() { Ping(); });
+    }
 
-        if (!ret) {
-            throw ProtocolError("fail to receive data packet");
-        }
-        if (server_packet == ServerCodes::Data) {
-            break;
-        }
-        if (server_packet == ServerCodes::Progress) {
-            continue;
+    Query query(query_text, query_id);
+    SendQuery(query);
+
+    Block header;
+    {
+        // The header is the first data packet of the query.
+        query.OnData([&header](const Block& block) { header = block; });
+        EnsureNull en(static_cast<QueryEvents*>(&query), &events_);
+        native_header_ = native_header;
+        std::unique_ptr<Impl, void (*)(Impl*)> native_header_guard(this, [](Impl* impl) { impl->native_header_ = nullptr; });
+
+        uint64_t server_packet;
+        // Receive data packet.
+        while (true) {
+            bool ret = ReceivePacket(&server_packet);
+
+            if (!ret) {
+                throw ProtocolError("fail to receive data packet");
+            }
+            if (server_packet == ServerCodes::Data) {
+                break;
+            }
+            if (server_packet == ServerCodes::Progress) {
+                continue;
+            }
         }
     }
 
     // Send data.
-    SendData(block);
+    try {
+        send_data(header);
+    } catch (...) {
+        // Data is not complete, the query is canceled rather than finished.
+        try {
+            SendCancel();
+            while (ReceivePacket()) {
+                ;
+            }
+        } catch (...) {
+        }
+        throw;
+    }
     // Send empty block as marker of
     // end of data.
     SendData(Block());
@@ -359,6 +550,101 @@ void Client::Impl::Insert(const std::string& table_name, const std::string& quer
     }
 }
 
+void Client::Impl::InsertArrowStream(const std::string& table_name, const std::string& query_id, ArrowArrayStream* stream) {
+    // The stream is consumed, whatever happens.
+    std::unique_ptr<ArrowArrayStream, void (*)(ArrowArrayStream*)> stream_guard(stream, [](ArrowArrayStream* s) {
+        if (s->release) {
+            s->release(s);
+        }
+    });
+    const auto check = [stream](int status) {
+        if (status != 0) {
+            const char* error = stream->get_last_error(stream);
+            throw ValidationError("Arrow stream failed with error " + std::to_string(status) + (error ? ": " + std::string(error) : ""));
+        }
+    };
+
+    ArrowSchema schema;
+    check(stream->get_schema(stream, &schema));
+    std::unique_ptr<ArrowSchema, void (*)(ArrowSchema*)> schema_guard(&schema, [](ArrowSchema* s) {
+        if (s->release) {
+            s->release(s);
+        }
+    });
+
+    std::vector<std::string> column_names;
+    for (int64_t i = 0; i < schema.n_children; ++i) {
+        column_names.push_back(schema.children[i]->name ? schema.children[i]->name : "");
+    }
+
+    Insert(table_name, query_id, column_names, [&](Block& block) {
+        ArrowArray array;
+        check(stream->get_next(stream, &array));
+        if (!array.release) {
+            return false;
+        }
+        std::unique_ptr<ArrowArray, void (*)(ArrowArray*)> array_guard(&array, [](ArrowArray* a) { a->release(a); });
+        block = ImportArrowArray(schema, array);
+        return true;
+    });
+}
+
+void Client::Impl::InsertNative(const std::string& table_name, const std::string& query_id,
+        const std::function<bool(std::string_view&)>& next_block, bool compressed) {
+    if (compressed && compression_ != CompressionState::Enable) {
+        throw ValidationError("compressed blocks can't be inserted by a client without compression");
+    }
+
+    // Types of the header are compared as the server writes them, they don't need to be supported by the client.
+    std::vector<NativeColumnHeader> header;
+    ExecuteInsert("INSERT INTO " + table_name + " VALUES", query_id, [&](const Block&) {
+        std::string_view data;
+        while (next_block(data)) {
+            // Only the leading part of the block is checked, columns are sent as they are.
+            ArrayInput input(data.data(), data.size());
+            NativeBlockHeader block_header;
+            std::string name;
+            std::string type;
+            const auto read_header = [&](InputStream& block_input) {
+                if (!ReadNativeBlockHeader(block_input, &block_header, server_info_.revision)) {
+                    return false;
+                }
+                return block_header.num_columns == 0
+                    || (WireFormat::ReadString(block_input, &name) && WireFormat::ReadString(block_input, &type));
+            };
+
+            bool has_header = false;
+            if (compressed) {
+                // Decompresses the first frame only.
+                CompressedInput compressed_input(&input);
+                has_header = read_header(compressed_input);
+                const void* rest;
+                compressed_input.Next(&rest, std::numeric_limits<size_t>::max());
+            } else {
+                has_header = read_header(input);
+            }
+
+            if (!has_header) {
+                throw ValidationError("block of " + std::to_string(data.size()) + " bytes is not in the Native format");
+            }
+            // Empty block is the marker of end of data.
+            if (block_header.num_rows == 0) {
+                continue;
+            }
+            if (block_header.num_columns != header.size()) {
+                throw ValidationError("block has " + std::to_string(block_header.num_columns) + " columns, expected "
+                    + std::to_string(header.size()));
+            }
+            if (!header.empty() && (name != header[0].name || type != header[0].type)) {
+                throw ValidationError("block starts with column '" + name + "' of type " + type + ", expected '"
+                    + header[0].name + "' of type " + header[0].type);
+            }
+
+            SendSerializedData(data, compressed);
+        }
+    }, &header);
+}
+
 void Client::Impl::Ping() {
     WireFormat::WriteUInt64(*output_, ClientCodes::Ping);
     output_->Flush();
@@ -588,68 +874,15 @@ bool Client::Impl::ReceivePacket(uint64_t* server_packet) {
 }
 
 bool Client::Impl::ReadBlock(InputStream& input, Block* block) {
-    // Additional information about block.
-    if constexpr (DMBS_PROTOCOL_REVISION >= DBMS_MIN_REVISION_WITH_BLOCK_INFO) {
-        uint64_t num;
-        BlockInfo info;
-
-        // BlockInfo
-        if (!WireFormat::ReadUInt64(input, &num)) {
-            return false;
-        }
-        if (!WireFormat::ReadFixed(input, &info.is_overflows)) {
-            return false;
-        }
-        if (!WireFormat::ReadUInt64(input, &num)) {
-            return false;
-        }
-        if (!WireFormat::ReadFixed(input, &info.bucket_num)) {
-            return false;
-        }
-        if (!WireFormat::ReadUInt64(input, &num)) {
-            return false;
-        }
-
-        block->SetInfo(std::move(info));
-    }
-
-    uint64_t num_columns = 0;
-    uint64_t num_rows = 0;
-
-    if (!WireFormat::ReadUInt64(input, &num_columns)) {
-        return false;
-    }
-    if (!WireFormat::ReadUInt64(input, &num_rows)) {
-        return false;
+    if (native_header_) {
+        return ReadNativeBlockColumns(input, native_header_, server_info_.revision);
     }
 
     CreateColumnByTypeSettings create_column_settings;
     create_column_settings.low_cardinality_as_wrapped_column = options_.backward_compatibility_lowcardinality_as_wrapped_column;
+    create_column_settings.native_json = options_.native_json;
 
-    for (size_t i = 0; i < num_columns; ++i) {
-        std::string name;
-        std::string type;
-        if (!WireFormat::ReadString(input, &name)) {
-            return false;
-        }
-        if (!WireFormat::ReadString(input, &type)) {
-            return false;
-        }
-        if (type == "Object('json')")
-            type = "JSON";
-
-        if (ColumnRef col = CreateColumnByType(type, create_column_settings)) {
-            if (num_rows && !col->Load(&input, num_rows)) {
-                throw ProtocolError("can't load column '" + name + "' of type " + type);
-            }
-
-            block->AppendColumn(name, col);
-        } else {
-            throw UnimplementedError(std::string("unsupported column type: ") + type);
-        }
-    }
-
-    return true;
+    return ReadNativeBlock(input, block, server_info_.revision, create_column_settings, options_.sparse_columns);
 }
 
 bool Client::Impl::ReceiveData() {
@@ -795,6 +1028,12 @@ void Client::Impl::SendQuery(const Query& query) {
                 throw UnimplementedError(std::string("Can't send open telemetry tracing context to a server, server version is too old"));
             }
         }
+
+        if (server_info_.revision >= DBMS_MIN_REVISION_WITH_PARALLEL_REPLICAS) {
+            WireFormat::WriteUInt64(*output_, 0u); // collaborate_with_initiator
+            WireFormat::WriteUInt64(*output_, 0u); // count_participating_replicas
+            WireFormat::WriteUInt64(*output_, 0u); // number_of_current_replica
+        }
     }
 
     /// Per query settings
@@ -828,30 +1067,7 @@ void Client::Impl::SendQuery(const Query& query) {
 
 
 void Client::Impl::WriteBlock(const Block& block, OutputStream& output) {
-    // Additional information about block.
-    if (server_info_.revision >= DBMS_MIN_REVISION_WITH_BLOCK_INFO) {
-        WireFormat::WriteUInt64(output, 1);
-        WireFormat::WriteFixed<uint8_t>(output, block.Info().is_overflows);
-        WireFormat::WriteUInt64(output, 2);
-        WireFormat::WriteFixed<int32_t>(output, block.Info().bucket_num);
-        WireFormat::WriteUInt64(output, 0);
-    }
-
-    WireFormat::WriteUInt64(output, block.GetColumnCount());
-    WireFormat::WriteUInt64(output, block.GetRowCount());
-
-    for (Block::Iterator bi(block); bi.IsValid(); bi.Next()) {
-        WireFormat::WriteString(output, bi.Name());
-        WireFormat::WriteString(output, bi.Type()->GetName());
-
-        // Empty columns are not serialized and occupy exactly 0 bytes.
-        // ref https://github.com/ClickHouse/ClickHouse/blob/39b37a3240f74f4871c8c1679910e065af6bea19/src/Formats/NativeWriter.cpp#L163
-        const bool containsData = block.GetRowCount() > 0;
-        if (containsData) {
-            bi.Column()->Save(&output);
-        }
-    }
-    output.Flush();
+    WriteNativeBlock(output, block, server_info_.revision);
 }
 
 void Client::Impl::SendData(const Block& block) {
@@ -874,6 +1090,26 @@ void Client::Impl::SendData(const Block& block) {
     output_->Flush();
 }
 
+void Client::Impl::SendSerializedData(std::string_view data, bool compressed) {
+    WireFormat::WriteUInt64(*output_, ClientCodes::Data);
+
+    if (server_info_.revision >= DBMS_MIN_REVISION_WITH_TEMPORARY_TABLES) {
+        WireFormat::WriteString(*output_, std::string());
+    }
+
+    if (compression_ == CompressionState::Enable && !compressed) {
+        std::unique_ptr<OutputStream> compressed_output = std::make_unique<CompressedOutput>(output_.get(), options_.max_compression_chunk_size, options_.compression_method);
+        BufferedOutput buffered(std::move(compressed_output), options_.max_compression_chunk_size);
+
+        WireFormat::WriteBytes(buffered, data.data(), data.size());
+        buffered.Flush();
+    } else {
+        WireFormat::WriteBytes(*output_, data.data(), data.size());
+    }
+
+    output_->Flush();
+}
+
 void Client::Impl::InitializeStreams(std::unique_ptr<SocketBase>&& socket) {
     std::unique_ptr<OutputStream> output = std::make_unique<BufferedOutput>(socket->makeOutputStream());
     std::unique_ptr<InputStream> input = std::make_unique<BufferedInput>(socket->makeInputStream());
@@ -1032,6 +1268,14 @@ void Client::Select(const Query& query) {
     Execute(query);
 }
 
+void Client::SelectArrowStream(const std::string& query, ArrowArrayStream* out) {
+    impl_->SelectArrowStream(query, Query::default_query_id, out);
+}
+
+void Client::SelectArrowStream(const std::string& query, const std::string& query_id, ArrowArrayStream* out) {
+    impl_->SelectArrowStream(query, query_id, out);
+}
+
 void Client::Insert(const std::string& table_name, const Block& block) {
     impl_->Insert(table_name, Query::default_query_id, block);
 }
@@ -1040,6 +1284,23 @@ void Client::Insert(const std::string& table_name, const std::string& query_id,
     impl_->Insert(table_name, query_id, block);
 }
 
+void Client::InsertArrowStream(const std::string& table_name, ArrowArrayStream* stream) {
+    impl_->InsertArrowStream(table_name, Query::default_query_id, stream);
+}
+
+void Client::InsertArrowStream(const std::string& table_name, const std::string& query_id, ArrowArrayStream* stream) {
+    impl_->InsertArrowStream(table_name, query_id, stream);
+}
+
+void Client::InsertNative(const std::string& table_name, const std::function<bool(std::string_view&)>& next_block, bool compressed) {
+    impl_->InsertNative(table_name, Query::default_query_id, next_block, compressed);
+}
+
+void Client::InsertNative(const std::string& table_name, const std::string& query_id,
+        const std::function<bool(std::string_view&)>& next_block, bool compressed) {
+    impl_->InsertNative(table_name, query_id, next_block, compressed);
+}
+
 void Client::Ping() {
     impl_->Ping();
 }
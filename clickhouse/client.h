@@ -1,28 +1,39 @@
 #pragma once
 
+#include "arrow.h"
+#include "block_builder.h"
+#include "block_reader.h"
+#include "compression.h"
 #include "query.h"
 #include "exceptions.h"
 
+#include "columns/aggregate_function.h"
 #include "columns/array.h"
 #include "columns/date.h"
 #include "columns/decimal.h"
+#include "columns/dynamic.h"
 #include "columns/enum.h"
 #include "columns/geo.h"
 #include "columns/ip4.h"
 #include "columns/ip6.h"
+#include "columns/json.h"
 #include "columns/lowcardinality.h"
 #include "columns/nullable.h"
 #include "columns/numeric.h"
 #include "columns/map.h"
+#include "columns/sparse.h"
 #include "columns/string.h"
 #include "columns/tuple.h"
 #include "columns/uuid.h"
+#include "columns/variant.h"
+#include "columns/visit.h"
 
 #include <chrono>
 #include <cstdint>
 #include <memory>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <optional>
 
 typedef struct ssl_ctx_st SSL_CTX;
@@ -39,13 +50,6 @@ struct ServerInfo {
     uint64_t    revision;
 };
 
-/// Methods of block compression.
-enum class CompressionMethod : int8_t {
-    None = -1,
-    LZ4  = 1,
-    ZSTD = 2,
-};
-
 struct Endpoint {
     std::string host;
     uint16_t port = 9000;
@@ -135,6 +139,16 @@ struct ClientOptions {
      */
     DECLARE_FIELD(max_compression_chunk_size, unsigned int, SetMaxCompressionChunkSize, 65535);
 
+    /** Receive columns the server sends in sparse serialization as ColumnSparse, which holds only non-default rows.
+     *  By default they are densified into columns of their types, e.g. ColumnUInt64.
+     */
+    DECLARE_FIELD(sparse_columns, bool, SetSparseColumns, false);
+
+    /** Receive JSON columns as ColumnJSON, decoding typed paths, dynamic paths and shared data of the native serialization.
+     *  By default they are received as ColumnIxJson, which holds JSON text of the rows.
+     */
+    DECLARE_FIELD(native_json, bool, SetNativeJson, false);
+
     struct SSLOptions {
         /** There are two ways to configure an SSL connection:
          *  - provide a pre-configured SSL_CTX, which is not modified and not owned by the Client.
@@ -251,10 +265,37 @@ public:
     /// Alias for Execute.
     void Select(const Query& query);
 
+    /** Executes a select query and returns its result as an Arrow C stream of record batches, see arrow.h.
+     *  The header of the result is received before return, blocks of rows are received by get_next() of the stream.
+     *  The client must outlive the stream and must not execute other queries until the stream is released,
+     *  releasing it before the end of the result cancels the query.
+     */
+    void SelectArrowStream(const std::string& query, ArrowArrayStream* out);
+    void SelectArrowStream(const std::string& query, const std::string& query_id, ArrowArrayStream* out);
+
     /// Intends for insert block of data into a table \p table_name.
     void Insert(const std::string& table_name, const Block& block);
     void Insert(const std::string& table_name, const std::string& query_id, const Block& block);
 
+    /** Inserts record batches of an Arrow C stream into a table \p table_name in one query, see ImportArrowArray().
+     *  The stream is released by the call. If the stream fails, the query is canceled and ValidationError is thrown.
+     */
+    void InsertArrowStream(const std::string& table_name, ArrowArrayStream* stream);
+    void InsertArrowStream(const std::string& table_name, const std::string& query_id, ArrowArrayStream* stream);
+
+    /** Inserts blocks pre-serialized in the Native format into a table \p table_name in one query, without decoding them.
+     *  \p next_block sets its argument to the bytes of the next block, which must stay valid until the next call, and
+     *  returns false at the end. Blocks must be serialized by WriteNativeBlock() with the revision of GetServerInfo(),
+     *  and contain all insertable columns of the table in order. If \p compressed, blocks are compressed frames as sent
+     *  by a client with compression, which this client must have enabled too.
+     *  Only the number of columns and the first column of each block are checked against the header of the table before
+     *  the block is sent; on mismatch the query is canceled and ValidationError is thrown.
+     */
+    void InsertNative(const std::string& table_name, const std::function<bool(std::string_view&)>& next_block,
+            bool compressed = false);
+    void InsertNative(const std::string& table_name, const std::string& query_id,
+            const std::function<bool(std::string_view&)>& next_block, bool compressed = false);
+
     /// Ping server for aliveness.
     void Ping();
 
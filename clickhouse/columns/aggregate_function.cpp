@@ -0,0 +1,975 @@
+#include "aggregate_function.h"
+
+#include "../base/text_codec.h"
+#include "../base/wire_format.h"
+
+#include <city.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+using namespace clickhouse;
+
+// Limits of UniquesHashSet of ClickHouse, the set of hashes of uniq().
+constexpr size_t UniqMaxSize = 1ULL << 16;
+constexpr uint8_t UniqMaxSkipDegree = 15;
+
+// Parameters of CombinedCardinalityEstimator of ClickHouse, the state of uniqCombined().
+constexpr size_t UniqCombinedSmallSize = 16;
+constexpr uint8_t UniqCombinedDefaultPrecision = 17;
+constexpr uint8_t UniqCombinedMinPrecision = 12;
+constexpr uint8_t UniqCombinedMaxPrecision = 20;
+
+// Max size of the hash set, after which hashes are counted by the HyperLogLog counter.
+constexpr size_t GetUniqCombinedMediumSize(size_t hash_size, uint8_t precision) {
+    return 1ULL << (precision - 5 + (hash_size == sizeof(uint32_t)));
+}
+
+// Width of ranks of the HyperLogLog counter in bits.
+constexpr size_t GetUniqCombinedRankWidth(size_t hash_size) {
+    return hash_size == sizeof(uint32_t) ? 5 : 6;
+}
+
+// Size of the HyperLogLog counter, its ranks are packed as a little-endian bit stream.
+constexpr size_t GetUniqCombinedLargeSize(size_t hash_size, uint8_t precision) {
+    return ((1ULL << precision) * GetUniqCombinedRankWidth(hash_size) + 7) / 8;
+}
+
+// Parameters of QuantileTDigest of ClickHouse.
+constexpr double TDigestEpsilon = 0.01;
+constexpr size_t TDigestMaxCentroids = 2048;
+constexpr size_t TDigestMaxUnmerged = 2048;
+constexpr size_t TDigestMaxDeserializedCentroids = 65536;
+
+bool IsNumeric(Type::Code code) {
+    switch (code) {
+        case Type::Int8:
+        case Type::Int16:
+        case Type::Int32:
+        case Type::Int64:
+        case Type::UInt8:
+        case Type::UInt16:
+        case Type::UInt32:
+        case Type::UInt64:
+        case Type::Float32:
+        case Type::Float64:
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t GetNumericSize(Type::Code code) {
+    switch (code) {
+        case Type::Int8:
+        case Type::UInt8:
+            return 1;
+        case Type::Int16:
+        case Type::UInt16:
+            return 2;
+        case Type::Int32:
+        case Type::UInt32:
+        case Type::Float32:
+            return 4;
+        default:
+            return 8;
+    }
+}
+
+// Type of the sum of values of numeric type, as of sum() and avg() of ClickHouse.
+Type::Code GetSumTypeCode(Type::Code code) {
+    switch (code) {
+        case Type::Int8:
+        case Type::Int16:
+        case Type::Int32:
+        case Type::Int64:
+            return Type::Int64;
+        case Type::UInt8:
+        case Type::UInt16:
+        case Type::UInt32:
+        case Type::UInt64:
+            return Type::UInt64;
+        case Type::Float32:
+        case Type::Float64:
+            return Type::Float64;
+        default:
+            return Type::Void;
+    }
+}
+
+template <typename T>
+constexpr Type::Code GetTypeCode() {
+    if constexpr (std::is_same_v<T, int8_t>)
+        return Type::Int8;
+    else if constexpr (std::is_same_v<T, int16_t>)
+        return Type::Int16;
+    else if constexpr (std::is_same_v<T, int32_t>)
+        return Type::Int32;
+    else if constexpr (std::is_same_v<T, int64_t>)
+        return Type::Int64;
+    else if constexpr (std::is_same_v<T, uint8_t>)
+        return Type::UInt8;
+    else if constexpr (std::is_same_v<T, uint16_t>)
+        return Type::UInt16;
+    else if constexpr (std::is_same_v<T, uint32_t>)
+        return Type::UInt32;
+    else if constexpr (std::is_same_v<T, uint64_t>)
+        return Type::UInt64;
+    else if constexpr (std::is_same_v<T, float>)
+        return Type::Float32;
+    else if constexpr (std::is_same_v<T, double>)
+        return Type::Float64;
+    else
+        return Type::Void;
+}
+
+// Returns code of the only argument of the function, Void if there is not exactly one.
+Type::Code GetArgumentCode(const AggregateFunctionType & type) {
+    const auto & arguments = type.GetArgumentTypes();
+    return arguments.size() == 1 ? arguments.front()->GetCode() : Type::Void;
+}
+
+bool IsTDigest(const std::string & function) {
+    return function == "quantileTDigest" || function == "quantilesTDigest" || function == "medianTDigest";
+}
+
+// Returns false if the type is not of uniqCombined() of a supported argument, otherwise
+// size of hashes, 8 bytes of uniqCombined64() and of strings, and precision of the state.
+bool GetUniqCombinedParameters(const AggregateFunctionType & type, size_t* hash_size, uint8_t* precision) {
+    const auto & function = type.GetFunction();
+    const auto code = GetArgumentCode(type);
+    if ((function != "uniqCombined" && function != "uniqCombined64") || !(IsNumeric(code) || code == Type::String)) {
+        return false;
+    }
+
+    const auto & parameters = type.GetParameters();
+    uint64_t value = UniqCombinedDefaultPrecision;
+    if (parameters.size() == 1) {
+        if (!ParseUInt64(parameters.front(), value)) {
+            return false;
+        }
+    } else if (!parameters.empty()) {
+        return false;
+    }
+    if (value < UniqCombinedMinPrecision || value > UniqCombinedMaxPrecision) {
+        return false;
+    }
+    *precision = static_cast<uint8_t>(value);
+
+    *hash_size = (function == "uniqCombined64" || code == Type::String) ? sizeof(uint64_t) : sizeof(uint32_t);
+    return true;
+}
+
+// intHash64 of ClickHouse, the hash of keys of uniq().
+uint64_t IntHash64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Copies parts of a state from the input as is.
+class StateReader {
+public:
+    StateReader(InputStream & input, Buffer & state)
+        : input_(input)
+        , state_(state)
+    {
+    }
+
+    bool Bytes(size_t len) {
+        const auto size = state_.size();
+        state_.resize(size + len);
+        return WireFormat::ReadBytes(input_, state_.data() + size, len);
+    }
+
+    bool VarUInt(uint64_t* value) {
+        if (!WireFormat::ReadVarint64(input_, value)) {
+            return false;
+        }
+        for (auto x = *value; ; x >>= 7) {
+            state_.push_back(static_cast<uint8_t>(x < 0x80 ? x : (x & 0x7F) | 0x80));
+            if (x < 0x80)
+                break;
+        }
+        return true;
+    }
+
+    const Buffer & State() const {
+        return state_;
+    }
+
+private:
+    InputStream & input_;
+    Buffer & state_;
+};
+
+}
+
+namespace clickhouse {
+
+/// class CountState
+bool CountState::IsStateOf(const AggregateFunctionType& type) {
+    return type.GetFunction() == "count";
+}
+
+void CountState::Serialize(OutputStream& output) const {
+    WireFormat::WriteVarint64(output, count_);
+}
+
+bool CountState::Deserialize(InputStream& input) {
+    return WireFormat::ReadVarint64(input, &count_);
+}
+
+/// class SumState
+template <typename T>
+bool SumState<T>::IsStateOf(const AggregateFunctionType& type) {
+    return type.GetFunction() == "sum" && GetSumTypeCode(GetArgumentCode(type)) == GetTypeCode<T>();
+}
+
+template <typename T>
+void SumState<T>::Serialize(OutputStream& output) const {
+    WireFormat::WriteFixed(output, sum_);
+}
+
+template <typename T>
+bool SumState<T>::Deserialize(InputStream& input) {
+    return WireFormat::ReadFixed(input, &sum_);
+}
+
+/// class ExtremumState
+template <typename T, bool IsMin>
+bool ExtremumState<T, IsMin>::IsStateOf(const AggregateFunctionType& type) {
+    return type.GetFunction() == (IsMin ? "min" : "max") && GetArgumentCode(type) == GetTypeCode<T>();
+}
+
+template <typename T, bool IsMin>
+void ExtremumState<T, IsMin>::Serialize(OutputStream& output) const {
+    WireFormat::WriteFixed<uint8_t>(output, value_.has_value());
+    if (value_) {
+        WireFormat::WriteFixed(output, *value_);
+    }
+}
+
+template <typename T, bool IsMin>
+bool ExtremumState<T, IsMin>::Deserialize(InputStream& input) {
+    uint8_t has_value;
+    if (!WireFormat::ReadFixed(input, &has_value)) {
+        return false;
+    }
+
+    value_.reset();
+    if (has_value) {
+        T value;
+        if (!WireFormat::ReadFixed(input, &value)) {
+            return false;
+        }
+        value_ = value;
+    }
+    return true;
+}
+
+/// class AvgState
+template <typename T>
+bool AvgState<T>::IsStateOf(const AggregateFunctionType& type) {
+    return type.GetFunction() == "avg" && GetSumTypeCode(GetArgumentCode(type)) == GetTypeCode<T>();
+}
+
+template <typename T>
+void AvgState<T>::Serialize(OutputStream& output) const {
+    WireFormat::WriteFixed(output, numerator_);
+    WireFormat::WriteVarint64(output, denominator_);
+}
+
+template <typename T>
+bool AvgState<T>::Deserialize(InputStream& input) {
+    return WireFormat::ReadFixed(input, &numerator_) && WireFormat::ReadVarint64(input, &denominator_);
+}
+
+/// class UniqState
+bool UniqState::IsStateOf(const AggregateFunctionType& type) {
+    const auto code = GetArgumentCode(type);
+    return type.GetFunction() == "uniq" && (IsNumeric(code) || code == Type::String);
+}
+
+void UniqState::Add(std::string_view value) {
+    AddKey(CityHash64(value.data(), value.size()));
+}
+
+void UniqState::AddKey(uint64_t key) {
+    AddHash(static_cast<uint32_t>(IntHash64(key)));
+}
+
+void UniqState::AddHash(uint32_t hash) {
+    // Only hashes with `skip_degree_` trailing zero bits are kept.
+    const auto is_kept = [this](uint32_t value) {
+        return (value & ((1u << skip_degree_) - 1)) == 0;
+    };
+
+    if (!is_kept(hash)) {
+        return;
+    }
+
+    hashes_.insert(hash);
+    while (hashes_.size() > UniqMaxSize) {
+        if (skip_degree_ == UniqMaxSkipDegree) {
+            throw ValidationError("Too many distinct values in state of uniq()");
+        }
+        ++skip_degree_;
+        for (auto it = hashes_.begin(); it != hashes_.end();) {
+            it = is_kept(*it) ? std::next(it) : hashes_.erase(it);
+        }
+    }
+}
+
+void UniqState::Merge(const UniqState& other) {
+    if (other.skip_degree_ > skip_degree_) {
+        std::unordered_set<uint32_t> hashes;
+        hashes.swap(hashes_);
+        skip_degree_ = other.skip_degree_;
+        for (const auto hash : hashes) {
+            AddHash(hash);
+        }
+    }
+
+    for (const auto hash : other.hashes_) {
+        AddHash(hash);
+    }
+}
+
+void UniqState::Serialize(OutputStream& output) const {
+    // Any order of hashes is valid, sorted ones make serialization stable.
+    std::vector<uint32_t> hashes(hashes_.begin(), hashes_.end());
+    std::sort(hashes.begin(), hashes.end());
+
+    WireFormat::WriteFixed(output, skip_degree_);
+    WireFormat::WriteVarint64(output, hashes.size());
+    WireFormat::WriteBytes(output, hashes.data(), hashes.size() * sizeof(uint32_t));
+}
+
+bool UniqState::Deserialize(InputStream& input) {
+    uint64_t size;
+    if (!WireFormat::ReadFixed(input, &skip_degree_) || !WireFormat::ReadVarint64(input, &size)) {
+        return false;
+    }
+    if (skip_degree_ > UniqMaxSkipDegree || size > UniqMaxSize) {
+        throw ProtocolError("Invalid state of uniq() of " + std::to_string(size) + " hashes");
+    }
+
+    std::vector<uint32_t> hashes(size);
+    if (!WireFormat::ReadBytes(input, hashes.data(), hashes.size() * sizeof(uint32_t))) {
+        return false;
+    }
+    hashes_ = std::unordered_set<uint32_t>(hashes.begin(), hashes.end());
+    return true;
+}
+
+/// class UniqCombinedState
+template <typename HashType, uint8_t Precision>
+bool UniqCombinedState<HashType, Precision>::IsStateOf(const AggregateFunctionType& type) {
+    size_t hash_size;
+    uint8_t precision;
+    return GetUniqCombinedParameters(type, &hash_size, &precision) && hash_size == sizeof(HashType) && precision == Precision;
+}
+
+template <typename HashType, uint8_t Precision>
+void UniqCombinedState<HashType, Precision>::Add(std::string_view value) {
+    // Like ClickHouse, strings are hashed by 64-bit CityHash, which is truncated for 32-bit hashes.
+    AddHash(static_cast<HashType>(CityHash64(value.data(), value.size())));
+}
+
+template <typename HashType, uint8_t Precision>
+void UniqCombinedState<HashType, Precision>::AddKey(uint64_t key) {
+    AddHash(static_cast<HashType>(IntHash64(key)));
+}
+
+template <typename HashType, uint8_t Precision>
+void UniqCombinedState<HashType, Precision>::AddHash(HashType hash) {
+    switch (container_) {
+        case Container::Small:
+            if (std::find(small_.begin(), small_.end(), hash) != small_.end()) {
+                break;
+            }
+            if (small_.size() < UniqCombinedSmallSize) {
+                small_.push_back(hash);
+                break;
+            }
+            ToMedium();
+            medium_.insert(hash);
+            break;
+
+        case Container::Medium:
+            // Like ClickHouse, the set is replaced by the counter when it is full, even if the hash is already in it.
+            if (medium_.size() < GetUniqCombinedMediumSize(sizeof(HashType), Precision)) {
+                medium_.insert(hash);
+                break;
+            }
+            ToLarge();
+            AddToLarge(hash);
+            break;
+
+        case Container::Large:
+            AddToLarge(hash);
+            break;
+    }
+}
+
+template <typename HashType, uint8_t Precision>
+void UniqCombinedState<HashType, Precision>::ToMedium() {
+    medium_.insert(small_.begin(), small_.end());
+    small_.clear();
+    container_ = Container::Medium;
+}
+
+template <typename HashType, uint8_t Precision>
+void UniqCombinedState<HashType, Precision>::ToLarge() {
+    ranks_.assign(size_t(1) << Precision, 0);
+    container_ = Container::Large;
+
+    for (const auto hash : small_) {
+        AddToLarge(hash);
+    }
+    for (const auto hash : medium_) {
+        AddToLarge(hash);
+    }
+    small_.clear();
+    medium_.clear();
+}
+
+template <typename HashType, uint8_t Precision>
+void UniqCombinedState<HashType, Precision>::AddToLarge(HashType hash) {
+    // Low bits of the hash are the bucket, the rank is 1 + count of trailing zeros of the rest of it.
+    constexpr uint8_t max_rank = sizeof(HashType) * 8 - Precision + 1;
+
+    const size_t bucket = hash & ((HashType(1) << Precision) - 1);
+    HashType tail = hash >> Precision;
+    uint8_t rank = 1;
+    while (rank < max_rank && !(tail & 1)) {
+        tail >>= 1;
+        ++rank;
+    }
+
+    ranks_[bucket] = std::max(ranks_[bucket], rank);
+}
+
+template <typename HashType, uint8_t Precision>
+void UniqCombinedState<HashType, Precision>::Merge(const UniqCombinedState& other) {
+    const auto container = std::max(container_, other.container_);
+    if (container_ != container) {
+        if (container == Container::Medium) {
+            ToMedium();
+        } else {
+            ToLarge();
+        }
+    }
+
+    switch (other.container_) {
+        case Container::Small:
+            for (const auto hash : other.small_) {
+                AddHash(hash);
+            }
+            break;
+        case Container::Medium:
+            for (const auto hash : other.medium_) {
+                AddHash(hash);
+            }
+            break;
+        case Container::Large:
+            for (size_t i = 0; i < ranks_.size(); ++i) {
+                ranks_[i] = std::max(ranks_[i], other.ranks_[i]);
+            }
+            break;
+    }
+}
+
+template <typename HashType, uint8_t Precision>
+void UniqCombinedState<HashType, Precision>::Serialize(OutputStream& output) const {
+    WireFormat::WriteFixed(output, static_cast<uint8_t>(container_));
+
+    switch (container_) {
+        case Container::Small:
+            WireFormat::WriteVarint64(output, small_.size());
+            WireFormat::WriteBytes(output, small_.data(), small_.size() * sizeof(HashType));
+            break;
+
+        case Container::Medium: {
+            // Any order of hashes is valid, sorted ones make serialization stable.
+            std::vector<HashType> hashes(medium_.begin(), medium_.end());
+            std::sort(hashes.begin(), hashes.end());
+
+            WireFormat::WriteVarint64(output, hashes.size());
+            WireFormat::WriteBytes(output, hashes.data(), hashes.size() * sizeof(HashType));
+            break;
+        }
+
+        case Container::Large: {
+            constexpr size_t width = GetUniqCombinedRankWidth(sizeof(HashType));
+            std::vector<uint8_t> packed(GetUniqCombinedLargeSize(sizeof(HashType), Precision), 0);
+            for (size_t i = 0; i < ranks_.size(); ++i) {
+                const size_t bit = i * width;
+                const unsigned value = static_cast<unsigned>(ranks_[i]) << (bit % 8);
+                packed[bit / 8] |= static_cast<uint8_t>(value);
+                if (value > 0xFF) {
+                    packed[bit / 8 + 1] |= static_cast<uint8_t>(value >> 8);
+                }
+            }
+            WireFormat::WriteBytes(output, packed.data(), packed.size());
+            break;
+        }
+    }
+}
+
+template <typename HashType, uint8_t Precision>
+bool UniqCombinedState<HashType, Precision>::Deserialize(InputStream& input) {
+    uint8_t container;
+    if (!WireFormat::ReadFixed(input, &container)) {
+        return false;
+    }
+
+    small_.clear();
+    medium_.clear();
+    ranks_.clear();
+
+    if (container == static_cast<uint8_t>(Container::Small) || container == static_cast<uint8_t>(Container::Medium)) {
+        const size_t max_size = container == static_cast<uint8_t>(Container::Small)
+                ? UniqCombinedSmallSize : GetUniqCombinedMediumSize(sizeof(HashType), Precision);
+        uint64_t size;
+        if (!WireFormat::ReadVarint64(input, &size)) {
+            return false;
+        }
+        if (size > max_size) {
+            throw ProtocolError("Invalid state of uniqCombined() of " + std::to_string(size) + " hashes");
+        }
+
+        std::vector<HashType> hashes(size);
+        if (!WireFormat::ReadBytes(input, hashes.data(), hashes.size() * sizeof(HashType))) {
+            return false;
+        }
+        container_ = static_cast<Container>(container);
+        if (container_ == Container::Small) {
+            small_ = std::move(hashes);
+        } else {
+            medium_.insert(hashes.begin(), hashes.end());
+        }
+        return true;
+    }
+
+    if (container == static_cast<uint8_t>(Container::Large)) {
+        constexpr size_t width = GetUniqCombinedRankWidth(sizeof(HashType));
+        // One more byte, so that ranks at the end are read as two bytes as well.
+        std::vector<uint8_t> packed(GetUniqCombinedLargeSize(sizeof(HashType), Precision) + 1, 0);
+        if (!WireFormat::ReadBytes(input, packed.data(), packed.size() - 1)) {
+            return false;
+        }
+
+        container_ = Container::Large;
+        ranks_.resize(size_t(1) << Precision);
+        for (size_t i = 0; i < ranks_.size(); ++i) {
+            const size_t bit = i * width;
+            const unsigned value = packed[bit / 8] | (static_cast<unsigned>(packed[bit / 8 + 1]) << 8);
+            ranks_[i] = static_cast<uint8_t>((value >> (bit % 8)) & ((1u << width) - 1));
+        }
+        return true;
+    }
+
+    throw ProtocolError("Invalid container of state of uniqCombined(): " + std::to_string(container));
+}
+
+/// class TDigestState
+bool TDigestState::IsStateOf(const AggregateFunctionType& type) {
+    return IsTDigest(type.GetFunction()) && IsNumeric(GetArgumentCode(type));
+}
+
+void TDigestState::Add(float value, float count) {
+    if (std::isnan(value)) {
+        return;
+    }
+
+    centroids_.push_back(Centroid{value, count});
+    count_ += count;
+    if (++unmerged_ > TDigestMaxUnmerged) {
+        Compress();
+    }
+}
+
+void TDigestState::Merge(const TDigestState& other) {
+    for (const auto & centroid : other.centroids_) {
+        Add(centroid.mean, centroid.count);
+    }
+}
+
+void TDigestState::Compress() {
+    if (centroids_.empty()) {
+        return;
+    }
+
+    // Like QuantileTDigest::compress() of ClickHouse: adjacent centroids are merged while their weight is small
+    // relative to the distance of their quantile to the edges.
+    if (unmerged_ > 0 || centroids_.size() > TDigestMaxCentroids) {
+        std::stable_sort(centroids_.begin(), centroids_.end(), [](const Centroid & left, const Centroid & right) {
+            return left.mean < right.mean;
+        });
+
+        const double count_epsilon_4 = count_ * TDigestEpsilon * 4;
+        auto l = centroids_.begin();
+        double sum = 0;
+        double l_mean = l->mean;
+        double l_count = l->count;
+        for (auto r = std::next(l); r != centroids_.end(); ++r) {
+            const double ql = (sum + l_count * 0.5) / count_;
+            const double qr = (sum + l_count + r->count * 0.5) / count_;
+            const double k = count_epsilon_4 * std::min(ql * (1 - ql), qr * (1 - qr));
+            const bool can_be_merged = l_mean == r->mean || (!std::isinf(l_mean) && !std::isinf(r->mean));
+
+            if (l_count + r->count <= k && can_be_merged) {
+                l_count += r->count;
+                if (r->mean != l_mean) {
+                    l_mean += r->count * (r->mean - l_mean) / l_count;
+                }
+                l->mean = static_cast<float>(l_mean);
+                l->count = static_cast<float>(l_count);
+            } else {
+                sum += l->count;
+                ++l;
+                if (l != r) {
+                    *l = *r;
+                }
+                l_mean = l->mean;
+                l_count = l->count;
+            }
+        }
+        centroids_.erase(std::next(l), centroids_.end());
+        unmerged_ = 0;
+    }
+
+    // Merges batches of adjacent centroids if there are still too many of them.
+    if (centroids_.size() > TDigestMaxCentroids) {
+        const size_t batch_size = (centroids_.size() + TDigestMaxCentroids - 1) / TDigestMaxCentroids;
+        auto l = centroids_.begin();
+        size_t batch_pos = 0;
+        for (auto r = std::next(l); r != centroids_.end(); ++r) {
+            if (batch_pos < batch_size - 1) {
+                l->count += r->count;
+                if (r->mean != l->mean) {
+                    l->mean += r->count * (r->mean - l->mean) / l->count;
+                }
+                ++batch_pos;
+            } else {
+                if (!std::isnan(l->mean)) {
+                    ++l;
+                }
+                if (l != r) {
+                    *l = *r;
+                }
+                batch_pos = 0;
+            }
+        }
+        if (!std::isnan(l->mean)) {
+            ++l;
+        }
+        centroids_.erase(l, centroids_.end());
+    }
+}
+
+void TDigestState::Serialize(OutputStream& output) const {
+    TDigestState compressed(*this);
+    compressed.Compress();
+
+    WireFormat::WriteVarint64(output, compressed.centroids_.size());
+    WireFormat::WriteBytes(output, compressed.centroids_.data(), compressed.centroids_.size() * sizeof(Centroid));
+}
+
+bool TDigestState::Deserialize(InputStream& input) {
+    uint64_t size;
+    if (!WireFormat::ReadVarint64(input, &size)) {
+        return false;
+    }
+    if (size > TDigestMaxDeserializedCentroids) {
+        throw ProtocolError("Too many centroids in state of t-digest: " + std::to_string(size));
+    }
+
+    centroids_.resize(size);
+    if (!WireFormat::ReadBytes(input, centroids_.data(), centroids_.size() * sizeof(Centroid))) {
+        return false;
+    }
+
+    // ClickHouse drops states with invalid weights.
+    count_ = 0;
+    unmerged_ = 0;
+    for (const auto & centroid : centroids_) {
+        if (!(centroid.count > 0)) {
+            centroids_.clear();
+            count_ = 0;
+            break;
+        }
+        count_ += centroid.count;
+    }
+    return true;
+}
+
+template class SumState<int64_t>;
+template class SumState<uint64_t>;
+template class SumState<double>;
+
+template class ExtremumState<int8_t, true>;
+template class ExtremumState<int16_t, true>;
+template class ExtremumState<int32_t, true>;
+template class ExtremumState<int64_t, true>;
+template class ExtremumState<uint8_t, true>;
+template class ExtremumState<uint16_t, true>;
+template class ExtremumState<uint32_t, true>;
+template class ExtremumState<uint64_t, true>;
+template class ExtremumState<float, true>;
+template class ExtremumState<double, true>;
+
+template class ExtremumState<int8_t, false>;
+template class ExtremumState<int16_t, false>;
+template class ExtremumState<int32_t, false>;
+template class ExtremumState<int64_t, false>;
+template class ExtremumState<uint8_t, false>;
+template class ExtremumState<uint16_t, false>;
+template class ExtremumState<uint32_t, false>;
+template class ExtremumState<uint64_t, false>;
+template class ExtremumState<float, false>;
+template class ExtremumState<double, false>;
+
+template class AvgState<int64_t>;
+template class AvgState<uint64_t>;
+template class AvgState<double>;
+
+template class UniqCombinedState<uint32_t, 12>;
+template class UniqCombinedState<uint32_t, 13>;
+template class UniqCombinedState<uint32_t, 14>;
+template class UniqCombinedState<uint32_t, 15>;
+template class UniqCombinedState<uint32_t, 16>;
+template class UniqCombinedState<uint32_t, 17>;
+template class UniqCombinedState<uint32_t, 18>;
+template class UniqCombinedState<uint32_t, 19>;
+template class UniqCombinedState<uint32_t, 20>;
+
+template class UniqCombinedState<uint64_t, 12>;
+template class UniqCombinedState<uint64_t, 13>;
+template class UniqCombinedState<uint64_t, 14>;
+template class UniqCombinedState<uint64_t, 15>;
+template class UniqCombinedState<uint64_t, 16>;
+template class UniqCombinedState<uint64_t, 17>;
+template class UniqCombinedState<uint64_t, 18>;
+template class UniqCombinedState<uint64_t, 19>;
+template class UniqCombinedState<uint64_t, 20>;
+
+/// class ColumnAggregateFunction
+enum class ColumnAggregateFunction::StateFormat : uint8_t {
+    Unsupported,
+    Count,
+    Sum,
+    Extremum,
+    Avg,
+    Uniq,
+    UniqCombined,
+    TDigest,
+};
+
+ColumnAggregateFunction::StateFormat ColumnAggregateFunction::GetStateFormat(const AggregateFunctionType& type) {
+    const auto & function = type.GetFunction();
+    if (CountState::IsStateOf(type))
+        return StateFormat::Count;
+    if (UniqState::IsStateOf(type))
+        return StateFormat::Uniq;
+    size_t hash_size;
+    uint8_t precision;
+    if (GetUniqCombinedParameters(type, &hash_size, &precision))
+        return StateFormat::UniqCombined;
+    if (TDigestState::IsStateOf(type))
+        return StateFormat::TDigest;
+
+    if (!IsNumeric(GetArgumentCode(type)))
+        return StateFormat::Unsupported;
+    if (function == "sum")
+        return StateFormat::Sum;
+    if (function == "min" || function == "max")
+        return StateFormat::Extremum;
+    if (function == "avg")
+        return StateFormat::Avg;
+
+    return StateFormat::Unsupported;
+}
+
+ColumnAggregateFunction::ColumnAggregateFunction(TypeRef type)
+    : Column(std::move(type))
+    , states_(std::make_shared<ColumnString>())
+    , format_(StateFormat::Unsupported)
+{
+    if (type_->GetCode() != Type::AggregateFunction || !IsSupported(GetAggregateFunctionType())) {
+        throw UnimplementedError("Unsupported aggregate function type: " + type_->GetName());
+    }
+
+    format_ = GetStateFormat(GetAggregateFunctionType());
+    if (format_ == StateFormat::Extremum) {
+        value_size_ = GetNumericSize(GetArgumentCode(GetAggregateFunctionType()));
+    } else if (format_ == StateFormat::UniqCombined) {
+        GetUniqCombinedParameters(GetAggregateFunctionType(), &value_size_, &precision_);
+    }
+}
+
+bool ColumnAggregateFunction::IsSupported(const AggregateFunctionType& type) {
+    return GetStateFormat(type) != StateFormat::Unsupported;
+}
+
+const AggregateFunctionType& ColumnAggregateFunction::GetAggregateFunctionType() const {
+    return *type_->As<AggregateFunctionType>();
+}
+
+void ColumnAggregateFunction::CheckState(bool is_state_of) const {
+    if (!is_state_of) {
+        throw ValidationError("State is not of " + type_->GetName());
+    }
+}
+
+bool ColumnAggregateFunction::ReadState(InputStream& input, Buffer& state) const {
+    StateReader reader(input, state);
+    uint64_t size;
+
+    switch (format_) {
+        case StateFormat::Count:
+            return reader.VarUInt(&size);
+
+        case StateFormat::Sum:
+            return reader.Bytes(8);
+
+        case StateFormat::Extremum:
+            if (!reader.Bytes(1)) {
+                return false;
+            }
+            return !reader.State().back() || reader.Bytes(value_size_);
+
+        case StateFormat::Avg:
+            return reader.Bytes(8) && reader.VarUInt(&size);
+
+        case StateFormat::Uniq:
+            if (!reader.Bytes(1) || !reader.VarUInt(&size)) {
+                return false;
+            }
+            if (size > UniqMaxSize) {
+                throw ProtocolError("Invalid state of uniq() of " + std::to_string(size) + " hashes");
+            }
+            return reader.Bytes(size * sizeof(uint32_t));
+
+        case StateFormat::UniqCombined:
+            if (!reader.Bytes(1)) {
+                return false;
+            }
+            switch (reader.State().back()) {
+                case 1:
+                case 2: {
+                    const size_t max_size = reader.State().back() == 1
+                            ? UniqCombinedSmallSize : GetUniqCombinedMediumSize(value_size_, precision_);
+                    if (!reader.VarUInt(&size)) {
+                        return false;
+                    }
+                    if (size > max_size) {
+                        throw ProtocolError("Invalid state of uniqCombined() of " + std::to_string(size) + " hashes");
+                    }
+                    return reader.Bytes(size * value_size_);
+                }
+                case 3:
+                    return reader.Bytes(GetUniqCombinedLargeSize(value_size_, precision_));
+                default:
+                    throw ProtocolError("Invalid container of state of uniqCombined(): " + std::to_string(reader.State().back()));
+            }
+
+        case StateFormat::TDigest:
+            if (!reader.VarUInt(&size)) {
+                return false;
+            }
+            if (size > TDigestMaxDeserializedCentroids) {
+                throw ProtocolError("Too many centroids in state of t-digest: " + std::to_string(size));
+            }
+            return reader.Bytes(size * sizeof(TDigestState::Centroid));
+
+        case StateFormat::Unsupported:
+            break;
+    }
+
+    return false;
+}
+
+void ColumnAggregateFunction::AppendSerializedState(std::string_view state) {
+    Buffer buffer;
+    ArrayInput input(state.data(), state.size());
+    if (!ReadState(input, buffer) || !input.Exhausted()) {
+        throw ValidationError("Invalid state of " + type_->GetName());
+    }
+    states_->Append(state);
+}
+
+std::string_view ColumnAggregateFunction::GetSerializedState(size_t n) const {
+    return states_->At(n);
+}
+
+void ColumnAggregateFunction::Reserve(size_t new_cap) {
+    states_->Reserve(new_cap);
+}
+
+void ColumnAggregateFunction::Append(ColumnRef column) {
+    const auto col = column->As<ColumnAggregateFunction>();
+    if (!col || !col->type_->IsEqual(type_)) {
+        throw ValidationError("Can't append " + column->Type()->GetName() + " to " + type_->GetName());
+    }
+    states_->Append(col->states_);
+}
+
+bool ColumnAggregateFunction::LoadBody(InputStream* input, size_t rows) {
+    states_->Clear();
+    states_->Reserve(rows);
+
+    Buffer state;
+    for (size_t i = 0; i < rows; ++i) {
+        state.clear();
+        if (!ReadState(*input, state)) {
+            return false;
+        }
+        states_->Append(std::string_view(reinterpret_cast<const char*>(state.data()), state.size()));
+    }
+
+    return true;
+}
+
+void ColumnAggregateFunction::SaveBody(OutputStream* output) {
+    // States are written one after another, with no sizes.
+    for (size_t i = 0; i < states_->Size(); ++i) {
+        const auto state = states_->At(i);
+        WireFormat::WriteBytes(*output, state.data(), state.size());
+    }
+}
+
+void ColumnAggregateFunction::Clear() {
+    states_->Clear();
+}
+
+size_t ColumnAggregateFunction::Size() const {
+    return states_->Size();
+}
+
+ColumnRef ColumnAggregateFunction::Slice(size_t begin, size_t len) const {
+    auto result = std::make_shared<ColumnAggregateFunction>(type_);
+    result->states_->Append(states_->Slice(begin, len));
+    return result;
+}
+
+ColumnRef ColumnAggregateFunction::CloneEmpty() const {
+    return std::make_shared<ColumnAggregateFunction>(type_);
+}
+
+void ColumnAggregateFunction::Swap(Column& other) {
+    auto & col = dynamic_cast<ColumnAggregateFunction &>(other);
+    type_.swap(col.type_);
+    states_.swap(col.states_);
+    std::swap(format_, col.format_);
+    std::swap(value_size_, col.value_size_);
+    std::swap(precision_, col.precision_);
+}
+
+}
@@ -0,0 +1,351 @@
+#pragma once
+
+#include "column.h"
+#include "string.h"
+#include "../base/buffer.h"
+#include "../base/input.h"
+#include "../base/output.h"
+
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace clickhouse {
+
+/**
+ * States of aggregate functions, built on the client and serialized in the binary format of ClickHouse,
+ * to be inserted into AggregateFunction columns, e.g. of AggregatingMergeTree tables.
+ *
+ * Each state has:
+ *  - IsStateOf(type), whether it is the state of the function of given AggregateFunction type;
+ *  - Serialize() and Deserialize() of the binary format;
+ *  - Add() of a value and Merge() of another state, which follow ClickHouse.
+ */
+
+/// State of count().
+class CountState {
+public:
+    static bool IsStateOf(const AggregateFunctionType& type);
+
+    inline void Add() { ++count_; }
+    inline void Merge(const CountState& other) { count_ += other.count_; }
+
+    inline uint64_t GetCount() const { return count_; }
+
+    void Serialize(OutputStream& output) const;
+    bool Deserialize(InputStream& input);
+
+private:
+    uint64_t count_ = 0;
+};
+
+/// State of sum(x), T is the type of the sum: int64_t of signed integers, uint64_t of unsigned ones and double of floats.
+template <typename T>
+class SumState {
+public:
+    static bool IsStateOf(const AggregateFunctionType& type);
+
+    inline void Add(T value) { sum_ += value; }
+    inline void Merge(const SumState& other) { sum_ += other.sum_; }
+
+    inline T GetSum() const { return sum_; }
+
+    void Serialize(OutputStream& output) const;
+    bool Deserialize(InputStream& input);
+
+private:
+    T sum_{};
+};
+
+/// State of min(x) or max(x), T is the type of x.
+template <typename T, bool IsMin>
+class ExtremumState {
+public:
+    static bool IsStateOf(const AggregateFunctionType& type);
+
+    inline void Add(T value) {
+        if (!value_ || (IsMin ? value < *value_ : *value_ < value)) {
+            value_ = value;
+        }
+    }
+
+    inline void Merge(const ExtremumState& other) {
+        if (other.value_) {
+            Add(*other.value_);
+        }
+    }
+
+    /// Returns nullopt if no value was added.
+    inline std::optional<T> GetValue() const { return value_; }
+
+    void Serialize(OutputStream& output) const;
+    bool Deserialize(InputStream& input);
+
+private:
+    std::optional<T> value_;
+};
+
+template <typename T>
+using MinState = ExtremumState<T, true>;
+
+template <typename T>
+using MaxState = ExtremumState<T, false>;
+
+/// State of avg(x), T is the type of the sum like of SumState.
+template <typename T>
+class AvgState {
+public:
+    static bool IsStateOf(const AggregateFunctionType& type);
+
+    inline void Add(T value) {
+        numerator_ += value;
+        ++denominator_;
+    }
+
+    inline void Merge(const AvgState& other) {
+        numerator_ += other.numerator_;
+        denominator_ += other.denominator_;
+    }
+
+    inline T GetSum() const { return numerator_; }
+    inline uint64_t GetCount() const { return denominator_; }
+
+    void Serialize(OutputStream& output) const;
+    bool Deserialize(InputStream& input);
+
+private:
+    T numerator_{};
+    uint64_t denominator_ = 0;
+};
+
+/**
+ * State of uniq(x) of a number or a string: a set of 32-bit hashes of values, at most 65536 of them,
+ * when there are more only hashes divisible by increasing power of 2 are kept.
+ */
+class UniqState {
+public:
+    static bool IsStateOf(const AggregateFunctionType& type);
+
+    /// Adds value of a numeric type of at most 64 bits, the type must be the type of the argument of the function.
+    template <typename T>
+    inline void Add(T value) {
+        static_assert(std::is_arithmetic_v<T> && sizeof(T) <= sizeof(uint64_t), "Unsupported type of uniq() argument");
+        if constexpr (std::is_floating_point_v<T>) {
+            uint64_t key = 0;
+            std::memcpy(&key, &value, sizeof(value));
+            AddKey(key);
+        } else {
+            AddKey(static_cast<uint64_t>(value));
+        }
+    }
+
+    void Add(std::string_view value);
+
+    void Merge(const UniqState& other);
+
+    /// Returns count of hashes kept.
+    inline size_t GetHashCount() const { return hashes_.size(); }
+
+    void Serialize(OutputStream& output) const;
+    bool Deserialize(InputStream& input);
+
+private:
+    void AddKey(uint64_t key);
+    void AddHash(uint32_t hash);
+
+private:
+    uint8_t skip_degree_ = 0;
+    std::unordered_set<uint32_t> hashes_;
+};
+
+/**
+ * State of uniqCombined(x), uniqCombined64(x) and uniqCombined(precision)(x) of a number or a string: hashes of values,
+ * kept in an array of up to 16 hashes, then in a hash set, and once the set is about as large as a HyperLogLog counter
+ * of 2^Precision buckets, counted by the counter.
+ *
+ * HashType is uint32_t for uniqCombined() of numbers, and uint64_t for uniqCombined64() and uniqCombined() of strings.
+ */
+template <typename HashType = uint32_t, uint8_t Precision = 17>
+class UniqCombinedState {
+    static_assert(std::is_same_v<HashType, uint32_t> || std::is_same_v<HashType, uint64_t>, "Unsupported type of hashes");
+    static_assert(Precision >= 12 && Precision <= 20, "Precision of uniqCombined() must be in [12, 20]");
+
+public:
+    static bool IsStateOf(const AggregateFunctionType& type);
+
+    /// Adds value of a numeric type of at most 64 bits, the type must be the type of the argument of the function.
+    template <typename T>
+    inline void Add(T value) {
+        static_assert(std::is_arithmetic_v<T> && sizeof(T) <= sizeof(uint64_t), "Unsupported type of uniqCombined() argument");
+        if constexpr (std::is_floating_point_v<T>) {
+            uint64_t key = 0;
+            std::memcpy(&key, &value, sizeof(value));
+            AddKey(key);
+        } else {
+            AddKey(static_cast<uint64_t>(value));
+        }
+    }
+
+    void Add(std::string_view value);
+
+    void Merge(const UniqCombinedState& other);
+
+    /// Returns true once hashes are counted by the HyperLogLog counter, rather than kept.
+    inline bool IsApproximate() const { return container_ == Container::Large; }
+
+    /// Returns count of hashes kept, until IsApproximate().
+    inline size_t GetHashCount() const { return small_.size() + medium_.size(); }
+
+    void Serialize(OutputStream& output) const;
+    bool Deserialize(InputStream& input);
+
+private:
+    void AddKey(uint64_t key);
+    void AddHash(HashType hash);
+    void ToMedium();
+    void ToLarge();
+    void AddToLarge(HashType hash);
+
+private:
+    /// Values are the serialized codes of containers.
+    enum class Container : uint8_t {
+        Small = 1,
+        Medium = 2,
+        Large = 3,
+    };
+
+    Container container_ = Container::Small;
+    /// Hashes in order of insertion, while there are few of them.
+    std::vector<HashType> small_;
+    std::unordered_set<HashType> medium_;
+    /// Ranks of buckets of the HyperLogLog counter.
+    std::vector<uint8_t> ranks_;
+};
+
+/// State of quantileTDigest(level)(x), quantilesTDigest(levels...)(x) and medianTDigest(x): compressed t-digest of values.
+class TDigestState {
+public:
+    struct Centroid {
+        float mean;
+        float count;
+    };
+
+    static bool IsStateOf(const AggregateFunctionType& type);
+
+    /// NaN values are ignored.
+    void Add(float value, float count = 1);
+
+    void Merge(const TDigestState& other);
+
+    /// Merges close centroids, Serialize() serializes compressed centroids anyway.
+    void Compress();
+
+    inline const std::vector<Centroid>& GetCentroids() const { return centroids_; }
+
+    void Serialize(OutputStream& output) const;
+    bool Deserialize(InputStream& input);
+
+private:
+    std::vector<Centroid> centroids_;
+    double count_ = 0;
+    size_t unmerged_ = 0;
+};
+
+/**
+ * Represents column of AggregateFunction(function, argument types...), holding states of the function
+ * in the binary format of ClickHouse.
+ *
+ * Supported functions, of numeric arguments unless stated otherwise:
+ * count, sum, min, max, avg, uniq, uniqCombined and uniqCombined64 (also of String),
+ * quantileTDigest, quantilesTDigest and medianTDigest.
+ */
+class ColumnAggregateFunction : public Column {
+public:
+    /// Throws UnimplementedError if the function is not supported.
+    explicit ColumnAggregateFunction(TypeRef type);
+
+    /// Returns true if states of the function of the type are supported.
+    static bool IsSupported(const AggregateFunctionType& type);
+
+    const AggregateFunctionType& GetAggregateFunctionType() const;
+
+    /// Appends state, which must be the state of the function, e.g. SumState<int64_t> of AggregateFunction(sum, Int32).
+    template <typename State, typename = decltype(State::IsStateOf(std::declval<const AggregateFunctionType&>()))>
+    inline void Append(const State& state) {
+        CheckState(State::IsStateOf(GetAggregateFunctionType()));
+
+        Buffer buffer;
+        BufferOutput output(&buffer);
+        state.Serialize(output);
+        output.Flush();
+        AppendSerializedState(std::string_view(reinterpret_cast<const char*>(buffer.data()), buffer.size()));
+    }
+
+    /// Returns state of given row, State must be the state of the function.
+    template <typename State>
+    inline State At(size_t n) const {
+        CheckState(State::IsStateOf(GetAggregateFunctionType()));
+
+        const auto serialized = GetSerializedState(n);
+        ArrayInput input(serialized.data(), serialized.size());
+        State state;
+        if (!state.Deserialize(input)) {
+            throw ProtocolError("Can't deserialize state of " + type_->GetName());
+        }
+        return state;
+    }
+
+    /// Appends state in the binary format of ClickHouse, throws ValidationError if it is not exactly one state of the function.
+    void AppendSerializedState(std::string_view state);
+
+    /// Returns state of given row in the binary format of ClickHouse.
+    std::string_view GetSerializedState(size_t n) const;
+
+public:
+    /// Increase the capacity of the column for large block insertion.
+    void Reserve(size_t new_cap) override;
+
+    /// Appends content of given column to the end of current one.
+    void Append(ColumnRef column) override;
+
+    /// Loads column data from input stream.
+    bool LoadBody(InputStream* input, size_t rows) override;
+
+    /// Saves column data to output stream.
+    void SaveBody(OutputStream* output) override;
+
+    /// Clear column data .
+    void Clear() override;
+
+    /// Returns count of rows in the column.
+    size_t Size() const override;
+
+    /// Makes slice of the current column.
+    ColumnRef Slice(size_t begin, size_t len) const override;
+    ColumnRef CloneEmpty() const override;
+    void Swap(Column&) override;
+
+private:
+    void CheckState(bool is_state_of) const;
+
+    /// Reads one state of the function as is, appending it to `state`.
+    bool ReadState(InputStream& input, Buffer& state) const;
+
+private:
+    enum class StateFormat : uint8_t;
+
+    static StateFormat GetStateFormat(const AggregateFunctionType& type);
+
+    std::shared_ptr<ColumnString> states_;
+    StateFormat format_;
+    /// Size of values of the argument, of min and max states, and size of hashes of uniqCombined states.
+    size_t value_size_ = 0;
+    /// Precision of uniqCombined states.
+    uint8_t precision_ = 0;
+};
+
+}
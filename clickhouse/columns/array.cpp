@@ -58,10 +58,35 @@ void ColumnArray::Reserve(size_t new_cap) {
 }
 
 void ColumnArray::Append(ColumnRef column) {
-    if (auto col = column->As<ColumnArray>()) {
-        for (size_t i = 0; i < col->Size(); ++i) {
-            AppendAsColumn(col->GetAsColumn(i));
-        }
+    auto col = column->As<ColumnArray>();
+    if (!col || col->Size() == 0)
+        return;
+
+    if (col.get() == this) {
+        col = Slice(0, Size())->As<ColumnArray>();
+    }
+
+    // Append all nested items at once, and then rebase offsets of appended rows,
+    // instead of appending each row as a separate column.
+    const auto nested_rows = col->GetOffset(col->Size());
+    auto nested = col->data_->Size() == nested_rows ? col->data_ : col->data_->Slice(0, nested_rows);
+
+    const auto prev_nested_size = data_->Size();
+    data_->Append(nested);
+
+    if (data_->Size() - prev_nested_size != nested_rows)
+        throw ValidationError("Can't append " + column->GetType().GetName() + " to " + GetType().GetName());
+
+    auto & offsets = offsets_->GetWritableData();
+    const auto source_offsets = col->offsets_->GetData();
+    const uint64_t base = offsets.empty() ? 0 : offsets.back();
+
+    const auto prev_size = offsets.size();
+    offsets.resize(prev_size + source_offsets.size());
+
+    uint64_t * dest = offsets.data() + prev_size;
+    for (size_t i = 0; i < source_offsets.size(); ++i) {
+        dest[i] = source_offsets[i] + base;
     }
 }
 
@@ -120,6 +145,10 @@ void ColumnArray::OffsetsIncrease(size_t n) {
     offsets_->Append(n);
 }
 
+Span<const uint64_t> ColumnArray::GetOffsets() const {
+    return offsets_->GetData();
+}
+
 size_t ColumnArray::GetOffset(size_t n) const {
 
     return (n == 0) ? 0 : (*offsets_)[n - 1];
@@ -4,13 +4,19 @@
 #include "numeric.h"
 #include "utils.h"
 
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace clickhouse {
 
 template <typename NestedColumnType>
 class ColumnArrayT;
 
+template <typename KeyColumnType, typename ValueColumnType>
+class ColumnMapT;
+
 /**
  * Represents column of Array(T).
  */
@@ -46,6 +52,15 @@ public:
         return GetAsColumn(n)->AsStrict<T>();
     }
 
+    /** Read-only view on end offsets of rows in the nested column: row `n` spans items
+     *  [GetOffsets()[n - 1], GetOffsets()[n]) of the nested column, the first row starts at 0.
+     *  Invalidated by any modification of the column.
+     */
+    Span<const uint64_t> GetOffsets() const;
+
+    /// Read-only column of items of all rows, see GetOffsets().
+    inline ColumnRef GetNestedColumn() const { return data_; }
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -80,6 +95,7 @@ public:
 
 protected:
     template<typename T> friend class ColumnArrayT;
+    template<typename K, typename V> friend class ColumnMapT;
 
     ColumnArray(ColumnArray&& array);
 
@@ -94,6 +110,29 @@ private:
     std::shared_ptr<ColumnUInt64> offsets_;
 };
 
+template <>
+struct ColumnTypeCodeFilter<ColumnArray> {
+    static constexpr bool Matches(Type::Code code) { return code == Type::Array; }
+};
+
+namespace details {
+
+/// Span of items of a contiguous container, e.g. std::vector.
+template <typename Container>
+auto MakeSpanOfItems(const Container& items) -> Span<const std::remove_pointer_t<decltype(std::data(items))>> {
+    return {std::data(items), std::size(items)};
+}
+
+/// True if items of a contiguous container can be appended to column with AppendMany().
+template <typename ColumnType, typename Container, typename = void>
+constexpr bool HasAppendManyOf = false;
+
+template <typename ColumnType, typename Container>
+constexpr bool HasAppendManyOf<ColumnType, Container, std::void_t<
+        decltype(std::declval<ColumnType&>().AppendMany(MakeSpanOfItems(std::declval<const Container&>())))>> = true;
+
+}
+
 template <typename ColumnType>
 class ColumnArrayT : public ColumnArray {
 public:
@@ -257,6 +296,11 @@ public:
         return ArrayValueView{typed_nested_data_, GetOffset(index), GetSize(index)};
     }
 
+    /// Nested column holding items of all rows, see GetOffsets().
+    inline const NestedColumnType & GetNestedColumn() const {
+        return *typed_nested_data_;
+    }
+
     using ColumnArray::Append;
 
     template <typename Container>
@@ -292,6 +336,23 @@ public:
         AddOffset(counter);
     }
 
+    /** Appends each of `rows`, a container of items of the nested column, as an array.
+     *  Items of a contiguous container (e.g. std::vector) are appended with AppendMany() of the nested column,
+     *  if it has one.
+     */
+    template <typename Container>
+    inline void AppendMany(Span<const Container> rows) {
+        auto & nested_data = *typed_nested_data_;
+        for (const auto & row : rows) {
+            if constexpr (details::HasAppendManyOf<NestedColumnType, Container>) {
+                nested_data.AppendMany(details::MakeSpanOfItems(row));
+                AddOffset(std::size(row));
+            } else {
+                Append(row);
+            }
+        }
+    }
+
     ColumnRef Slice(size_t begin, size_t size) const override {
         return Wrap(ColumnArray::Slice(begin, size));
     }
@@ -6,6 +6,8 @@
 
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
 
 namespace clickhouse {
 
@@ -14,6 +16,14 @@ class OutputStream;
 
 using ColumnRef = std::shared_ptr<class Column>;
 
+/** Tells whether a column with type of given code may be of class T, so that AsPtr() rejects other columns
+ *  without RTTI. Specialized next to column classes.
+ */
+template <typename T>
+struct ColumnTypeCodeFilter {
+    static constexpr bool Matches(Type::Code) { return true; }
+};
+
 /**
  * An abstract base of all columns classes.
  */
@@ -45,6 +55,41 @@ public:
         return result;
     }
 
+    /** Downcast to the specific column's subtype, nullptr if the column is not of it.
+     *  Unlike As(), does not touch reference counters, and checks the type code and the exact class
+     *  before falling back to dynamic_cast, so it is cheap enough for per-row use.
+     */
+    template <typename T>
+    inline T* AsPtr() {
+        return const_cast<T*>(static_cast<const Column*>(this)->AsPtr<T>());
+    }
+
+    template <typename T>
+    inline const T* AsPtr() const {
+        static_assert(std::is_base_of_v<Column, T>, "T must be a column class");
+        if (!ColumnTypeCodeFilter<std::remove_const_t<T>>::Matches(type_->GetCode())) {
+            return nullptr;
+        }
+        if (typeid(*this) == typeid(T)) {
+            return static_cast<const T*>(this);
+        }
+        return dynamic_cast<const T*>(this);
+    }
+
+    /// Like AsPtr(), but throws ValidationError if the column is not of the subtype.
+    template <typename T>
+    inline T& AsRef() {
+        return const_cast<T&>(static_cast<const Column*>(this)->AsRef<T>());
+    }
+
+    template <typename T>
+    inline const T& AsRef() const {
+        if (const auto result = AsPtr<T>()) {
+            return *result;
+        }
+        throw ValidationError("Can't cast from " + type_->GetName());
+    }
+
     /// Get type object of the column.
     inline TypeRef Type() const { return type_; }
     inline const class Type& GetType() const { return *type_; }
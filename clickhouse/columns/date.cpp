@@ -1,5 +1,87 @@
 #include "date.h"
+#include "string.h"
+#include "utils.h"
+
+#include "../base/text_codec.h"
+
+#include <algorithm>
 #include <cstdint>
+#include <limits>
+
+namespace {
+using namespace clickhouse;
+
+// Appends `values` to `data`, converting each with `convert`, written as a plain loop over preallocated memory,
+// so compiler is free to vectorize it.
+template <typename T, typename ValueType, typename Converter>
+void AppendManyConverted(std::vector<T> & data, Span<const ValueType> values, Converter convert) {
+    const auto old_size = data.size();
+    data.resize(old_size + values.size());
+
+    T * dest = data.data() + old_size;
+    for (size_t i = 0; i < values.size(); ++i) {
+        dest[i] = convert(values[i]);
+    }
+}
+
+inline int64_t FloorDiv(int64_t value, int64_t divisor) {
+    const int64_t quotient = value / divisor;
+    return quotient - ((value % divisor) < 0);
+}
+
+// Number of DateTime64 ticks in a second.
+inline int64_t TicksPerSecond(size_t precision) {
+    int64_t result = 1;
+    for (size_t i = 0; i < precision; ++i)
+        result *= 10;
+    return result;
+}
+
+// Rows are processed in chunks of that size via a buffer on stack where conversion requires intermediate values.
+constexpr size_t ConversionChunkSize = 1024;
+
+template <typename T>
+void AppendDatesFromStrings(const ColumnString & strings, std::vector<T> & data) {
+    AppendParsedStrings(strings.GetData(), data, [](std::string_view str, T & value) {
+        int64_t days;
+        if (!ParseDate(str, days))
+            throw ValidationError("invalid date format: " + std::string(str));
+        if (days < std::numeric_limits<T>::min() || days > std::numeric_limits<T>::max())
+            throw ValidationError("date is out of range: " + std::string(str));
+
+        value = static_cast<T>(days);
+    });
+}
+
+template <typename T>
+void FormatDatesToStrings(Span<const T> data, ColumnString & dest) {
+    uint16_t year[ConversionChunkSize];
+    uint8_t month[ConversionChunkSize];
+    uint8_t day[ConversionChunkSize];
+
+    FormatToStringColumn<MaxDateTextSize>(dest, data.size(), [&](size_t row, char * out) {
+        const size_t i = row % ConversionChunkSize;
+        if (i == 0) {
+            const size_t count = std::min(ConversionChunkSize, data.size() - row);
+            TimeZone::DaysToCivilDate(data.subspan(row, count), CivilTimeFields{
+                Span<uint16_t>(year, count), Span<uint8_t>(month, count), Span<uint8_t>(day, count), {}, {}, {}});
+        }
+
+        return FormatDate(year[i], month[i], day[i], out);
+    });
+}
+
+template <typename T, typename ValueType, typename Converter>
+void CopyToConverted(Span<const T> data, Span<ValueType> dest, size_t begin, Converter convert) {
+    ValidateCopyToRange(data.size(), begin, dest.size());
+
+    const T * src = data.data() + begin;
+    for (size_t i = 0; i < dest.size(); ++i) {
+        dest[i] = convert(src[i]);
+    }
+}
+
+}
 
 namespace clickhouse {
 
@@ -29,6 +111,21 @@ std::time_t ColumnDate::At(size_t n) const {
     return static_cast<std::time_t>(data_->At(n)) * 86400;
 }
 
+void ColumnDate::CopyCivilDate(const CivilTimeFields& fields, size_t begin) const {
+    const auto rows = fields.Size();
+    ValidateCopyToRange(Size(), begin, rows);
+
+    TimeZone::DaysToCivilDate(data_->GetData().subspan(begin, rows), fields);
+}
+
+void ColumnDate::AppendFromStrings(const ColumnString& strings) {
+    AppendDatesFromStrings(strings, data_->GetWritableData());
+}
+
+void ColumnDate::FormatToStrings(ColumnString& dest) const {
+    FormatDatesToStrings(data_->GetData(), dest);
+}
+
 void ColumnDate::AppendRaw(uint16_t value) {
     data_->Append(value);
 }
@@ -37,6 +134,28 @@ uint16_t ColumnDate::RawAt(size_t n) const {
     return data_->At(n);
 }
 
+void ColumnDate::AppendMany(Span<const std::time_t> values) {
+    /// The implementation is fundamentally wrong, ignores timezones, leap years and daylight saving.
+    AppendManyConverted(data_->GetWritableData(), values, [](std::time_t value) {
+        return static_cast<uint16_t>(value / std::time_t(86400));
+    });
+}
+
+void ColumnDate::AppendRawMany(Span<const uint16_t> values) {
+    data_->AppendMany(values);
+}
+
+void ColumnDate::CopyTo(Span<std::time_t> dest, size_t begin) const {
+    /// The implementation is fundamentally wrong, ignores timezones, leap years and daylight saving.
+    CopyToConverted(data_->GetData(), dest, begin, [](uint16_t value) {
+        return static_cast<std::time_t>(value) * 86400;
+    });
+}
+
+Span<const uint16_t> ColumnDate::GetData() const {
+    return data_->GetData();
+}
+
 void ColumnDate::Append(ColumnRef column) {
     if (auto col = column->As<ColumnDate>()) {
         data_->Append(col->data_);
@@ -142,6 +261,43 @@ int32_t ColumnDate32::RawAt(size_t n) const {
     return data_->At(n);
 }
 
+void ColumnDate32::AppendMany(Span<const std::time_t> values) {
+    /// The implementation is fundamentally wrong, ignores timezones, leap years and daylight saving.
+    AppendManyConverted(data_->GetWritableData(), values, [](std::time_t value) {
+        return static_cast<int32_t>(value / std::time_t(86400));
+    });
+}
+
+void ColumnDate32::AppendRawMany(Span<const int32_t> values) {
+    data_->AppendMany(values);
+}
+
+void ColumnDate32::CopyTo(Span<std::time_t> dest, size_t begin) const {
+    /// The implementation is fundamentally wrong, ignores timezones, leap years and daylight saving.
+    CopyToConverted(data_->GetData(), dest, begin, [](int32_t value) {
+        return static_cast<std::time_t>(value) * 86400;
+    });
+}
+
+Span<const int32_t> ColumnDate32::GetData() const {
+    return data_->GetData();
+}
+
+void ColumnDate32::CopyCivilDate(const CivilTimeFields& fields, size_t begin) const {
+    const auto rows = fields.Size();
+    ValidateCopyToRange(Size(), begin, rows);
+
+    TimeZone::DaysToCivilDate(data_->GetData().subspan(begin, rows), fields);
+}
+
+void ColumnDate32::AppendFromStrings(const ColumnString& strings) {
+    AppendDatesFromStrings(strings, data_->GetWritableData());
+}
+
+void ColumnDate32::FormatToStrings(ColumnString& dest) const {
+    FormatDatesToStrings(data_->GetData(), dest);
+}
+
 bool ColumnDate32::LoadBody(InputStream* input, size_t rows) {
     return data_->LoadBody(input, rows);
 }
@@ -214,10 +370,51 @@ uint32_t ColumnDateTime::RawAt(size_t n) const {
 	return data_->At(n);
 }
 
+void ColumnDateTime::AppendMany(Span<const std::time_t> values) {
+    AppendManyConverted(data_->GetWritableData(), values, [](std::time_t value) {
+        return static_cast<uint32_t>(value);
+    });
+}
+
+void ColumnDateTime::AppendRawMany(Span<const uint32_t> values) {
+    data_->AppendMany(values);
+}
+
+void ColumnDateTime::CopyTo(Span<std::time_t> dest, size_t begin) const {
+    CopyToConverted(data_->GetData(), dest, begin, [](uint32_t value) {
+        return static_cast<std::time_t>(value);
+    });
+}
+
+Span<const uint32_t> ColumnDateTime::GetData() const {
+    return data_->GetData();
+}
+
 std::string ColumnDateTime::Timezone() const {
     return type_->As<DateTimeType>()->Timezone();
 }
 
+std::shared_ptr<const TimeZone> ColumnDateTime::GetTimeZone() const {
+    return TimeZone::Get(Timezone());
+}
+
+void ColumnDateTime::CopyCivilTime(const CivilTimeFields& fields, size_t begin) const {
+    CopyCivilTime(*GetTimeZone(), fields, begin);
+}
+
+void ColumnDateTime::CopyCivilTime(const TimeZone& time_zone, const CivilTimeFields& fields, size_t begin) const {
+    const auto rows = fields.Size();
+    ValidateCopyToRange(Size(), begin, rows);
+
+    time_zone.ToCivilTime(data_->GetData().subspan(begin, rows), fields);
+}
+
+void ColumnDateTime::CopyLocalTime(const TimeZone& time_zone, Span<int64_t> dest, size_t begin) const {
+    ValidateCopyToRange(Size(), begin, dest.size());
+
+    time_zone.ToLocalSeconds(data_->GetData().subspan(begin, dest.size()), dest);
+}
+
 void ColumnDateTime::Append(ColumnRef column) {
     if (auto col = column->As<ColumnDateTime>()) {
         data_->Append(col->data_);
@@ -303,10 +500,62 @@ Int64 ColumnDateTime64::At(size_t n) const {
     return static_cast<Int64>(data_->At(n));
 }
 
+void ColumnDateTime64::AppendMany(Span<const Int64> values) {
+    data_->AppendMany(values);
+}
+
+void ColumnDateTime64::CopyTo(Span<Int64> dest, size_t begin) const {
+    data_->CopyTo(dest, begin);
+}
+
 std::string ColumnDateTime64::Timezone() const {
     return type_->As<DateTime64Type>()->Timezone();
 }
 
+std::shared_ptr<const TimeZone> ColumnDateTime64::GetTimeZone() const {
+    return TimeZone::Get(Timezone());
+}
+
+void ColumnDateTime64::CopyCivilTime(const CivilTimeFields& fields, size_t begin) const {
+    CopyCivilTime(*GetTimeZone(), fields, begin);
+}
+
+void ColumnDateTime64::CopyCivilTime(const TimeZone& time_zone, const CivilTimeFields& fields, size_t begin) const {
+    const auto rows = fields.Size();
+    ValidateCopyToRange(Size(), begin, rows);
+
+    const auto ticks_per_second = TicksPerSecond(precision_);
+    Int64 seconds[ConversionChunkSize];
+    for (size_t chunk = 0; chunk < rows; chunk += ConversionChunkSize) {
+        const auto count = std::min(ConversionChunkSize, rows - chunk);
+        data_->CopyTo(Span<Int64>(seconds, count), begin + chunk);
+        for (size_t i = 0; i < count; ++i) {
+            seconds[i] = FloorDiv(seconds[i], ticks_per_second);
+        }
+
+        time_zone.ToCivilTime(Span<const Int64>(seconds, count), fields.Subspan(chunk, count));
+    }
+}
+
+void ColumnDateTime64::CopyLocalTime(const TimeZone& time_zone, Span<Int64> dest, size_t begin) const {
+    data_->CopyTo(dest, begin);
+
+    const auto ticks_per_second = TicksPerSecond(precision_);
+    Int64 seconds[ConversionChunkSize];
+    Int64 local_seconds[ConversionChunkSize];
+    for (size_t chunk = 0; chunk < dest.size(); chunk += ConversionChunkSize) {
+        const auto count = std::min(ConversionChunkSize, dest.size() - chunk);
+        for (size_t i = 0; i < count; ++i) {
+            seconds[i] = FloorDiv(dest[chunk + i], ticks_per_second);
+        }
+
+        time_zone.ToLocalSeconds(Span<const Int64>(seconds, count), Span<Int64>(local_seconds, count));
+        for (size_t i = 0; i < count; ++i) {
+            dest[chunk + i] += (local_seconds[i] - seconds[i]) * ticks_per_second;
+        }
+    }
+}
+
 void ColumnDateTime64::Reserve(size_t new_cap)
 {
     data_->Reserve(new_cap);
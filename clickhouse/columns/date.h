@@ -2,11 +2,14 @@
 
 #include "decimal.h"
 #include "numeric.h"
+#include "../base/time_zone.h"
 
 #include <ctime>
 
 namespace clickhouse {
 
+class ColumnString;
+
 /** */
 class ColumnDate : public Column {
 public:
@@ -28,12 +31,35 @@ public:
     void AppendRaw(uint16_t value);
     uint16_t RawAt(size_t n) const;
 
+    /// Appends all elements of `values` to the end of column, same conversion as Append(const std::time_t&).
+    void AppendMany(Span<const std::time_t> values);
+
+    /// Appends raw values (number of day in Unix epoch) as is.
+    void AppendRawMany(Span<const uint16_t> values);
+
+    /// Copies `dest.size()` elements starting at row `begin` into `dest`, same conversion as At().
+    void CopyTo(Span<std::time_t> dest, size_t begin = 0) const;
+
+    /// Splits dates into year, month and day, time fields (if any) are zeroed.
+    /// Number of rows is the size of non-empty `fields`, starting at row `begin`.
+    void CopyCivilDate(const CivilTimeFields& fields, size_t begin = 0) const;
+
+    /// Appends all elements of `strings` parsed as "YYYY-MM-DD", throws ValidationError if any of them is malformed
+    /// or out of range of the column type and leaves the column unchanged in that case.
+    void AppendFromStrings(const ColumnString& strings);
+
+    /// Appends text of all elements of the column as "YYYY-MM-DD" to `dest`.
+    void FormatToStrings(ColumnString& dest) const;
+
     /// Appends content of given column to the end of current one.
     void Append(ColumnRef column) override;
 
     /// Get Raw Vector Contents
     std::vector<uint16_t>& GetWritableData();
 
+    /// Read-only view on raw column contents (number of day in Unix epoch).
+    Span<const uint16_t> GetData() const;
+
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
 
@@ -85,9 +111,32 @@ public:
     void AppendRaw(int32_t value);
     int32_t RawAt(size_t n) const;
 
+    /// Appends all elements of `values` to the end of column, same conversion as Append(const std::time_t&).
+    void AppendMany(Span<const std::time_t> values);
+
+    /// Appends raw values (number of day in Unix epoch) as is.
+    void AppendRawMany(Span<const int32_t> values);
+
+    /// Copies `dest.size()` elements starting at row `begin` into `dest`, same conversion as At().
+    void CopyTo(Span<std::time_t> dest, size_t begin = 0) const;
+
+    /// Splits dates into year, month and day, time fields (if any) are zeroed.
+    /// Number of rows is the size of non-empty `fields`, starting at row `begin`.
+    void CopyCivilDate(const CivilTimeFields& fields, size_t begin = 0) const;
+
+    /// Appends all elements of `strings` parsed as "YYYY-MM-DD", throws ValidationError if any of them is malformed
+    /// or out of range of the column type and leaves the column unchanged in that case.
+    void AppendFromStrings(const ColumnString& strings);
+
+    /// Appends text of all elements of the column as "YYYY-MM-DD" to `dest`.
+    void FormatToStrings(ColumnString& dest) const;
+
     /// Get Raw Vector Contents
     std::vector<int32_t>& GetWritableData();
 
+    /// Read-only view on raw column contents (number of day in Unix epoch).
+    Span<const int32_t> GetData() const;
+
     /// Returns the capacity of the column
     size_t Capacity() const;
 
@@ -144,12 +193,38 @@ public:
     void AppendRaw(uint32_t value);
     uint32_t RawAt(size_t n) const;
 
+    /// Appends all elements of `values` to the end of column.
+    void AppendMany(Span<const std::time_t> values);
+
+    /// Appends raw values (UNIX epoch seconds in uint32) as is.
+    void AppendRawMany(Span<const uint32_t> values);
+
+    /// Copies `dest.size()` elements starting at row `begin` into `dest`.
+    void CopyTo(Span<std::time_t> dest, size_t begin = 0) const;
+
+    /** Time zone rules of the column. Columns without explicit time zone are treated as UTC,
+     *  since the default time zone of the server is not known on the client side.
+     */
+    std::shared_ptr<const TimeZone> GetTimeZone() const;
+
+    /// Splits values into civil time fields in the time zone of the column or in the given one.
+    /// Number of rows is the size of non-empty `fields`, starting at row `begin`.
+    void CopyCivilTime(const CivilTimeFields& fields, size_t begin = 0) const;
+    void CopyCivilTime(const TimeZone& time_zone, const CivilTimeFields& fields, size_t begin = 0) const;
+
+    /// Copies `dest.size()` values starting at row `begin` converted to wall clock time of `time_zone`,
+    /// as seconds since 1970-01-01 00:00:00 local time.
+    void CopyLocalTime(const TimeZone& time_zone, Span<int64_t> dest, size_t begin = 0) const;
+
     /// Timezone associated with a data column.
     std::string Timezone() const;
 
     /// Get Raw Vector Contents
     std::vector<uint32_t>& GetWritableData();
 
+    /// Read-only view on raw column contents (UNIX epoch seconds).
+    Span<const uint32_t> GetData() const;
+
     /// Returns the capacity of the column
     size_t Capacity() const;
 
@@ -203,6 +278,26 @@ public:
 
     inline Int64 operator[](size_t n) const { return At(n); }
 
+    /// Appends all elements of `values` to the end of column.
+    void AppendMany(Span<const Int64> values);
+
+    /// Copies `dest.size()` elements starting at row `begin` into `dest`.
+    void CopyTo(Span<Int64> dest, size_t begin = 0) const;
+
+    /** Time zone rules of the column. Columns without explicit time zone are treated as UTC,
+     *  since the default time zone of the server is not known on the client side.
+     */
+    std::shared_ptr<const TimeZone> GetTimeZone() const;
+
+    /// Splits values, truncated to seconds, into civil time fields in the time zone of the column or in the given one.
+    /// Number of rows is the size of non-empty `fields`, starting at row `begin`.
+    void CopyCivilTime(const CivilTimeFields& fields, size_t begin = 0) const;
+    void CopyCivilTime(const TimeZone& time_zone, const CivilTimeFields& fields, size_t begin = 0) const;
+
+    /// Copies `dest.size()` values starting at row `begin` converted to wall clock time of `time_zone`,
+    /// in units of the column precision since 1970-01-01 00:00:00 local time.
+    void CopyLocalTime(const TimeZone& time_zone, Span<Int64> dest, size_t begin = 0) const;
+
     /// Timezone associated with a data column.
     std::string Timezone() const;
 
@@ -1,4 +1,11 @@
 #include "decimal.h"
+#include "string.h"
+#include "utils.h"
+
+#include "../base/text_codec.h"
+
+#include <algorithm>
+#include <cstring>
 
 namespace
 {
@@ -95,6 +102,304 @@ inline bool mulOverflow(const Int128 & l, const T & r, Int128 * result)
 }
 #endif
 
+template <typename ResultColumnType>
+inline const ResultColumnType & column_down_cast(const Column & c) {
+    return static_cast<const ResultColumnType &>(c);
+}
+
+template <typename ResultColumnType>
+inline ResultColumnType & column_down_cast(Column & c) {
+    return static_cast<ResultColumnType &>(c);
+}
+
+// Dispatches on the actual type of the data column once, instead of once per value.
+template <typename Visitor, typename ColumnType>
+inline auto VisitDecimalData(Visitor && visitor, ColumnType && data) {
+    switch (data.Type()->GetCode()) {
+        case Type::Int32:
+            return visitor(column_down_cast<ColumnInt32>(data));
+        case Type::Int64:
+            return visitor(column_down_cast<ColumnInt64>(data));
+        case Type::Int128:
+            return visitor(column_down_cast<ColumnInt128>(data));
+        case Type::Int256:
+            return visitor(column_down_cast<ColumnInt256>(data));
+        default:
+            throw ValidationError("Invalid data_ column type in ColumnDecimal");
+    }
+}
+
+constexpr uint64_t Pow10[] = {
+    1ull,
+    10ull,
+    100ull,
+    1000ull,
+    10000ull,
+    100000ull,
+    1000000ull,
+    10000000ull,
+    100000000ull,
+    1000000000ull,
+    10000000000ull,
+    100000000000ull,
+    1000000000000ull,
+    10000000000000ull,
+    100000000000000ull,
+    1000000000000000ull,
+    10000000000000000ull,
+    100000000000000000ull,
+    1000000000000000000ull,
+};
+
+// Computes `value * multiplier + addend` for non-negative `value`, returns true on overflow.
+inline bool mulAddOverflow(Int128 & value, uint64_t multiplier, uint64_t addend) {
+    return mulOverflow(value, static_cast<Int128>(multiplier), &value)
+        || addOverflow(value, static_cast<Int128>(addend), &value);
+}
+
+inline bool mulAddOverflow(Int256 & value, uint64_t multiplier, uint64_t addend) {
+    auto limbs = value.GetLimbs();
+    uint64_t carry = addend;
+    for (auto & limb : limbs) {
+        const absl::uint128 product = absl::uint128(limb) * multiplier + carry;
+        limb = absl::Uint128Low64(product);
+        carry = absl::Uint128High64(product);
+    }
+
+    value = Int256::FromLimbs(limbs);
+    return carry != 0 || value.IsNegative();
+}
+
+/// Accumulates decimal digits into 64-bit integer and carries it over to the wide result only every 18 digits,
+/// so overflow checks are done once per 18 digits instead of once per digit.
+template <typename ResultType>
+class DecimalDigitsAccumulator {
+public:
+    static constexpr size_t MaxDigits = 18;
+
+    explicit DecimalDigitsAccumulator(std::string_view value)
+        : value_(value)
+    {}
+
+    /// Appends digits of `value_` in range [begin, end).
+    void AppendDigits(size_t begin, size_t end) {
+        const char * p = value_.data() + begin;
+        const char * const last = value_.data() + end;
+
+        while (last - p >= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            if (!IsEightDigits(word))
+                break;
+
+            Append(ParseEightDigits(word), 8);
+            p += 8;
+        }
+
+        for (; p != last; ++p) {
+            if (*p < '0' || *p > '9')
+                throw ValidationError(std::string("unexpected symbol '") + *p + "' in decimal value");
+
+            Append(static_cast<uint64_t>(*p - '0'), 1);
+        }
+    }
+
+    /// Appends `count` zero digits.
+    void AppendZeros(size_t count) {
+        while (count) {
+            const size_t digits = std::min(count, size_t(8));
+            Append(0, digits);
+            count -= digits;
+        }
+    }
+
+    ResultType Finish() {
+        Flush();
+        return result_;
+    }
+
+private:
+    inline void Append(uint64_t chunk, size_t digits) {
+        if (pending_digits_ + digits > MaxDigits)
+            Flush();
+
+        pending_ = pending_ * Pow10[digits] + chunk;
+        pending_digits_ += digits;
+    }
+
+    void Flush() {
+        if (pending_digits_ == 0)
+            return;
+
+        if (mulAddOverflow(result_, Pow10[pending_digits_], pending_)) {
+            throw AssertionError("value is too big for " + std::to_string(sizeof(ResultType) * 8) + "-bit integer");
+        }
+
+        pending_ = 0;
+        pending_digits_ = 0;
+    }
+
+    const std::string_view value_;
+    ResultType result_ = 0;
+    uint64_t pending_ = 0;
+    size_t pending_digits_ = 0;
+};
+
+// Parses decimal number with at most `scale` digits after the point into an integer scaled by 10^scale,
+// extra fractional digits are truncated.
+template <typename ResultType>
+ResultType ParseDecimal(std::string_view value, size_t scale) {
+    size_t begin = 0;
+    bool negative = false;
+    if (!value.empty() && value[0] == '-') {
+        negative = true;
+        begin = 1;
+    }
+
+    const auto minus = value.find('-', begin);
+    const auto dot = value.find('.', begin);
+    // Anything after the point past the `scale` digits is ignored.
+    const auto fraction_end = dot == std::string_view::npos ? dot : dot + 1 + std::min(scale, value.size() - dot - 1);
+    if (minus != std::string_view::npos && minus < fraction_end) {
+        throw ValidationError("unexpected symbol '-' in decimal value");
+    }
+
+    DecimalDigitsAccumulator<ResultType> accumulator(value);
+    if (dot == std::string_view::npos) {
+        accumulator.AppendDigits(begin, value.size());
+        accumulator.AppendZeros(scale);
+    } else {
+        accumulator.AppendDigits(begin, dot);
+        accumulator.AppendDigits(dot + 1, fraction_end);
+        accumulator.AppendZeros(scale - (fraction_end - dot - 1));
+    }
+
+    const auto result = accumulator.Finish();
+    return negative ? -result : result;
+}
+
+// Longest text is of Decimal256 with scale 76: sign, "0.", 76 digits.
+constexpr size_t MaxDecimalTextSize = 80;
+constexpr uint64_t MaxPow10InLimb = 10'000'000'000'000'000'000ull;
+
+// Writes decimal digits of `value` right to left, so that they end at `end`, returns the beginning of digits.
+inline char * WriteDigitsBackward(uint64_t value, char * end) {
+    do {
+        *--end = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value);
+    return end;
+}
+
+// Same, but always writes 19 digits, padding `value` with leading zeros.
+inline char * WriteLimbDigitsBackward(uint64_t value, char * end) {
+    char * const begin = end - 19;
+    while (end != begin) {
+        *--end = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return begin;
+}
+
+inline char * WriteDigitsBackward(absl::uint128 value, char * end) {
+    while (absl::Uint128High64(value) != 0) {
+        const absl::uint128 quotient = value / MaxPow10InLimb;
+        end = WriteLimbDigitsBackward(absl::Uint128Low64(value - quotient * MaxPow10InLimb), end);
+        value = quotient;
+    }
+    return WriteDigitsBackward(absl::Uint128Low64(value), end);
+}
+
+inline char * WriteDigitsBackward(const UInt256 & value, char * end) {
+    auto limbs = value.GetLimbs();
+    while (limbs[1] | limbs[2] | limbs[3]) {
+        uint64_t remainder = 0;
+        for (size_t i = limbs.size(); i > 0; --i) {
+            const absl::uint128 current = absl::MakeUint128(remainder, limbs[i - 1]);
+            limbs[i - 1] = absl::Uint128Low64(current / MaxPow10InLimb);
+            remainder = absl::Uint128Low64(current % MaxPow10InLimb);
+        }
+        end = WriteLimbDigitsBackward(remainder, end);
+    }
+    return WriteDigitsBackward(limbs[0], end);
+}
+
+inline uint64_t Magnitude(int64_t value) {
+    return value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+}
+
+inline absl::uint128 Magnitude(const Int128 & value) {
+    const auto result = static_cast<absl::uint128>(value);
+    return value < 0 ? -result : result;
+}
+
+inline UInt256 Magnitude(const Int256 & value) {
+    return UInt256::FromLimbs((value.IsNegative() ? -value : value).GetLimbs());
+}
+
+// Formats scaled integer `value` as decimal with `scale` digits after the point, trailing zeros of fraction
+// are omitted, same as in ClickHouse output by default.
+template <typename T>
+char * FormatDecimal(const T & value, size_t scale, char * out) {
+    char digits[96];
+    char * const digits_end = digits + sizeof(digits);
+    char * begin = WriteDigitsBackward(Magnitude(value), digits_end);
+
+    // At least one digit before the point.
+    while (static_cast<size_t>(digits_end - begin) <= scale) {
+        *--begin = '0';
+    }
+
+    if (value < T(0)) {
+        *out++ = '-';
+    }
+
+    const char * const point = digits_end - scale;
+    std::memcpy(out, begin, point - begin);
+    out += point - begin;
+
+    const char * fraction_end = digits_end;
+    while (fraction_end != point && fraction_end[-1] == '0') {
+        --fraction_end;
+    }
+
+    if (fraction_end != point) {
+        *out++ = '.';
+        std::memcpy(out, point, fraction_end - point);
+        out += fraction_end - point;
+    }
+
+    return out;
+}
+
+template <typename ValueType, typename ColumnType>
+inline void AppendManyConverted(ColumnType & col, Span<const ValueType> values) {
+    using DataType = typename ColumnType::DataType;
+    if constexpr (std::is_same_v<DataType, ValueType>) {
+        col.AppendMany(values);
+    } else {
+        auto & data = col.GetWritableData();
+        const auto old_size = data.size();
+        data.resize(old_size + values.size());
+
+        DataType * dest = data.data() + old_size;
+        for (size_t i = 0; i < values.size(); ++i) {
+            dest[i] = static_cast<DataType>(values[i]);
+        }
+    }
+}
+
+template <typename ValueType, typename ColumnType>
+inline void CopyToConverted(const ColumnType & col, Span<ValueType> dest, size_t begin) {
+    const auto data = col.GetData();
+    ValidateCopyToRange(data.size(), begin, dest.size());
+
+    const auto * src = data.data() + begin;
+    for (size_t i = 0; i < dest.size(); ++i) {
+        dest[i] = static_cast<ValueType>(src[i]);
+    }
+}
+
 }
 
 namespace clickhouse {
@@ -106,8 +411,10 @@ ColumnDecimal::ColumnDecimal(size_t precision, size_t scale)
         data_ = std::make_shared<ColumnInt32>();
     } else if (precision <= 18) {
         data_ = std::make_shared<ColumnInt64>();
-    } else {
+    } else if (precision <= 38) {
         data_ = std::make_shared<ColumnInt128>();
+    } else {
+        data_ = std::make_shared<ColumnInt256>();
     }
 }
 
@@ -118,77 +425,65 @@ ColumnDecimal::ColumnDecimal(TypeRef type, ColumnRef data)
 }
 
 void ColumnDecimal::Append(const Int128& value) {
-    if (data_->Type()->GetCode() == Type::Int32) {
-        data_->As<ColumnInt32>()->Append(static_cast<ColumnInt32::DataType>(value));
-    } else if (data_->Type()->GetCode() == Type::Int64) {
-        data_->As<ColumnInt64>()->Append(static_cast<ColumnInt64::DataType>(value));
-    } else {
-        data_->As<ColumnInt128>()->Append(static_cast<ColumnInt128::DataType>(value));
-    }
+    VisitDecimalData([&value](auto & col) {
+        col.Append(static_cast<typename std::decay_t<decltype(col)>::DataType>(value));
+    }, *data_);
 }
 
 void ColumnDecimal::Append(const std::string& value) {
-    Int128 int_value = 0;
-    auto c = value.begin();
-    auto end = value.end();
-    bool sign = true;
-    bool has_dot = false;
-
-    size_t zeros = 0;
-
-    while (c != end) {
-        if (*c == '-') {
-            sign = false;
-            if (c != value.begin()) {
-                break;
-            }
-        } else if (*c == '.' && !has_dot) {
-            size_t distance = std::distance(c, end) - 1;
-            auto scale = type_->As<DecimalType>()->GetScale();
+    const auto scale = GetScale();
+    VisitDecimalData([&value, scale](auto & col) {
+        using DataType = typename std::decay_t<decltype(col)>::DataType;
+        if constexpr (std::is_same_v<DataType, Int256>) {
+            col.Append(ParseDecimal<Int256>(value, scale));
+        } else {
+            col.Append(static_cast<DataType>(ParseDecimal<Int128>(value, scale)));
+        }
+    }, *data_);
+}
 
-            if (distance <= scale) {
-                zeros = scale - distance;
+void ColumnDecimal::AppendFromStrings(const ColumnString& strings) {
+    const auto scale = GetScale();
+    VisitDecimalData([&strings, scale](auto & col) {
+        using DataType = typename std::decay_t<decltype(col)>::DataType;
+        AppendParsedStrings(strings.GetData(), col.GetWritableData(), [scale](std::string_view str, DataType & value) {
+            if constexpr (std::is_same_v<DataType, Int256>) {
+                value = ParseDecimal<Int256>(str, scale);
             } else {
-                std::advance(end, scale - distance);
+                value = static_cast<DataType>(ParseDecimal<Int128>(str, scale));
             }
+        });
+    }, *data_);
+}
 
-            has_dot = true;
-        } else if (*c >= '0' && *c <= '9') {
-            if (mulOverflow(int_value, 10, &int_value) ||
-                addOverflow(int_value, *c - '0', &int_value)) {
-                throw AssertionError("value is too big for 128-bit integer");
-            }
-        } else {
-            throw ValidationError(std::string("unexpected symbol '") + (*c) + "' in decimal value");
-        }
-        ++c;
-    }
+void ColumnDecimal::FormatToStrings(ColumnString& dest) const {
+    const auto scale = GetScale();
+    VisitDecimalData([&dest, scale](const auto & col) {
+        const auto * data = col.GetData().data();
+        FormatToStringColumn<MaxDecimalTextSize>(dest, col.Size(), [data, scale](size_t row, char * out) {
+            return FormatDecimal(data[row], scale, out);
+        });
+    }, *data_);
+}
 
-    if (c != end) {
-        throw ValidationError("unexpected symbol '-' in decimal value");
-    }
+void ColumnDecimal::AppendMany(Span<const Int128> values) {
+    VisitDecimalData([values](auto & col) { AppendManyConverted(col, values); }, *data_);
+}
 
-    while (zeros) {
-        if (mulOverflow(int_value, 10, &int_value)) {
-            throw AssertionError("value is too big for 128-bit integer");
-        }
-        --zeros;
-    }
+void ColumnDecimal::AppendMany(Span<const Int64> values) {
+    VisitDecimalData([values](auto & col) { AppendManyConverted(col, values); }, *data_);
+}
 
-    Append(sign ? int_value : -int_value);
+void ColumnDecimal::CopyTo(Span<Int128> dest, size_t begin) const {
+    VisitDecimalData([dest, begin](const auto & col) { CopyToConverted(col, dest, begin); }, *data_);
+}
+
+void ColumnDecimal::CopyTo(Span<Int64> dest, size_t begin) const {
+    VisitDecimalData([dest, begin](const auto & col) { CopyToConverted(col, dest, begin); }, *data_);
 }
 
 Int128 ColumnDecimal::At(size_t i) const {
-    switch (data_->Type()->GetCode()) {
-        case Type::Int32:
-            return static_cast<Int128>(data_->As<ColumnInt32>()->At(i));
-        case Type::Int64:
-            return static_cast<Int128>(data_->As<ColumnInt64>()->At(i));
-        case Type::Int128:
-            return data_->As<ColumnInt128>()->At(i);
-        default:
-            throw ValidationError("Invalid data_ column type in ColumnDecimal");
-    }
+    return VisitDecimalData([i](const auto & col) { return static_cast<Int128>(col.At(i)); }, *data_);
 }
 
 void ColumnDecimal::Reserve(size_t new_cap) {
@@ -196,7 +491,7 @@ void ColumnDecimal::Reserve(size_t new_cap) {
 }
 
 void ColumnDecimal::Append(ColumnRef column) {
-    if (auto col = column->As<ColumnDecimal>()) {
+    if (auto col = column->AsPtr<ColumnDecimal>()) {
         data_->Append(col->data_);
     }
 }
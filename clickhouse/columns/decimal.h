@@ -3,8 +3,15 @@
 #include "column.h"
 #include "numeric.h"
 
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+
 namespace clickhouse {
 
+class ColumnString;
+
 /**
  * Represents a column of decimal type.
  */
@@ -17,9 +24,25 @@ public:
     void Append(const Int128& value);
     void Append(const std::string& value);
 
+    /// Values of Decimal256 columns are truncated to Int128, use ColumnDecimal256 to access them fully.
     Int128 At(size_t i) const;
     inline auto operator[](size_t i) const { return At(i); }
 
+    /// Appends all elements of `values` to the end of column, values are not scaled.
+    void AppendMany(Span<const Int128> values);
+    void AppendMany(Span<const Int64> values);
+
+    /// Copies `dest.size()` elements starting at row `begin` into `dest`.
+    void CopyTo(Span<Int128> dest, size_t begin = 0) const;
+    void CopyTo(Span<Int64> dest, size_t begin = 0) const;
+
+    /// Appends all elements of `strings` parsed same as Append(const std::string&), throws if any of them is malformed
+    /// and leaves the column unchanged in that case.
+    void AppendFromStrings(const ColumnString& strings);
+
+    /// Appends text of all elements of the column to `dest`, without trailing zeros of the fractional part.
+    void FormatToStrings(ColumnString& dest) const;
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -37,13 +60,123 @@ public:
     size_t GetPrecision() const;
 
 private:
+    template <typename T>
+    friend class ColumnDecimalT;
+
     /// Depending on a precision it can be one of:
     ///  - ColumnInt32
     ///  - ColumnInt64
     ///  - ColumnInt128
+    ///  - ColumnInt256
     ColumnRef data_;
 
     explicit ColumnDecimal(TypeRef type, ColumnRef data);
 };
 
+/** Decimal column with statically known width of the underlying integer: Int32, Int64, Int128 or Int256.
+ *
+ *  Values are accessed directly in the typed storage, without dispatch on the data type per value,
+ *  and are raw i.e. scaled by 10^scale, same as ColumnDecimal::Append(const Int128&).
+ *  Precision must match the width: 1..9 for Int32, 10..18 for Int64, 19..38 for Int128, 39..76 for Int256.
+ */
+template <typename T>
+class ColumnDecimalT : public ColumnDecimal {
+    // True if values of type U may not fit into T, so Append() checks their range.
+    template <typename U>
+    static constexpr bool IsWiderThanData = std::is_same_v<U, Int128>
+            ? sizeof(T) < sizeof(Int128) : std::is_integral_v<U> && sizeof(U) > sizeof(T);
+
+public:
+    using DataType = T;
+    using ValueType = T;
+    using DataColumnType = ColumnVector<T>;
+
+    ColumnDecimalT(size_t precision, size_t scale)
+        : ColumnDecimalT(Type::CreateDecimal(ValidatePrecision(precision), scale), std::make_shared<DataColumnType>())
+    {}
+
+    inline void Append(T value) { typed_data_->Append(value); }
+    inline void Append(const std::string& value) { ColumnDecimal::Append(value); }
+
+    /// Appends raw value of a wider integer type, e.g. Int128 to Decimal32 column,
+    /// throws ValidationError if it doesn't fit into the storage.
+    template <typename U, typename = std::enable_if_t<IsWiderThanData<U>>>
+    inline void Append(const U& value) {
+        const Int128 wide(value);
+        if (wide < Int128(std::numeric_limits<T>::min()) || wide > Int128(std::numeric_limits<T>::max())) {
+            throw ValidationError("Value is out of range of " + Type()->GetName() + " storage");
+        }
+        typed_data_->Append(static_cast<T>(wide));
+    }
+
+    inline T At(size_t i) const { return typed_data_->At(i); }
+    inline T operator[](size_t i) const { return typed_data_->At(i); }
+
+    using ColumnDecimal::AppendMany;
+
+    /// Appends all elements of `values` to the end of column with a single copy, values are not scaled.
+    inline void AppendMany(Span<const T> values) { typed_data_->AppendMany(values); }
+
+    inline Span<const T> GetData() const { return typed_data_->GetData(); }
+    inline std::vector<T>& GetWritableData() { return typed_data_->GetWritableData(); }
+
+    void Append(ColumnRef column) override { ColumnDecimal::Append(std::move(column)); }
+
+    /** Create a ColumnDecimalT from a ColumnDecimal, without copying data, but by 'stealing' it from `col`.
+     *
+     *  Ownership of column internals is transferred to returned object, original (argument) object
+     *  MUST NOT BE USED IN ANY WAY, it is only safe to dispose it.
+     *
+     *  Throws an exception if `col` is of wrong type, it is safe to use original col in this case.
+     *  This is a static method to make such conversion verbose.
+     */
+    static auto Wrap(ColumnDecimal&& col) {
+        auto data = col.data_->template AsStrict<DataColumnType>();
+        return std::shared_ptr<ColumnDecimalT<T>>(new ColumnDecimalT<T>(col.Type(), std::move(data)));
+    }
+
+    static auto Wrap(Column&& col) { return Wrap(std::move(dynamic_cast<ColumnDecimal&&>(col))); }
+
+    // Helper to simplify integration with other APIs
+    static auto Wrap(ColumnRef&& col) { return Wrap(std::move(*col->AsStrict<ColumnDecimal>())); }
+
+    ColumnRef Slice(size_t begin, size_t len) const override { return Wrap(ColumnDecimal::Slice(begin, len)); }
+    ColumnRef CloneEmpty() const override { return Wrap(ColumnDecimal::CloneEmpty()); }
+
+    void Swap(Column& other) override {
+        auto & col = dynamic_cast<ColumnDecimalT<T> &>(other);
+        typed_data_.swap(col.typed_data_);
+        ColumnDecimal::Swap(other);
+    }
+
+private:
+    ColumnDecimalT(TypeRef type, std::shared_ptr<DataColumnType> data)
+        : ColumnDecimal(std::move(type), data)
+        , typed_data_(std::move(data))
+    {}
+
+    static size_t ValidatePrecision(size_t precision) {
+        static_assert(std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>
+                || std::is_same_v<T, Int128> || std::is_same_v<T, Int256>,
+                "ColumnDecimalT supports only Int32, Int64, Int128 and Int256 storage");
+
+        const auto [min_precision, max_precision] = std::is_same_v<T, int32_t> ? std::make_pair(1u, 9u)
+                : std::is_same_v<T, int64_t> ? std::make_pair(10u, 18u)
+                : std::is_same_v<T, Int128> ? std::make_pair(19u, 38u) : std::make_pair(39u, 76u);
+        if (precision < min_precision || precision > max_precision) {
+            throw ValidationError("Decimal precision " + std::to_string(precision) + " doesn't match storage, expected "
+                    + std::to_string(min_precision) + " to " + std::to_string(max_precision));
+        }
+
+        return precision;
+    }
+
+    std::shared_ptr<DataColumnType> typed_data_;
+};
+
+using ColumnDecimal32 = ColumnDecimalT<int32_t>;
+using ColumnDecimal64 = ColumnDecimalT<int64_t>;
+using ColumnDecimal128 = ColumnDecimalT<Int128>;
+using ColumnDecimal256 = ColumnDecimalT<Int256>;
+
 }
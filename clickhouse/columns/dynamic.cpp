@@ -0,0 +1,243 @@
+#include "dynamic.h"
+#include "factory.h"
+#include "string.h"
+
+#include "../base/wire_format.h"
+
+#include <algorithm>
+
+namespace {
+using namespace clickhouse;
+
+// Versions of serialization of the structure of the column, the first value of the prefix.
+enum StructureSerializationVersion : uint64_t {
+    // Followed by max_types, which is ignored.
+    V1 = 1,
+    V2 = 2,
+};
+
+ColumnRef CreateVariantColumn(const std::string & type_name) {
+    if (type_name == ColumnDynamic::SharedVariantName) {
+        return std::make_shared<ColumnString>();
+    }
+
+    auto column = CreateColumnByType(type_name);
+    if (!column) {
+        throw UnimplementedError("Unsupported type in Dynamic column: " + type_name);
+    }
+    return column;
+}
+
+std::shared_ptr<ColumnVariant> CreateVariant(const std::vector<std::string> & type_names) {
+    std::vector<ColumnRef> variants;
+    variants.reserve(type_names.size());
+    for (const auto & name : type_names) {
+        variants.push_back(CreateVariantColumn(name));
+    }
+    return std::make_shared<ColumnVariant>(std::move(variants));
+}
+
+}
+
+namespace clickhouse {
+
+ColumnDynamic::ColumnDynamic(size_t max_types)
+    : Column(Type::CreateDynamic(max_types))
+    , variant_names_{SharedVariantName}
+    , variant_(CreateVariant(variant_names_))
+{
+}
+
+size_t ColumnDynamic::GetMaxTypes() const {
+    return type_->As<DynamicType>()->GetMaxTypes();
+}
+
+uint8_t ColumnDynamic::FindVariant(const std::string& type_name) const {
+    const auto it = std::lower_bound(variant_names_.begin(), variant_names_.end(), type_name);
+    if (it == variant_names_.end() || *it != type_name) {
+        return ColumnVariant::NullDiscriminator;
+    }
+    return static_cast<uint8_t>(it - variant_names_.begin());
+}
+
+void ColumnDynamic::AppendNull() {
+    variant_->AppendNull();
+}
+
+ColumnRef ColumnDynamic::AppendToType(const std::string& type_name) {
+    auto discriminator = FindVariant(type_name);
+    if (discriminator == ColumnVariant::NullDiscriminator) {
+        auto names = variant_names_;
+        names.push_back(type_name);
+        SetVariantNames(std::move(names));
+        discriminator = FindVariant(type_name);
+    }
+    return variant_->AppendToVariant(discriminator);
+}
+
+void ColumnDynamic::SetVariantNames(std::vector<std::string> type_names) {
+    std::sort(type_names.begin(), type_names.end());
+    type_names.erase(std::unique(type_names.begin(), type_names.end()), type_names.end());
+    if (type_names.size() > GetMaxTypes() + 1) {
+        throw ValidationError("Too many types in " + type_->GetName() + ", at most " + std::to_string(GetMaxTypes()) + " are allowed");
+    }
+
+    std::vector<ColumnRef> variants;
+    variants.reserve(type_names.size());
+    for (const auto & name : type_names) {
+        const auto discriminator = FindVariant(name);
+        variants.push_back(discriminator == ColumnVariant::NullDiscriminator
+                ? CreateVariantColumn(name)
+                : variant_->GetVariant(discriminator)->CloneEmpty());
+    }
+    auto result = std::make_shared<ColumnVariant>(std::move(variants));
+
+    std::vector<uint8_t> mapping(variant_names_.size());
+    for (size_t i = 0; i < variant_names_.size(); ++i) {
+        const auto it = std::lower_bound(type_names.begin(), type_names.end(), variant_names_[i]);
+        mapping[i] = static_cast<uint8_t>(it - type_names.begin());
+        result->variants_[mapping[i]]->Swap(*variant_->variants_[i]);
+    }
+
+    result->discriminators_ = std::move(variant_->discriminators_);
+    result->offsets_ = std::move(variant_->offsets_);
+    for (auto & discriminator : result->discriminators_) {
+        if (discriminator != ColumnVariant::NullDiscriminator) {
+            discriminator = mapping[discriminator];
+        }
+    }
+
+    variant_names_ = std::move(type_names);
+    variant_ = std::move(result);
+}
+
+void ColumnDynamic::Reserve(size_t new_cap) {
+    variant_->Reserve(new_cap);
+}
+
+void ColumnDynamic::Append(ColumnRef column) {
+    const auto col = column->As<ColumnDynamic>();
+    if (!col) {
+        throw ValidationError("Can't append " + column->Type()->GetName() + " to " + type_->GetName());
+    }
+
+    auto names = variant_names_;
+    names.insert(names.end(), col->variant_names_.begin(), col->variant_names_.end());
+    SetVariantNames(std::move(names));
+
+    std::vector<uint8_t> mapping(col->variant_names_.size());
+    for (size_t i = 0; i < mapping.size(); ++i) {
+        mapping[i] = FindVariant(col->variant_names_[i]);
+    }
+
+    std::vector<uint8_t> discriminators(col->variant_->discriminators_);
+    for (auto & discriminator : discriminators) {
+        if (discriminator != ColumnVariant::NullDiscriminator) {
+            discriminator = mapping[discriminator];
+        }
+    }
+
+    std::vector<size_t> sizes;
+    sizes.reserve(variant_->variants_.size());
+    for (const auto & variant : variant_->variants_) {
+        sizes.push_back(variant->Size());
+    }
+
+    for (size_t i = 0; i < mapping.size(); ++i) {
+        variant_->variants_[mapping[i]]->Append(col->variant_->variants_[i]);
+    }
+    variant_->AppendDiscriminators(discriminators, sizes);
+}
+
+bool ColumnDynamic::LoadPrefix(InputStream* input, size_t rows) {
+    uint64_t version;
+    if (!WireFormat::ReadFixed(*input, &version)) {
+        return false;
+    }
+    if (version != V1 && version != V2) {
+        throw UnimplementedError("Serialization version " + std::to_string(version) + " of Dynamic column is not supported");
+    }
+
+    uint64_t max_types;
+    if (version == V1 && !WireFormat::ReadVarint64(*input, &max_types)) {
+        return false;
+    }
+
+    uint64_t count;
+    if (!WireFormat::ReadVarint64(*input, &count)) {
+        return false;
+    }
+    if (count > 254) {
+        throw ProtocolError("Too many types in Dynamic column: " + std::to_string(count));
+    }
+
+    std::vector<std::string> names(count);
+    for (auto & name : names) {
+        if (!WireFormat::ReadString(*input, &name)) {
+            return false;
+        }
+    }
+    names.push_back(SharedVariantName);
+    std::sort(names.begin(), names.end());
+
+    variant_ = CreateVariant(names);
+    variant_names_ = std::move(names);
+
+    return variant_->LoadPrefix(input, rows);
+}
+
+bool ColumnDynamic::LoadBody(InputStream* input, size_t rows) {
+    return variant_->LoadBody(input, rows);
+}
+
+void ColumnDynamic::SavePrefix(OutputStream* output) {
+    WireFormat::WriteFixed<uint64_t>(*output, V1);
+    WireFormat::WriteVarint64(*output, GetMaxTypes());
+    WireFormat::WriteVarint64(*output, variant_names_.size() - 1);
+    for (const auto & name : variant_names_) {
+        if (name != SharedVariantName) {
+            WireFormat::WriteString(*output, name);
+        }
+    }
+
+    variant_->SavePrefix(output);
+}
+
+void ColumnDynamic::SaveBody(OutputStream* output) {
+    variant_->SaveBody(output);
+}
+
+void ColumnDynamic::Clear() {
+    variant_->Clear();
+}
+
+size_t ColumnDynamic::Size() const {
+    return variant_->Size();
+}
+
+ColumnRef ColumnDynamic::Slice(size_t begin, size_t len) const {
+    auto result = std::make_shared<ColumnDynamic>(GetMaxTypes());
+    result->variant_names_ = variant_names_;
+    result->variant_ = std::static_pointer_cast<ColumnVariant>(variant_->Slice(begin, len));
+    return result;
+}
+
+ColumnRef ColumnDynamic::CloneEmpty() const {
+    auto result = std::make_shared<ColumnDynamic>(GetMaxTypes());
+    result->variant_names_ = variant_names_;
+    result->variant_ = std::static_pointer_cast<ColumnVariant>(variant_->CloneEmpty());
+    return result;
+}
+
+void ColumnDynamic::Swap(Column& other) {
+    auto & col = dynamic_cast<ColumnDynamic &>(other);
+    type_.swap(col.type_);
+    variant_names_.swap(col.variant_names_);
+    variant_.swap(col.variant_);
+}
+
+ItemView ColumnDynamic::GetItem(size_t index) const {
+    return variant_->GetItem(index);
+}
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "column.h"
+#include "variant.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clickhouse {
+
+/**
+ * Represents column of Dynamic type.
+ *
+ * Values are stored in a Variant of types present in the column, sorted by type name like in ClickHouse,
+ * plus SharedVariant, which holds values of types beyond max_types as String
+ * in ClickHouse binary encoding of type and value, exposed as is.
+ */
+class ColumnDynamic : public Column {
+public:
+    /// Type name of the variant of values of types beyond max_types.
+    static constexpr const char* SharedVariantName = "SharedVariant";
+
+    explicit ColumnDynamic(size_t max_types = DynamicType::DefaultMaxTypes);
+
+    /// Returns column of values and discriminators of rows.
+    inline std::shared_ptr<ColumnVariant> GetVariantColumn() const { return variant_; }
+
+    /// Returns type names of variants, index of a name is the discriminator of its values in GetVariantColumn().
+    inline const std::vector<std::string>& GetVariantNames() const { return variant_names_; }
+
+    /// Returns discriminator of the variant of given type, ColumnVariant::NullDiscriminator if there is none.
+    uint8_t FindVariant(const std::string& type_name) const;
+
+    /// Appends NULL row.
+    void AppendNull();
+
+    /** Appends row of given type and returns column of values of the type,
+     *  the value of the row must be appended to the returned column right after, e.g.
+     *  `col.AppendToType("UInt64")->As<ColumnUInt64>()->Append(1);`
+     *
+     *  Adding a new type changes discriminators of other types and copies discriminators of all rows.
+     *  Throws ValidationError if the type is not supported or if there would be more than max_types types.
+     */
+    ColumnRef AppendToType(const std::string& type_name);
+
+public:
+    /// Increase the capacity of the column for large block insertion.
+    void Reserve(size_t new_cap) override;
+
+    /// Appends content of given column to the end of current one, adding its types.
+    void Append(ColumnRef column) override;
+
+    /// Loads column prefix from input stream.
+    bool LoadPrefix(InputStream* input, size_t rows) override;
+
+    /// Loads column data from input stream.
+    bool LoadBody(InputStream* input, size_t rows) override;
+
+    /// Saves column prefix to output stream.
+    void SavePrefix(OutputStream* output) override;
+
+    /// Saves column data to output stream.
+    void SaveBody(OutputStream* output) override;
+
+    /// Clear column data .
+    void Clear() override;
+
+    /// Returns count of rows in the column.
+    size_t Size() const override;
+
+    /// Makes slice of the current column.
+    ColumnRef Slice(size_t begin, size_t len) const override;
+    ColumnRef CloneEmpty() const override;
+    void Swap(Column&) override;
+
+    ItemView GetItem(size_t) const override;
+
+private:
+    /// Replaces variants with ones of given types, keeping values of rows; `type_names` must include all current types.
+    void SetVariantNames(std::vector<std::string> type_names);
+
+    /// Maximum number of types stored as separate variants.
+    size_t GetMaxTypes() const;
+
+private:
+    std::vector<std::string> variant_names_;
+    std::shared_ptr<ColumnVariant> variant_;
+};
+
+}
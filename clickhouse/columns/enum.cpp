@@ -40,6 +40,17 @@ void ColumnEnum<T>::Append(const std::string& name) {
     data_.push_back(static_cast<T>(type_->As<EnumType>()->GetEnumValue(name)));
 }
 
+template <typename T>
+void ColumnEnum<T>::AppendMany(Span<const T> values) {
+    AppendToVector(data_, values);
+}
+
+template <typename T>
+void ColumnEnum<T>::CopyTo(Span<T> dest, size_t begin) const {
+    ValidateCopyToRange(data_.size(), begin, dest.size());
+    std::copy_n(data_.begin() + begin, dest.size(), dest.begin());
+}
+
 template <typename T>
 void ColumnEnum<T>::Clear() {
     data_.clear();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "column.h"
+#include "../base/span.h"
 
 namespace clickhouse {
 
@@ -18,6 +19,9 @@ public:
     void Append(const T& value, bool checkValue = false);
     void Append(const std::string& name);
 
+    /// Appends all elements of `values` to the end of column, values are not checked.
+    void AppendMany(Span<const T> values);
+
     /// Returns element at given row number.
     const T& At(size_t n) const;
     std::string_view NameAt(size_t n) const;
@@ -25,6 +29,12 @@ public:
     /// Returns element at given row number.
     inline const T& operator[] (size_t n) const { return At(n); }
 
+    /// Read-only view on column contents, invalidated by any modification of the column.
+    inline Span<const T> GetData() const { return Span<const T>(data_.data(), data_.size()); }
+
+    /// Copies `dest.size()` elements starting at row `begin` into `dest`.
+    void CopyTo(Span<T> dest, size_t begin = 0) const;
+
     /// Set element at given row number.
     void SetAt(size_t n, const T& value, bool checkValue = false);
     void SetNameAt(size_t n, const std::string& name);
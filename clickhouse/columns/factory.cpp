@@ -1,13 +1,16 @@
 #include "factory.h"
 
+#include "aggregate_function.h"
 #include "array.h"
 #include "date.h"
 #include "decimal.h"
+#include "dynamic.h"
 #include "enum.h"
 #include "geo.h"
 #include "ip4.h"
 #include "ip6.h"
 #include "ix-json.h"
+#include "json.h"
 #include "lowcardinality.h"
 #include "lowcardinalityadaptor.h"
 #include "map.h"
@@ -17,14 +20,19 @@
 #include "string.h"
 #include "tuple.h"
 #include "uuid.h"
+#include "variant.h"
 
 
+#include "../base/text_codec.h"
 #include "../types/type_parser.h"
 
 #include "../exceptions.h"
 
+#include <cctype>
+#include <limits>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 namespace clickhouse {
 namespace {
@@ -44,7 +52,9 @@ const auto& GetASTChildElement(const TypeAst & ast, int position) {
     return ast.elements[static_cast<size_t>(position)];
 }
 
-static ColumnRef CreateTerminalColumn(const TypeAst& ast) {
+ColumnRef CreateJSONColumn(std::string_view type_name, CreateColumnByTypeSettings settings);
+
+static ColumnRef CreateTerminalColumn(const TypeAst& ast, CreateColumnByTypeSettings settings) {
     switch (ast.code) {
     case Type::Void:
         return std::make_shared<ColumnNothing>();
@@ -57,6 +67,10 @@ static ColumnRef CreateTerminalColumn(const TypeAst& ast) {
         return std::make_shared<ColumnUInt32>();
     case Type::UInt64:
         return std::make_shared<ColumnUInt64>();
+    case Type::UInt128:
+        return std::make_shared<ColumnUInt128>();
+    case Type::UInt256:
+        return std::make_shared<ColumnUInt256>();
 
     case Type::Int8:
         return std::make_shared<ColumnInt8>();
@@ -68,7 +82,11 @@ static ColumnRef CreateTerminalColumn(const TypeAst& ast) {
         return std::make_shared<ColumnInt64>();
     case Type::Int128:
         return std::make_shared<ColumnInt128>();
+    case Type::Int256:
+        return std::make_shared<ColumnInt256>();
 
+    case Type::BFloat16:
+        return std::make_shared<ColumnBFloat16>();
     case Type::Float32:
         return std::make_shared<ColumnFloat32>();
     case Type::Float64:
@@ -82,6 +100,8 @@ static ColumnRef CreateTerminalColumn(const TypeAst& ast) {
         return std::make_shared<ColumnDecimal>(18, GetASTChildElement(ast, 0).value);
     case Type::Decimal128:
         return std::make_shared<ColumnDecimal>(38, GetASTChildElement(ast, 0).value);
+    case Type::Decimal256:
+        return std::make_shared<ColumnDecimal>(76, GetASTChildElement(ast, 0).value);
 
     case Type::String:
         return std::make_shared<ColumnString>();
@@ -131,28 +151,60 @@ static ColumnRef CreateTerminalColumn(const TypeAst& ast) {
     case Type::IxJson:
         return std::make_shared<ColumnIxJson>();
 
+    case Type::Dynamic:
+        // Dynamic(max_types=N) is parsed into elements `max_types` and N.
+        if (ast.elements.size() == 2 && ast.elements[0].name == "max_types") {
+            return std::make_shared<ColumnDynamic>(ast.elements[1].value);
+        }
+        return ast.elements.empty() ? std::make_shared<ColumnDynamic>() : nullptr;
+
+    case Type::JSON:
+        if (!settings.native_json) {
+            return std::make_shared<ColumnIxJson>();
+        }
+        // Arguments of JSON are kept as raw text by TypeParser.
+        return CreateJSONColumn(ast.value_string, settings);
+
     default:
         return nullptr;
     }
 }
 
+static ColumnRef CreateColumnFromAst(const TypeAst& ast, CreateColumnByTypeSettings settings);
+
+// Dictionary column is created from AST to preserve type parameters, like Enum items or DateTime timezone.
+template <typename DictionaryColumnType>
+static ColumnRef CreateLowCardinalityColumn(const TypeAst& nested, CreateColumnByTypeSettings settings) {
+    auto dictionary = CreateColumnFromAst(nested, settings);
+    if (!dictionary)
+        return nullptr;
+
+    return std::make_shared<ColumnLowCardinalityT<DictionaryColumnType>>(dictionary->AsStrict<DictionaryColumnType>());
+}
+
 static ColumnRef CreateColumnFromAst(const TypeAst& ast, CreateColumnByTypeSettings settings) {
     switch (ast.meta) {
         case TypeAst::Array: {
-            return std::make_shared<ColumnArray>(
-                CreateColumnFromAst(GetASTChildElement(ast, 0), settings)
-            );
+            auto nested = CreateColumnFromAst(GetASTChildElement(ast, 0), settings);
+            if (!nested)
+                return nullptr;
+
+            return std::make_shared<ColumnArray>(nested);
         }
 
         case TypeAst::Nullable: {
+            auto nested = CreateColumnFromAst(GetASTChildElement(ast, 0), settings);
+            if (!nested)
+                return nullptr;
+
             return std::make_shared<ColumnNullable>(
-                CreateColumnFromAst(GetASTChildElement(ast, 0), settings),
+                nested,
                 std::make_shared<ColumnUInt8>()
             );
         }
 
         case TypeAst::Terminal: {
-            return CreateTerminalColumn(ast);
+            return CreateTerminalColumn(ast, settings);
         }
 
         case TypeAst::Tuple: {
@@ -225,13 +277,49 @@ static ColumnRef CreateColumnFromAst(const TypeAst& ast, CreateColumnByTypeSetti
                                 std::make_shared<ColumnUInt8>()
                             )
                         );
+
+                    case Type::Int8:
+                        return CreateLowCardinalityColumn<ColumnInt8>(nested, settings);
+                    case Type::Int16:
+                        return CreateLowCardinalityColumn<ColumnInt16>(nested, settings);
+                    case Type::Int32:
+                        return CreateLowCardinalityColumn<ColumnInt32>(nested, settings);
+                    case Type::Int64:
+                        return CreateLowCardinalityColumn<ColumnInt64>(nested, settings);
+                    case Type::Int128:
+                        return CreateLowCardinalityColumn<ColumnInt128>(nested, settings);
+                    case Type::UInt8:
+                        return CreateLowCardinalityColumn<ColumnUInt8>(nested, settings);
+                    case Type::UInt16:
+                        return CreateLowCardinalityColumn<ColumnUInt16>(nested, settings);
+                    case Type::UInt32:
+                        return CreateLowCardinalityColumn<ColumnUInt32>(nested, settings);
+                    case Type::UInt64:
+                        return CreateLowCardinalityColumn<ColumnUInt64>(nested, settings);
+                    case Type::Float32:
+                        return CreateLowCardinalityColumn<ColumnFloat32>(nested, settings);
+                    case Type::Float64:
+                        return CreateLowCardinalityColumn<ColumnFloat64>(nested, settings);
+                    case Type::Date:
+                        return CreateLowCardinalityColumn<ColumnDate>(nested, settings);
+                    case Type::Date32:
+                        return CreateLowCardinalityColumn<ColumnDate32>(nested, settings);
+                    case Type::DateTime:
+                        return CreateLowCardinalityColumn<ColumnDateTime>(nested, settings);
+                    case Type::DateTime64:
+                        return CreateLowCardinalityColumn<ColumnDateTime64>(nested, settings);
+                    case Type::Enum8:
+                        return CreateLowCardinalityColumn<ColumnEnum8>(nested, settings);
+                    case Type::Enum16:
+                        return CreateLowCardinalityColumn<ColumnEnum16>(nested, settings);
+
                     default:
                         throw UnimplementedError("LowCardinality(" + nested.name + ") is not supported");
                 }
             }
         }
         case TypeAst::SimpleAggregateFunction: {
-            return CreateTerminalColumn(GetASTChildElement(ast, -1));
+            return CreateTerminalColumn(GetASTChildElement(ast, -1), settings);
         }
 
         case TypeAst::Map: {
@@ -255,6 +343,21 @@ static ColumnRef CreateColumnFromAst(const TypeAst& ast, CreateColumnByTypeSetti
                     std::make_shared<ColumnTuple>(columns)));
         }
 
+        case TypeAst::Variant: {
+            std::vector<ColumnRef> columns;
+
+            columns.reserve(ast.elements.size());
+            for (const auto& elem : ast.elements) {
+                if (auto col = CreateColumnFromAst(elem, settings)) {
+                    columns.push_back(col);
+                } else {
+                    return nullptr;
+                }
+            }
+
+            return std::make_shared<ColumnVariant>(columns);
+        }
+
         case TypeAst::Assign:
         case TypeAst::Null:
         case TypeAst::Number:
@@ -265,10 +368,147 @@ static ColumnRef CreateColumnFromAst(const TypeAst& ast, CreateColumnByTypeSetti
     return nullptr;
 }
 
+std::string_view TrimSpaces(std::string_view value) {
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.front())))
+        value.remove_prefix(1);
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back())))
+        value.remove_suffix(1);
+    return value;
+}
+
+// Splits arguments of a type by top-level commas, respecting parentheses, quotes and back quotes.
+std::vector<std::string_view> SplitTypeArguments(std::string_view arguments) {
+    std::vector<std::string_view> result;
+    size_t depth = 0;
+    char quote = 0;
+    size_t begin = 0;
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        const char c = arguments[i];
+        if (quote) {
+            if (c == '\\')
+                ++i;
+            else if (c == quote)
+                quote = 0;
+        } else if (c == '\'' || c == '`') {
+            quote = c;
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            --depth;
+        } else if (c == ',' && depth == 0) {
+            result.push_back(TrimSpaces(arguments.substr(begin, i - begin)));
+            begin = i + 1;
+        }
+    }
+    result.push_back(TrimSpaces(arguments.substr(begin)));
+    return result;
+}
+
+// Typed paths of JSON are not type names, so JSON with arguments is parsed here instead of TypeParser,
+// e.g. JSON(max_dynamic_paths=10, a.b UInt32, `c d` String, SKIP e, SKIP REGEXP 'f.*').
+ColumnRef CreateJSONColumn(std::string_view type_name, CreateColumnByTypeSettings settings) {
+    if (type_name == "JSON")
+        return std::make_shared<ColumnJSON>();
+    if (type_name.back() != ')')
+        return nullptr;
+    type_name.remove_suffix(1);
+
+    std::vector<ColumnJSON::PathColumn> typed_paths;
+    size_t max_dynamic_paths = JSONType::DefaultMaxDynamicPaths;
+    size_t max_dynamic_types = DynamicType::DefaultMaxTypes;
+    std::vector<std::string> skip;
+
+    for (const auto argument : SplitTypeArguments(type_name.substr(type_name.find('(') + 1))) {
+        if (argument.empty())
+            return nullptr;
+
+        const auto assign = argument.find('=');
+        if (argument.front() != '`' && assign != std::string_view::npos) {
+            const auto name = TrimSpaces(argument.substr(0, assign));
+            if (name != "max_dynamic_paths" && name != "max_dynamic_types")
+                return nullptr;
+
+            const auto value_text = TrimSpaces(argument.substr(assign + 1));
+            uint64_t value = 0;
+            if (!ParseUInt64(value_text, value) || value > std::numeric_limits<size_t>::max()) {
+                throw ValidationError("Invalid value of " + std::string(name) + " in " + std::string(type_name) + "): "
+                        + std::string(value_text));
+            }
+            (name == "max_dynamic_paths" ? max_dynamic_paths : max_dynamic_types) = static_cast<size_t>(value);
+            continue;
+        }
+
+        if (argument.substr(0, 5) == "SKIP ") {
+            skip.emplace_back(TrimSpaces(argument.substr(5)));
+            continue;
+        }
+
+        std::string path;
+        std::string_view type;
+        if (argument.front() == '`') {
+            const auto end = argument.find('`', 1);
+            if (end == std::string_view::npos)
+                return nullptr;
+            path = argument.substr(1, end - 1);
+            type = TrimSpaces(argument.substr(end + 1));
+        } else {
+            const auto end = argument.find(' ');
+            if (end == std::string_view::npos)
+                return nullptr;
+            path = argument.substr(0, end);
+            type = TrimSpaces(argument.substr(end + 1));
+        }
+
+        auto column = CreateColumnByType(std::string(type), settings);
+        if (!column)
+            return nullptr;
+        typed_paths.emplace_back(std::move(path), std::move(column));
+    }
+
+    return std::make_shared<ColumnJSON>(std::move(typed_paths), max_dynamic_paths, max_dynamic_types, std::move(skip));
+}
+
+// Parameters of aggregate functions are not type names, so AggregateFunction is parsed here instead of TypeParser,
+// e.g. AggregateFunction(quantileTDigest(0.9), Float64).
+ColumnRef CreateAggregateFunctionColumn(std::string_view type_name, CreateColumnByTypeSettings settings) {
+    if (type_name.back() != ')')
+        return nullptr;
+    type_name.remove_suffix(1);
+
+    const auto arguments = SplitTypeArguments(type_name.substr(type_name.find('(') + 1));
+    auto function = arguments.front();
+    std::vector<std::string> parameters;
+    if (const auto open = function.find('('); open != std::string_view::npos) {
+        if (function.back() != ')')
+            return nullptr;
+        for (const auto parameter : SplitTypeArguments(function.substr(open + 1, function.size() - open - 2)))
+            parameters.emplace_back(parameter);
+        function = TrimSpaces(function.substr(0, open));
+    }
+
+    std::vector<TypeRef> argument_types;
+    for (size_t i = 1; i < arguments.size(); ++i) {
+        auto column = CreateColumnByType(std::string(arguments[i]), settings);
+        if (!column)
+            return nullptr;
+        argument_types.push_back(column->Type());
+    }
+
+    auto type = Type::CreateAggregateFunction(std::string(function), std::move(argument_types), std::move(parameters));
+    if (!ColumnAggregateFunction::IsSupported(*type->As<AggregateFunctionType>()))
+        return nullptr;
+
+    return std::make_shared<ColumnAggregateFunction>(std::move(type));
+}
+
 } // namespace
 
 
 ColumnRef CreateColumnByType(const std::string& type_name, CreateColumnByTypeSettings settings) {
+    if (type_name.compare(0, 18, "AggregateFunction(") == 0) {
+        return CreateAggregateFunctionColumn(type_name, settings);
+    }
+
     auto ast = ParseTypeName(type_name);
     if (ast != nullptr) {
         return CreateColumnFromAst(*ast, settings);
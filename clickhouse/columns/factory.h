@@ -7,6 +7,9 @@ namespace clickhouse {
 struct CreateColumnByTypeSettings
 {
     bool low_cardinality_as_wrapped_column = false;
+    /// Create ColumnJSON for JSON types, which decodes the native JSON serialization.
+    /// By default JSON is created as ColumnIxJson, which holds rows as JSON text.
+    bool native_json = false;
 };
 
 ColumnRef CreateColumnByType(const std::string& type_name, CreateColumnByTypeSettings settings = {});
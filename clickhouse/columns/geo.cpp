@@ -54,6 +54,38 @@ const typename ColumnGeo<NestedColumnType, type_code>::ValueType ColumnGeo<Neste
     return data_->At(n);
 }
 
+template <typename NestedColumnType, Type::Code type_code>
+Span<const double> ColumnGeo<NestedColumnType, type_code>::GetX() const {
+    if constexpr (type_code == Type::Code::Point) {
+        return data_->ColumnTuple::At(0)->template AsStrict<ColumnFloat64>()->GetData();
+    } else {
+        return data_->GetNestedColumn().GetX();
+    }
+}
+
+template <typename NestedColumnType, Type::Code type_code>
+Span<const double> ColumnGeo<NestedColumnType, type_code>::GetY() const {
+    if constexpr (type_code == Type::Code::Point) {
+        return data_->ColumnTuple::At(1)->template AsStrict<ColumnFloat64>()->GetData();
+    } else {
+        return data_->GetNestedColumn().GetY();
+    }
+}
+
+template <typename NestedColumnType, Type::Code type_code>
+Span<const uint64_t> ColumnGeo<NestedColumnType, type_code>::GetOffsets(size_t level) const {
+    if (level >= NestingDepth) {
+        throw ValidationError("Offsets level " + std::to_string(level) + " is out of range for " + GetType().GetName()
+                + ", nesting depth is " + std::to_string(NestingDepth));
+    }
+
+    if constexpr (type_code == Type::Code::Point) {
+        return {};
+    } else {
+        return level == 0 ? data_->GetOffsets() : data_->GetNestedColumn().GetOffsets(level - 1);
+    }
+}
+
 template<typename NestedColumnType, Type::Code type_code>
 void ColumnGeo<NestedColumnType, type_code>::Reserve(size_t new_cap) {
     data_->Reserve(new_cap);
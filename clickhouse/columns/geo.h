@@ -12,6 +12,12 @@ class ColumnGeo : public Column {
 public:
     using ValueType = typename NestedColumnType::ValueType;
 
+    /// Levels of arrays above points: 0 for Point, 1 for Ring, 2 for Polygon and 3 for MultiPolygon.
+    static constexpr size_t NestingDepth = type_code == Type::Code::Point ? 0
+            : type_code == Type::Code::Ring ? 1
+            : type_code == Type::Code::Polygon ? 2
+            : 3;
+
     ColumnGeo();
 
     explicit ColumnGeo(ColumnRef data);
@@ -28,6 +34,21 @@ public:
     /// Returns element at given row number.
     inline const ValueType operator[](size_t n) const { return At(n); }
 
+    /** Read-only views on coordinates of all points of the column, both of the same size, no data is copied.
+     *  Rows of Point column are points, points of other columns are addressed with GetOffsets().
+     *  Invalidated by any modification of the column.
+     */
+    Span<const double> GetX() const;
+    Span<const double> GetY() const;
+
+    /** End offsets of arrays at nesting `level`, 0 being the rows of the column:
+     *  item `i` of the level spans items [offsets[i - 1], offsets[i]) of the next level, or points at the deepest level.
+     *  E.g. rings of row `n` of a Polygon column are [GetOffsets(0)[n - 1], GetOffsets(0)[n]),
+     *  and points of ring `r` are [GetOffsets(1)[r - 1], GetOffsets(1)[r]), the first item of each level starts at 0.
+     *  Throws ValidationError if `level` is not less than NestingDepth.
+     */
+    Span<const uint64_t> GetOffsets(size_t level) const;
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -1,6 +1,9 @@
 #include "ip4.h"
+#include "string.h"
+#include "utils.h"
 
 #include "../base/socket.h" // for platform-specific IPv4-related functions
+#include "../base/text_codec.h"
 #include <stdexcept>
 
 namespace clickhouse {
@@ -43,6 +46,17 @@ void ColumnIPv4::Append(in_addr ip) {
     data_->Append(htonl(ip.s_addr));
 }
 
+void ColumnIPv4::AppendMany(Span<const uint32_t> ips) {
+    auto & data = data_->GetWritableData();
+    const auto old_size = data.size();
+    data.resize(old_size + ips.size());
+
+    uint32_t * dest = data.data() + old_size;
+    for (size_t i = 0; i < ips.size(); ++i) {
+        dest[i] = htonl(ips[i]);
+    }
+}
+
 void ColumnIPv4::Clear() {
     data_->Clear();
 }
@@ -74,6 +88,20 @@ std::string ColumnIPv4::AsString(size_t n) const {
     return ip_str;
 }
 
+void ColumnIPv4::AppendFromStrings(const ColumnString& strings) {
+    AppendParsedStrings(strings.GetData(), data_->GetWritableData(), [](std::string_view str, uint32_t & value) {
+        if (!ParseIPv4(str, value))
+            throw ValidationError("invalid IPv4 format, ip: " + std::string(str));
+    });
+}
+
+void ColumnIPv4::FormatToStrings(ColumnString& dest) const {
+    const uint32_t * data = data_->GetData().data();
+    FormatToStringColumn<MaxIPv4TextSize>(dest, Size(), [data](size_t row, char * out) {
+        return FormatIPv4(data[row], out);
+    });
+}
+
 void ColumnIPv4::Reserve(size_t new_cap) {
     data_->Reserve(new_cap);
 }
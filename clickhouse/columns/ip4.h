@@ -6,6 +6,8 @@ struct in_addr;
 
 namespace clickhouse {
 
+class ColumnString;
+
 class ColumnIPv4 : public Column {
 public:
     using DataType = in_addr;
@@ -30,6 +32,9 @@ public:
     ///
     void Append(in_addr ip);
 
+    /// Appends all elements of `ips`, numeric values with host byte order.
+    void AppendMany(Span<const uint32_t> ips);
+
     /// Returns element at given row number.
     in_addr At(size_t n) const;
 
@@ -38,6 +43,13 @@ public:
 
     std::string AsString(size_t n) const;
 
+    /// Appends all elements of `strings` parsed as dotted quads, throws ValidationError if any of them is malformed
+    /// and leaves the column unchanged in that case.
+    void AppendFromStrings(const ColumnString& strings);
+
+    /// Appends text of all elements of the column to `dest`, same as AsString().
+    void FormatToStrings(ColumnString& dest) const;
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -1,5 +1,8 @@
 #include "ip6.h"
+#include "utils.h"
+
 #include "../base/socket.h" // for IPv6 platform-specific stuff
+#include "../base/text_codec.h"
 #include "../exceptions.h"
 
 #include <stdexcept>
@@ -38,6 +41,30 @@ void ColumnIPv6::Append(const in6_addr& addr) {
     Append(&addr);
 }
 
+void ColumnIPv6::AppendMany(Span<const in6_addr> addrs) {
+    std::vector<std::string_view> items;
+    items.reserve(addrs.size());
+    for (const auto & addr : addrs) {
+        items.emplace_back(reinterpret_cast<const char*>(addr.s6_addr), sizeof(addr.s6_addr));
+    }
+    data_->AppendMany(items);
+}
+
+void ColumnIPv6::AppendFromStrings(const ColumnString& strings) {
+    std::vector<in6_addr> addrs;
+    AppendParsedStrings(strings.GetData(), addrs, [](std::string_view str, in6_addr & addr) {
+        if (!ParseIPv6(str, addr.s6_addr))
+            throw ValidationError("invalid IPv6 format, ip: " + std::string(str));
+    });
+    AppendMany(addrs);
+}
+
+void ColumnIPv6::FormatToStrings(ColumnString& dest) const {
+    FormatToStringColumn<MaxIPv6TextSize>(dest, Size(), [this](size_t row, char * out) {
+        return FormatIPv6(reinterpret_cast<const uint8_t*>(data_->At(row).data()), out);
+    });
+}
+
 void ColumnIPv6::Clear() {
     data_->Clear();
 }
@@ -26,6 +26,9 @@ public:
     void Append(const in6_addr* addr);
     void Append(const in6_addr& addr);
 
+    /// Appends all elements of `addrs` to the column.
+    void AppendMany(Span<const in6_addr> addrs);
+
     /// Returns element at given row number.
     in6_addr At(size_t n) const;
 
@@ -34,6 +37,13 @@ public:
 
     std::string AsString(size_t n) const;
 
+    /// Appends all elements of `strings` parsed as IPv6 addresses, throws ValidationError if any of them is malformed
+    /// and leaves the column unchanged in that case.
+    void AppendFromStrings(const ColumnString& strings);
+
+    /// Appends text of all elements of the column to `dest`, same as AsString().
+    void FormatToStrings(ColumnString& dest) const;
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -48,6 +48,7 @@ void ItemView::ValidateData(Type::Code type, DataType data) {
 
         case Type::Code::Int16:
         case Type::Code::UInt16:
+        case Type::Code::BFloat16:
         case Type::Code::Date:
         case Type::Code::Enum16:
             return AssertSize({2});
@@ -78,17 +79,27 @@ void ItemView::ValidateData(Type::Code type, DataType data) {
         case Type::Code::Tuple:
         case Type::Code::LowCardinality:
         case Type::Code::Map:
+        case Type::Code::Variant:
+        case Type::Code::Dynamic:
+        case Type::Code::JSON:
+        case Type::Code::AggregateFunction:
             throw AssertionError("Unsupported type in ItemView: " + std::string(Type::TypeName(type)));
 
         case Type::Code::IPv6:
         case Type::Code::UUID:
         case Type::Code::Int128:
+        case Type::Code::UInt128:
         case Type::Code::Decimal128:
             return AssertSize({16});
 
+        case Type::Code::Int256:
+        case Type::Code::UInt256:
+        case Type::Code::Decimal256:
+            return AssertSize({32});
+
         case Type::Code::Decimal:
-            // Could be either Decimal32, Decimal64 or Decimal128
-            return AssertSize({4, 8, 16});
+            // Could be either Decimal32, Decimal64, Decimal128 or Decimal256
+            return AssertSize({4, 8, 16, 32});
 
         default:
             throw UnimplementedError("Unknown type code:" + std::to_string(static_cast<int>(type)));
@@ -24,11 +24,18 @@ struct ItemView {
     const DataType data;
 
 private:
+    /// Fixed-size values that are stored in ItemView as their binary representation.
+    template <typename T>
+    static constexpr bool IsFixedSizeValue = std::is_fundamental_v<T>
+            || std::is_same_v<Int128, T> || std::is_same_v<absl::uint128, T>
+            || std::is_same_v<Int256, T> || std::is_same_v<UInt256, T>
+            || std::is_same_v<BFloat16, T>;
+
     template <typename T>
     inline auto ConvertToStorageValue(const T& t) {
         if constexpr (std::is_same_v<std::string_view, T> || std::is_same_v<std::string, T>) {
             return std::string_view{t};
-        } else if constexpr (std::is_fundamental_v<T> || std::is_same_v<Int128, std::decay_t<T>>) {
+        } else if constexpr (IsFixedSizeValue<std::decay_t<T>>) {
             return std::string_view{reinterpret_cast<const char*>(&t), sizeof(T)};
         } else {
             static_assert(!std::is_same_v<T, T>, "Unknown type, which can't be stored in ItemView");
@@ -65,7 +72,7 @@ public:
         using ValueType = std::remove_cv_t<std::decay_t<T>>;
         if constexpr (std::is_same_v<std::string_view, ValueType> || std::is_same_v<std::string, ValueType>) {
             return data;
-        } else if constexpr (std::is_fundamental_v<ValueType> || std::is_same_v<Int128, ValueType>) {
+        } else if constexpr (IsFixedSizeValue<ValueType>) {
             if (sizeof(ValueType) == data.size()) {
                 return *reinterpret_cast<const T*>(data.data());
             } else {
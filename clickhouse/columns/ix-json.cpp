@@ -1,12 +1,502 @@
 #include "ix-json.h"
+#include "nullable.h"
+#include "numeric.h"
+#include "string.h"
 #include "utils.h"
 
+#include "../base/json_index.h"
+#include "../base/text_codec.h"
 #include "../base/wire_format.h"
 
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
 namespace {
+using namespace clickhouse;
 
 constexpr size_t DEFAULT_BLOCK_SIZE = 4096;
 
+/// Value found at a path in a single row.
+struct JsonValue {
+    enum Kind {
+        Missing,
+        String,     // `text` is the raw (escaped) content between quotes
+        Number,
+        Other,      // object, array, true or false, `text` is the JSON text
+        Null,
+    };
+
+    Kind kind = Missing;
+    std::string_view text;
+};
+
+/// Tree of keys of paths to extract, node 0 is the root object.
+struct PathTree {
+    struct Node {
+        std::string key;
+        std::vector<size_t> children;
+        /// Indices of paths ending at this node.
+        std::vector<size_t> targets;
+    };
+
+    std::vector<Node> nodes{1};
+
+    void Add(const std::string & path, size_t target) {
+        size_t node = 0;
+        size_t begin = 0;
+        while (true) {
+            const auto end = std::min(path.find('.', begin), path.size());
+            if (end == begin)
+                throw ValidationError("Empty key in JSON path '" + path + "'");
+
+            node = GetChild(node, std::string_view(path).substr(begin, end - begin));
+            if (end == path.size())
+                break;
+            begin = end + 1;
+        }
+        nodes[node].targets.push_back(target);
+    }
+
+    size_t FindChild(size_t node, std::string_view key) const {
+        for (const auto child : nodes[node].children) {
+            if (nodes[child].key == key)
+                return child;
+        }
+        return 0;
+    }
+
+private:
+    size_t GetChild(size_t node, std::string_view key) {
+        if (const auto child = FindChild(node, key))
+            return child;
+
+        nodes.push_back(Node{std::string(key), {}, {}});
+        nodes[node].children.push_back(nodes.size() - 1);
+        return nodes.size() - 1;
+    }
+};
+
+inline bool IsJsonWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline size_t ParseHex4(const char * p) {
+    size_t result = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        const char c = p[i];
+        result <<= 4;
+        if (c >= '0' && c <= '9') {
+            result |= c - '0';
+        } else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') {
+            result |= (c | 0x20) - 'a' + 10;
+        } else {
+            return size_t(-1);
+        }
+    }
+    return result;
+}
+
+void AppendUtf8(uint32_t code_point, std::string & out) {
+    if (code_point < 0x80) {
+        out.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+// Unescapes content of JSON string into `out`, returns false on invalid escape sequence.
+bool UnescapeJsonString(std::string_view raw, std::string & out) {
+    out.clear();
+    out.reserve(raw.size());
+
+    for (size_t i = 0; i < raw.size(); ++i) {
+        if (raw[i] != '\\') {
+            out.push_back(raw[i]);
+            continue;
+        }
+
+        if (++i == raw.size())
+            return false;
+
+        switch (raw[i]) {
+            case '"': out.push_back('"'); break;
+            case '\\': out.push_back('\\'); break;
+            case '/': out.push_back('/'); break;
+            case 'b': out.push_back('\b'); break;
+            case 'f': out.push_back('\f'); break;
+            case 'n': out.push_back('\n'); break;
+            case 'r': out.push_back('\r'); break;
+            case 't': out.push_back('\t'); break;
+            case 'u': {
+                if (raw.size() - i < 5)
+                    return false;
+                uint32_t code_point = static_cast<uint32_t>(ParseHex4(raw.data() + i + 1));
+                if (code_point > 0xFFFF)
+                    return false;
+                i += 4;
+
+                // Surrogate pair.
+                if (code_point >= 0xD800 && code_point < 0xDC00 && raw.size() - i >= 7
+                        && raw[i + 1] == '\\' && raw[i + 2] == 'u') {
+                    const auto low = static_cast<uint32_t>(ParseHex4(raw.data() + i + 3));
+                    if (low >= 0xDC00 && low < 0xE000) {
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                }
+                AppendUtf8(code_point, out);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+bool ParseJsonInt64(std::string_view text, int64_t & value) {
+    const bool negative = !text.empty() && text.front() == '-';
+    uint64_t magnitude = 0;
+    if (!ParseUInt64(text.substr(negative), magnitude))
+        return false;
+
+    const auto max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    if (magnitude > max + negative)
+        return false;
+
+    value = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+bool ParseJsonFloat64(std::string_view text, double & value) {
+    static constexpr double Pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+
+    const char * p = text.data();
+    const char * const end = p + text.size();
+
+    const bool negative = p != end && *p == '-';
+    p += negative;
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    const char * const digits_begin = p;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+    }
+    if (p == digits_begin)
+        return false;
+
+    if (p != end && *p == '.') {
+        const char * const fraction_begin = ++p;
+        for (; p != end && *p >= '0' && *p <= '9'; ++p, ++digits, --exponent) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+        }
+        if (p == fraction_begin)
+            return false;
+    }
+
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        const bool negative_exponent = p != end && *p == '-';
+        p += (p != end && (*p == '-' || *p == '+'));
+
+        int explicit_exponent = 0;
+        const char * const exponent_begin = p;
+        for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+            explicit_exponent = std::min(explicit_exponent * 10 + (*p - '0'), 100000);
+        }
+        if (p == exponent_begin)
+            return false;
+
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+
+    if (p != end)
+        return false;
+
+    // Exact when both mantissa and power of 10 are representable as double (Clinger's fast path).
+    if (digits <= 19 && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+        value = static_cast<double>(mantissa);
+        value = exponent < 0 ? value / Pow10[-exponent] : value * Pow10[exponent];
+        value = negative ? -value : value;
+        return true;
+    }
+
+    // Rewrite as "[-]<digits>e<exponent>" without the decimal point, which strtod() would take from the current locale.
+    std::string number(negative, '-');
+    for (const char * q = digits_begin; q != end && *q != 'e' && *q != 'E'; ++q) {
+        if (*q != '.')
+            number += *q;
+    }
+    number += 'e';
+    number += std::to_string(exponent);
+
+    // Too large or too small magnitudes give infinity or zero.
+    char * parsed_end = nullptr;
+    value = std::strtod(number.c_str(), &parsed_end);
+    return parsed_end == number.c_str() + number.size();
+}
+
+/// Walks a single row by positions of its structural characters, collecting values at paths of the tree.
+class JsonRowWalker {
+public:
+    JsonRowWalker(std::string_view json, const uint32_t * positions, size_t size, const PathTree & tree, std::vector<JsonValue> & values)
+        : json_(json)
+        , positions_(positions)
+        , size_(size)
+        , tree_(tree)
+        , values_(values)
+    {}
+
+    void Walk() {
+        const auto begin = SkipWhitespace(0);
+        if (begin < json_.size() && json_[begin] == '{') {
+            WalkObject(0);
+        }
+    }
+
+private:
+    inline char Current() const {
+        return index_ < size_ ? json_[positions_[index_]] : '\0';
+    }
+
+    inline size_t CurrentPosition() const {
+        return index_ < size_ ? positions_[index_] : json_.size();
+    }
+
+    inline void Expect(char c) {
+        if (Current() != c)
+            throw ValidationError("Malformed JSON, expected '" + std::string(1, c) + "' at " + std::to_string(CurrentPosition())
+                    + " in " + std::string(json_.substr(0, 256)));
+        ++index_;
+    }
+
+    size_t SkipWhitespace(size_t pos) const {
+        while (pos < json_.size() && IsJsonWhitespace(json_[pos]))
+            ++pos;
+        return pos;
+    }
+
+    // Walks object starting at the current position, descending only into keys of `node`.
+    void WalkObject(size_t node) {
+        Expect('{');
+        if (Current() == '}') {
+            ++index_;
+            return;
+        }
+
+        while (true) {
+            const size_t key_begin = CurrentPosition() + 1;
+            Expect('"');
+            const size_t key_end = CurrentPosition();
+            Expect('"');
+            Expect(':');
+
+            const auto raw_key = json_.substr(key_begin, key_end - key_begin);
+            size_t child = 0;
+            if (raw_key.find('\\') == std::string_view::npos) {
+                child = tree_.FindChild(node, raw_key);
+            } else if (UnescapeJsonString(raw_key, key_buffer_)) {
+                child = tree_.FindChild(node, key_buffer_);
+            }
+
+            const auto value = WalkValue(child);
+            if (child) {
+                for (const auto target : tree_.nodes[child].targets) {
+                    values_[target] = value;
+                }
+            }
+
+            if (Current() == ',') {
+                ++index_;
+                continue;
+            }
+            Expect('}');
+            return;
+        }
+    }
+
+    // Walks value after ':' or at the beginning of an array item, `node` is 0 if no path continues into the value.
+    JsonValue WalkValue(size_t node) {
+        const size_t begin = SkipWhitespace(index_ == 0 ? 0 : positions_[index_ - 1] + 1);
+        if (begin < json_.size() && begin == CurrentPosition()) {
+            switch (Current()) {
+                case '"': {
+                    ++index_;
+                    const size_t end = CurrentPosition();
+                    Expect('"');
+                    return JsonValue{JsonValue::String, json_.substr(begin + 1, end - begin - 1)};
+                }
+                case '{':
+                    if (node && !tree_.nodes[node].children.empty()) {
+                        WalkObject(node);
+                    } else {
+                        SkipContainer();
+                    }
+                    return JsonValue{JsonValue::Other, json_.substr(begin, positions_[index_ - 1] + 1 - begin)};
+                case '[':
+                    SkipContainer();
+                    return JsonValue{JsonValue::Other, json_.substr(begin, positions_[index_ - 1] + 1 - begin)};
+                default:
+                    break;
+            }
+        }
+
+        // Scalar spans up to the next structural character.
+        size_t end = CurrentPosition();
+        while (end > begin && IsJsonWhitespace(json_[end - 1]))
+            --end;
+
+        const auto text = json_.substr(begin, end - begin);
+        if (text.empty())
+            throw ValidationError("Malformed JSON, expected value at " + std::to_string(begin) + " in " + std::string(json_.substr(0, 256)));
+
+        if (text == "null")
+            return JsonValue{JsonValue::Null, text};
+        if (text[0] == '-' || (text[0] >= '0' && text[0] <= '9'))
+            return JsonValue{JsonValue::Number, text};
+        return JsonValue{JsonValue::Other, text};
+    }
+
+    void SkipContainer() {
+        size_t depth = 0;
+        do {
+            switch (Current()) {
+                case '{': case '[': ++depth; break;
+                case '}': case ']': --depth; break;
+                case '\0': throw ValidationError("Malformed JSON, unterminated object or array in " + std::string(json_.substr(0, 256)));
+                default: break;
+            }
+            ++index_;
+        } while (depth);
+    }
+
+    const std::string_view json_;
+    const uint32_t * const positions_;
+    const size_t size_;
+    const PathTree & tree_;
+    std::vector<JsonValue> & values_;
+
+    size_t index_ = 0;
+    std::string key_buffer_;
+};
+
+/// Accumulates extracted values of a single path.
+class ExtractedColumnBuilder {
+public:
+    explicit ExtractedColumnBuilder(const TypeRef & type)
+        : nullable_(type->GetCode() == Type::Nullable)
+        , code_(nullable_ ? type->As<NullableType>()->GetNestedType()->GetCode() : type->GetCode())
+    {
+        switch (code_) {
+            case Type::String:
+                strings_ = std::make_shared<ColumnString>();
+                break;
+            case Type::Int64:
+            case Type::Float64:
+                break;
+            default:
+                throw ValidationError("Can't extract JSON values as " + type->GetName()
+                        + ", only String, Int64, Float64 and Nullable of those are supported");
+        }
+    }
+
+    void Reserve(size_t rows) {
+        if (nullable_)
+            nulls_.reserve(rows);
+
+        switch (code_) {
+            case Type::String: strings_->Reserve(rows); break;
+            case Type::Int64: integers_.reserve(rows); break;
+            default: floats_.reserve(rows); break;
+        }
+    }
+
+    void Append(const JsonValue & value) {
+        bool is_null = true;
+        switch (code_) {
+            case Type::String:
+                is_null = !AppendString(value);
+                break;
+            case Type::Int64: {
+                int64_t result = 0;
+                is_null = !(value.kind == JsonValue::Number && ParseJsonInt64(value.text, result));
+                integers_.push_back(is_null ? 0 : result);
+                break;
+            }
+            default: {
+                double result = 0;
+                is_null = !(value.kind == JsonValue::Number && ParseJsonFloat64(value.text, result));
+                floats_.push_back(is_null ? 0 : result);
+                break;
+            }
+        }
+
+        if (nullable_)
+            nulls_.push_back(is_null);
+    }
+
+    ColumnRef Finish() {
+        ColumnRef result;
+        switch (code_) {
+            case Type::String: result = strings_; break;
+            case Type::Int64: result = std::make_shared<ColumnInt64>(std::move(integers_)); break;
+            default: result = std::make_shared<ColumnFloat64>(std::move(floats_)); break;
+        }
+
+        if (nullable_)
+            result = std::make_shared<ColumnNullable>(result, std::make_shared<ColumnUInt8>(std::move(nulls_)));
+        return result;
+    }
+
+private:
+    bool AppendString(const JsonValue & value) {
+        switch (value.kind) {
+            case JsonValue::String:
+                if (value.text.find('\\') == std::string_view::npos) {
+                    strings_->Append(value.text);
+                } else if (UnescapeJsonString(value.text, buffer_)) {
+                    strings_->Append(std::string_view(buffer_));
+                } else {
+                    strings_->Append(value.text);
+                }
+                return true;
+            case JsonValue::Number:
+            case JsonValue::Other:
+                strings_->Append(value.text);
+                return true;
+            default:
+                strings_->Append(std::string_view());
+                return false;
+        }
+    }
+
+    const bool nullable_;
+    const Type::Code code_;
+
+    std::shared_ptr<ColumnString> strings_;
+    std::vector<int64_t> integers_;
+    std::vector<double> floats_;
+    std::vector<uint8_t> nulls_;
+    std::string buffer_;
+};
+
 template <typename Container>
 size_t ComputeTotalSize(const Container & strings, size_t begin = 0, size_t len = -1) {
     size_t result = 0;
@@ -62,6 +552,13 @@ struct ColumnIxJson::Block
     std::unique_ptr<CharT[]> data_;
 };
 
+struct ColumnIxJson::StructureIndex {
+    /// Positions of structural characters of all indexed rows, relative to beginning of each row.
+    std::vector<uint32_t> positions;
+    /// Structural characters of row `n` are [row_offsets[n], row_offsets[n + 1]) in `positions`.
+    std::vector<size_t> row_offsets{0};
+};
+
 ColumnIxJson::ColumnIxJson()
     : Column(Type::CreateIxJson())
 {
@@ -101,6 +598,60 @@ ColumnIxJson::ColumnIxJson(std::vector<std::string>&& data)
 ColumnIxJson::~ColumnIxJson()
 {}
 
+void ColumnIxJson::UpdateStructureIndex() const {
+    if (!structure_index_)
+        structure_index_ = std::make_unique<StructureIndex>();
+
+    auto & index = *structure_index_;
+    index.row_offsets.reserve(items_.size() + 1);
+    for (size_t row = index.row_offsets.size() - 1; row < items_.size(); ++row) {
+        if (items_[row].size() > std::numeric_limits<uint32_t>::max())
+            throw ValidationError("JSON value at row " + std::to_string(row) + " is too long to be indexed");
+
+        IndexJsonStructure(items_[row], index.positions);
+        index.row_offsets.push_back(index.positions.size());
+    }
+}
+
+std::vector<ColumnRef> ColumnIxJson::ExtractPaths(const std::vector<PathToExtract>& paths) const {
+    PathTree tree;
+    std::vector<ExtractedColumnBuilder> builders;
+    builders.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        tree.Add(paths[i].path, i);
+        builders.emplace_back(paths[i].type);
+        builders.back().Reserve(items_.size());
+    }
+
+    UpdateStructureIndex();
+    const auto & index = *structure_index_;
+
+    std::vector<JsonValue> values(paths.size());
+    for (size_t row = 0; row < items_.size(); ++row) {
+        std::fill(values.begin(), values.end(), JsonValue{});
+
+        const auto begin = index.row_offsets[row];
+        JsonRowWalker(items_[row], index.positions.data() + begin, index.row_offsets[row + 1] - begin, tree, values).Walk();
+
+        for (size_t i = 0; i < paths.size(); ++i) {
+            builders[i].Append(values[i]);
+        }
+    }
+
+    std::vector<ColumnRef> result;
+    result.reserve(paths.size());
+    for (auto & builder : builders) {
+        result.push_back(builder.Finish());
+    }
+    return result;
+}
+
+void ColumnIxJson::Reserve(size_t new_cap) {
+    items_.reserve(new_cap);
+    // 100 is arbitrary number, assumption that string values are about ~40 bytes long.
+    blocks_.reserve(std::max<size_t>(1, new_cap / 100));
+}
+
 void ColumnIxJson::Append(std::string_view str) {
     if (blocks_.size() == 0 || blocks_.back().GetAvailable() < str.length()) {
         blocks_.emplace_back(std::max(DEFAULT_BLOCK_SIZE, str.size()));
@@ -128,6 +679,7 @@ void ColumnIxJson::AppendUnsafe(std::string_view str) {
 }
 
 void ColumnIxJson::Clear() {
+    structure_index_.reset();
     items_.clear();
     blocks_.clear();
     append_data_.clear();
@@ -158,6 +710,7 @@ void ColumnIxJson::Append(ColumnRef column) {
 }
 
 bool ColumnIxJson::LoadBody(InputStream* input, size_t rows) {
+    structure_index_.reset();
     items_.clear();
     blocks_.clear();
 
@@ -217,6 +770,7 @@ void ColumnIxJson::Swap(Column& other) {
     items_.swap(col.items_);
     blocks_.swap(col.blocks_);
     append_data_.swap(col.append_data_);
+    structure_index_.swap(col.structure_index_);
 }
 
 ItemView ColumnIxJson::GetItem(size_t index) const {
@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 #include <deque>
+#include <memory>
 
 namespace clickhouse {
 
@@ -27,6 +28,9 @@ public:
     ColumnIxJson& operator=(const ColumnIxJson&) = delete;
     ColumnIxJson(const ColumnIxJson&) = delete;
 
+    /// Increase the capacity of the column for large block insertion.
+    void Reserve(size_t new_cap) override;
+
     /// Appends one element to the column.
     void Append(std::string_view str);
 
@@ -46,6 +50,27 @@ public:
     /// Returns element at given row number.
     std::string_view operator [] (size_t n) const;
 
+    /// JSON path to extract with ExtractPaths() and type of the resulting column.
+    struct PathToExtract {
+        /// Keys of nested objects separated by '.', e.g. "user.address.city".
+        std::string path;
+        /// String, Int64, Float64 or Nullable of any of them.
+        TypeRef type;
+    };
+
+    /** Extracts values at `paths` from all rows into new columns of requested types, in a single pass over the column.
+     *
+     *  JSON strings are unescaped, other values extracted into String columns are stored as their JSON text.
+     *  Int64 columns accept integer numbers only, Float64 columns accept any numbers.
+     *  Rows where a path is missing, null or of an incompatible kind get NULL in Nullable columns and the default value otherwise.
+     *  Throws ValidationError on unsupported type or empty key in a path, and on malformed JSON.
+     *
+     *  Positions of structural characters of each row are found once and cached with the column,
+     *  so repeated extractions don't rescan the text, but only walk the cached index and parse extracted values.
+     *  Not thread-safe, even though the method is const.
+     */
+    std::vector<ColumnRef> ExtractPaths(const std::vector<PathToExtract>& paths) const;
+
 public:
     /// Appends content of given column to the end of current one.
     void Append(ColumnRef column) override;
@@ -71,12 +96,18 @@ public:
 private:
     void AppendUnsafe(std::string_view);
 
+    /// Indexes structure of rows appended since the last call.
+    void UpdateStructureIndex() const;
+
 private:
     struct Block;
+    struct StructureIndex;
 
     std::vector<std::string_view> items_;
     std::vector<Block> blocks_;
     std::deque<std::string> append_data_;
+    /// Built lazily by ExtractPaths() and extended with appended rows, reset when existing rows change.
+    mutable std::unique_ptr<StructureIndex> structure_index_;
 };
 
 }
@@ -0,0 +1,338 @@
+#include "json.h"
+#include "string.h"
+#include "tuple.h"
+
+#include "../base/wire_format.h"
+
+#include <algorithm>
+
+namespace {
+using namespace clickhouse;
+
+// Versions of serialization of the structure of the column, the first value of the prefix.
+enum ObjectSerializationVersion : uint64_t {
+    // Followed by max_dynamic_paths, which is ignored.
+    V1 = 0,
+    // Rows as JSON text.
+    AsString = 1,
+    V2 = 2,
+};
+
+ColumnRef CreateSharedDataItems() {
+    return std::make_shared<ColumnTuple>(std::vector<ColumnRef>{
+        std::make_shared<ColumnString>(),
+        std::make_shared<ColumnString>()
+    });
+}
+
+TypeRef CreateType(const std::vector<ColumnJSON::PathColumn> & typed_paths, size_t max_dynamic_paths, size_t max_dynamic_types,
+        std::vector<std::string> skip) {
+    std::vector<std::pair<std::string, TypeRef>> types;
+    types.reserve(typed_paths.size());
+    for (const auto & [path, column] : typed_paths) {
+        types.emplace_back(path, column->Type());
+    }
+    return Type::CreateJSON(std::move(types), max_dynamic_paths, max_dynamic_types, std::move(skip));
+}
+
+template <typename Paths>
+auto FindPath(Paths & paths, const std::string & path) {
+    return std::lower_bound(paths.begin(), paths.end(), path, [](const auto & item, const std::string & value) {
+        return item.first < value;
+    });
+}
+
+}
+
+namespace clickhouse {
+
+ColumnJSON::ColumnJSON(std::vector<PathColumn> typed_paths, size_t max_dynamic_paths, size_t max_dynamic_types, std::vector<std::string> skip)
+    : Column(CreateType(typed_paths, max_dynamic_paths, max_dynamic_types, std::move(skip)))
+    , typed_paths_(std::move(typed_paths))
+    , shared_data_(std::make_shared<ColumnArray>(CreateSharedDataItems()))
+{
+    std::sort(typed_paths_.begin(), typed_paths_.end(), [](const auto & left, const auto & right) {
+        return left.first < right.first;
+    });
+
+    for (const auto & [path, column] : typed_paths_) {
+        if (column->Size() != 0) {
+            throw ValidationError("Column of typed path '" + path + "' must be empty");
+        }
+    }
+}
+
+const JSONType& ColumnJSON::GetJSONType() const {
+    return *type_->As<JSONType>();
+}
+
+ColumnRef ColumnJSON::GetTypedPath(const std::string& path) const {
+    const auto it = FindPath(typed_paths_, path);
+    return it != typed_paths_.end() && it->first == path ? it->second : nullptr;
+}
+
+std::shared_ptr<ColumnDynamic> ColumnJSON::GetDynamicPath(const std::string& path) const {
+    const auto it = FindPath(dynamic_paths_, path);
+    return it != dynamic_paths_.end() && it->first == path ? it->second : nullptr;
+}
+
+std::shared_ptr<ColumnDynamic> ColumnJSON::AddDynamicPath(const std::string& path) {
+    if (text_) {
+        throw ValidationError("Can't add path to JSON column received as text");
+    }
+    if (GetTypedPath(path) || GetDynamicPath(path)) {
+        throw ValidationError("Path '" + path + "' already exists in JSON column");
+    }
+    if (dynamic_paths_.size() >= GetJSONType().GetMaxDynamicPaths()) {
+        throw ValidationError("Too many dynamic paths in " + type_->GetName() + ", at most "
+                + std::to_string(GetJSONType().GetMaxDynamicPaths()) + " are allowed");
+    }
+
+    auto column = std::make_shared<ColumnDynamic>(GetJSONType().GetMaxDynamicTypes());
+    for (size_t i = 0; i < Size(); ++i) {
+        column->AppendNull();
+    }
+
+    dynamic_paths_.emplace(FindPath(dynamic_paths_, path), path, column);
+    return column;
+}
+
+void ColumnJSON::CommitRow() {
+    if (text_) {
+        throw ValidationError("Can't append rows to JSON column received as text");
+    }
+
+    const auto rows = Size() + 1;
+    for (const auto & [path, column] : typed_paths_) {
+        if (column->Size() != rows) {
+            throw ValidationError("Typed path '" + path + "' has " + std::to_string(column->Size()) + " rows, expected "
+                    + std::to_string(rows));
+        }
+    }
+
+    for (const auto & [path, column] : dynamic_paths_) {
+        if (column->Size() + 1 == rows) {
+            column->AppendNull();
+        } else if (column->Size() != rows) {
+            throw ValidationError("Dynamic path '" + path + "' has " + std::to_string(column->Size()) + " rows, expected "
+                    + std::to_string(rows));
+        }
+    }
+
+    shared_data_->AppendAsColumn(CreateSharedDataItems());
+}
+
+std::vector<ColumnRef> ColumnJSON::GetSubcolumns() const {
+    std::vector<ColumnRef> result;
+    result.reserve(typed_paths_.size() + dynamic_paths_.size() + 1);
+    for (const auto & [path, column] : typed_paths_) {
+        result.push_back(column);
+    }
+    for (const auto & [path, column] : dynamic_paths_) {
+        result.push_back(column);
+    }
+    result.push_back(shared_data_);
+    return result;
+}
+
+void ColumnJSON::Reserve(size_t new_cap) {
+    if (text_) {
+        text_->Reserve(new_cap);
+        return;
+    }
+    for (auto & column : GetSubcolumns()) {
+        column->Reserve(new_cap);
+    }
+}
+
+void ColumnJSON::Append(ColumnRef column) {
+    const auto col = column->As<ColumnJSON>();
+    if (!col || !col->type_->IsEqual(type_)) {
+        throw ValidationError("Can't append " + column->Type()->GetName() + " to " + type_->GetName());
+    }
+
+    if (text_ || col->text_) {
+        if (!text_ || !col->text_) {
+            throw ValidationError("Can't append JSON column received as text to one that is not and vice versa");
+        }
+        text_->Append(col->text_);
+        return;
+    }
+
+    const auto rows = Size();
+    const auto appended_rows = col->Size();
+
+    for (size_t i = 0; i < typed_paths_.size(); ++i) {
+        typed_paths_[i].second->Append(col->typed_paths_[i].second);
+    }
+
+    for (const auto & [path, column] : col->dynamic_paths_) {
+        if (!GetDynamicPath(path)) {
+            AddDynamicPath(path);
+        }
+    }
+    for (auto & [path, column] : dynamic_paths_) {
+        if (auto appended = col->GetDynamicPath(path)) {
+            column->Append(appended);
+        } else {
+            column->Reserve(rows + appended_rows);
+            for (size_t i = 0; i < appended_rows; ++i) {
+                column->AppendNull();
+            }
+        }
+    }
+
+    shared_data_->Append(col->shared_data_);
+}
+
+bool ColumnJSON::LoadPrefix(InputStream* input, size_t rows) {
+    uint64_t version;
+    if (!WireFormat::ReadFixed(*input, &version)) {
+        return false;
+    }
+
+    if (version == AsString) {
+        text_ = std::make_shared<ColumnIxJson>();
+        return true;
+    }
+    if (version != V1 && version != V2) {
+        throw UnimplementedError("Serialization version " + std::to_string(version) + " of JSON column is not supported");
+    }
+    text_.reset();
+
+    uint64_t max_dynamic_paths;
+    if (version == V1 && !WireFormat::ReadVarint64(*input, &max_dynamic_paths)) {
+        return false;
+    }
+
+    uint64_t count;
+    if (!WireFormat::ReadVarint64(*input, &count)) {
+        return false;
+    }
+
+    dynamic_paths_.clear();
+    dynamic_paths_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string path;
+        if (!WireFormat::ReadString(*input, &path)) {
+            return false;
+        }
+        dynamic_paths_.emplace_back(std::move(path), std::make_shared<ColumnDynamic>(GetJSONType().GetMaxDynamicTypes()));
+    }
+    // Paths are sent sorted, keep them so regardless.
+    std::sort(dynamic_paths_.begin(), dynamic_paths_.end(), [](const auto & left, const auto & right) {
+        return left.first < right.first;
+    });
+
+    for (auto & column : GetSubcolumns()) {
+        if (!column->LoadPrefix(input, rows)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ColumnJSON::LoadBody(InputStream* input, size_t rows) {
+    if (text_) {
+        return text_->LoadBody(input, rows);
+    }
+
+    for (auto & column : GetSubcolumns()) {
+        if (!column->LoadBody(input, rows)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ColumnJSON::SavePrefix(OutputStream* output) {
+    if (text_) {
+        WireFormat::WriteFixed<uint64_t>(*output, AsString);
+        return;
+    }
+
+    WireFormat::WriteFixed<uint64_t>(*output, V1);
+    WireFormat::WriteVarint64(*output, GetJSONType().GetMaxDynamicPaths());
+    WireFormat::WriteVarint64(*output, dynamic_paths_.size());
+    for (const auto & [path, column] : dynamic_paths_) {
+        WireFormat::WriteString(*output, path);
+    }
+
+    for (auto & column : GetSubcolumns()) {
+        column->SavePrefix(output);
+    }
+}
+
+void ColumnJSON::SaveBody(OutputStream* output) {
+    if (text_) {
+        for (size_t i = 0; i < text_->Size(); ++i) {
+            WireFormat::WriteString(*output, text_->At(i));
+        }
+        return;
+    }
+
+    for (auto & column : GetSubcolumns()) {
+        column->SaveBody(output);
+    }
+}
+
+void ColumnJSON::Clear() {
+    if (text_) {
+        text_->Clear();
+    }
+    for (auto & [path, column] : typed_paths_) {
+        column->Clear();
+    }
+    dynamic_paths_.clear();
+    shared_data_->Clear();
+}
+
+size_t ColumnJSON::Size() const {
+    return text_ ? text_->Size() : shared_data_->Size();
+}
+
+ColumnRef ColumnJSON::Slice(size_t begin, size_t len) const {
+    auto result = std::static_pointer_cast<ColumnJSON>(CloneEmpty());
+    if (text_) {
+        result->text_ = std::static_pointer_cast<ColumnIxJson>(text_->Slice(begin, len));
+        return result;
+    }
+
+    for (size_t i = 0; i < typed_paths_.size(); ++i) {
+        result->typed_paths_[i].second = typed_paths_[i].second->Slice(begin, len);
+    }
+    for (const auto & [path, column] : dynamic_paths_) {
+        result->dynamic_paths_.emplace_back(path, std::static_pointer_cast<ColumnDynamic>(column->Slice(begin, len)));
+    }
+    result->shared_data_ = std::static_pointer_cast<ColumnArray>(shared_data_->Slice(begin, len));
+
+    return result;
+}
+
+ColumnRef ColumnJSON::CloneEmpty() const {
+    std::vector<PathColumn> typed_paths;
+    typed_paths.reserve(typed_paths_.size());
+    for (const auto & [path, column] : typed_paths_) {
+        typed_paths.emplace_back(path, column->CloneEmpty());
+    }
+
+    const auto & type = GetJSONType();
+    auto result = std::make_shared<ColumnJSON>(std::move(typed_paths), type.GetMaxDynamicPaths(), type.GetMaxDynamicTypes(), type.GetSkip());
+    if (text_) {
+        result->text_ = std::make_shared<ColumnIxJson>();
+    }
+    return result;
+}
+
+void ColumnJSON::Swap(Column& other) {
+    auto & col = dynamic_cast<ColumnJSON &>(other);
+    type_.swap(col.type_);
+    typed_paths_.swap(col.typed_paths_);
+    dynamic_paths_.swap(col.dynamic_paths_);
+    shared_data_.swap(col.shared_data_);
+    text_.swap(col.text_);
+}
+
+}
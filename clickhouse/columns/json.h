@@ -0,0 +1,107 @@
+#pragma once
+
+#include "array.h"
+#include "column.h"
+#include "dynamic.h"
+#include "ix-json.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace clickhouse {
+
+/**
+ * Represents column of JSON type, split into subcolumns like ClickHouse stores it:
+ *  - typed paths, declared in the type, each a column of its declared type;
+ *  - dynamic paths, up to max_dynamic_paths other paths, each a Dynamic column;
+ *  - shared data, values of the rest of paths, Array(Tuple(String, String)) of paths and values
+ *    in ClickHouse binary encoding of type and value, exposed as is.
+ *
+ * If the server sends JSON as text (output_format_native_write_json_as_string), rows are kept as is in GetText().
+ */
+class ColumnJSON : public Column {
+public:
+    using PathColumn = std::pair<std::string, ColumnRef>;
+    using DynamicPathColumn = std::pair<std::string, std::shared_ptr<ColumnDynamic>>;
+
+    /// Typed paths must be empty columns, e.g. {"a.b", std::make_shared<ColumnUInt32>()}; `skip` as in JSONType.
+    explicit ColumnJSON(std::vector<PathColumn> typed_paths = {},
+            size_t max_dynamic_paths = JSONType::DefaultMaxDynamicPaths,
+            size_t max_dynamic_types = DynamicType::DefaultMaxTypes,
+            std::vector<std::string> skip = {});
+
+    /// Returns columns of typed paths, sorted by path.
+    inline const std::vector<PathColumn>& GetTypedPaths() const { return typed_paths_; }
+
+    /// Returns columns of dynamic paths, sorted by path.
+    inline const std::vector<DynamicPathColumn>& GetDynamicPaths() const { return dynamic_paths_; }
+
+    /// Returns column of the typed path, nullptr if there is none.
+    ColumnRef GetTypedPath(const std::string& path) const;
+
+    /// Returns column of the dynamic path, nullptr if there is none.
+    std::shared_ptr<ColumnDynamic> GetDynamicPath(const std::string& path) const;
+
+    /// Returns shared data, Array(Tuple(String, String)) column of paths and binary encoded values of each row.
+    inline ColumnRef GetSharedData() const { return shared_data_; }
+
+    /// Returns rows as text if the column was received as text, nullptr otherwise.
+    inline std::shared_ptr<ColumnIxJson> GetText() const { return text_; }
+
+    /** Adds dynamic path with NULL values in all existing rows.
+     *  Throws ValidationError if the path already exists, or if there would be more than max_dynamic_paths dynamic paths.
+     */
+    std::shared_ptr<ColumnDynamic> AddDynamicPath(const std::string& path);
+
+    /** Completes a row after its values are appended to columns of typed paths and of some dynamic paths,
+     *  other dynamic paths get NULL and the row gets no shared data.
+     *  Throws ValidationError if a typed path has no value for the row.
+     */
+    void CommitRow();
+
+public:
+    /// Increase the capacity of the column for large block insertion.
+    void Reserve(size_t new_cap) override;
+
+    /// Appends content of given column to the end of current one, adding its dynamic paths.
+    void Append(ColumnRef column) override;
+
+    /// Loads column prefix from input stream.
+    bool LoadPrefix(InputStream* input, size_t rows) override;
+
+    /// Loads column data from input stream.
+    bool LoadBody(InputStream* input, size_t rows) override;
+
+    /// Saves column prefix to output stream.
+    void SavePrefix(OutputStream* output) override;
+
+    /// Saves column data to output stream.
+    void SaveBody(OutputStream* output) override;
+
+    /// Clear column data, dynamic paths are removed.
+    void Clear() override;
+
+    /// Returns count of rows in the column.
+    size_t Size() const override;
+
+    /// Makes slice of the current column.
+    ColumnRef Slice(size_t begin, size_t len) const override;
+    ColumnRef CloneEmpty() const override;
+    void Swap(Column&) override;
+
+private:
+    const JSONType& GetJSONType() const;
+
+    /// Columns of all paths and shared data, in order of serialization.
+    std::vector<ColumnRef> GetSubcolumns() const;
+
+private:
+    std::vector<PathColumn> typed_paths_;
+    std::vector<DynamicPathColumn> dynamic_paths_;
+    std::shared_ptr<ColumnArray> shared_data_;
+    std::shared_ptr<ColumnIxJson> text_;
+};
+
+}
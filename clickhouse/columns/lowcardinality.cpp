@@ -1,14 +1,18 @@
 #include "lowcardinality.h"
 
+#include "date.h"
+#include "enum.h"
 #include "string.h"
 #include "nullable.h"
 #include "../base/wire_format.h"
 
 #include <city.h>
 
-#include <functional>
+#include <algorithm>
+#include <limits>
 #include <string_view>
 #include <type_traits>
+#include <utility>
 
 #include <cassert>
 
@@ -67,14 +71,16 @@ IndexType indexTypeFromIndexColumn(const Column & index_column) {
     }
 }
 
+// Callers dispatch on the type code of the column, which already guarantees the column type,
+// so there is no need to pay for dynamic_cast on every appended item.
 template <typename ResultColumnType, typename ColumnType>
 inline const ResultColumnType & column_down_cast(const ColumnType & c) {
-    return dynamic_cast<const ResultColumnType &>(c);
+    return static_cast<const ResultColumnType &>(c);
 }
 
 template <typename ResultColumnType, typename ColumnType>
 inline ResultColumnType & column_down_cast(ColumnType & c) {
-    return dynamic_cast<ResultColumnType &>(c);
+    return static_cast<ResultColumnType &>(c);
 }
 
 // std::visit-ish function to avoid including <variant> header, which is not present in older version of XCode.
@@ -94,26 +100,82 @@ inline auto VisitIndexColumn(Vizitor && vizitor, ColumnType && col) {
     }
 }
 
+// Size of the value of fixed-width dictionary type, 0 for String and FixedString.
+inline size_t GetDictionaryItemSize(Type::Code type) {
+    switch (type) {
+        case Type::Int8:
+        case Type::UInt8:
+        case Type::Enum8:
+            return 1;
+        case Type::Int16:
+        case Type::UInt16:
+        case Type::Date:
+        case Type::Enum16:
+            return 2;
+        case Type::Int32:
+        case Type::UInt32:
+        case Type::Float32:
+        case Type::Date32:
+        case Type::DateTime:
+            return 4;
+        case Type::Int64:
+        case Type::UInt64:
+        case Type::Float64:
+        case Type::DateTime64:
+            return 8;
+        case Type::Int128:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+// Value of the type filled with zero bytes: empty string for String and FixedString, 0 for numeric types.
+inline ItemView GetZeroItemForDictionary(const ColumnRef dictionary) {
+    static const char zeroes[16] = {};
+
+    const auto type = dictionary->Type()->GetCode();
+    return ItemView{type, std::string_view(zeroes, GetDictionaryItemSize(type))};
+}
+
 // A special NULL-item, which is expected at pos(0) in dictionary,
 // note that we distinguish empty string from NULL-value.
 inline auto GetNullItemForDictionary(const ColumnRef dictionary) {
-    if (auto n = dictionary->As<ColumnNullable>()) {
+    if (dictionary->AsPtr<ColumnNullable>()) {
         return ItemView {};
     } else {
-        return ItemView{dictionary->Type()->GetCode(), std::string_view{}};
+        return GetZeroItemForDictionary(dictionary);
     }
 }
 
 // A special default item, which is expected at pos(0) in dictionary,
 // note that we distinguish empty string from NULL-value.
 inline ItemView GetDefaultItemForDictionary(const ColumnRef dictionary) {
-    if (auto n = dictionary->As<ColumnNullable>()) {
+    if (auto n = dictionary->AsPtr<ColumnNullable>()) {
         return GetDefaultItemForDictionary(n->Nested());
     } else {
-        return ItemView{dictionary->Type()->GetCode(), std::string_view{}};
+        return GetZeroItemForDictionary(dictionary);
     }
 }
 
+// FixedString dictionary items are zero-padded up to the fixed size, while appended values may be shorter,
+// hence trailing zeroes are not significant and are skipped both for hashing and comparison.
+inline std::string_view GetItemKey(const ItemView & item) {
+    auto data = item.data;
+    if (item.type == Type::FixedString) {
+        while (!data.empty() && data.back() == '\0')
+            data.remove_suffix(1);
+    }
+    return data;
+}
+
+inline bool IsSameItem(const ItemView & left, const ItemView & right) {
+    // to distinguish NULL of ColumnNullable and empty string.
+    const bool left_is_null = left.type == Type::Void;
+    const bool right_is_null = right.type == Type::Void;
+    return left_is_null == right_is_null && GetItemKey(left) == GetItemKey(right);
+}
+
 void AppendToDictionary(Column& dictionary, const ItemView & item);
 
 inline void AppendNullableToDictionary(ColumnNullable& nullable, const ItemView & item) {
@@ -146,6 +208,62 @@ inline void AppendToDictionary(Column& dictionary, const ItemView & item) {
         case Type::Nullable:
             AppendNullableToDictionary(column_down_cast<ColumnNullable>(dictionary), item);
             return;
+
+        case Type::Int8:
+            column_down_cast<ColumnInt8>(dictionary).Append(item.get<int8_t>());
+            return;
+        case Type::Int16:
+            column_down_cast<ColumnInt16>(dictionary).Append(item.get<int16_t>());
+            return;
+        case Type::Int32:
+            column_down_cast<ColumnInt32>(dictionary).Append(item.get<int32_t>());
+            return;
+        case Type::Int64:
+            column_down_cast<ColumnInt64>(dictionary).Append(item.get<int64_t>());
+            return;
+        case Type::Int128:
+            column_down_cast<ColumnInt128>(dictionary).Append(item.get<Int128>());
+            return;
+        case Type::UInt8:
+            column_down_cast<ColumnUInt8>(dictionary).Append(item.get<uint8_t>());
+            return;
+        case Type::UInt16:
+            column_down_cast<ColumnUInt16>(dictionary).Append(item.get<uint16_t>());
+            return;
+        case Type::UInt32:
+            column_down_cast<ColumnUInt32>(dictionary).Append(item.get<uint32_t>());
+            return;
+        case Type::UInt64:
+            column_down_cast<ColumnUInt64>(dictionary).Append(item.get<uint64_t>());
+            return;
+        case Type::Float32:
+            column_down_cast<ColumnFloat32>(dictionary).Append(item.get<float>());
+            return;
+        case Type::Float64:
+            column_down_cast<ColumnFloat64>(dictionary).Append(item.get<double>());
+            return;
+
+        // Date and time columns are filled with raw values, exactly as those are returned by GetItem().
+        case Type::Date:
+            column_down_cast<ColumnDate>(dictionary).AppendRaw(item.get<uint16_t>());
+            return;
+        case Type::Date32:
+            column_down_cast<ColumnDate32>(dictionary).AppendRaw(item.get<int32_t>());
+            return;
+        case Type::DateTime:
+            column_down_cast<ColumnDateTime>(dictionary).AppendRaw(item.get<uint32_t>());
+            return;
+        case Type::DateTime64:
+            column_down_cast<ColumnDateTime64>(dictionary).Append(item.get<Int64>());
+            return;
+
+        case Type::Enum8:
+            column_down_cast<ColumnEnum8>(dictionary).Append(item.get<int8_t>());
+            return;
+        case Type::Enum16:
+            column_down_cast<ColumnEnum16>(dictionary).Append(item.get<int16_t>());
+            return;
+
         default:
             throw ValidationError("Unexpected dictionary column type: " + dictionary.GetType().GetName());
     }
@@ -189,9 +307,12 @@ void ColumnLowCardinality::Setup(ColumnRef dictionary_column) {
         // by adding InsertUnsafe(pos, ItemView) method to a Column
         // (to insert null-item at pos 0),
         // but that is too much work for now.
+        std::vector<ItemView> items;
+        items.reserve(dictionary_column->Size());
         for (size_t i = 0; i < dictionary_column->Size(); ++i) {
-            AppendUnsafe(dictionary_column->GetItem(i));
+            items.push_back(dictionary_column->GetItem(i));
         }
+        AppendUnsafeMany(items);
     }
 }
 
@@ -202,29 +323,56 @@ std::uint64_t ColumnLowCardinality::getDictionaryIndex(std::uint64_t item_index)
 }
 
 void ColumnLowCardinality::appendIndex(std::uint64_t item_index) {
-    // TODO (nemkov): handle case when index should go from UInt8 to UInt16, etc.
+    widenIndexColumn(item_index);
     VisitIndexColumn([item_index](auto & arg) {
         arg.Append(static_cast<typename std::decay_t<decltype(arg)>::DataType>(item_index));
     }, *index_column_);
 }
 
+void ColumnLowCardinality::widenIndexColumn(std::uint64_t max_dictionary_index) {
+    const auto required_type = max_dictionary_index <= std::numeric_limits<std::uint8_t>::max() ? IndexType::UInt8
+            : max_dictionary_index <= std::numeric_limits<std::uint16_t>::max() ? IndexType::UInt16
+            : max_dictionary_index <= std::numeric_limits<std::uint32_t>::max() ? IndexType::UInt32
+            : IndexType::UInt64;
+    if (required_type <= indexTypeFromIndexColumn(*index_column_))
+        return;
+
+    auto new_index_column = createIndexColumn(required_type);
+    VisitIndexColumn([this](auto & new_index) {
+        VisitIndexColumn([&new_index](const auto & index) {
+            const auto data = index.GetData();
+            new_index.GetWritableData().assign(data.begin(), data.end());
+        }, *index_column_);
+    }, *new_index_column);
+
+    index_column_.swap(new_index_column);
+}
+
 void ColumnLowCardinality::removeLastIndex() {
     VisitIndexColumn([](auto & arg) {
         arg.Erase(arg.Size() - 1);
     }, *index_column_);
 }
 
-details::LowCardinalityHashKey ColumnLowCardinality::computeHashKey(const ItemView & item) {
-    static const auto hasher = std::hash<ItemView::DataType>{};
-    if (item.type == Type::Void) {
-        // to distinguish NULL of ColumnNullable and empty string.
-        return {0u, 0u};
+void ColumnLowCardinality::buildUniqueItemsMap() {
+    UniqueItems new_unique_items_map;
+    new_unique_items_map.Reserve(dictionary_column_->Size());
+    for (size_t i = 0; i < dictionary_column_->Size(); ++i) {
+        new_unique_items_map.Insert(computeHashKey(dictionary_column_->GetItem(i)), i);
     }
 
-    const auto hash1 = hasher(item.data);
-    const auto hash2 = CityHash64(item.data.data(), item.data.size());
+    unique_items_map_.Swap(new_unique_items_map);
+    unique_items_map_is_built_ = true;
+}
+
+std::uint64_t ColumnLowCardinality::computeHashKey(const ItemView & item) {
+    if (item.type == Type::Void) {
+        // NULL of ColumnNullable, is told apart from empty string by IsSameItem().
+        return 0u;
+    }
 
-    return details::LowCardinalityHashKey{hash1, hash2};
+    const auto key = GetItemKey(item);
+    return CityHash64(key.data(), key.size());
 }
 
 ColumnRef ColumnLowCardinality::GetDictionary() {
@@ -236,18 +384,142 @@ void ColumnLowCardinality::Append(ColumnRef col) {
     // - exactly same type as `this`: LowCardinality wrapping same dictionary type
     // - same type as dictionary column
 
-    auto c = col->As<ColumnLowCardinality>();
+    auto c = col->AsPtr<ColumnLowCardinality>();
     // If not LowCardinality of same dictionary type
     if (!c || !dictionary_column_->Type()->IsEqual(c->dictionary_column_->Type())) {
         // If not column of the same type as dictionary type
         if (!dictionary_column_->Type()->IsEqual(col->GetType())) {
             return;
         }
+    } else {
+        appendLowCardinality(*c);
+        return;
     }
 
+    constexpr size_t BatchSize = 1024;
+
+    index_column_->Reserve(index_column_->Size() + col->Size());
+
+    std::vector<ItemView> items;
+    items.reserve(std::min(BatchSize, col->Size()));
     for (size_t i = 0; i < col->Size(); ++i) {
-        AppendUnsafe(col->GetItem(i));
+        items.push_back(col->GetItem(i));
+        if (items.size() == BatchSize) {
+            AppendUnsafeMany(items);
+            items.clear();
+        }
+    }
+    AppendUnsafeMany(items);
+}
+
+void ColumnLowCardinality::appendLowCardinality(const ColumnLowCardinality & source) {
+    if (!unique_items_map_is_built_)
+        buildUniqueItemsMap();
+
+    const auto & source_dictionary = *source.dictionary_column_;
+    const auto rows = source.Size();
+
+    // Source dictionary index -> dictionary index in this column, resolved only for items that are actually
+    // referenced by source rows, so each unique source item is hashed and looked up at most once.
+    std::vector<std::uint64_t> remap(source_dictionary.Size(), UniqueItems::NotFound);
+
+    VisitIndexColumn([&](const auto & source_index) {
+        const auto source_data = source_index.GetData();
+        for (size_t i = 0; i < rows; ++i) {
+            auto & dictionary_index = remap[source_data[i]];
+            if (dictionary_index != UniqueItems::NotFound)
+                continue;
+
+            const auto item = source_dictionary.GetItem(source_data[i]);
+            const auto hash = computeHashKey(item);
+            dictionary_index = unique_items_map_.Find(hash, [this, &item](std::uint64_t index) {
+                return IsSameItem(item, dictionary_column_->GetItem(index));
+            });
+
+            if (dictionary_index == UniqueItems::NotFound) {
+                // Item is registered in unique items map only after it was successfully added to dictionary,
+                // if that throws, index column is not modified yet and there is nothing to rollback.
+                AppendToDictionary(*dictionary_column_, item);
+                dictionary_index = dictionary_column_->Size() - 1;
+                unique_items_map_.Insert(hash, dictionary_index);
+            }
+        }
+    }, *source.index_column_);
+
+    // Dictionary may have grown beyond the range of the index type, e.g. of UInt8 index after Load().
+    widenIndexColumn(dictionary_column_->Size() - 1);
+
+    VisitIndexColumn([&](auto & index) {
+        using IndexDataType = typename std::decay_t<decltype(index)>::DataType;
+
+        auto & data = index.GetWritableData();
+        const auto initial_size = data.size();
+        data.resize(initial_size + rows);
+
+        // Source index data is fetched after resize(), since source may be this very column.
+        VisitIndexColumn([&](const auto & source_index) {
+            const auto source_data = source_index.GetData();
+            for (size_t i = 0; i < rows; ++i) {
+                data[initial_size + i] = static_cast<IndexDataType>(remap[source_data[i]]);
+            }
+        }, *source.index_column_);
+    }, *index_column_);
+}
+
+void ColumnLowCardinality::AppendIndices(const Column& dictionary, Span<const uint64_t> indices, Span<const uint8_t> nulls) {
+    if (!nulls.empty()) {
+        if (!dictionary_column_->AsPtr<ColumnNullable>()) {
+            throw ValidationError("Can't append NULLs to " + type_->GetName());
+        }
+        if (nulls.size() != indices.size()) {
+            throw ValidationError("Count of null flags " + std::to_string(nulls.size()) + " doesn't match count of indices "
+                    + std::to_string(indices.size()));
+        }
+    }
+
+    if (!unique_items_map_is_built_)
+        buildUniqueItemsMap();
+
+    // Index in `dictionary` -> dictionary index in this column, resolved only for items that are actually referenced.
+    std::vector<std::uint64_t> remap(dictionary.Size(), UniqueItems::NotFound);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (!nulls.empty() && nulls[i])
+            continue;
+        if (indices[i] >= remap.size()) {
+            throw ValidationError("Index " + std::to_string(indices[i]) + " is out of dictionary of "
+                    + std::to_string(remap.size()) + " items");
+        }
+
+        auto & dictionary_index = remap[indices[i]];
+        if (dictionary_index != UniqueItems::NotFound)
+            continue;
+
+        const auto item = dictionary.GetItem(indices[i]);
+        const auto hash = computeHashKey(item);
+        dictionary_index = unique_items_map_.Find(hash, [this, &item](std::uint64_t index) {
+            return IsSameItem(item, dictionary_column_->GetItem(index));
+        });
+
+        if (dictionary_index == UniqueItems::NotFound) {
+            AppendToDictionary(*dictionary_column_, item);
+            dictionary_index = dictionary_column_->Size() - 1;
+            unique_items_map_.Insert(hash, dictionary_index);
+        }
     }
+
+    widenIndexColumn(dictionary_column_->Size() - 1);
+
+    VisitIndexColumn([&](auto & index) {
+        using IndexDataType = typename std::decay_t<decltype(index)>::DataType;
+
+        auto & data = index.GetWritableData();
+        data.reserve(data.size() + indices.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            // NULL is the first item of the dictionary.
+            const bool is_null = !nulls.empty() && nulls[i];
+            data.push_back(is_null ? 0 : static_cast<IndexDataType>(remap[indices[i]]));
+        }
+    }, *index_column_);
 }
 
 namespace {
@@ -277,7 +549,7 @@ auto Load(ColumnRef new_dictionary_column, InputStream& input, size_t rows) {
         throw ProtocolError("Failed to read number of rows in dictionary column.");
 
     auto dataColumn = new_dictionary_column;
-    if (auto nullable = new_dictionary_column->As<ColumnNullable>()) {
+    if (auto nullable = new_dictionary_column->AsPtr<ColumnNullable>()) {
         dataColumn = nullable->Nested();
     }
 
@@ -291,25 +563,20 @@ auto Load(ColumnRef new_dictionary_column, InputStream& input, size_t rows) {
     if (number_of_rows != rows)
         throw AssertionError("LowCardinality column must be read in full.");
 
-    new_index_column->LoadBody(&input, number_of_rows);
+    if (!new_index_column->LoadBody(&input, number_of_rows))
+        throw ProtocolError("Failed to read values of index column.");
 
-    if (auto nullable = new_dictionary_column->As<ColumnNullable>()) {
+    if (auto nullable = new_dictionary_column->AsPtr<ColumnNullable>()) {
         nullable->Append(true);
         for(std::size_t i = 1; i < dataColumn->Size(); i++) {
             nullable->Append(false);
         }
     }
 
-    ColumnLowCardinality::UniqueItems new_unique_items_map;
-    for (size_t i = 0; i < dataColumn->Size(); ++i) {
-        const auto key = ColumnLowCardinality::computeHashKey(new_dictionary_column->GetItem(i));
-        new_unique_items_map.emplace(key, i);
-    }
-
     // suffix
     // NOP
 
-    return std::make_tuple(new_dictionary_column, new_index_column, new_unique_items_map);
+    return std::make_tuple(new_dictionary_column, new_index_column);
 }
 
 }
@@ -328,11 +595,15 @@ bool ColumnLowCardinality::LoadPrefix(InputStream* input, size_t) {
 
 bool ColumnLowCardinality::LoadBody(InputStream* input, size_t rows) {
     try {
-        auto [new_dictionary, new_index, new_unique_items_map] = ::Load(dictionary_column_->CloneEmpty(), *input, rows);
+        auto [new_dictionary, new_index] = ::Load(dictionary_column_->CloneEmpty(), *input, rows);
 
         dictionary_column_->Swap(*new_dictionary);
         index_column_.swap(new_index);
-        unique_items_map_.swap(new_unique_items_map);
+
+        // Column that was read from server is most likely never appended to,
+        // so unique items map is going to be built on first append, if any.
+        unique_items_map_.Clear();
+        unique_items_map_is_built_ = false;
 
         return true;
     } catch (...) {
@@ -352,7 +623,7 @@ void ColumnLowCardinality::SaveBody(OutputStream* output) {
     const uint64_t number_of_keys = dictionary_column_->Size();
     WireFormat::WriteFixed(*output, number_of_keys);
 
-    if (auto columnNullable = dictionary_column_->As<ColumnNullable>()) {
+    if (auto columnNullable = dictionary_column_->AsPtr<ColumnNullable>()) {
         columnNullable->Nested()->SaveBody(output);
     } else {
         dictionary_column_->SaveBody(output);
@@ -367,9 +638,10 @@ void ColumnLowCardinality::SaveBody(OutputStream* output) {
 void ColumnLowCardinality::Clear() {
     index_column_->Clear();
     dictionary_column_->Clear();
-    unique_items_map_.clear();
+    unique_items_map_.Clear();
+    unique_items_map_is_built_ = true;
 
-    if (auto columnNullable = dictionary_column_->As<ColumnNullable>()) {
+    if (dictionary_column_->AsPtr<ColumnNullable>()) {
         AppendNullItem();
     }
     AppendDefaultItem();
@@ -385,8 +657,12 @@ ColumnRef ColumnLowCardinality::Slice(size_t begin, size_t len) const {
 
     auto result = std::make_shared<ColumnLowCardinality>(dictionary_column_->CloneEmpty());
 
+    std::vector<ItemView> items;
+    items.reserve(len);
     for (size_t i = begin; i < begin + len; ++i)
-        result->AppendUnsafe(this->GetItem(i));
+        items.push_back(this->GetItem(i));
+
+    result->AppendUnsafeMany(items);
 
     return result;
 }
@@ -406,17 +682,18 @@ void ColumnLowCardinality::Swap(Column& other) {
     dictionary_column_->Swap(*col.dictionary_column_);
 
     index_column_.swap(col.index_column_);
-    unique_items_map_.swap(col.unique_items_map_);
+    unique_items_map_.Swap(col.unique_items_map_);
+    std::swap(unique_items_map_is_built_, col.unique_items_map_is_built_);
 }
 
 ItemView ColumnLowCardinality::GetItem(size_t index) const {
     const auto dictionaryIndex = getDictionaryIndex(index);
 
-    if (auto nullable = dictionary_column_->As<ColumnNullable>()) {
+    if (dictionary_column_->AsPtr<ColumnNullable>()) {
         const auto isNull = dictionaryIndex == 0u;
 
         if (isNull) {
-            return GetNullItemForDictionary(nullable);
+            return GetNullItemForDictionary(dictionary_column_);
         }
     }
 
@@ -425,10 +702,25 @@ ItemView ColumnLowCardinality::GetItem(size_t index) const {
 
 // No checks regarding value type or validity of value is made.
 void ColumnLowCardinality::AppendUnsafe(const ItemView & value) {
-    const auto key = computeHashKey(value);
+    AppendUnsafe(value, computeHashKey(value));
+}
+
+void ColumnLowCardinality::AppendUnsafe(const ItemView & value, std::uint64_t hash) {
+    if (!unique_items_map_is_built_)
+        buildUniqueItemsMap();
+
     const auto initial_index_size = index_column_->Size();
+    auto dictionary_index = unique_items_map_.Find(hash, [this, &value](std::uint64_t index) {
+        return IsSameItem(value, dictionary_column_->GetItem(index));
+    });
+
     // If the value is unique, then we are going to append it to a dictionary, hence new index is Size().
-    auto [iterator, is_new_item] = unique_items_map_.try_emplace(key, dictionary_column_->Size());
+    const bool is_new_item = dictionary_index == UniqueItems::NotFound;
+    if (is_new_item) {
+        dictionary_index = dictionary_column_->Size();
+        unique_items_map_.Insert(hash, dictionary_index);
+    }
+
     try {
         // Order is important, adding to dictionary last, since it is much (MUCH!!!!) harder
         // to remove item from dictionary column than from index column
@@ -436,7 +728,7 @@ void ColumnLowCardinality::AppendUnsafe(const ItemView & value) {
         // Hence in catch-block we assume that dictionary wasn't modified on exception
         // and there is nothing to rollback.
 
-        appendIndex(iterator->second);
+        appendIndex(dictionary_index);
         if (is_new_item) {
             AppendToDictionary(*dictionary_column_, value);
         }
@@ -445,23 +737,34 @@ void ColumnLowCardinality::AppendUnsafe(const ItemView & value) {
         if (index_column_->Size() != initial_index_size)
             removeLastIndex();
         if (is_new_item)
-            unique_items_map_.erase(iterator);
+            unique_items_map_.Erase(hash, dictionary_index);
 
         throw;
     }
 }
 
+void ColumnLowCardinality::AppendUnsafeMany(const std::vector<ItemView> & items) {
+    std::vector<std::uint64_t> hashes(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        hashes[i] = computeHashKey(items[i]);
+    }
+
+    for (size_t i = 0; i < items.size(); ++i) {
+        AppendUnsafe(items[i], hashes[i]);
+    }
+}
+
 void ColumnLowCardinality::AppendNullItem()
 {
     const auto null_item = GetNullItemForDictionary(dictionary_column_);
     AppendToDictionary(*dictionary_column_, null_item);
-    unique_items_map_.emplace(computeHashKey(null_item), 0);
+    unique_items_map_.Insert(computeHashKey(null_item), 0);
 }
 
 void ColumnLowCardinality::AppendDefaultItem()
 {
     const auto defaultItem = GetDefaultItemForDictionary(dictionary_column_);
-    unique_items_map_.emplace(computeHashKey(defaultItem), dictionary_column_->Size());
+    unique_items_map_.Insert(computeHashKey(defaultItem), dictionary_column_->Size());
     AppendToDictionary(*dictionary_column_, defaultItem);
 }
 
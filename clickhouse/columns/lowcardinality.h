@@ -1,37 +1,25 @@
 #pragma once
 
+#include "../base/hash_index.h"
 #include "column.h"
 #include "numeric.h"
 #include "nullable.h"
 
-#include <functional>
+#include <cstdint>
+#include <iterator>
 #include <string>
-#include <unordered_map>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace clickhouse {
 
 template <typename NestedColumnType>
 class ColumnLowCardinalityT;
 
-namespace details {
-
-/** LowCardinalityHashKey used as key in unique items hashmap to abstract away key value
- * (type of which depends on dictionary column) and to reduce likelehood of collisions.
- *
- * In order to dramatically reduce collision rate, we use 2 different hashes from 2 different hash functions.
- * First hash is used in hashtable (to calculate item position).
- * Second one is used as part of key value and accessed via `operator==()` upon collision resolution/detection.
- */
-using LowCardinalityHashKey = std::pair<std::uint64_t, std::uint64_t>;
-
-struct LowCardinalityHashKeyHash {
-    inline std::size_t operator()(const LowCardinalityHashKey &hash_key) const noexcept {
-        return hash_key.first;
-    }
-};
-
-}
+class ColumnDate;
+class ColumnDate32;
+class ColumnDateTime;
 
 /*
  * LC column contains an "invisible" default item at the beginning of the collection. [default, ...]
@@ -40,7 +28,7 @@ struct LowCardinalityHashKeyHash {
  * */
 class ColumnLowCardinality : public Column {
 public:
-    using UniqueItems = std::unordered_map<details::LowCardinalityHashKey, size_t /*dictionary index*/, details::LowCardinalityHashKeyHash>;
+    using UniqueItems = HashIndex;
 
     template <typename T>
     friend class ColumnLowCardinalityT;
@@ -51,6 +39,8 @@ private:
     ColumnRef dictionary_column_;
     ColumnRef index_column_;
     UniqueItems unique_items_map_;
+    // false if unique_items_map_ doesn't reflect contents of dictionary_column_ yet (i.e. after Load()).
+    bool unique_items_map_is_built_ = true;
 
 public:
     ColumnLowCardinality(ColumnLowCardinality&& col) = default;
@@ -97,13 +87,36 @@ public:
     size_t GetDictionarySize() const;
     TypeRef GetNestedType() const;
 
+    /** Read-only column of unique values, indexed by GetIndexColumn(), starting with NULL (if the dictionary is Nullable)
+     *  and the default value.
+     */
+    inline ColumnRef GetDictionaryColumn() const { return dictionary_column_; }
+
+    /// Read-only column of indices of rows in the dictionary: ColumnUInt8, ColumnUInt16, ColumnUInt32 or ColumnUInt64.
+    inline ColumnRef GetIndexColumn() const { return index_column_; }
+
+    /** Appends rows of items of `dictionary`, a column of the nested type without Nullable, at given `indices`.
+     *  `nulls` is either empty or a flag of each row, flagged rows are NULL and their indices are ignored,
+     *  it must be empty unless the nested type is Nullable.
+     *  Each item of `dictionary` used by the rows is looked up in the dictionary of this column once.
+     */
+    void AppendIndices(const Column& dictionary, Span<const uint64_t> indices, Span<const uint8_t> nulls = {});
+
 protected:
     std::uint64_t getDictionaryIndex(std::uint64_t item_index) const;
     void appendIndex(std::uint64_t item_index);
+    // Replaces index column with a wider one, if it can't hold given dictionary index, e.g. UInt8 index after Load().
+    void widenIndexColumn(std::uint64_t max_dictionary_index);
     void removeLastIndex();
+    void buildUniqueItemsMap();
+    /// Merges dictionary of `source` into this one and appends all rows of `source`, translating indices.
+    void appendLowCardinality(const ColumnLowCardinality & source);
     ColumnRef GetDictionary();
 
     void AppendUnsafe(const ItemView &);
+    void AppendUnsafe(const ItemView &, std::uint64_t hash);
+    /// Appends items in batch: hashes are computed for all items before the dictionary lookup.
+    void AppendUnsafeMany(const std::vector<ItemView> & items);
 
 private:
     void Setup(ColumnRef dictionary_column);
@@ -111,16 +124,45 @@ private:
     void AppendDefaultItem();
 
 public:
-    static details::LowCardinalityHashKey computeHashKey(const ItemView &);
+    static std::uint64_t computeHashKey(const ItemView &);
+};
+
+template <>
+struct ColumnTypeCodeFilter<ColumnLowCardinality> {
+    static constexpr bool Matches(Type::Code code) { return code == Type::LowCardinality; }
+};
+
+namespace details {
+
+/// Columns which convert value on Append() (e.g. Date from std::time_t), so ItemView can't be made from the value directly.
+template <typename T>
+constexpr bool LowCardinalityConvertsValue =
+        std::is_same_v<T, ColumnDate> || std::is_same_v<T, ColumnDate32> || std::is_same_v<T, ColumnDateTime>;
+
+template <typename T, typename = void>
+struct LowCardinalityDataColumn {
+    using Type = T;
+};
+
+template <typename T>
+struct LowCardinalityDataColumn<T, std::void_t<typename T::NestedColumnType>> {
+    using Type = typename T::NestedColumnType;
 };
 
+}
+
 /** Type-aware wrapper that provides simple convenience interface for accessing/appending individual items.
  */
 template <typename DictionaryColumnType>
 class ColumnLowCardinalityT : public ColumnLowCardinality {
+    // Type of non-NULL values in dictionary.
+    using DataColumnType = typename details::LowCardinalityDataColumn<DictionaryColumnType>::Type;
+    static constexpr bool ConvertsValue = details::LowCardinalityConvertsValue<DataColumnType>;
 
     DictionaryColumnType& typed_dictionary_;
     const Type::Code type_;
+    // Holds single converted value while it is appended, only used if ConvertsValue.
+    std::shared_ptr<DataColumnType> convert_buffer_;
 
 public:
     using WrappedColumnType = DictionaryColumnType;
@@ -162,21 +204,44 @@ public:
     using ColumnLowCardinality::Append;
 
     inline void Append(const ValueType & value) {
-        if constexpr (IsNullable<WrappedColumnType>) {
-            if (value.has_value()) {
-                AppendUnsafe(ItemView{type_, *value});
-            } else {
-                AppendUnsafe(ItemView{});
-            }
+        AppendUnsafe(MakeItemView(value));
+    }
+
+    /// True if AppendMany() appends items of the container in batches, rather than one by one.
+    /// Batching is only safe if items are stored in the container and are viewed by ItemView without
+    /// a temporary copy (e.g. std::string for LowCardinality(String)), so ItemView doesn't outlive the value.
+    template <typename Container>
+    static constexpr bool AppendsInBatches = []() {
+        using ItemType = decltype(*std::begin(std::declval<const Container&>()));
+        if constexpr (ConvertsValue || !std::is_reference_v<ItemType>) {
+            return false;
+        } else if constexpr (std::is_same_v<ValueType, std::string_view>) {
+            return std::is_convertible_v<ItemType, std::string_view>;
         } else {
-            AppendUnsafe(ItemView{type_, value});
+            return std::is_same_v<std::decay_t<ItemType>, ValueType>;
         }
-    }
+    }();
 
+    /// Appends all items of `container`, e.g. std::vector or Span, to the end of column.
     template <typename T>
     inline void AppendMany(const T& container) {
-        for (const auto & item : container) {
-            Append(item);
+        if constexpr (AppendsInBatches<T>) {
+            constexpr size_t BatchSize = 1024;
+
+            std::vector<ItemView> items;
+            items.reserve(BatchSize);
+            for (const auto & item : container) {
+                items.push_back(MakeItemView(item));
+                if (items.size() == BatchSize) {
+                    AppendUnsafeMany(items);
+                    items.clear();
+                }
+            }
+            AppendUnsafeMany(items);
+        } else {
+            for (const auto & item : container) {
+                Append(item);
+            }
         }
     }
 
@@ -206,6 +271,33 @@ public:
 
 private:
 
+    inline ItemView MakeItemView(const ValueType & value) {
+        if constexpr (IsNullable<WrappedColumnType>) {
+            if (value.has_value()) {
+                return MakeDataItemView(*value);
+            } else {
+                return ItemView{};
+            }
+        } else {
+            return MakeDataItemView(value);
+        }
+    }
+
+    // If ConvertsValue, returned ItemView is valid only until the next call.
+    template <typename T>
+    inline ItemView MakeDataItemView(const T & value) {
+        if constexpr (ConvertsValue) {
+            if (!convert_buffer_)
+                convert_buffer_ = std::make_shared<DataColumnType>();
+
+            convert_buffer_->Clear();
+            convert_buffer_->Append(value);
+            return convert_buffer_->GetItem(0);
+        } else {
+            return ItemView{type_, value};
+        }
+    }
+
     template <typename T>
     static auto GetTypeCode(T& column) {
         if constexpr (IsNullable<T>) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../base/hash_index.h"
 #include "../base/projected_iterator.h"
 #include "array.h"
 #include "column.h"
@@ -7,6 +8,9 @@
 
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 
 namespace clickhouse {
 
@@ -58,6 +62,9 @@ public:
     /// Type of row is tuple {key, value}.
     ColumnRef GetAsColumn(size_t n) const;
 
+    /// Read-only column of entries of all rows, of Array(Tuple(key, value)).
+    inline std::shared_ptr<ColumnArray> GetEntries() const { return data_; }
+
 protected:
     template <typename K, typename V>
     friend class ColumnMapT;
@@ -97,9 +104,26 @@ public:
     void Swap(Column& other) override {
         auto& col = dynamic_cast<ColumnMapT<K, V>&>(other);
         col.typed_data_.swap(typed_data_);
+        col.ResetKeyIndex();
+        ResetKeyIndex();
         ColumnMap::Swap(other);
     }
 
+    void Append(ColumnRef column) override {
+        ResetKeyIndex();
+        ColumnMap::Append(std::move(column));
+    }
+
+    bool LoadBody(InputStream* input, size_t rows) override {
+        ResetKeyIndex();
+        return ColumnMap::LoadBody(input, rows);
+    }
+
+    void Clear() override {
+        ResetKeyIndex();
+        ColumnMap::Clear();
+    }
+
     /// A single (row) value of the Map-column i.e. read-only map.
     /// It has a linear time complexity to access items
     /// Because data base type has same structure
@@ -217,11 +241,44 @@ public:
 
     inline auto operator[](size_t index) const { return At(index); }
 
+    /** Returns value of the `key` in map at row `n`, or std::nullopt if there is no such key.
+     *  Same as At(n).Find(key), but in constant time on average instead of linear time in size of the map.
+     *
+     *  First call builds a hash index over keys of all rows, which is dropped on any modification of the column,
+     *  so it pays off for repeated lookups into the same block. The index is built once even if the method is called
+     *  concurrently, but like any other method it must not run concurrently with modifications of the column.
+     */
+    std::optional<Value> FindValue(size_t n, const Key& key) const {
+        if (n >= Size())
+            throw ValidationError("ColumnMap row index out of bounds: "
+                    + std::to_string(n) + ", max is " + std::to_string(Size()));
+
+        std::call_once(key_index_->built, [this]() { key_index_->index = BuildKeyIndex(); });
+        const auto & key_index = *key_index_->index;
+
+        const auto & keys = *key_index.keys;
+        const size_t begin = typed_data_->GetOffset(n);
+        const size_t end = begin + typed_data_->GetSize(n);
+
+        const auto pos = key_index.index.Find(HashKey(n, key), [&](std::uint64_t i) {
+            return i >= begin && i < end && keys[i] == key;
+        });
+
+        if (pos == HashIndex::NotFound)
+            return std::nullopt;
+
+        return (*key_index.values)[pos];
+    }
+
     using ColumnMap::Append;
 
-    inline void Append(const MapValueView& value) { typed_data_->Append(value.data_); }
+    inline void Append(const MapValueView& value) {
+        ResetKeyIndex();
+        typed_data_->Append(value.data_);
+    }
 
     inline void Append(const std::vector<std::tuple<Key, Value>>& tuples) {
+        ResetKeyIndex();
         typed_data_->Append(tuples.begin(), tuples.end());
     }
 
@@ -237,6 +294,7 @@ public:
             return std::make_tuple(std::cref(i->first), std::cref(i->second));
         };
 
+        ResetKeyIndex();
         typed_data_->Append(Iterator{value.begin(), functor}, Iterator{value.end(), functor});
     }
 
@@ -251,7 +309,59 @@ public:
     static auto Wrap(ColumnRef&& col) { return Wrap(std::move(*col->AsStrict<ColumnMap>())); }
 
 private:
+    // Hash of the key combined with row number, so same key in different rows occupies different slots.
+    static std::uint64_t HashKey(size_t row, const Key& key) {
+        std::uint64_t hash = static_cast<std::uint64_t>(std::hash<Key>{}(key)) ^ (row * 0x9E3779B97F4A7C15ull);
+
+        // splitmix64 finalizer, since std::hash of integers is usually identity.
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+        return hash ^ (hash >> 31);
+    }
+
+    struct KeyIndex;
+
+    std::unique_ptr<KeyIndex> BuildKeyIndex() const {
+        auto tuple = typed_data_->GetData()->template AsStrict<ColumnTuple>();
+
+        auto key_index = std::make_unique<KeyIndex>();
+        key_index->keys = tuple->At(0)->template AsStrict<KeyColumnType>();
+        key_index->values = tuple->At(1)->template AsStrict<ValueColumnType>();
+
+        const auto & keys = *key_index->keys;
+        key_index->index.Reserve(keys.Size());
+        for (size_t row = 0; row < Size(); ++row) {
+            const size_t begin = typed_data_->GetOffset(row);
+            const size_t end = begin + typed_data_->GetSize(row);
+            // Positions are inserted in ascending order, so the first of duplicate keys in a row is found first.
+            for (size_t i = begin; i < end; ++i) {
+                key_index->index.Insert(HashKey(row, keys[i]), i);
+            }
+        }
+
+        return key_index;
+    }
+
+    // Drops the index if it is built, the once_flag can't be reset, so it is replaced along with the index.
+    void ResetKeyIndex() {
+        if (key_index_->index)
+            key_index_ = std::make_unique<LazyKeyIndex>();
+    }
+
+    struct KeyIndex {
+        std::shared_ptr<KeyColumnType> keys;
+        std::shared_ptr<ValueColumnType> values;
+        HashIndex index;
+    };
+
+    struct LazyKeyIndex {
+        std::once_flag built;
+        std::unique_ptr<KeyIndex> index;
+    };
+
     std::shared_ptr<ArrayColumnType> typed_data_;
+    // Never null, the index in it is built by the first FindValue() call.
+    std::unique_ptr<LazyKeyIndex> key_index_ = std::make_unique<LazyKeyIndex>();
 };
 
 }  // namespace clickhouse
@@ -1,14 +1,45 @@
 #include "nullable.h"
 
+#include "utils.h"
+
 #include <assert.h>
+#include <cstring>
 #include <stdexcept>
 
+namespace {
+
+// Null flags are processed 8 at once, as a single 64-bit word of 8 bytes, host is expected to be little-endian.
+inline uint64_t LoadFlags(const uint8_t * flags) {
+    uint64_t word;
+    std::memcpy(&word, flags, sizeof(word));
+    return word;
+}
+
+// Packs 8 byte-sized flags into 8 bits, any non-zero byte is treated as set flag.
+inline uint8_t PackFlags(uint64_t word) {
+    // fold all bits of each byte into its lowest bit
+    word |= word >> 4;
+    word |= word >> 2;
+    word |= word >> 1;
+    word &= 0x0101010101010101ull;
+    // gather lowest bits of all bytes into the highest byte
+    return static_cast<uint8_t>((word * 0x0102040810204080ull) >> 56);
+}
+
+// Inverse of PackFlags(): spreads 8 bits into 8 bytes of values 0 or 1.
+inline uint64_t UnpackFlags(uint8_t bits) {
+    const uint64_t spread = (bits * 0x0101010101010101ull) & 0x8040201008040201ull;
+    return ((spread + 0x7F7F7F7F7F7F7F7Full) >> 7) & 0x0101010101010101ull;
+}
+
+}
+
 namespace clickhouse {
 
 ColumnNullable::ColumnNullable(ColumnRef nested, ColumnRef nulls)
     : Column(Type::CreateNullable(nested->Type()))
     , nested_(nested)
-    , nulls_(nulls->As<ColumnUInt8>())
+    , nulls_(nulls->AsPtr<ColumnUInt8>() ? std::static_pointer_cast<ColumnUInt8>(nulls) : nullptr)
 {
     if (nested_->Size() != nulls->Size()) {
         throw ValidationError("count of elements in nested and nulls should be the same");
@@ -34,13 +65,97 @@ ColumnRef ColumnNullable::Nulls() const
        return nulls_;
 }
 
+size_t ColumnNullable::NullCount() const {
+    const auto nulls = nulls_->GetData();
+
+    // Plain loop over the flags, so compiler is free to vectorize it.
+    size_t count = 0;
+    for (size_t i = 0; i < nulls.size(); ++i) {
+        count += nulls[i] != 0;
+    }
+
+    return count;
+}
+
+bool ColumnNullable::HasNull() const {
+    const auto nulls = nulls_->GetData();
+
+    constexpr size_t BlockSize = 64;
+    size_t i = 0;
+    for (; i + BlockSize <= nulls.size(); i += BlockSize) {
+        uint64_t any = 0;
+        for (size_t j = i; j < i + BlockSize; j += sizeof(any)) {
+            any |= LoadFlags(nulls.data() + j);
+        }
+
+        if (any)
+            return true;
+    }
+
+    for (; i < nulls.size(); ++i) {
+        if (nulls[i])
+            return true;
+    }
+
+    return false;
+}
+
+void ColumnNullable::CopyNullBitmap(Span<uint64_t> dest, size_t begin, size_t rows) const {
+    const auto nulls = nulls_->GetData();
+    ValidateCopyToRange(nulls.size(), begin, rows);
+    if (dest.size() * 64 < rows) {
+        throw ValidationError("Bitmap of " + std::to_string(dest.size()) + " words can't hold "
+                + std::to_string(rows) + " null flags");
+    }
+
+    const uint8_t * flags = nulls.data() + begin;
+    const size_t words = (rows + 63) / 64;
+    for (size_t w = 0; w < words; ++w) {
+        uint64_t bits = 0;
+        const size_t first = w * 64;
+        const size_t count = std::min<size_t>(64, rows - first);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            bits |= static_cast<uint64_t>(PackFlags(LoadFlags(flags + first + i))) << i;
+        }
+        for (; i < count; ++i) {
+            bits |= static_cast<uint64_t>(flags[first + i] != 0) << i;
+        }
+
+        dest[w] = bits;
+    }
+}
+
+void ColumnNullable::AppendNullBitmap(Span<const uint64_t> bitmap, size_t rows) {
+    if (bitmap.size() * 64 < rows) {
+        throw ValidationError("Bitmap of " + std::to_string(bitmap.size()) + " words doesn't hold "
+                + std::to_string(rows) + " null flags");
+    }
+
+    auto & data = nulls_->GetWritableData();
+    const auto initial_size = data.size();
+    data.resize(initial_size + rows);
+
+    uint8_t * flags = data.data() + initial_size;
+    size_t i = 0;
+    for (; i + 8 <= rows; i += 8) {
+        const auto bits = static_cast<uint8_t>(bitmap[i / 64] >> (i % 64));
+        const uint64_t word = UnpackFlags(bits);
+        std::memcpy(flags + i, &word, sizeof(word));
+    }
+    for (; i < rows; ++i) {
+        flags[i] = (bitmap[i / 64] >> (i % 64)) & 1;
+    }
+}
+
 void ColumnNullable::Reserve(size_t new_cap) {
     nested_->Reserve(new_cap);
     nulls_->Reserve(new_cap);
 }
 
 void ColumnNullable::Append(ColumnRef column) {
-    if (auto col = column->As<ColumnNullable>()) {
+    if (auto col = column->AsPtr<ColumnNullable>()) {
         if (!col->nested_->Type()->IsEqual(nested_->Type())) {
             return;
         }
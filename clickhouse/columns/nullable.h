@@ -3,6 +3,7 @@
 #include "column.h"
 #include "numeric.h"
 
+#include <cstring>
 #include <optional>
 
 namespace clickhouse {
@@ -26,6 +27,21 @@ public:
     /// Returns nulls column.
     ColumnRef Nulls() const;
 
+    /// Returns number of NULL values in the column.
+    size_t NullCount() const;
+
+    /// Returns true if there is at least one NULL value in the column, stops on the first one found.
+    bool HasNull() const;
+
+    /** Packs null flags of rows [begin, begin + rows) into a validity bitmap:
+     *  bit `i % 64` of `dest[i / 64]` is set if row `begin + i` is NULL.
+     *  `dest` must hold at least (rows + 63) / 64 words, unused bits of the last word are zeroed.
+     */
+    void CopyNullBitmap(Span<uint64_t> dest, size_t begin, size_t rows) const;
+
+    /// Appends `rows` null flags from the bitmap of the layout described above, nested column is not modified.
+    void AppendNullBitmap(Span<const uint64_t> bitmap, size_t rows);
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
@@ -63,6 +79,11 @@ private:
     std::shared_ptr<ColumnUInt8> nulls_;
 };
 
+template <>
+struct ColumnTypeCodeFilter<ColumnNullable> {
+    static constexpr bool Matches(Type::Code code) { return code == Type::Nullable; }
+};
+
 template <typename ColumnType>
 class ColumnNullableT : public ColumnNullable {
 public:
@@ -89,6 +110,33 @@ public:
 
     inline ValueType operator[](size_t index) const { return At(index); }
 
+    /// Calls `f(index, value)` for each non-NULL row, checking null flags of 8 rows at once.
+    template <typename Func>
+    void ForEachNotNull(Func && f) const {
+        const auto nulls = Nulls()->template AsStrict<ColumnUInt8>()->GetData();
+        const auto & nested = *typed_nested_data_;
+
+        size_t i = 0;
+        for (; i + 8 <= nulls.size(); i += 8) {
+            uint64_t flags;
+            std::memcpy(&flags, nulls.data() + i, sizeof(flags));
+            if (flags == 0) {
+                for (size_t j = i; j < i + 8; ++j)
+                    f(j, nested.At(j));
+            } else {
+                for (size_t j = i; j < i + 8; ++j) {
+                    if (nulls[j] == 0)
+                        f(j, nested.At(j));
+                }
+            }
+        }
+
+        for (; i < nulls.size(); ++i) {
+            if (nulls[i] == 0)
+                f(i, nested.At(i));
+        }
+    }
+
     /// Appends content of given column to the end of current one.
     void Append(ColumnRef column) override {
         ColumnNullable::Append(std::move(column));
@@ -103,6 +151,24 @@ public:
         }
     }
 
+    /// Appends all elements of `values` to the end of column, null flags are appended at once.
+    void AppendMany(Span<const ValueType> values) {
+        auto & nulls = Nulls()->template AsStrict<ColumnUInt8>()->GetWritableData();
+        const auto old_size = nulls.size();
+        nulls.resize(old_size + values.size());
+
+        auto & nested = *typed_nested_data_;
+        nested.Reserve(nested.Size() + values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            nulls[old_size + i] = !values[i].has_value();
+            if (values[i].has_value()) {
+                nested.Append(*values[i]);
+            } else {
+                nested.Append(typename ValueType::value_type{});
+            }
+        }
+    }
+
     /** Create a ColumnNullableT from a ColumnNullable, without copying data and offsets, but by
      * 'stealing' those from `col`.
      *
@@ -137,11 +203,7 @@ public:
 
 private:
     static inline auto FillNulls(size_t n){
-        auto result = std::make_shared<ColumnUInt8>();
-        for (size_t i = 0; i < n; ++i) {
-            result->Append(0);
-        }
-        return result;
+        return std::make_shared<ColumnUInt8>(std::vector<uint8_t>(n, 0));
     }
 
     std::shared_ptr<NestedColumnType> typed_nested_data_;
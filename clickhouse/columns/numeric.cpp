@@ -30,6 +30,18 @@ void ColumnVector<T>::Append(const T& value) {
     data_.push_back(value);
 }
 
+template <typename T>
+void ColumnVector<T>::AppendMany(Span<const T> values) {
+    AppendToVector(data_, values);
+}
+
+template <typename T>
+void ColumnVector<T>::CopyTo(Span<T> dest, size_t begin) const {
+    ValidateCopyToRange(data_.size(), begin, dest.size());
+
+    std::copy(data_.begin() + begin, data_.begin() + begin + dest.size(), dest.begin());
+}
+
 template <typename T>
 void ColumnVector<T>::Erase(size_t pos, size_t count) {
     const auto begin = std::min(pos, data_.size());
@@ -65,7 +77,7 @@ const T& ColumnVector<T>::At(size_t n) const {
 
 template <typename T>
 void ColumnVector<T>::Append(ColumnRef column) {
-    if (auto col = column->As<ColumnVector<T>>()) {
+    if (auto col = column->AsPtr<ColumnVector<T>>()) {
         data_.insert(data_.end(), col->data_.begin(), col->data_.end());
     }
 }
@@ -118,7 +130,11 @@ template class ColumnVector<uint16_t>;
 template class ColumnVector<uint32_t>;
 template class ColumnVector<uint64_t>;
 template class ColumnVector<Int128>;
+template class ColumnVector<Int256>;
+template class ColumnVector<absl::uint128>;
+template class ColumnVector<UInt256>;
 
+template class ColumnVector<BFloat16>;
 template class ColumnVector<float>;
 template class ColumnVector<double>;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "column.h"
+#include "../base/span.h"
 #include "absl/numeric/int128.h"
 
 namespace clickhouse {
@@ -25,6 +26,15 @@ public:
     /// Appends one element to the end of column.
     void Append(const T& value);
 
+    /// Appends all elements of `values` to the end of column.
+    void AppendMany(Span<const T> values);
+
+    /// Appends elements from [begin, end) to the end of column.
+    template <typename Iterator>
+    inline void AppendMany(Iterator begin, Iterator end) {
+        data_.insert(data_.end(), begin, end);
+    }
+
     /// Returns element at given row number.
     const T& At(size_t n) const;
 
@@ -36,6 +46,12 @@ public:
     /// Get Raw Vector Contents
     std::vector<T>& GetWritableData();
 
+    /// Read-only view on column contents, invalidated by any modification of the column.
+    inline Span<const T> GetData() const { return Span<const T>(data_.data(), data_.size()); }
+
+    /// Copies `dest.size()` elements starting at row `begin` into `dest`.
+    void CopyTo(Span<T> dest, size_t begin = 0) const;
+
     /// Returns the capacity of the column
     size_t Capacity() const;
 
@@ -73,13 +89,17 @@ using ColumnUInt8   = ColumnVector<uint8_t>;
 using ColumnUInt16  = ColumnVector<uint16_t>;
 using ColumnUInt32  = ColumnVector<uint32_t>;
 using ColumnUInt64  = ColumnVector<uint64_t>;
+using ColumnUInt128 = ColumnVector<absl::uint128>;
+using ColumnUInt256 = ColumnVector<UInt256>;
 
 using ColumnInt8    = ColumnVector<int8_t>;
 using ColumnInt16   = ColumnVector<int16_t>;
 using ColumnInt32   = ColumnVector<int32_t>;
 using ColumnInt64   = ColumnVector<int64_t>;
 using ColumnInt128  = ColumnVector<Int128>;
+using ColumnInt256  = ColumnVector<Int256>;
 
+using ColumnBFloat16 = ColumnVector<BFloat16>;
 using ColumnFloat32 = ColumnVector<float>;
 using ColumnFloat64 = ColumnVector<double>;
 
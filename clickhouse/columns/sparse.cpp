@@ -0,0 +1,402 @@
+#include "sparse.h"
+#include "nullable.h"
+#include "numeric.h"
+#include "tuple.h"
+
+#include "../base/input.h"
+#include "../base/wire_format.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+using namespace clickhouse;
+
+// Set in the last group size of offsets, which is followed by no value.
+constexpr uint64_t EndOfGranuleFlag = 1ULL << 62;
+
+// Kinds of serialization of columns, sent in blocks with custom serialization.
+enum SerializationKind : uint8_t {
+    Default = 0,
+    Sparse = 1,
+};
+
+/// Endless stream of zero bytes, the native encoding of default values of most column types.
+class ZeroInput : public InputStream {
+public:
+    bool Skip(size_t) override {
+        return true;
+    }
+
+protected:
+    size_t DoRead(void* buf, size_t len) override {
+        std::memset(buf, 0, len);
+        return len;
+    }
+};
+
+ColumnRef CreateDefaults(const ColumnRef & prototype, size_t rows) {
+    // Default of Nullable is NULL and defaults of elements of Tuple may be so, zero bytes do not make them.
+    if (const auto nullable = prototype->As<ColumnNullable>()) {
+        return std::make_shared<ColumnNullable>(CreateDefaults(nullable->Nested(), rows),
+                std::make_shared<ColumnUInt8>(std::vector<uint8_t>(rows, 1)));
+    }
+    if (const auto tuple = prototype->As<ColumnTuple>()) {
+        std::vector<ColumnRef> elements;
+        elements.reserve(tuple->TupleSize());
+        for (size_t i = 0; i < tuple->TupleSize(); ++i) {
+            elements.push_back(CreateDefaults(tuple->At(i), rows));
+        }
+        return std::make_shared<ColumnTuple>(elements);
+    }
+
+    auto result = prototype->CloneEmpty();
+    ZeroInput zeros;
+    if (rows && !result->LoadBody(&zeros, rows)) {
+        throw UnimplementedError("Can't make default values of column of " + prototype->Type()->GetName());
+    }
+    return result;
+}
+
+bool IsZero(const ItemView & item) {
+    return std::all_of(item.data.begin(), item.data.end(), [](char c) { return c == 0; });
+}
+
+bool LoadKinds(InputStream* input, const TypeRef & type, ColumnRef* column) {
+    uint8_t kind;
+    if (!WireFormat::ReadFixed(*input, &kind)) {
+        return false;
+    }
+    if (kind != Default && kind != Sparse) {
+        throw UnimplementedError("Serialization kind " + std::to_string(kind) + " of column of "
+                + type->GetName() + " is not supported");
+    }
+
+    // Tuples have kinds of their elements, Point is Tuple(Float64, Float64) in ClickHouse.
+    if (type->GetCode() == Type::Tuple) {
+        const auto & element_types = type->As<TupleType>()->GetTupleType();
+        const auto tuple = (*column)->AsStrict<ColumnTuple>();
+
+        std::vector<ColumnRef> elements;
+        elements.reserve(element_types.size());
+        bool has_sparse = false;
+        for (size_t i = 0; i < element_types.size(); ++i) {
+            auto element = tuple->At(i);
+            if (!LoadKinds(input, element_types[i], &element)) {
+                return false;
+            }
+            has_sparse |= element != tuple->At(i);
+            elements.push_back(std::move(element));
+        }
+        if (has_sparse) {
+            *column = std::make_shared<ColumnTuple>(elements);
+        }
+    } else if (type->GetCode() == Type::Point) {
+        for (size_t i = 0; i < 2; ++i) {
+            uint8_t element_kind;
+            if (!WireFormat::ReadFixed(*input, &element_kind)) {
+                return false;
+            }
+            if (element_kind != Default) {
+                throw UnimplementedError("Sparse coordinates of Point column are not supported");
+            }
+        }
+    }
+
+    if (kind == Sparse) {
+        *column = std::make_shared<ColumnSparse>(*column);
+    }
+    return true;
+}
+
+void SaveKinds(OutputStream* output, const TypeRef & type, const Column* column) {
+    const auto sparse = dynamic_cast<const ColumnSparse*>(column);
+    WireFormat::WriteFixed<uint8_t>(*output, sparse ? Sparse : Default);
+    if (sparse) {
+        column = sparse->GetValues().get();
+    }
+
+    if (type->GetCode() == Type::Tuple) {
+        const auto & element_types = type->As<TupleType>()->GetTupleType();
+        const auto tuple = dynamic_cast<const ColumnTuple*>(column);
+        for (size_t i = 0; i < element_types.size(); ++i) {
+            SaveKinds(output, element_types[i], tuple ? tuple->At(i).get() : nullptr);
+        }
+    } else if (type->GetCode() == Type::Point) {
+        WireFormat::WriteFixed<uint8_t>(*output, Default);
+        WireFormat::WriteFixed<uint8_t>(*output, Default);
+    }
+}
+
+}
+
+namespace clickhouse {
+
+ColumnSparse::ColumnSparse(ColumnRef values)
+    : Column(values->Type())
+    , values_(std::move(values))
+{
+    if (values_->Size() != 0) {
+        throw ValidationError("Column of values of sparse column must be empty");
+    }
+}
+
+std::shared_ptr<ColumnSparse> ColumnSparse::FromDense(const ColumnRef& dense) {
+    auto result = std::make_shared<ColumnSparse>(dense->CloneEmpty());
+    const auto nullable = dense->As<ColumnNullable>();
+
+    for (size_t i = 0; i < dense->Size(); ++i) {
+        const bool is_default = nullable ? nullable->IsNull(i) : IsZero(dense->GetItem(i));
+        if (!is_default) {
+            result->offsets_.push_back(i);
+        }
+    }
+
+    // Append values by runs of adjacent rows.
+    const auto & offsets = result->offsets_;
+    for (size_t i = 0; i < offsets.size();) {
+        size_t j = i + 1;
+        while (j < offsets.size() && offsets[j] == offsets[j - 1] + 1) {
+            ++j;
+        }
+        result->values_->Append(dense->Slice(offsets[i], j - i));
+        i = j;
+    }
+    result->rows_ = dense->Size();
+
+    return result;
+}
+
+bool ColumnSparse::IsDefault(size_t n) const {
+    return !std::binary_search(offsets_.begin(), offsets_.end(), n);
+}
+
+ColumnRef ColumnSparse::Densify() const {
+    size_t max_defaults = 0;
+    uint64_t row = 0;
+    for (const auto offset : offsets_) {
+        max_defaults = std::max<size_t>(max_defaults, offset - row);
+        row = offset + 1;
+    }
+    max_defaults = std::max<size_t>(max_defaults, rows_ - row);
+
+    const auto defaults = CreateDefaults(values_, max_defaults);
+    if (offsets_.empty()) {
+        return defaults;
+    }
+
+    auto result = values_->CloneEmpty();
+    result->Reserve(rows_);
+
+    const auto append_defaults = [&](size_t count) {
+        if (count) {
+            result->Append(count == defaults->Size() ? defaults : defaults->Slice(0, count));
+        }
+    };
+
+    // Alternate runs of default rows with runs of adjacent non-default ones.
+    row = 0;
+    for (size_t i = 0; i < offsets_.size();) {
+        append_defaults(offsets_[i] - row);
+
+        size_t j = i + 1;
+        while (j < offsets_.size() && offsets_[j] == offsets_[j - 1] + 1) {
+            ++j;
+        }
+        result->Append(values_->Slice(i, j - i));
+        row = offsets_[j - 1] + 1;
+        i = j;
+    }
+    append_defaults(rows_ - row);
+
+    return result;
+}
+
+void ColumnSparse::AppendDefaults(size_t count) {
+    rows_ += count;
+}
+
+ColumnRef ColumnSparse::AppendToValues() {
+    offsets_.push_back(rows_++);
+    return values_;
+}
+
+void ColumnSparse::Reserve(size_t) {
+    // Count of non-default rows is unknown, there is nothing to reserve.
+}
+
+void ColumnSparse::Append(ColumnRef column) {
+    if (!column->Type()->IsEqual(type_)) {
+        throw ValidationError("Can't append " + column->Type()->GetName() + " to " + type_->GetName());
+    }
+
+    if (const auto col = column->As<ColumnSparse>()) {
+        offsets_.reserve(offsets_.size() + col->offsets_.size());
+        for (const auto offset : col->offsets_) {
+            offsets_.push_back(rows_ + offset);
+        }
+        values_->Append(col->values_);
+        rows_ += col->rows_;
+        return;
+    }
+
+    const auto rows = column->Size();
+    offsets_.reserve(offsets_.size() + rows);
+    for (size_t i = 0; i < rows; ++i) {
+        offsets_.push_back(rows_ + i);
+    }
+    values_->Append(column);
+    rows_ += rows;
+}
+
+bool ColumnSparse::LoadPrefix(InputStream* input, size_t rows) {
+    return values_->LoadPrefix(input, rows);
+}
+
+bool ColumnSparse::LoadBody(InputStream* input, size_t rows) {
+    // Offsets are sent as sizes of groups of default rows, each followed by a non-default one but the last.
+    offsets_.clear();
+    uint64_t row = 0;
+    for (;;) {
+        uint64_t group_size;
+        if (!WireFormat::ReadVarint64(*input, &group_size)) {
+            return false;
+        }
+
+        row += group_size & ~EndOfGranuleFlag;
+        if (group_size & EndOfGranuleFlag) {
+            break;
+        }
+        if (row >= rows) {
+            throw ProtocolError("Offset of sparse column is out of " + std::to_string(rows) + " rows");
+        }
+        offsets_.push_back(row++);
+    }
+    if (row != rows) {
+        throw ProtocolError("Sparse column has " + std::to_string(row) + " rows, expected " + std::to_string(rows));
+    }
+
+    if (!offsets_.empty() && !values_->LoadBody(input, offsets_.size())) {
+        return false;
+    }
+    rows_ = rows;
+
+    return true;
+}
+
+void ColumnSparse::SavePrefix(OutputStream* output) {
+    values_->SavePrefix(output);
+}
+
+void ColumnSparse::SaveBody(OutputStream* output) {
+    uint64_t row = 0;
+    for (const auto offset : offsets_) {
+        WireFormat::WriteVarint64(*output, offset - row);
+        row = offset + 1;
+    }
+    WireFormat::WriteVarint64(*output, (rows_ - row) | EndOfGranuleFlag);
+
+    if (!offsets_.empty()) {
+        values_->SaveBody(output);
+    }
+}
+
+void ColumnSparse::Clear() {
+    values_->Clear();
+    offsets_.clear();
+    rows_ = 0;
+}
+
+size_t ColumnSparse::Size() const {
+    return rows_;
+}
+
+ColumnRef ColumnSparse::Slice(size_t begin, size_t len) const {
+    auto result = std::make_shared<ColumnSparse>(values_->CloneEmpty());
+    if (begin >= rows_) {
+        return result;
+    }
+    len = std::min(len, rows_ - begin);
+
+    const auto first = std::lower_bound(offsets_.begin(), offsets_.end(), begin);
+    const auto last = std::lower_bound(first, offsets_.end(), begin + len);
+    result->offsets_.reserve(last - first);
+    for (auto it = first; it != last; ++it) {
+        result->offsets_.push_back(*it - begin);
+    }
+    if (first != last) {
+        result->values_ = values_->Slice(first - offsets_.begin(), last - first);
+    }
+    result->rows_ = len;
+
+    return result;
+}
+
+ColumnRef ColumnSparse::CloneEmpty() const {
+    return std::make_shared<ColumnSparse>(values_->CloneEmpty());
+}
+
+void ColumnSparse::Swap(Column& other) {
+    auto & col = dynamic_cast<ColumnSparse &>(other);
+    type_.swap(col.type_);
+    values_.swap(col.values_);
+    offsets_.swap(col.offsets_);
+    std::swap(rows_, col.rows_);
+    default_.swap(col.default_);
+}
+
+ItemView ColumnSparse::GetItem(size_t index) const {
+    if (index >= rows_) {
+        throw ValidationError("Row " + std::to_string(index) + " is out of range of sparse column of "
+                + std::to_string(rows_) + " rows");
+    }
+
+    const auto it = std::lower_bound(offsets_.begin(), offsets_.end(), index);
+    if (it != offsets_.end() && *it == index) {
+        return values_->GetItem(it - offsets_.begin());
+    }
+
+    if (!default_) {
+        default_ = CreateDefaults(values_, 1);
+    }
+    return default_->GetItem(0);
+}
+
+bool LoadSerializationKinds(InputStream* input, ColumnRef* column) {
+    return LoadKinds(input, (*column)->Type(), column);
+}
+
+ColumnRef DensifySerialization(const ColumnRef& column) {
+    if (const auto sparse = column->AsPtr<ColumnSparse>()) {
+        return sparse->Densify();
+    }
+    if (const auto tuple = column->AsPtr<ColumnTuple>(); tuple && HasCustomSerialization(*tuple)) {
+        std::vector<ColumnRef> elements;
+        elements.reserve(tuple->TupleSize());
+        for (size_t i = 0; i < tuple->TupleSize(); ++i) {
+            elements.push_back(DensifySerialization(tuple->At(i)));
+        }
+        return std::make_shared<ColumnTuple>(elements);
+    }
+    return column;
+}
+
+bool HasCustomSerialization(const Column& column) {
+    if (dynamic_cast<const ColumnSparse*>(&column)) {
+        return true;
+    }
+    if (const auto tuple = dynamic_cast<const ColumnTuple*>(&column)) {
+        for (size_t i = 0; i < tuple->TupleSize(); ++i) {
+            if (HasCustomSerialization(*tuple->At(i))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void SaveSerializationKinds(OutputStream* output, const Column& column) {
+    SaveKinds(output, column.Type(), &column);
+}
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "column.h"
+#include "../base/span.h"
+
+#include <vector>
+
+namespace clickhouse {
+
+/**
+ * Represents column of any type in sparse serialization, as ClickHouse sends columns of mostly default values:
+ * only values of non-default rows are kept, along with their row numbers, other rows have the default value
+ * of the column, i.e. zero, empty or NULL.
+ *
+ * The type of the column is the type of its values, so it can be sent and received in place of a dense column.
+ */
+class ColumnSparse : public Column {
+public:
+    /// `values` must be an empty column of the type of the column, it holds values of non-default rows.
+    explicit ColumnSparse(ColumnRef values);
+
+    /** Makes sparse column of rows of `dense` which are not default, i.e. are not NULL and are not all zero bytes.
+     *  Throws UnimplementedError if the column does not support GetItem().
+     */
+    static std::shared_ptr<ColumnSparse> FromDense(const ColumnRef& dense);
+
+    /// Returns column of values of non-default rows, in the order of rows.
+    inline ColumnRef GetValues() const { return values_; }
+
+    /// Returns numbers of non-default rows, ascending.
+    inline Span<const uint64_t> GetOffsets() const { return offsets_; }
+
+    /// Returns true if the row has the default value.
+    bool IsDefault(size_t n) const;
+
+    /// Makes dense column of the type of values with all rows.
+    ColumnRef Densify() const;
+
+    /// Appends `count` rows of the default value.
+    void AppendDefaults(size_t count);
+
+    /** Appends non-default row and returns column of values,
+     *  the value of the row must be appended to the returned column right after, e.g.
+     *  `col.AppendToValues()->As<ColumnUInt64>()->Append(1);`
+     */
+    ColumnRef AppendToValues();
+
+public:
+    /// Increase the capacity of the column for large block insertion.
+    void Reserve(size_t new_cap) override;
+
+    /// Appends content of given column to the end of current one, rows of a dense column are appended as non-default.
+    void Append(ColumnRef column) override;
+
+    /// Loads column prefix from input stream.
+    bool LoadPrefix(InputStream* input, size_t rows) override;
+
+    /// Loads column data from input stream.
+    bool LoadBody(InputStream* input, size_t rows) override;
+
+    /// Saves column prefix to output stream.
+    void SavePrefix(OutputStream* output) override;
+
+    /// Saves column data to output stream.
+    void SaveBody(OutputStream* output) override;
+
+    /// Clear column data .
+    void Clear() override;
+
+    /// Returns count of rows in the column.
+    size_t Size() const override;
+
+    /// Makes slice of the current column.
+    ColumnRef Slice(size_t begin, size_t len) const override;
+    ColumnRef CloneEmpty() const override;
+    void Swap(Column&) override;
+
+    ItemView GetItem(size_t) const override;
+
+private:
+    ColumnRef values_;
+    std::vector<uint64_t> offsets_;
+    size_t rows_ = 0;
+    /// Single row of the default value, made on demand by GetItem().
+    mutable ColumnRef default_;
+};
+
+/** Reads serialization kinds of the column, which follow its type in a block if it is not serialized in the default way,
+ *  and replaces the column with the one to load data into: ColumnSparse of it, or a tuple with ColumnSparse elements.
+ *  Throws UnimplementedError on kinds other than default and sparse.
+ */
+bool LoadSerializationKinds(InputStream* input, ColumnRef* column);
+
+/// Returns the column with ColumnSparse, also elements of tuples, replaced by dense columns, or the column itself if there are none.
+ColumnRef DensifySerialization(const ColumnRef& column);
+
+/// Returns true if the column or an element of the tuple is ColumnSparse, so serialization kinds must be sent with it.
+bool HasCustomSerialization(const Column& column);
+
+/// Writes serialization kinds of the column.
+void SaveSerializationKinds(OutputStream* output, const Column& column);
+
+}
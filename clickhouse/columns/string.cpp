@@ -55,6 +55,42 @@ void ColumnFixedString::Append(std::string_view str) {
     }
 }
 
+void ColumnFixedString::AppendMany(Span<const std::string_view> values) {
+    for (const auto & str : values) {
+        if (str.size() > string_size_) {
+            throw ValidationError("Expected string of length not greater than "
+                                     + std::to_string(string_size_) + " bytes, received "
+                                     + std::to_string(str.size()) + " bytes.");
+        }
+    }
+
+    // Values may view items of this column (e.g. filled by CopyTo()), which are moved by resize().
+    const char * const old_begin = data_.data();
+    const char * const old_end = old_begin + data_.size();
+
+    auto pos = data_.size();
+    data_.resize(pos + values.size() * string_size_, char(0));
+
+    for (const auto & str : values) {
+        const char * src = str.data();
+        if (str.size() && PointsInto(src, old_begin, old_end)) {
+            src = data_.data() + (src - old_begin);
+        }
+        memcpy(&data_[pos], src, str.size());
+        pos += string_size_;
+    }
+}
+
+void ColumnFixedString::CopyTo(Span<std::string_view> dest, size_t begin) const {
+    ValidateCopyToRange(Size(), begin, dest.size());
+
+    const char * pos = data_.data() + begin * string_size_;
+    for (auto & item : dest) {
+        item = std::string_view(pos, string_size_);
+        pos += string_size_;
+    }
+}
+
 void ColumnFixedString::Clear() {
     data_.clear();
 }
@@ -69,7 +105,7 @@ size_t ColumnFixedString::FixedSize() const {
 }
 
 void ColumnFixedString::Append(ColumnRef column) {
-    if (auto col = column->As<ColumnFixedString>()) {
+    if (auto col = column->AsPtr<ColumnFixedString>()) {
         if (string_size_ == col->string_size_) {
             data_.insert(data_.end(), col->data_.begin(), col->data_.end());
         }
@@ -224,6 +260,30 @@ void ColumnString::AppendNoManagedLifetime(std::string_view str) {
     items_.emplace_back(str);
 }
 
+void ColumnString::AppendMany(Span<const std::string_view> values) {
+    if (values.size() && PointsInto(values.data(), items_.data(), items_.data() + items_.size())) {
+        // `values` is a view on items of this column (e.g. GetData()), which are about to be reallocated.
+        // Strings themselves stay in place, only the views are copied.
+        const std::vector<std::string_view> items(values.begin(), values.end());
+        AppendMany(items);
+        return;
+    }
+
+    const auto total_size = ComputeTotalSize(values);
+
+    if (blocks_.size() == 0 || blocks_.back().GetAvailable() < total_size)
+        blocks_.emplace_back(std::max(DEFAULT_BLOCK_SIZE, total_size));
+
+    for (const auto & str : values) {
+        AppendUnsafe(str);
+    }
+}
+
+void ColumnString::CopyTo(Span<std::string_view> dest, size_t begin) const {
+    ValidateCopyToRange(items_.size(), begin, dest.size());
+    std::copy_n(items_.begin() + begin, dest.size(), dest.begin());
+}
+
 void ColumnString::AppendUnsafe(std::string_view str) {
     items_.emplace_back(blocks_.back().AppendUnsafe(str));
 }
@@ -239,7 +299,7 @@ std::string_view ColumnString::At(size_t n) const {
 }
 
 void ColumnString::Append(ColumnRef column) {
-    if (auto col = column->As<ColumnString>()) {
+    if (auto col = column->AsPtr<ColumnString>()) {
         const auto total_size = ComputeTotalSize(col->items_);
 
         // TODO: fill up existing block with some items and then add a new one for the rest of items
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "column.h"
+#include "../base/span.h"
 
 #include <string>
 #include <string_view>
@@ -33,12 +34,19 @@ public:
     /// Appends one element to the column.
     void Append(std::string_view str);
 
+    /// Appends all elements of `values` to the column.
+    void AppendMany(Span<const std::string_view> values);
+
     /// Returns element at given row number.
     std::string_view At(size_t n) const;
 
     /// Returns element at given row number.
     inline std::string_view operator [] (size_t n) const { return At(n); }
 
+    /// Copies views on `dest.size()` elements starting at row `begin` into `dest`.
+    /// Views are invalidated once column is modified.
+    void CopyTo(Span<std::string_view> dest, size_t begin = 0) const;
+
     /// Returns the max size of the fixed string
     size_t FixedSize() const;
 
@@ -70,6 +78,11 @@ private:
     std::string data_;
 };
 
+template <>
+struct ColumnTypeCodeFilter<ColumnFixedString> {
+    static constexpr bool Matches(Type::Code code) { return code == Type::FixedString; }
+};
+
 /**
  * Represents column of variable-length strings.
  */
@@ -103,12 +116,30 @@ public:
     /// If str lifetime is managed elsewhere and guaranteed to outlive the Block sent to the server
     void AppendNoManagedLifetime(std::string_view str);
 
+    /// Appends all elements of `values` to the column, copying all of them into a single memory block.
+    void AppendMany(Span<const std::string_view> values);
+
+    /// Appends elements from [begin, end) to the column.
+    template <typename Iterator>
+    inline void AppendMany(Iterator begin, Iterator end) {
+        for (; begin != end; ++begin) {
+            Append(std::string_view(*begin));
+        }
+    }
+
     /// Returns element at given row number.
     std::string_view At(size_t n) const;
 
     /// Returns element at given row number.
     inline std::string_view operator [] (size_t n) const { return At(n); }
 
+    /// Read-only view on all elements of the column, invalidated by any modification of the column.
+    inline Span<const std::string_view> GetData() const { return Span<const std::string_view>(items_.data(), items_.size()); }
+
+    /// Copies views on `dest.size()` elements starting at row `begin` into `dest`.
+    /// Views are invalidated once column is modified.
+    void CopyTo(Span<std::string_view> dest, size_t begin = 0) const;
+
 public:
     /// Appends content of given column to the end of current one.
     void Append(ColumnRef column) override;
@@ -142,4 +173,9 @@ private:
     std::deque<std::string> append_data_;
 };
 
+template <>
+struct ColumnTypeCodeFilter<ColumnString> {
+    static constexpr bool Matches(Type::Code code) { return code == Type::String; }
+};
+
 }
@@ -3,6 +3,8 @@
 #include "column.h"
 #include "utils.h"
 
+#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace clickhouse {
@@ -44,7 +46,7 @@ public:
     /// Saves column data to output stream.
     void SaveBody(OutputStream* output) override;
 
-    /// Clear column data .
+    /// Clears data of nested columns, the tuple keeps its elements and type.
     void Clear() override;
 
     /// Returns count of rows in the column.
@@ -59,6 +61,11 @@ private:
     std::vector<ColumnRef> columns_;
 };
 
+template <>
+struct ColumnTypeCodeFilter<ColumnTuple> {
+    static constexpr bool Matches(Type::Code code) { return code == Type::Tuple; }
+};
+
 template <typename... Columns>
 class ColumnTupleT : public ColumnTuple {
 public:
@@ -86,6 +93,11 @@ public:
         AppendTuple(std::move(value));
     }
 
+    /// Appends all elements of `values` to the end of column, one nested column at a time.
+    inline void AppendMany(Span<const ValueType> values) {
+        AppendManyToColumns(values, std::index_sequence_for<Columns...>{});
+    }
+
     /** Create a ColumnTupleT from a ColumnTuple, without copying data and offsets, but by
      * 'stealing' those from `col`.
      *
@@ -132,6 +144,20 @@ private:
         }
     }
 
+    template <size_t... index>
+    inline void AppendManyToColumns(Span<const ValueType> values, std::index_sequence<index...>) {
+        (AppendManyToColumn<index>(values), ...);
+    }
+
+    template <size_t index>
+    inline void AppendManyToColumn(Span<const ValueType> values) {
+        auto & column = *std::get<index>(typed_columns_);
+        column.Reserve(column.Size() + values.size());
+        for (const auto & value : values) {
+            column.Append(std::get<index>(value));
+        }
+    }
+
     template <typename T, size_t index = std::tuple_size_v<T>>
     inline static std::vector<ColumnRef> TupleToVector([[maybe_unused]] const T& value) {
         static_assert(index <= std::tuple_size_v<T>);
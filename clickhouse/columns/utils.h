@@ -1,6 +1,12 @@
 #pragma once
 
+#include "../base/span.h"
+#include "../exceptions.h"
+
 #include <algorithm>
+#include <functional>
+#include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 
@@ -18,6 +24,83 @@ std::vector<T> SliceVector(const std::vector<T>& vec, size_t begin, size_t len)
     return result;
 }
 
+/// Throws if [begin, begin + len) is not within [0, size), used by CopyTo() implementations.
+inline void ValidateCopyToRange(size_t size, size_t begin, size_t len) {
+    if (begin > size || len > size - begin) {
+        throw ValidationError("CopyTo range is out of bounds: "
+                + std::to_string(begin) + " + " + std::to_string(len) + " > " + std::to_string(size));
+    }
+}
+
+/// True if `ptr` points into [begin, end), e.g. into storage of the column a value is appended to.
+template <typename T>
+inline bool PointsInto(const T* ptr, const T* begin, const T* end) {
+    return std::less_equal<const T*>{}(begin, ptr) && std::less<const T*>{}(ptr, end);
+}
+
+/** Appends all `values` to the end of `data`, `values` may point into `data` itself
+ *  (e.g. AppendMany(GetData()) of the same column), in which case they are copied after `data` is grown.
+ */
+template <typename T>
+void AppendToVector(std::vector<T>& data, Span<const T> values) {
+    if (values.size() && PointsInto(values.data(), data.data(), data.data() + data.size())) {
+        const auto offset = static_cast<size_t>(values.data() - data.data());
+        const auto old_size = data.size();
+        data.resize(old_size + values.size());
+        std::copy_n(data.begin() + offset, values.size(), data.begin() + old_size);
+        return;
+    }
+
+    data.insert(data.end(), values.begin(), values.end());
+}
+
+/** Appends values parsed from `strings` to `data`, `parse(text, value)` throws on malformed text.
+ *  All-or-nothing: `data` is left unchanged if any of the strings fails to parse.
+ */
+template <typename T, typename Parser>
+void AppendParsedStrings(Span<const std::string_view> strings, std::vector<T>& data, Parser&& parse) {
+    const auto old_size = data.size();
+    data.resize(old_size + strings.size());
+
+    try {
+        T * dest = data.data() + old_size;
+        for (size_t i = 0; i < strings.size(); ++i) {
+            parse(strings[i], dest[i]);
+        }
+    } catch (...) {
+        data.resize(old_size);
+        throw;
+    }
+}
+
+/** Appends text of `rows` values to string column `dest`, `format(row, out)` writes text of a row
+ *  taking at most `MaxTextSize` bytes at `out` and returns its end.
+ *  Rows are formatted in order, in chunks into a scratch buffer, which is copied into the column one chunk at a time.
+ */
+template <size_t MaxTextSize, typename StringColumn, typename Formatter>
+void FormatToStringColumn(StringColumn& dest, size_t rows, Formatter&& format) {
+    constexpr size_t ChunkSize = 1024;
+
+    std::vector<char> buffer(std::min(rows, ChunkSize) * MaxTextSize);
+    std::vector<std::string_view> items;
+    items.reserve(std::min(rows, ChunkSize));
+
+    dest.Reserve(dest.Size() + rows);
+    for (size_t begin = 0; begin < rows; begin += ChunkSize) {
+        const size_t end = std::min(rows, begin + ChunkSize);
+
+        items.clear();
+        char * pos = buffer.data();
+        for (size_t row = begin; row < end; ++row) {
+            char * const text_end = format(row, pos);
+            items.emplace_back(pos, static_cast<size_t>(text_end - pos));
+            pos = text_end;
+        }
+
+        dest.AppendMany(Span<const std::string_view>(items.data(), items.size()));
+    }
+}
+
 template <typename T>
 struct HasWrapMethod {
 private:
@@ -1,5 +1,8 @@
 #include "uuid.h"
+#include "string.h"
 #include "utils.h"
+
+#include "../base/text_codec.h"
 #include "../exceptions.h"
 
 #include <stdexcept>
@@ -26,6 +29,43 @@ void ColumnUUID::Append(const UUID& value) {
     data_->Append(value.second);
 }
 
+void ColumnUUID::AppendMany(Span<const UUID> values) {
+    auto & data = data_->GetWritableData();
+    const auto old_size = data.size();
+    data.resize(old_size + values.size() * 2);
+
+    uint64_t * dest = data.data() + old_size;
+    for (size_t i = 0; i < values.size(); ++i) {
+        dest[i * 2] = values[i].first;
+        dest[i * 2 + 1] = values[i].second;
+    }
+}
+
+void ColumnUUID::CopyTo(Span<UUID> dest, size_t begin) const {
+    ValidateCopyToRange(Size(), begin, dest.size());
+
+    const uint64_t * src = data_->GetData().data() + begin * 2;
+    for (size_t i = 0; i < dest.size(); ++i) {
+        dest[i] = UUID(src[i * 2], src[i * 2 + 1]);
+    }
+}
+
+void ColumnUUID::AppendFromStrings(const ColumnString& strings) {
+    std::vector<UUID> values;
+    AppendParsedStrings(strings.GetData(), values, [](std::string_view str, UUID & value) {
+        if (!ParseUUID(str, value))
+            throw ValidationError("invalid UUID format: " + std::string(str));
+    });
+    AppendMany(values);
+}
+
+void ColumnUUID::FormatToStrings(ColumnString& dest) const {
+    const uint64_t * data = data_->GetData().data();
+    FormatToStringColumn<UUIDTextSize>(dest, Size(), [data](size_t row, char * out) {
+        return FormatUUID(UUID(data[row * 2], data[row * 2 + 1]), out);
+    });
+}
+
 void ColumnUUID::Clear() {
     data_->Clear();
 }
@@ -6,6 +6,7 @@
 
 namespace clickhouse {
 
+class ColumnString;
 
 /**
  * Represents a UUID column.
@@ -19,12 +20,25 @@ public:
     /// Appends one element to the end of column.
     void Append(const UUID& value);
 
+    /// Appends all elements of `values` to the end of column.
+    void AppendMany(Span<const UUID> values);
+
     /// Returns element at given row number.
     const UUID At(size_t n) const;
 
     /// Returns element at given row number.
     inline const UUID operator [] (size_t n) const { return At(n); }
 
+    /// Copies `dest.size()` elements starting at row `begin` into `dest`.
+    void CopyTo(Span<UUID> dest, size_t begin = 0) const;
+
+    /// Appends all elements of `strings` parsed as "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx",
+    /// throws ValidationError if any of them is malformed and leaves the column unchanged in that case.
+    void AppendFromStrings(const ColumnString& strings);
+
+    /// Appends text of all elements of the column to `dest`, lowercase hex digits.
+    void FormatToStrings(ColumnString& dest) const;
+
 public:
     /// Increase the capacity of the column for large block insertion.
     void Reserve(size_t new_cap) override;
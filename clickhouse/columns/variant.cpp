@@ -0,0 +1,276 @@
+#include "variant.h"
+
+#include "../base/wire_format.h"
+
+#include <algorithm>
+
+namespace {
+
+// Serialization modes of discriminators, the first value of the prefix.
+enum DiscriminatorsSerializationMode : uint64_t {
+    // Discriminators of all rows as is.
+    Basic = 0,
+    // Granules of discriminators, each either of a single discriminator or of discriminators as is.
+    Compact = 1,
+};
+
+enum CompactGranuleFormat : uint8_t {
+    Plain = 0,
+    SingleDiscriminator = 1,
+};
+
+std::vector<clickhouse::TypeRef> GetTypes(const std::vector<clickhouse::ColumnRef> & columns) {
+    std::vector<clickhouse::TypeRef> types;
+    types.reserve(columns.size());
+    for (const auto & column : columns) {
+        types.push_back(column->Type());
+    }
+    return types;
+}
+
+std::vector<size_t> GetSizes(const std::vector<clickhouse::ColumnRef> & columns) {
+    std::vector<size_t> sizes;
+    sizes.reserve(columns.size());
+    for (const auto & column : columns) {
+        sizes.push_back(column->Size());
+    }
+    return sizes;
+}
+
+}
+
+namespace clickhouse {
+
+ColumnVariant::ColumnVariant(std::vector<ColumnRef> variants)
+    : Column(Type::CreateVariant(GetTypes(variants)))
+    , variants_(std::move(variants))
+{
+    for (const auto & variant : variants_) {
+        if (variant->Size() != 0) {
+            throw ValidationError("Variant columns must be empty");
+        }
+    }
+}
+
+ColumnRef ColumnVariant::GetVariant(size_t discriminator) const {
+    if (discriminator >= variants_.size()) {
+        throw ValidationError("Variant discriminator " + std::to_string(discriminator) + " is out of range for " + type_->GetName());
+    }
+    return variants_[discriminator];
+}
+
+void ColumnVariant::AppendNull() {
+    discriminators_.push_back(NullDiscriminator);
+    offsets_.push_back(0);
+}
+
+ColumnRef ColumnVariant::AppendToVariant(size_t discriminator) {
+    auto variant = GetVariant(discriminator);
+    discriminators_.push_back(static_cast<uint8_t>(discriminator));
+    offsets_.push_back(variant->Size());
+    return variant;
+}
+
+void ColumnVariant::AppendDiscriminators(Span<const uint8_t> discriminators, std::vector<size_t> sizes) {
+    discriminators_.reserve(discriminators_.size() + discriminators.size());
+    offsets_.reserve(offsets_.size() + discriminators.size());
+
+    for (const auto discriminator : discriminators) {
+        if (discriminator == NullDiscriminator) {
+            discriminators_.push_back(discriminator);
+            offsets_.push_back(0);
+        } else if (discriminator < sizes.size()) {
+            discriminators_.push_back(discriminator);
+            offsets_.push_back(sizes[discriminator]++);
+        } else {
+            throw ProtocolError("Variant discriminator " + std::to_string(discriminator) + " is out of range for " + type_->GetName());
+        }
+    }
+}
+
+void ColumnVariant::Reserve(size_t new_cap) {
+    discriminators_.reserve(new_cap);
+    offsets_.reserve(new_cap);
+}
+
+void ColumnVariant::Append(ColumnRef column) {
+    const auto col = column->As<ColumnVariant>();
+    if (!col || !col->type_->IsEqual(type_)) {
+        throw ValidationError("Can't append " + column->Type()->GetName() + " to " + type_->GetName());
+    }
+
+    const auto sizes = GetSizes(variants_);
+    for (size_t i = 0; i < variants_.size(); ++i) {
+        variants_[i]->Append(col->variants_[i]);
+    }
+    AppendDiscriminators(col->discriminators_, sizes);
+}
+
+bool ColumnVariant::LoadPrefix(InputStream* input, size_t rows) {
+    uint64_t mode;
+    if (!WireFormat::ReadFixed(*input, &mode)) {
+        return false;
+    }
+    if (mode != Basic && mode != Compact) {
+        throw ProtocolError("Unknown serialization mode of Variant discriminators: " + std::to_string(mode));
+    }
+    compact_discriminators_ = mode == Compact;
+
+    // Number of rows of each variant is not known yet, prefixes only check it for zero.
+    for (auto & variant : variants_) {
+        if (!variant->LoadPrefix(input, rows)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ColumnVariant::LoadBody(InputStream* input, size_t rows) {
+    std::vector<uint8_t> discriminators(rows);
+    if (!compact_discriminators_) {
+        if (!WireFormat::ReadBytes(*input, discriminators.data(), rows)) {
+            return false;
+        }
+    } else {
+        for (size_t begin = 0; begin < rows;) {
+            uint64_t granule_rows;
+            uint8_t format;
+            if (!WireFormat::ReadVarint64(*input, &granule_rows) || !WireFormat::ReadFixed(*input, &format)) {
+                return false;
+            }
+            granule_rows = std::min<uint64_t>(granule_rows, rows - begin);
+
+            if (format == SingleDiscriminator) {
+                uint8_t discriminator;
+                if (!WireFormat::ReadFixed(*input, &discriminator)) {
+                    return false;
+                }
+                std::fill_n(discriminators.begin() + begin, granule_rows, discriminator);
+            } else if (!WireFormat::ReadBytes(*input, discriminators.data() + begin, granule_rows)) {
+                return false;
+            }
+            begin += granule_rows;
+        }
+    }
+
+    std::vector<size_t> counts(variants_.size(), 0);
+    for (const auto discriminator : discriminators) {
+        if (discriminator != NullDiscriminator && discriminator < counts.size()) {
+            ++counts[discriminator];
+        }
+    }
+
+    for (size_t i = 0; i < variants_.size(); ++i) {
+        variants_[i]->Clear();
+        if (counts[i] && !variants_[i]->LoadBody(input, counts[i])) {
+            return false;
+        }
+    }
+
+    discriminators_.clear();
+    offsets_.clear();
+    AppendDiscriminators(discriminators, std::vector<size_t>(variants_.size(), 0));
+
+    return true;
+}
+
+void ColumnVariant::SavePrefix(OutputStream* output) {
+    WireFormat::WriteFixed<uint64_t>(*output, Basic);
+    for (auto & variant : variants_) {
+        variant->SavePrefix(output);
+    }
+}
+
+void ColumnVariant::SaveBody(OutputStream* output) {
+    std::vector<size_t> counts(variants_.size(), 0);
+    for (const auto discriminator : discriminators_) {
+        if (discriminator != NullDiscriminator) {
+            ++counts[discriminator];
+        }
+    }
+    for (size_t i = 0; i < variants_.size(); ++i) {
+        if (counts[i] != variants_[i]->Size()) {
+            throw ValidationError("Variant column " + variants_[i]->Type()->GetName() + " has " + std::to_string(variants_[i]->Size())
+                    + " rows, while " + std::to_string(counts[i]) + " rows refer to it");
+        }
+    }
+
+    WireFormat::WriteBytes(*output, discriminators_.data(), discriminators_.size());
+    for (auto & variant : variants_) {
+        if (variant->Size()) {
+            variant->SaveBody(output);
+        }
+    }
+}
+
+void ColumnVariant::Clear() {
+    for (auto & variant : variants_) {
+        variant->Clear();
+    }
+    discriminators_.clear();
+    offsets_.clear();
+}
+
+size_t ColumnVariant::Size() const {
+    return discriminators_.size();
+}
+
+ColumnRef ColumnVariant::Slice(size_t begin, size_t len) const {
+    begin = std::min(begin, Size());
+    len = std::min(len, Size() - begin);
+
+    // Rows of each variant in the range are consecutive in its column.
+    std::vector<size_t> first(variants_.size(), 0);
+    std::vector<size_t> counts(variants_.size(), 0);
+    for (size_t i = begin; i < begin + len; ++i) {
+        const auto discriminator = discriminators_[i];
+        if (discriminator != NullDiscriminator && counts[discriminator]++ == 0) {
+            first[discriminator] = offsets_[i];
+        }
+    }
+
+    std::vector<ColumnRef> variants;
+    variants.reserve(variants_.size());
+    for (const auto & variant : variants_) {
+        variants.push_back(variant->CloneEmpty());
+    }
+
+    auto result = std::make_shared<ColumnVariant>(std::move(variants));
+    for (size_t i = 0; i < variants_.size(); ++i) {
+        if (counts[i]) {
+            result->variants_[i]->Append(variants_[i]->Slice(first[i], counts[i]));
+        }
+    }
+    result->AppendDiscriminators(Span<const uint8_t>(discriminators_.data() + begin, len), std::vector<size_t>(variants_.size(), 0));
+
+    return result;
+}
+
+ColumnRef ColumnVariant::CloneEmpty() const {
+    std::vector<ColumnRef> variants;
+    variants.reserve(variants_.size());
+    for (const auto & variant : variants_) {
+        variants.push_back(variant->CloneEmpty());
+    }
+    return std::make_shared<ColumnVariant>(std::move(variants));
+}
+
+void ColumnVariant::Swap(Column& other) {
+    auto & col = dynamic_cast<ColumnVariant &>(other);
+    type_.swap(col.type_);
+    variants_.swap(col.variants_);
+    discriminators_.swap(col.discriminators_);
+    offsets_.swap(col.offsets_);
+    std::swap(compact_discriminators_, col.compact_discriminators_);
+}
+
+ItemView ColumnVariant::GetItem(size_t index) const {
+    const auto discriminator = GetDiscriminator(index);
+    if (discriminator == NullDiscriminator) {
+        return ItemView();
+    }
+    return variants_[discriminator]->GetItem(offsets_[index]);
+}
+
+}
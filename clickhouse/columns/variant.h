@@ -0,0 +1,97 @@
+#pragma once
+
+#include "column.h"
+#include "../base/span.h"
+
+#include <vector>
+
+namespace clickhouse {
+
+/**
+ * Represents column of Variant(T1, T2, ...).
+ *
+ * Each row is either NULL or a value of one of the variants, identified by its discriminator, the index of the variant.
+ * Variant columns hold only values of their own rows, in the order of rows, so the layout matches the native format:
+ * discriminators of all rows are followed by data of each variant column as is.
+ */
+class ColumnVariant : public Column {
+public:
+    /// Discriminator of NULL rows.
+    static constexpr uint8_t NullDiscriminator = 255;
+
+    /// Variants must be given in the order of ClickHouse, i.e. sorted by type name, and must be empty.
+    explicit ColumnVariant(std::vector<ColumnRef> variants);
+
+    /// Returns count of variants.
+    inline size_t GetVariantCount() const { return variants_.size(); }
+
+    /// Returns column of values of the variant with given discriminator.
+    ColumnRef GetVariant(size_t discriminator) const;
+
+    /// Returns discriminator of given row, NullDiscriminator for NULL rows.
+    inline uint8_t GetDiscriminator(size_t n) const { return discriminators_.at(n); }
+
+    /// Returns discriminators of all rows.
+    inline Span<const uint8_t> GetDiscriminators() const { return discriminators_; }
+
+    /// Returns position of the value of given row in its variant column, unspecified for NULL rows.
+    inline size_t GetVariantOffset(size_t n) const { return offsets_.at(n); }
+
+    inline bool IsNull(size_t n) const { return GetDiscriminator(n) == NullDiscriminator; }
+
+    /// Appends NULL row.
+    void AppendNull();
+
+    /** Appends row of the variant with given discriminator and returns its column,
+     *  the value of the row must be appended to the returned column right after, e.g.
+     *  `col.AppendToVariant(1)->As<ColumnString>()->Append("value");`
+     */
+    ColumnRef AppendToVariant(size_t discriminator);
+
+public:
+    /// Increase the capacity of the column for large block insertion.
+    void Reserve(size_t new_cap) override;
+
+    /// Appends content of given column to the end of current one, column must be of the same type.
+    void Append(ColumnRef column) override;
+
+    /// Loads column prefix from input stream.
+    bool LoadPrefix(InputStream* input, size_t rows) override;
+
+    /// Loads column data from input stream.
+    bool LoadBody(InputStream* input, size_t rows) override;
+
+    /// Saves column prefix to output stream.
+    void SavePrefix(OutputStream* output) override;
+
+    /// Saves column data to output stream.
+    void SaveBody(OutputStream* output) override;
+
+    /// Clear column data .
+    void Clear() override;
+
+    /// Returns count of rows in the column.
+    size_t Size() const override;
+
+    /// Makes slice of the current column.
+    ColumnRef Slice(size_t begin, size_t len) const override;
+    ColumnRef CloneEmpty() const override;
+    void Swap(Column&) override;
+
+    ItemView GetItem(size_t) const override;
+
+private:
+    friend class ColumnDynamic;
+
+    /// Appends discriminators of rows whose values were appended to variant columns, which had `sizes` rows before.
+    void AppendDiscriminators(Span<const uint8_t> discriminators, std::vector<size_t> sizes);
+
+private:
+    std::vector<ColumnRef> variants_;
+    std::vector<uint8_t> discriminators_;
+    std::vector<uint64_t> offsets_;
+    /// Serialization mode of discriminators being loaded, read by LoadPrefix().
+    bool compact_discriminators_ = false;
+};
+
+}
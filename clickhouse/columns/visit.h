@@ -0,0 +1,106 @@
+#pragma once
+
+#include "aggregate_function.h"
+#include "array.h"
+#include "date.h"
+#include "decimal.h"
+#include "dynamic.h"
+#include "enum.h"
+#include "geo.h"
+#include "ip4.h"
+#include "ip6.h"
+#include "ix-json.h"
+#include "json.h"
+#include "lowcardinality.h"
+#include "map.h"
+#include "nothing.h"
+#include "nullable.h"
+#include "numeric.h"
+#include "string.h"
+#include "tuple.h"
+#include "uuid.h"
+#include "variant.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace clickhouse {
+
+namespace details {
+
+template <typename T, typename ColumnType, typename Visitor>
+inline decltype(auto) VisitAs(ColumnType & column, Visitor && visitor) {
+    if (const auto result = column.template AsPtr<T>()) {
+        return std::forward<Visitor>(visitor)(*result);
+    }
+    return std::forward<Visitor>(visitor)(column);
+}
+
+}
+
+/** Calls `visitor` with the column downcast to its class, chosen by the code of the column's type, e.g.
+ *  `VisitColumn(column, [](auto & col) { ... });`, where `col` is ColumnUInt8&, ColumnString&, ColumnArray& and so on.
+ *
+ *  Wrappers like ColumnArrayT, ColumnNullableT or ColumnLowCardinalityT are passed as their base classes,
+ *  columns of other classes, e.g. ColumnSparse, are passed as Column&.
+ *  All calls of the visitor must return the same type.
+ */
+template <typename ColumnType, typename Visitor>
+inline decltype(auto) VisitColumn(ColumnType & column, Visitor && visitor) {
+    static_assert(std::is_same_v<std::remove_const_t<ColumnType>, Column>, "VisitColumn() takes Column& or const Column&");
+
+#define VISIT_AS(T) return details::VisitAs<T>(column, std::forward<Visitor>(visitor))
+    switch (column.GetType().GetCode()) {
+        case Type::Void:              VISIT_AS(ColumnNothing);
+        case Type::Int8:              VISIT_AS(ColumnInt8);
+        case Type::Int16:             VISIT_AS(ColumnInt16);
+        case Type::Int32:             VISIT_AS(ColumnInt32);
+        case Type::Int64:             VISIT_AS(ColumnInt64);
+        case Type::Int128:            VISIT_AS(ColumnInt128);
+        case Type::Int256:            VISIT_AS(ColumnInt256);
+        case Type::UInt8:             VISIT_AS(ColumnUInt8);
+        case Type::UInt16:            VISIT_AS(ColumnUInt16);
+        case Type::UInt32:            VISIT_AS(ColumnUInt32);
+        case Type::UInt64:            VISIT_AS(ColumnUInt64);
+        case Type::UInt128:           VISIT_AS(ColumnUInt128);
+        case Type::UInt256:           VISIT_AS(ColumnUInt256);
+        case Type::BFloat16:          VISIT_AS(ColumnBFloat16);
+        case Type::Float32:           VISIT_AS(ColumnFloat32);
+        case Type::Float64:           VISIT_AS(ColumnFloat64);
+        case Type::String:            VISIT_AS(ColumnString);
+        case Type::FixedString:       VISIT_AS(ColumnFixedString);
+        case Type::DateTime:          VISIT_AS(ColumnDateTime);
+        case Type::DateTime64:        VISIT_AS(ColumnDateTime64);
+        case Type::Date:              VISIT_AS(ColumnDate);
+        case Type::Date32:            VISIT_AS(ColumnDate32);
+        case Type::Array:             VISIT_AS(ColumnArray);
+        case Type::Nullable:          VISIT_AS(ColumnNullable);
+        case Type::Tuple:             VISIT_AS(ColumnTuple);
+        case Type::Enum8:             VISIT_AS(ColumnEnum8);
+        case Type::Enum16:            VISIT_AS(ColumnEnum16);
+        case Type::UUID:              VISIT_AS(ColumnUUID);
+        case Type::IPv4:              VISIT_AS(ColumnIPv4);
+        case Type::IPv6:              VISIT_AS(ColumnIPv6);
+        case Type::Decimal:
+        case Type::Decimal32:
+        case Type::Decimal64:
+        case Type::Decimal128:
+        case Type::Decimal256:        VISIT_AS(ColumnDecimal);
+        case Type::LowCardinality:    VISIT_AS(ColumnLowCardinality);
+        case Type::Map:               VISIT_AS(ColumnMap);
+        case Type::Point:             VISIT_AS(ColumnPoint);
+        case Type::Ring:              VISIT_AS(ColumnRing);
+        case Type::Polygon:           VISIT_AS(ColumnPolygon);
+        case Type::MultiPolygon:      VISIT_AS(ColumnMultiPolygon);
+        case Type::IxJson:            VISIT_AS(ColumnIxJson);
+        case Type::Variant:           VISIT_AS(ColumnVariant);
+        case Type::Dynamic:           VISIT_AS(ColumnDynamic);
+        case Type::JSON:              VISIT_AS(ColumnJSON);
+        case Type::AggregateFunction: VISIT_AS(ColumnAggregateFunction);
+    }
+#undef VISIT_AS
+
+    return std::forward<Visitor>(visitor)(column);
+}
+
+}
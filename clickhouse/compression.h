@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace clickhouse {
+
+/// Methods of block compression.
+enum class CompressionMethod : int8_t {
+    None = -1,
+    LZ4  = 1,
+    ZSTD = 2,
+};
+
+}
@@ -0,0 +1,384 @@
+#include "native.h"
+#include "protocol_revisions.h"
+
+#include "base/compressed.h"
+#include "base/platform.h"
+#include "base/wire_format.h"
+#include "columns/nullable.h"
+#include "columns/sparse.h"
+#include "columns/string.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <system_error>
+#include <vector>
+
+#if defined(_win_)
+#   include <fstream>
+#   include <iterator>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace clickhouse {
+
+namespace {
+
+/// Loads strings referencing the memory of the input, which must outlive the column.
+bool LoadStringsInPlace(ArrayInput& input, ColumnString& column, size_t rows) {
+    for (size_t i = 0; i < rows; ++i) {
+        uint64_t size = 0;
+        if (!WireFormat::ReadVarint64(input, &size) || size > input.Avail()) {
+            return false;
+        }
+        column.AppendNoManagedLifetime(std::string_view(reinterpret_cast<const char*>(input.Data()), size));
+        input.Skip(size);
+    }
+    return true;
+}
+
+bool LoadColumn(InputStream& input, ArrayInput* in_place_input, Column& column, size_t rows) {
+    if (in_place_input) {
+        if (const auto strings = column.AsPtr<ColumnString>()) {
+            return LoadStringsInPlace(*in_place_input, *strings, rows);
+        }
+        if (const auto nullable = column.AsPtr<ColumnNullable>()) {
+            if (const auto strings = nullable->Nested()->AsPtr<ColumnString>()) {
+                return nullable->Nulls()->LoadBody(in_place_input, rows) && LoadStringsInPlace(*in_place_input, *strings, rows);
+            }
+        }
+    }
+    return column.Load(&input, rows);
+}
+
+/// Reads a block, strings of String and Nullable(String) columns reference the memory of `in_place_input` if it is set.
+bool ReadBlock(InputStream& input, ArrayInput* in_place_input, Block* block, uint64_t revision,
+        CreateColumnByTypeSettings settings, bool sparse_columns) {
+    NativeBlockHeader header;
+    if (!ReadNativeBlockHeader(input, &header, revision)) {
+        return false;
+    }
+    block->SetInfo(std::move(header.info));
+
+    for (size_t i = 0; i < header.num_columns; ++i) {
+        std::string name;
+        std::string type;
+        if (!WireFormat::ReadString(input, &name)) {
+            return false;
+        }
+        if (!WireFormat::ReadString(input, &type)) {
+            return false;
+        }
+        if (ColumnRef col = CreateColumnByType(type, settings)) {
+            uint8_t has_custom = 0;
+            // Serialization kinds follow if the column is not serialized in the default way, e.g. is sparse.
+            if (revision >= DBMS_MIN_REVISION_WITH_CUSTOM_SERIALIZATION) {
+                if (!WireFormat::ReadFixed(input, &has_custom)) {
+                    return false;
+                }
+                if (has_custom && !LoadSerializationKinds(&input, &col)) {
+                    return false;
+                }
+            }
+            if (header.num_rows && !LoadColumn(input, has_custom ? nullptr : in_place_input, *col, header.num_rows)) {
+                throw ProtocolError("can't load column '" + name + "' of type " + type);
+            }
+            if (has_custom && !sparse_columns) {
+                col = DensifySerialization(col);
+            }
+
+            block->AppendColumn(name, col);
+        } else {
+            throw UnimplementedError(std::string("unsupported column type: ") + type);
+        }
+    }
+
+    return true;
+}
+
+}
+
+bool ReadNativeBlockHeader(InputStream& input, NativeBlockHeader* header, uint64_t revision) {
+    // Additional information about block.
+    if (revision >= DBMS_MIN_REVISION_WITH_BLOCK_INFO) {
+        uint64_t num;
+
+        // BlockInfo
+        if (!WireFormat::ReadUInt64(input, &num)) {
+            return false;
+        }
+        if (!WireFormat::ReadFixed(input, &header->info.is_overflows)) {
+            return false;
+        }
+        if (!WireFormat::ReadUInt64(input, &num)) {
+            return false;
+        }
+        if (!WireFormat::ReadFixed(input, &header->info.bucket_num)) {
+            return false;
+        }
+        if (!WireFormat::ReadUInt64(input, &num)) {
+            return false;
+        }
+    }
+
+    if (!WireFormat::ReadUInt64(input, &header->num_columns)) {
+        return false;
+    }
+    if (!WireFormat::ReadUInt64(input, &header->num_rows)) {
+        return false;
+    }
+    return true;
+}
+
+bool ReadNativeBlockColumns(InputStream& input, std::vector<NativeColumnHeader>* columns, uint64_t revision) {
+    NativeBlockHeader header;
+    if (!ReadNativeBlockHeader(input, &header, revision)) {
+        return false;
+    }
+    if (header.num_rows) {
+        throw ProtocolError("block of " + std::to_string(header.num_rows) + " rows, expected a block without rows");
+    }
+
+    columns->clear();
+    for (size_t i = 0; i < header.num_columns; ++i) {
+        NativeColumnHeader column;
+        if (!WireFormat::ReadString(input, &column.name)) {
+            return false;
+        }
+        if (!WireFormat::ReadString(input, &column.type)) {
+            return false;
+        }
+        if (revision >= DBMS_MIN_REVISION_WITH_CUSTOM_SERIALIZATION) {
+            uint8_t has_custom = 0;
+            if (!WireFormat::ReadFixed(input, &has_custom)) {
+                return false;
+            }
+            // Serialization kinds can't be skipped without knowing structure of the type.
+            if (has_custom) {
+                throw ProtocolError("column '" + column.name + "' of block without rows has custom serialization");
+            }
+        }
+        columns->push_back(std::move(column));
+    }
+    return true;
+}
+
+void WriteNativeBlock(OutputStream& output, const Block& block, uint64_t revision) {
+    // Additional information about block.
+    if (revision >= DBMS_MIN_REVISION_WITH_BLOCK_INFO) {
+        WireFormat::WriteUInt64(output, 1);
+        WireFormat::WriteFixed<uint8_t>(output, block.Info().is_overflows);
+        WireFormat::WriteUInt64(output, 2);
+        WireFormat::WriteFixed<int32_t>(output, block.Info().bucket_num);
+        WireFormat::WriteUInt64(output, 0);
+    }
+
+    WireFormat::WriteUInt64(output, block.GetColumnCount());
+    WireFormat::WriteUInt64(output, block.GetRowCount());
+
+    for (Block::Iterator bi(block); bi.IsValid(); bi.Next()) {
+        WireFormat::WriteString(output, bi.Name());
+        WireFormat::WriteString(output, bi.Type()->GetName());
+
+        ColumnRef column = bi.Column();
+        if (revision >= DBMS_MIN_REVISION_WITH_CUSTOM_SERIALIZATION) {
+            const bool has_custom = HasCustomSerialization(*column);
+            WireFormat::WriteFixed<uint8_t>(output, has_custom);
+            if (has_custom) {
+                SaveSerializationKinds(&output, *column);
+            }
+        } else if (const auto sparse = column->AsPtr<ColumnSparse>()) {
+            column = sparse->Densify();
+        }
+
+        // Empty columns are not serialized and occupy exactly 0 bytes.
+        // ref https://github.com/ClickHouse/ClickHouse/blob/39b37a3240f74f4871c8c1679910e065af6bea19/src/Formats/NativeWriter.cpp#L163
+        const bool containsData = block.GetRowCount() > 0;
+        if (containsData) {
+            column->Save(&output);
+        }
+    }
+    output.Flush();
+}
+
+bool ReadNativeBlock(InputStream& input, Block* block, uint64_t revision, CreateColumnByTypeSettings settings,
+        bool sparse_columns) {
+    return ReadBlock(input, nullptr, block, revision, settings, sparse_columns);
+}
+
+class NativeFileWriter::FileOutput : public OutputStream {
+public:
+    explicit FileOutput(const std::string& path)
+        : path_(path)
+        , file_(std::fopen(path.c_str(), "wb"))
+    {
+        if (!file_) {
+            throw std::system_error(errno, std::system_category(), "can't create file " + path_);
+        }
+    }
+
+    ~FileOutput() override {
+        if (file_) {
+            std::fclose(file_);
+        }
+    }
+
+    void Close() {
+        std::FILE* file = file_;
+        file_ = nullptr;
+        if (std::fclose(file) != 0) {
+            throw std::system_error(errno, std::system_category(), "can't close file " + path_);
+        }
+    }
+
+protected:
+    size_t DoWrite(const void* data, size_t len) override {
+        if (std::fwrite(data, 1, len, file_) != len) {
+            throw std::system_error(errno, std::system_category(), "can't write file " + path_);
+        }
+        return len;
+    }
+
+    void DoFlush() override {
+        if (std::fflush(file_) != 0) {
+            throw std::system_error(errno, std::system_category(), "can't write file " + path_);
+        }
+    }
+
+private:
+    const std::string path_;
+    std::FILE* file_;
+};
+
+NativeFileWriter::NativeFileWriter(const std::string& path, CompressionMethod compression_method, size_t max_compression_chunk_size)
+    : file_(std::make_unique<FileOutput>(path))
+    , compression_method_(compression_method)
+    , max_compression_chunk_size_(max_compression_chunk_size)
+{
+}
+
+NativeFileWriter::~NativeFileWriter() {
+    if (file_) {
+        try {
+            Close();
+        } catch (...) {
+        }
+    }
+}
+
+void NativeFileWriter::Write(const Block& block) {
+    if (!file_) {
+        throw ValidationError("NativeFileWriter is closed");
+    }
+
+    if (compression_method_ != CompressionMethod::None) {
+        // Each block is flushed in whole frames, like data packets.
+        std::unique_ptr<OutputStream> compressed_output = std::make_unique<CompressedOutput>(file_.get(), max_compression_chunk_size_, compression_method_);
+        BufferedOutput buffered(std::move(compressed_output), max_compression_chunk_size_);
+
+        WriteNativeBlock(buffered, block);
+    } else {
+        WriteNativeBlock(*file_, block);
+    }
+}
+
+void NativeFileWriter::Close() {
+    if (file_) {
+        const auto file = std::move(file_);
+        file->Close();
+    }
+}
+
+class NativeFileReader::MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#if defined(_win_)
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::system_error(errno, std::system_category(), "can't open file " + path);
+        }
+        data_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error(errno, std::system_category(), "can't open file " + path);
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::system_category(), "can't stat file " + path);
+        }
+
+        size_ = static_cast<size_t>(st.st_size);
+        // Empty files can't be mapped, and have no blocks anyway.
+        if (size_) {
+            data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        const int error = errno;
+        ::close(fd);
+        if (data_ == MAP_FAILED) {
+            throw std::system_error(error, std::system_category(), "can't map file " + path);
+        }
+        ::madvise(data_, size_, MADV_SEQUENTIAL);
+#endif
+    }
+
+    ~MappedFile() {
+#if !defined(_win_)
+        if (size_) {
+            ::munmap(data_, size_);
+        }
+#endif
+    }
+
+#if defined(_win_)
+    inline const void* Data() const { return data_.data(); }
+    inline size_t Size() const { return data_.size(); }
+
+private:
+    std::vector<char> data_;
+#else
+    inline const void* Data() const { return data_; }
+    inline size_t Size() const { return size_; }
+
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+#endif
+};
+
+NativeFileReader::NativeFileReader(const std::string& path, bool compressed)
+    : file_(std::make_unique<MappedFile>(path))
+    , input_(file_->Data(), file_->Size())
+    , compressed_(compressed)
+{
+}
+
+NativeFileReader::~NativeFileReader() = default;
+
+bool NativeFileReader::Next(Block* block) {
+    if (input_.Exhausted()) {
+        return false;
+    }
+
+    *block = Block();
+    bool read = false;
+    if (compressed_) {
+        CompressedInput compressed(&input_);
+        read = ReadBlock(compressed, nullptr, block, 0, {}, false);
+    } else {
+        read = ReadBlock(input_, &input_, block, 0, {}, false);
+    }
+
+    if (!read) {
+        throw ProtocolError("unexpected end of Native file");
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "block.h"
+#include "compression.h"
+#include "base/input.h"
+#include "base/output.h"
+#include "columns/factory.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clickhouse {
+
+/**
+ * Writes the block in the Native format of given protocol revision and flushes the output.
+ * Revision 0 is the format of files, without block info and custom serializations, where sparse columns are written dense.
+ */
+void WriteNativeBlock(OutputStream& output, const Block& block, uint64_t revision = 0);
+
+/**
+ * Reads a block in the Native format of given protocol revision, see WriteNativeBlock().
+ * Columns in sparse serialization are densified into columns of their types, unless `sparse_columns` is set,
+ * then they are read as ColumnSparse, or tuples of ColumnSparse elements.
+ * Returns false if the input ends, throws ProtocolError if a column can't be loaded.
+ */
+bool ReadNativeBlock(InputStream& input, Block* block, uint64_t revision = 0, CreateColumnByTypeSettings settings = {},
+        bool sparse_columns = false);
+
+/// Leading part of a block in the Native format, followed by names, types and data of its columns.
+struct NativeBlockHeader {
+    BlockInfo info;
+    uint64_t num_columns = 0;
+    uint64_t num_rows = 0;
+};
+
+/// Reads the header of a block in the Native format of given protocol revision, returns false if the input ends.
+bool ReadNativeBlockHeader(InputStream& input, NativeBlockHeader* header, uint64_t revision = 0);
+
+/// Name and type of a column of a block in the Native format, as they are written.
+struct NativeColumnHeader {
+    std::string name;
+    std::string type;
+};
+
+/**
+ * Reads a block without rows, e.g. the header of an INSERT query, keeping names and types of its columns as they are,
+ * without creating columns, so types the client doesn't support are read as well.
+ * Returns false if the input ends, throws ProtocolError if the block has rows or columns in custom serialization.
+ */
+bool ReadNativeBlockColumns(InputStream& input, std::vector<NativeColumnHeader>* columns, uint64_t revision = 0);
+
+/**
+ * Writes blocks to a file in the Native format, which ClickHouse reads with e.g. `SELECT * FROM file('data.native', Native)`.
+ * If compressed, blocks are written in frames of compressed data of the protocol, like data packets sent to the server,
+ * and can be read back by NativeFileReader only.
+ */
+class NativeFileWriter {
+public:
+    /// Creates the file, or truncates it if it exists, throws std::system_error on failure.
+    explicit NativeFileWriter(const std::string& path, CompressionMethod compression_method = CompressionMethod::None,
+            size_t max_compression_chunk_size = 65535);
+    /// Closes the file, errors are ignored, call Close() to check them.
+    ~NativeFileWriter();
+
+    void Write(const Block& block);
+
+    /// Flushes and closes the file, throws std::system_error on failure.
+    void Close();
+
+private:
+    class FileOutput;
+
+    std::unique_ptr<FileOutput> file_;
+    const CompressionMethod compression_method_;
+    const size_t max_compression_chunk_size_;
+};
+
+/**
+ * Reads blocks of a file written by NativeFileWriter or by ClickHouse in the Native format.
+ *
+ * The file is memory-mapped and blocks are decoded straight from the mapping. Strings of String and Nullable(String)
+ * columns of uncompressed files are not copied but reference the mapping, so blocks read must not outlive the reader.
+ * Other data is copied from the mapping into columns, one copy of each column.
+ */
+class NativeFileReader {
+public:
+    /// Maps the file, throws std::system_error on failure. `compressed` must match the writer.
+    explicit NativeFileReader(const std::string& path, bool compressed = false);
+    ~NativeFileReader();
+
+    /// Reads the next block, returns false at the end of the file.
+    bool Next(Block* block);
+
+private:
+    class MappedFile;
+
+    std::unique_ptr<MappedFile> file_;
+    ArrayInput input_;
+    const bool compressed_;
+};
+
+}
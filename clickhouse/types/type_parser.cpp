@@ -4,6 +4,7 @@
 #include "clickhouse/base/platform.h" // for _win_
 
 #include <algorithm>
+#include <cctype>
 #include <cmath>
 #include <map>
 #include <mutex>
@@ -54,18 +55,25 @@ static const std::unordered_map<std::string, Type::Code> kTypeCode = {
     { "IPv4",        Type::IPv4 },
     { "IPv6",        Type::IPv6 },
     { "Int128",      Type::Int128 },
-//    { "UInt128",      Type::UInt128 },
+    { "Int256",      Type::Int256 },
+    { "UInt128",     Type::UInt128 },
+    { "UInt256",     Type::UInt256 },
+    { "BFloat16",    Type::BFloat16 },
     { "Decimal",     Type::Decimal },
     { "Decimal32",   Type::Decimal32 },
     { "Decimal64",   Type::Decimal64 },
     { "Decimal128",  Type::Decimal128 },
+    { "Decimal256",  Type::Decimal256 },
     { "LowCardinality", Type::LowCardinality },
     { "Map",         Type::Map },
     { "Point",       Type::Point },
     { "Ring",        Type::Ring },
     { "Polygon",     Type::Polygon },
     { "MultiPolygon", Type::MultiPolygon },
-    { "JSON",        Type::IxJson },
+    { "Object",      Type::IxJson },
+    { "Variant",     Type::Variant },
+    { "Dynamic",     Type::Dynamic },
+    { "JSON",        Type::JSON },
 };
 
 template <typename L, typename R>
@@ -123,6 +131,10 @@ static TypeAst::Meta GetTypeMeta(const StringView& name) {
         return TypeAst::Map;
     }
 
+    if (name == "Variant") {
+        return TypeAst::Variant;
+    }
+
     return TypeAst::Terminal;
 }
 
@@ -169,6 +181,14 @@ bool TypeParser::Parse(TypeAst* type) {
                 type_->meta = GetTypeMeta(token.value);
                 type_->name = token.value.to_string();
                 type_->code = GetTypeCode(type_->name);
+                // Typed paths of JSON are not type names, so arguments of JSON are kept as raw text,
+                // e.g. JSON(max_dynamic_paths=10, a.b UInt32, SKIP REGEXP 'f.*').
+                if (type_->code == Type::JSON) {
+                    const char* arguments_end = SkipArguments();
+                    if (!arguments_end)
+                        return false;
+                    type_->value_string = std::string(token.value.data(), arguments_end);
+                }
                 break;
             case Token::Number:
                 type_->meta = TypeAst::Number;
@@ -214,6 +234,36 @@ bool TypeParser::Parse(TypeAst* type) {
     } while (true);
 }
 
+const char* TypeParser::SkipArguments() {
+    const char* pos = cur_;
+    while (pos < end_ && std::isspace(static_cast<unsigned char>(*pos)))
+        ++pos;
+    if (pos == end_ || *pos != '(')
+        return cur_;
+
+    size_t depth = 0;
+    char quote = 0;
+    for (; pos < end_; ++pos) {
+        const char c = *pos;
+        if (quote) {
+            if (c == '\\')
+                ++pos;
+            else if (c == quote)
+                quote = 0;
+        } else if (c == '\'' || c == '`') {
+            quote = c;
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')' && --depth == 0) {
+            cur_ = pos + 1;
+            return cur_;
+        }
+    }
+
+    // Unbalanced parentheses or quotes.
+    return nullptr;
+}
+
 TypeParser::Token TypeParser::NextToken() {
     for (; cur_ < end_; ++cur_) {
         switch (*cur_) {
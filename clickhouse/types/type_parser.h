@@ -22,7 +22,8 @@ struct TypeAst {
         Enum,
         LowCardinality,
         SimpleAggregateFunction,
-        Map
+        Map,
+        Variant
     };
 
     /// Type's category.
@@ -74,6 +75,9 @@ public:
 
 private:
     Token NextToken();
+    /// Skips arguments in parentheses following the current position, if any, without tokenizing them.
+    /// Returns the new position, or nullptr if parentheses or quotes are unbalanced.
+    const char* SkipArguments();
 
 private:
     const char* cur_;
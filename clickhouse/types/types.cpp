@@ -4,7 +4,34 @@
 
 #include <city.h>
 
+#include <algorithm>
+#include <cctype>
 #include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+using namespace clickhouse;
+
+/// Types made by Create*() and still in use, by name.
+struct InternTable {
+    struct Entry {
+        const Type* type;
+        std::weak_ptr<Type> ref;
+    };
+
+    std::mutex mutex;
+    // Keys are names of types in entries.
+    std::unordered_map<std::string_view, Entry> types;
+};
+
+InternTable& GetInternTable() {
+    // Never destroyed, since types may outlive static objects.
+    static auto* table = new InternTable;
+    return *table;
+}
+
+}
 
 namespace clickhouse {
 
@@ -13,6 +40,39 @@ Type::Type(const Code code)
     , type_unique_id_(0)
 {}
 
+TypeRef Type::Intern(Type* type, void (*destroy)(Type*)) {
+    std::unique_ptr<Type, void (*)(Type*)> holder(type, destroy);
+    const std::string_view name = type->GetName();
+
+    auto & table = GetInternTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    const auto it = table.types.find(name);
+    if (it != table.types.end()) {
+        if (auto existing = it->second.ref.lock()) {
+            return existing;
+        }
+        // The type is being destroyed, its key must not outlive it.
+        table.types.erase(it);
+    }
+
+    type->interned_ = true;
+    TypeRef result(holder.release(), [destroy](Type* t) {
+        {
+            auto & table = GetInternTable();
+            std::lock_guard<std::mutex> lock(table.mutex);
+            const auto it = table.types.find(t->GetName());
+            if (it != table.types.end() && it->second.type == t) {
+                table.types.erase(it);
+            }
+        }
+        // Out of the lock, since nested types are released here too.
+        destroy(t);
+    });
+    table.types.emplace(name, InternTable::Entry{type, result});
+    return result;
+}
+
 const char* Type::TypeName(Type::Code code) {
     switch (code) {
         case Type::Code::Void:           return "Void";
@@ -52,12 +112,29 @@ const char* Type::TypeName(Type::Code code) {
         case Type::Code::Polygon:        return "Polygon";
         case Type::Code::MultiPolygon:   return "MultiPolygon";
         case Type::Code::IxJson:         return "JSON";
+        case Type::Code::UInt128:        return "UInt128";
+        case Type::Code::Int256:         return "Int256";
+        case Type::Code::UInt256:        return "UInt256";
+        case Type::Code::BFloat16:       return "BFloat16";
+        case Type::Code::Decimal256:     return "Decimal256";
+        case Type::Code::Variant:        return "Variant";
+        case Type::Code::Dynamic:        return "Dynamic";
+        case Type::Code::JSON:           return "JSON";
+        case Type::Code::AggregateFunction: return "AggregateFunction";
     }
 
     return "Unknown type";
 }
 
-std::string Type::GetName() const {
+const std::string& Type::GetName() const {
+    std::call_once(name_once_, [this] {
+        name_ = BuildName();
+        type_unique_id_ = CityHash64WithSeed(name_.c_str(), name_.size(), code_);
+    });
+    return name_;
+}
+
+std::string Type::BuildName() const {
     switch (code_) {
         case Void:
         case Int8:
@@ -65,13 +142,17 @@ std::string Type::GetName() const {
         case Int32:
         case Int64:
         case Int128:
+        case Int256:
         case UInt8:
         case UInt16:
         case UInt32:
         case UInt64:
+        case UInt128:
+        case UInt256:
         case UUID:
         case Float32:
         case Float64:
+        case BFloat16:
         case String:
         case IPv4:
         case IPv6:
@@ -102,11 +183,20 @@ std::string Type::GetName() const {
         case Decimal32:
         case Decimal64:
         case Decimal128:
+        case Decimal256:
             return As<DecimalType>()->GetName();
         case LowCardinality:
             return As<LowCardinalityType>()->GetName();
         case Map:
             return As<MapType>()->GetName();
+        case Variant:
+            return As<VariantType>()->GetName();
+        case Dynamic:
+            return As<DynamicType>()->GetName();
+        case JSON:
+            return As<JSONType>()->GetName();
+        case AggregateFunction:
+            return As<AggregateFunctionType>()->GetName();
     }
 
     // XXX: NOT REACHED!
@@ -116,7 +206,7 @@ std::string Type::GetName() const {
 uint64_t Type::GetTypeUniqueId() const {
     // Helper method to optimize equality checks of types with Type::IsEqual(),
     // base invariant: types with same names produce same unique id (and hence considered equal).
-    // As an optimization, full type name is constructed at most once, and only for complex types.
+    // As an optimization, full type name is constructed at most once.
     switch (code_) {
         case Void:
         case Int8:
@@ -124,13 +214,17 @@ uint64_t Type::GetTypeUniqueId() const {
         case Int32:
         case Int64:
         case Int128:
+        case Int256:
         case UInt8:
         case UInt16:
         case UInt32:
         case UInt64:
+        case UInt128:
+        case UInt256:
         case UUID:
         case Float32:
         case Float64:
+        case BFloat16:
         case String:
         case IPv4:
         case IPv6:
@@ -156,116 +250,142 @@ uint64_t Type::GetTypeUniqueId() const {
         case Decimal32:
         case Decimal64:
         case Decimal128:
+        case Decimal256:
         case LowCardinality:
-        case Map: {
+        case Map:
+        case Variant:
+        case Dynamic:
+        case JSON:
+        case AggregateFunction:
             // For complex types, exact unique ID depends on nested types and/or parameters,
-            // the easiest way is to lazy-compute unique ID from name once.
-            // Here we do not care if multiple threads are computing value simultaneosly since it is both:
-            //   1. going to be the same
-            //   2. going to be stored atomically
-
-            if (type_unique_id_.load(std::memory_order_relaxed) == 0) {
-                const auto name = GetName();
-                type_unique_id_.store(CityHash64WithSeed(name.c_str(), name.size(), code_), std::memory_order_relaxed);
-            }
-
+            // it is computed from the name once, when the name is built.
+            GetName();
             return type_unique_id_;
-        }
     }
     assert(false);
     return 0;
 }
 
 TypeRef Type::CreateArray(TypeRef item_type) {
-    return TypeRef(new ArrayType(item_type));
+    return Intern(new ArrayType(item_type));
 }
 
 TypeRef Type::CreateDate() {
-    return TypeRef(new Type(Type::Date));
+    static const TypeRef type = Intern(new Type(Type::Date));
+    return type;
 }
 
 TypeRef Type::CreateDate32() {
-    return TypeRef(new Type(Type::Date32));
+    static const TypeRef type = Intern(new Type(Type::Date32));
+    return type;
 }
 
 TypeRef Type::CreateDateTime(std::string timezone) {
-    return TypeRef(new DateTimeType(std::move(timezone)));
+    return Intern(new DateTimeType(std::move(timezone)));
 }
 
 TypeRef Type::CreateDateTime64(size_t precision, std::string timezone) {
-    return TypeRef(new DateTime64Type(precision, std::move(timezone)));
+    return Intern(new DateTime64Type(precision, std::move(timezone)));
 }
 
 TypeRef Type::CreateDecimal(size_t precision, size_t scale) {
-    return TypeRef(new DecimalType(precision, scale));
+    return Intern(new DecimalType(precision, scale));
 }
 
 TypeRef Type::CreateIPv4() {
-    return TypeRef(new Type(Type::IPv4));
+    static const TypeRef type = Intern(new Type(Type::IPv4));
+    return type;
 }
 
 TypeRef Type::CreateIPv6() {
-    return TypeRef(new Type(Type::IPv6));
+    static const TypeRef type = Intern(new Type(Type::IPv6));
+    return type;
 }
 
 TypeRef Type::CreateNothing() {
-    return TypeRef(new Type(Type::Void));
+    static const TypeRef type = Intern(new Type(Type::Void));
+    return type;
 }
 
 TypeRef Type::CreateNullable(TypeRef nested_type) {
-    return TypeRef(new NullableType(nested_type));
+    return Intern(new NullableType(nested_type));
 }
 
 TypeRef Type::CreateString() {
-    return TypeRef(new Type(Type::String));
+    static const TypeRef type = Intern(new Type(Type::String));
+    return type;
 }
 
 TypeRef Type::CreateString(size_t n) {
-    return TypeRef(new FixedStringType(n));
+    return Intern(new FixedStringType(n));
 }
 
 TypeRef Type::CreateTuple(const std::vector<TypeRef>& item_types) {
-    return TypeRef(new TupleType(item_types));
+    return Intern(new TupleType(item_types));
 }
 
 TypeRef Type::CreateEnum8(const std::vector<EnumItem>& enum_items) {
-    return TypeRef(new EnumType(Type::Enum8, enum_items));
+    return Intern(new EnumType(Type::Enum8, enum_items));
 }
 
 TypeRef Type::CreateEnum16(const std::vector<EnumItem>& enum_items) {
-    return TypeRef(new EnumType(Type::Enum16, enum_items));
+    return Intern(new EnumType(Type::Enum16, enum_items));
 }
 
 TypeRef Type::CreateUUID() {
-    return TypeRef(new Type(Type::UUID));
+    static const TypeRef type = Intern(new Type(Type::UUID));
+    return type;
 }
 
 TypeRef Type::CreateLowCardinality(TypeRef item_type) {
-    return std::make_shared<LowCardinalityType>(item_type);
+    return Intern(new LowCardinalityType(item_type));
 }
 
 TypeRef Type::CreateMap(TypeRef key_type, TypeRef value_type) {
-    return std::make_shared<MapType>(key_type, value_type);
+    return Intern(new MapType(key_type, value_type));
 }
 
 TypeRef Type::CreatePoint() {
-    return TypeRef(new Type(Type::Point));
+    static const TypeRef type = Intern(new Type(Type::Point));
+    return type;
 }
 
 TypeRef Type::CreateRing() {
-    return TypeRef(new Type(Type::Ring));
+    static const TypeRef type = Intern(new Type(Type::Ring));
+    return type;
 }
 
 TypeRef Type::CreatePolygon() {
-    return TypeRef(new Type(Type::Polygon));
+    static const TypeRef type = Intern(new Type(Type::Polygon));
+    return type;
 }
 
 TypeRef Type::CreateMultiPolygon() {
-    return TypeRef(new Type(Type::MultiPolygon));
+    static const TypeRef type = Intern(new Type(Type::MultiPolygon));
+    return type;
 }
 
 TypeRef Type::CreateIxJson() {
-    return TypeRef(new Type(Type::IxJson));
+    // Not interned, since JSON without arguments, made by CreateJSON(), has the same name.
+    static const TypeRef type(new Type(Type::IxJson));
+    return type;
+}
+
+TypeRef Type::CreateVariant(const std::vector<TypeRef>& variant_types) {
+    return Intern(new VariantType(variant_types));
+}
+
+TypeRef Type::CreateDynamic(size_t max_types) {
+    return Intern(new DynamicType(max_types));
+}
+
+TypeRef Type::CreateJSON(std::vector<std::pair<std::string, TypeRef>> typed_paths, size_t max_dynamic_paths, size_t max_dynamic_types,
+        std::vector<std::string> skip) {
+    return Intern(new JSONType(std::move(typed_paths), max_dynamic_paths, max_dynamic_types, std::move(skip)));
+}
+
+TypeRef Type::CreateAggregateFunction(std::string function, std::vector<TypeRef> argument_types, std::vector<std::string> parameters) {
+    return Intern(new AggregateFunctionType(std::move(function), std::move(argument_types), std::move(parameters)));
 }
 
 /// class ArrayType
@@ -279,7 +399,7 @@ DecimalType::DecimalType(size_t precision, size_t scale)
     : Type(Decimal),
       precision_(precision),
       scale_(scale) {
-    // TODO: assert(precision <= 38 && precision > 0);
+    // TODO: assert(precision <= 76 && precision > 0);
 }
 
 std::string DecimalType::GetName() const {
@@ -292,6 +412,8 @@ std::string DecimalType::GetName() const {
             return "Decimal64(" + std::to_string(scale_) + ")";
         case Decimal128:
             return "Decimal128(" + std::to_string(scale_) + ")";
+        case Decimal256:
+            return "Decimal256(" + std::to_string(scale_) + ")";
         default:
             /// XXX: NOT REACHED!
             return "";
@@ -458,4 +580,120 @@ std::string MapType::GetName() const {
     return std::string("Map(") + key_type_->GetName() + ", " +value_type_->GetName() + ")";
 }
 
+/// class VariantType
+VariantType::VariantType(const std::vector<TypeRef>& variant_types)
+    : Type(Variant)
+    , variant_types_(variant_types) {
+    // Discriminator 255 denotes NULL.
+    if (variant_types_.size() > 255) {
+        throw ValidationError("Variant can't have more than 255 variants");
+    }
+}
+
+std::string VariantType::GetName() const {
+    std::string result("Variant(");
+
+    for (size_t i = 0; i < variant_types_.size(); ++i) {
+        if (i)
+            result += ", ";
+        result += variant_types_[i]->GetName();
+    }
+
+    result += ")";
+
+    return result;
+}
+
+/// class DynamicType
+DynamicType::DynamicType(size_t max_types)
+    : Type(Dynamic)
+    , max_types_(max_types) {
+    if (max_types_ > 254) {
+        throw ValidationError("Dynamic max_types can't be greater than 254");
+    }
+}
+
+std::string DynamicType::GetName() const {
+    if (max_types_ == DefaultMaxTypes)
+        return "Dynamic";
+    return "Dynamic(max_types=" + std::to_string(max_types_) + ")";
+}
+
+/// class JSONType
+JSONType::JSONType(std::vector<std::pair<std::string, TypeRef>> typed_paths, size_t max_dynamic_paths, size_t max_dynamic_types,
+        std::vector<std::string> skip)
+    : Type(JSON)
+    , typed_paths_(std::move(typed_paths))
+    , max_dynamic_paths_(max_dynamic_paths)
+    , max_dynamic_types_(max_dynamic_types)
+    , skip_(std::move(skip)) {
+    std::sort(typed_paths_.begin(), typed_paths_.end(), [](const auto & left, const auto & right) {
+        return left.first < right.first;
+    });
+}
+
+std::string JSONType::GetName() const {
+    std::vector<std::string> arguments;
+    if (max_dynamic_paths_ != DefaultMaxDynamicPaths)
+        arguments.push_back("max_dynamic_paths=" + std::to_string(max_dynamic_paths_));
+    if (max_dynamic_types_ != DynamicType::DefaultMaxTypes)
+        arguments.push_back("max_dynamic_types=" + std::to_string(max_dynamic_types_));
+
+    for (const auto & [path, type] : typed_paths_) {
+        const bool needs_quotes = path.empty() || std::any_of(path.begin(), path.end(), [](char c) {
+            return !(std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.');
+        });
+        arguments.push_back((needs_quotes ? "`" + path + "`" : path) + " " + type->GetName());
+    }
+
+    for (const auto & skip : skip_)
+        arguments.push_back("SKIP " + skip);
+
+    if (arguments.empty())
+        return "JSON";
+
+    std::string result("JSON(");
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        if (i)
+            result += ", ";
+        result += arguments[i];
+    }
+    result += ")";
+
+    return result;
+}
+
+/// class AggregateFunctionType
+AggregateFunctionType::AggregateFunctionType(std::string function, std::vector<TypeRef> argument_types,
+        std::vector<std::string> parameters)
+    : Type(AggregateFunction)
+    , function_(std::move(function))
+    , argument_types_(std::move(argument_types))
+    , parameters_(std::move(parameters)) {
+}
+
+std::string AggregateFunctionType::GetName() const {
+    std::string result("AggregateFunction(");
+    result += function_;
+
+    if (!parameters_.empty()) {
+        result += "(";
+        for (size_t i = 0; i < parameters_.size(); ++i) {
+            if (i)
+                result += ", ";
+            result += parameters_[i];
+        }
+        result += ")";
+    }
+
+    for (const auto & type : argument_types_) {
+        result += ", ";
+        result += type->GetName();
+    }
+
+    result += ")";
+
+    return result;
+}
+
 }  // namespace clickhouse
@@ -1,11 +1,15 @@
 #pragma once
 
+#include "../base/bfloat16.h"
+#include "../base/wide_integer.h"
+
 #include "absl/numeric/int128.h"
 
-#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 #include <stdexcept>
 
@@ -13,6 +17,8 @@ namespace clickhouse {
 
 using Int128 = absl::int128;
 using Int64 = int64_t;
+// Note that clickhouse::UInt128 is taken by UUID representation (see base/uuid.h),
+// values of UInt128 columns are absl::uint128.
 
 using TypeRef = std::shared_ptr<class Type>;
 
@@ -55,7 +61,16 @@ public:
         Ring,
         Polygon,
         MultiPolygon,
-        IxJson
+        IxJson,
+        UInt128,
+        Int256,
+        UInt256,
+        BFloat16,
+        Decimal256,
+        Variant,
+        Dynamic,
+        JSON,
+        AggregateFunction,
     };
 
     using EnumItem = std::pair<std::string /* name */, int16_t /* value */>;
@@ -77,15 +92,17 @@ public:
     /// Type's code.
     Code GetCode() const { return code_; }
 
-    /// String representation of the type.
-    std::string GetName() const;
+    /// String representation of the type, built once.
+    const std::string& GetName() const;
 
     /// Is given type same as current one.
     bool IsEqual(const Type& other) const {
         // Types are equal only if both code_ and type_unique_id_ are equal.
         return this == &other
-                // GetTypeUniqueId() is relatively heavy, so avoid calling it when comparing obviously different types.
-                || (this->GetCode() == other.GetCode() && this->GetTypeUniqueId() == other.GetTypeUniqueId());
+                // Types made by Create*() are interned, so different instances of them are different types.
+                || (!(interned_ && other.interned_)
+                    // GetTypeUniqueId() is relatively heavy, so avoid calling it when comparing obviously different types.
+                    && this->GetCode() == other.GetCode() && this->GetTypeUniqueId() == other.GetTypeUniqueId());
     }
 
     bool IsEqual(const TypeRef& other) const { return IsEqual(*other); }
@@ -141,13 +158,44 @@ public:
 
     static TypeRef CreateMultiPolygon();
 
+    /// Type of ColumnIxJson, the legacy Object('json') sent as text.
     static TypeRef CreateIxJson();
 
+    /// Variant types must be given in the order of ClickHouse, i.e. sorted by type name.
+    static TypeRef CreateVariant(const std::vector<TypeRef>& variant_types);
+
+    static TypeRef CreateDynamic(size_t max_types = 32);
+
+    static TypeRef CreateJSON(std::vector<std::pair<std::string, TypeRef>> typed_paths = {},
+            size_t max_dynamic_paths = 1024,
+            size_t max_dynamic_types = 32,
+            std::vector<std::string> skip = {});
+
+    /// Parameters are given as in the type name, e.g. CreateAggregateFunction("quantileTDigest", {Type::CreateSimple<double>()}, {"0.9"}).
+    static TypeRef CreateAggregateFunction(std::string function, std::vector<TypeRef> argument_types,
+            std::vector<std::string> parameters = {});
+
 private:
+    /** Returns the type, taking ownership of it, or the equal type made before and still in use,
+     *  so that all types made by Create*() with the same name share one instance.
+     *  Type has no virtual destructor, so the type is deleted as T.
+     */
+    template <typename T>
+    static TypeRef Intern(T* type) {
+        return Intern(type, [](Type* t) { delete static_cast<T*>(t); });
+    }
+
+    static TypeRef Intern(Type* type, void (*destroy)(Type*));
+
+    std::string BuildName() const;
+
     uint64_t GetTypeUniqueId() const;
 
     const Code code_;
-    mutable std::atomic<uint64_t> type_unique_id_;
+    mutable std::once_flag name_once_;
+    mutable std::string name_;
+    mutable uint64_t type_unique_id_;
+    bool interned_ = false;
 };
 
 inline bool operator==(const Type & left, const Type & right) {
@@ -317,59 +365,170 @@ private:
     TypeRef value_type_;
 };
 
+class VariantType : public Type {
+public:
+    explicit VariantType(const std::vector<TypeRef>& variant_types);
+
+    std::string GetName() const;
+
+    /// Types of variants, index of a type is the discriminator of its values.
+    const std::vector<TypeRef>& GetVariantTypes() const { return variant_types_; }
+
+private:
+    std::vector<TypeRef> variant_types_;
+};
+
+class DynamicType : public Type {
+public:
+    static constexpr size_t DefaultMaxTypes = 32;
+
+    explicit DynamicType(size_t max_types);
+
+    std::string GetName() const;
+
+    /// Maximum number of distinct types stored as separate variants.
+    inline size_t GetMaxTypes() const { return max_types_; }
+
+private:
+    size_t max_types_;
+};
+
+class JSONType : public Type {
+public:
+    static constexpr size_t DefaultMaxDynamicPaths = 1024;
+
+    /// Typed paths are sorted by path, `skip` holds arguments of SKIP clauses as is, e.g. "a.b" or "REGEXP 'c.*'".
+    JSONType(std::vector<std::pair<std::string, TypeRef>> typed_paths, size_t max_dynamic_paths, size_t max_dynamic_types,
+            std::vector<std::string> skip);
+
+    std::string GetName() const;
+
+    /// Paths with types declared in the type, sorted by path.
+    inline const std::vector<std::pair<std::string, TypeRef>>& GetTypedPaths() const { return typed_paths_; }
+
+    /// Maximum number of paths stored as separate Dynamic columns.
+    inline size_t GetMaxDynamicPaths() const { return max_dynamic_paths_; }
+
+    /// `max_types` of Dynamic columns of paths without declared type.
+    inline size_t GetMaxDynamicTypes() const { return max_dynamic_types_; }
+
+    inline const std::vector<std::string>& GetSkip() const { return skip_; }
+
+private:
+    std::vector<std::pair<std::string, TypeRef>> typed_paths_;
+    size_t max_dynamic_paths_;
+    size_t max_dynamic_types_;
+    std::vector<std::string> skip_;
+};
+
+class AggregateFunctionType : public Type {
+public:
+    AggregateFunctionType(std::string function, std::vector<TypeRef> argument_types, std::vector<std::string> parameters);
+
+    std::string GetName() const;
+
+    /// Name of the function, e.g. "sum".
+    inline const std::string& GetFunction() const { return function_; }
+
+    inline const std::vector<TypeRef>& GetArgumentTypes() const { return argument_types_; }
+
+    /// Parameters of the function as in the type name, e.g. "0.9" of quantileTDigest(0.9).
+    inline const std::vector<std::string>& GetParameters() const { return parameters_; }
+
+private:
+    std::string function_;
+    std::vector<TypeRef> argument_types_;
+    std::vector<std::string> parameters_;
+};
+
 template <>
 inline TypeRef Type::CreateSimple<int8_t>() {
-    return TypeRef(new Type(Int8));
+    static const TypeRef type = Intern(new Type(Int8));
+    return type;
 }
 
 template <>
 inline TypeRef Type::CreateSimple<int16_t>() {
-    return TypeRef(new Type(Int16));
+    static const TypeRef type = Intern(new Type(Int16));
+    return type;
 }
 
 template <>
 inline TypeRef Type::CreateSimple<int32_t>() {
-    return TypeRef(new Type(Int32));
+    static const TypeRef type = Intern(new Type(Int32));
+    return type;
 }
 
 template <>
 inline TypeRef Type::CreateSimple<int64_t>() {
-    return TypeRef(new Type(Int64));
+    static const TypeRef type = Intern(new Type(Int64));
+    return type;
 }
 
 template <>
 inline TypeRef Type::CreateSimple<Int128>() {
-    return TypeRef(new Type(Int128));
+    static const TypeRef type = Intern(new Type(Int128));
+    return type;
+}
+
+template <>
+inline TypeRef Type::CreateSimple<Int256>() {
+    static const TypeRef type = Intern(new Type(Int256));
+    return type;
 }
 
 template <>
 inline TypeRef Type::CreateSimple<uint8_t>() {
-    return TypeRef(new Type(UInt8));
+    static const TypeRef type = Intern(new Type(UInt8));
+    return type;
 }
 
 template <>
 inline TypeRef Type::CreateSimple<uint16_t>() {
-    return TypeRef(new Type(UInt16));
+    static const TypeRef type = Intern(new Type(UInt16));
+    return type;
 }
 
 template <>
 inline TypeRef Type::CreateSimple<uint32_t>() {
-    return TypeRef(new Type(UInt32));
+    static const TypeRef type = Intern(new Type(UInt32));
+    return type;
 }
 
 template <>
 inline TypeRef Type::CreateSimple<uint64_t>() {
-    return TypeRef(new Type(UInt64));
+    static const TypeRef type = Intern(new Type(UInt64));
+    return type;
+}
+
+template <>
+inline TypeRef Type::CreateSimple<absl::uint128>() {
+    static const TypeRef type = Intern(new Type(UInt128));
+    return type;
+}
+
+template <>
+inline TypeRef Type::CreateSimple<UInt256>() {
+    static const TypeRef type = Intern(new Type(UInt256));
+    return type;
+}
+
+template <>
+inline TypeRef Type::CreateSimple<BFloat16>() {
+    static const TypeRef type = Intern(new Type(BFloat16));
+    return type;
 }
 
 template <>
 inline TypeRef Type::CreateSimple<float>() {
-    return TypeRef(new Type(Float32));
+    static const TypeRef type = Intern(new Type(Float32));
+    return type;
 }
 
 template <>
 inline TypeRef Type::CreateSimple<double>() {
-    return TypeRef(new Type(Float64));
+    static const TypeRef type = Intern(new Type(Float64));
+    return type;
 }
 
 }  // namespace clickhouse
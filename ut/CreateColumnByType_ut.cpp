@@ -1,5 +1,9 @@
+#include <clickhouse/columns/aggregate_function.h>
 #include <clickhouse/columns/factory.h>
+#include <clickhouse/columns/array.h>
 #include <clickhouse/columns/date.h>
+#include <clickhouse/columns/ix-json.h>
+#include <clickhouse/columns/json.h>
 #include <clickhouse/columns/numeric.h>
 #include <clickhouse/columns/string.h>
 
@@ -53,6 +57,14 @@ TEST(CreateColumnByType, DateTime) {
 TEST(CreateColumnByType, AggregateFunction) {
     EXPECT_EQ(nullptr, CreateColumnByType("AggregateFunction(argMax, Int32, DateTime64(3))"));
     EXPECT_EQ(nullptr, CreateColumnByType("AggregateFunction(argMax, FIxedString(10), DateTime64(3, 'UTC'))"));
+    EXPECT_EQ(nullptr, CreateColumnByType("AggregateFunction(sum, String)"));
+    EXPECT_EQ(nullptr, CreateColumnByType("AggregateFunction(uniq, UInt64, String)"));
+
+    const auto col = CreateColumnByType("AggregateFunction(quantilesTDigest(0.5, 0.9), Float32)");
+    ASSERT_NE(nullptr, col->As<ColumnAggregateFunction>());
+    const auto & type = col->As<ColumnAggregateFunction>()->GetAggregateFunctionType();
+    EXPECT_EQ(type.GetFunction(), "quantilesTDigest");
+    EXPECT_EQ(type.GetParameters(), (std::vector<std::string>{"0.5", "0.9"}));
 }
 
 
@@ -76,13 +88,14 @@ INSTANTIATE_TEST_SUITE_P(Basic, CreateColumnByTypeWithName, ::testing::Values(
     "Int8", "Int16", "Int32", "Int64",
     "UInt8", "UInt16", "UInt32", "UInt64",
     "String", "Date", "DateTime",
-    "UUID", "Int128"
+    "UUID", "Int128", "UInt128",
+    "Int256", "UInt256", "BFloat16"
 ));
 
 INSTANTIATE_TEST_SUITE_P(Parametrized, CreateColumnByTypeWithName, ::testing::Values(
     "FixedString(0)", "FixedString(10000)",
     "DateTime('UTC')", "DateTime64(3, 'UTC')",
-    "Decimal(9,3)", "Decimal(18,3)",
+    "Decimal(9,3)", "Decimal(18,3)", "Decimal(50,10)",
     "Enum8('ONE' = 1, 'TWO' = 2)",
     "Enum16('ONE' = 1, 'TWO' = 2, 'THREE' = 3, 'FOUR' = 4)"
 ));
@@ -92,5 +105,67 @@ INSTANTIATE_TEST_SUITE_P(Nested, CreateColumnByTypeWithName, ::testing::Values(
     "Nullable(FixedString(10000))",
     "Nullable(LowCardinality(FixedString(10000)))",
     "Array(Nullable(LowCardinality(FixedString(10000))))",
-    "Array(Enum8('ONE' = 1, 'TWO' = 2))"
+    "Array(Enum8('ONE' = 1, 'TWO' = 2))",
+    "LowCardinality(UInt32)",
+    "LowCardinality(Float64)",
+    "LowCardinality(Date)",
+    "LowCardinality(DateTime('UTC'))",
+    "LowCardinality(Enum8('ONE' = 1, 'TWO' = 2))",
+    "LowCardinality(Nullable(Int64))",
+    "Array(LowCardinality(UInt16))",
+    "Map(LowCardinality(Date), String)"
+));
+
+INSTANTIATE_TEST_SUITE_P(SemiStructured, CreateColumnByTypeWithName, ::testing::Values(
+    "Variant(String, UInt64)",
+    "Array(Variant(Array(UInt8), Nullable(String)))",
+    "Dynamic",
+    "Dynamic(max_types=10)",
+    "JSON"
+));
+
+TEST(CreateColumnByType, JSON) {
+    // JSON is ColumnIxJson unless native JSON is requested.
+    EXPECT_NE(CreateColumnByType("JSON")->As<ColumnIxJson>(), nullptr);
+    EXPECT_NE(CreateColumnByType("JSON(a.b UInt32)")->As<ColumnIxJson>(), nullptr);
+    EXPECT_EQ(CreateColumnByType("Object('json')")->GetType().GetName(), "JSON");
+
+    CreateColumnByTypeSettings settings;
+    settings.native_json = true;
+
+    for (const std::string type : {
+            "JSON",
+            "JSON(max_dynamic_paths=10, max_dynamic_types=2, a.b UInt32, `c d` Array(String), SKIP e, SKIP REGEXP 'f.*')",
+            "Array(JSON(a UInt32))",
+            "Tuple(UInt8, JSON(`x (y)` String))",
+            "Map(String, JSON(a Nullable(String)))",
+            "Nullable(JSON)"}) {
+        SCOPED_TRACE(type);
+        const auto col = CreateColumnByType(type, settings);
+        ASSERT_NE(col, nullptr);
+        EXPECT_EQ(col->GetType().GetName(), type);
+    }
+    EXPECT_NE(CreateColumnByType("Array(JSON(a UInt32))", settings)->As<ColumnArray>()->GetNestedColumn()->As<ColumnJSON>(), nullptr);
+    EXPECT_NE(CreateColumnByType("Object('json')", settings)->As<ColumnIxJson>(), nullptr);
+
+    // Malformed arguments.
+    EXPECT_THROW(CreateColumnByType("JSON(max_dynamic_paths=abc)", settings), ValidationError);
+    EXPECT_THROW(CreateColumnByType("JSON(max_dynamic_paths=99999999999999999999999)", settings), ValidationError);
+    EXPECT_THROW(CreateColumnByType("JSON(max_dynamic_types=10x)", settings), ValidationError);
+    EXPECT_THROW(CreateColumnByType("JSON(max_dynamic_types=-1)", settings), ValidationError);
+    EXPECT_EQ(CreateColumnByType("JSON(max_dynamic_depth=10)", settings), nullptr);
+    EXPECT_EQ(CreateColumnByType("JSON(a UInt32", settings), nullptr);
+    EXPECT_EQ(CreateColumnByType("Array(JSON(a Unknown))", settings), nullptr);
+}
+
+INSTANTIATE_TEST_SUITE_P(AggregateFunction, CreateColumnByTypeWithName, ::testing::Values(
+    "AggregateFunction(count)",
+    "AggregateFunction(sum, UInt32)",
+    "AggregateFunction(min, Float64)",
+    "AggregateFunction(avg, Int16)",
+    "AggregateFunction(uniq, String)",
+    "AggregateFunction(uniqCombined, UInt64)",
+    "AggregateFunction(uniqCombined(12), String)",
+    "AggregateFunction(uniqCombined64, Float32)",
+    "AggregateFunction(quantileTDigest(0.9), Float64)"
 ));
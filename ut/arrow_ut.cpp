@@ -0,0 +1,412 @@
+#include <clickhouse/arrow.h>
+#include <clickhouse/client.h>
+#include <clickhouse/columns/factory.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+namespace {
+using namespace clickhouse;
+
+Block MakeBlock(std::vector<std::pair<std::string, ColumnRef>> columns) {
+    Block result;
+
+    for (const auto & name_and_col : columns) {
+        result.AppendColumn(name_and_col.first, name_and_col.second);
+    }
+
+    result.RefreshRowCount();
+    return result;
+}
+
+/// Schema and array of a single-column block, released on destruction.
+struct ExportedColumn {
+    explicit ExportedColumn(ColumnRef column) {
+        const auto block = MakeBlock({{"column", std::move(column)}});
+        ExportArrowSchema(block, &schema);
+        ExportArrowArray(block, &array);
+    }
+
+    ~ExportedColumn() {
+        schema.release(&schema);
+        array.release(&array);
+    }
+
+    const ArrowSchema& Field() const { return *schema.children[0]; }
+    const ArrowArray& Column() const { return *array.children[0]; }
+
+    ArrowSchema schema;
+    ArrowArray array;
+};
+
+::testing::AssertionResult SameItems(const Column& left, const Column& right, size_t row) {
+    const auto l = left.GetItem(row);
+    const auto r = right.GetItem(row);
+    if (l.type == r.type && l.data == r.data) {
+        return ::testing::AssertionSuccess();
+    }
+    return ::testing::AssertionFailure() << "items of row " << row << " differ";
+}
+
+bool IsValid(const ArrowArray& array, size_t row) {
+    const auto bitmap = static_cast<const uint8_t*>(array.buffers[0]);
+    return bitmap == nullptr || (bitmap[row / 8] >> (row % 8)) & 1;
+}
+
+}
+
+TEST(ArrowTest, SchemaFormats) {
+    const std::vector<std::pair<std::string, std::string>> types = {
+        {"Int8", "c"},
+        {"UInt64", "L"},
+        {"Float64", "g"},
+        {"Enum16('a' = 1)", "s"},
+        {"IPv4", "I"},
+        {"String", "z"},
+        {"FixedString(4)", "w:4"},
+        {"UUID", "w:16"},
+        {"Date", "tdD"},
+        {"DateTime('UTC')", "tss:UTC"},
+        {"DateTime64(2, 'UTC')", "tsm:UTC"},
+        {"DateTime64(9)", "tsn:"},
+        {"Decimal(10, 2)", "d:10,2"},
+        {"Decimal(76, 10)", "d:76,10,256"},
+        {"Array(Int32)", "+l"},
+        {"Tuple(Int32, String)", "+s"},
+        {"Map(String, UInt8)", "+m"},
+        {"LowCardinality(String)", "i"},
+    };
+
+    for (const auto & [type, format] : types) {
+        SCOPED_TRACE(type);
+        const auto block = MakeBlock({{"x", CreateColumnByType(type)}});
+        ArrowSchema schema;
+        ExportArrowSchema(block, &schema);
+
+        EXPECT_STREQ("+s", schema.format);
+        ASSERT_EQ(1, schema.n_children);
+        EXPECT_STREQ(format.c_str(), schema.children[0]->format);
+        EXPECT_STREQ("x", schema.children[0]->name);
+        EXPECT_EQ(0, schema.children[0]->flags);
+
+        schema.release(&schema);
+        EXPECT_EQ(nullptr, schema.release);
+    }
+}
+
+TEST(ArrowTest, SchemaOfNestedTypes) {
+    const auto block = MakeBlock({
+        {"map", CreateColumnByType("Map(String, Nullable(UInt8))")},
+        {"lc", CreateColumnByType("LowCardinality(Nullable(String))")},
+    });
+    ArrowSchema schema;
+    ExportArrowSchema(block, &schema);
+
+    const auto & map = *schema.children[0];
+    ASSERT_EQ(1, map.n_children);
+    const auto & entries = *map.children[0];
+    EXPECT_STREQ("entries", entries.name);
+    EXPECT_STREQ("+s", entries.format);
+    ASSERT_EQ(2, entries.n_children);
+    EXPECT_STREQ("key", entries.children[0]->name);
+    EXPECT_EQ(0, entries.children[0]->flags);
+    EXPECT_STREQ("value", entries.children[1]->name);
+    EXPECT_STREQ("C", entries.children[1]->format);
+    EXPECT_EQ(ARROW_FLAG_NULLABLE, entries.children[1]->flags);
+
+    const auto & lc = *schema.children[1];
+    EXPECT_STREQ("i", lc.format);
+    EXPECT_EQ(ARROW_FLAG_NULLABLE, lc.flags);
+    ASSERT_NE(nullptr, lc.dictionary);
+    EXPECT_STREQ("z", lc.dictionary->format);
+
+    schema.release(&schema);
+}
+
+TEST(ArrowTest, UnsupportedType) {
+    const auto block = MakeBlock({{"x", std::make_shared<ColumnInt128>()}});
+    ArrowSchema schema;
+    ArrowArray array;
+    EXPECT_THROW(ExportArrowSchema(block, &schema), UnimplementedError);
+    EXPECT_THROW(ExportArrowArray(block, &array), UnimplementedError);
+}
+
+TEST(ArrowTest, NumbersAreShared) {
+    auto column = std::make_shared<ColumnUInt64>(std::vector<uint64_t>{1, 2, 3});
+    const auto data = column->GetData().data();
+
+    ArrowArray array;
+    ExportArrowArray(MakeBlock({{"x", column}}), &array);
+    column.reset();
+
+    EXPECT_EQ(3, array.length);
+    ASSERT_EQ(1, array.n_children);
+    const auto & child = *array.children[0];
+    EXPECT_EQ(0, child.null_count);
+    ASSERT_EQ(2, child.n_buffers);
+    EXPECT_EQ(nullptr, child.buffers[0]);
+    // The column is kept alive by the array.
+    EXPECT_EQ(static_cast<const void*>(data), child.buffers[1]);
+    EXPECT_EQ(3u, static_cast<const uint64_t*>(child.buffers[1])[2]);
+
+    array.release(&array);
+    EXPECT_EQ(nullptr, array.release);
+}
+
+TEST(ArrowTest, NullableStrings) {
+    auto column = std::make_shared<ColumnNullableT<ColumnString>>();
+    column->Append("foo");
+    column->Append(std::nullopt);
+    column->Append("");
+    column->Append("barbaz");
+
+    ExportedColumn exported(column);
+    EXPECT_EQ(ARROW_FLAG_NULLABLE, exported.Field().flags);
+
+    const auto & array = exported.Column();
+    EXPECT_EQ(4, array.length);
+    EXPECT_EQ(1, array.null_count);
+    ASSERT_EQ(3, array.n_buffers);
+    EXPECT_TRUE(IsValid(array, 0));
+    EXPECT_FALSE(IsValid(array, 1));
+    EXPECT_TRUE(IsValid(array, 2));
+    EXPECT_TRUE(IsValid(array, 3));
+
+    const auto offsets = static_cast<const int32_t*>(array.buffers[1]);
+    EXPECT_EQ(std::vector<int32_t>({0, 3, 3, 3, 9}), std::vector<int32_t>(offsets, offsets + 5));
+    EXPECT_EQ("foobarbaz", std::string(static_cast<const char*>(array.buffers[2]), offsets[4]));
+}
+
+TEST(ArrowTest, ConvertedValues) {
+    auto date = std::make_shared<ColumnDate>();
+    date->Append(86400 * 3);
+    auto datetime64 = std::make_shared<ColumnDateTime64>(2);
+    datetime64->Append(Int64(12345));
+    auto decimal = std::make_shared<ColumnDecimal>(10, 2);
+    decimal->Append("-1.25");
+    auto uuid = std::make_shared<ColumnUUID>();
+    uuid->Append(UUID{0x0102030405060708ull, 0x090a0b0c0d0e0f10ull});
+
+    const auto block = MakeBlock({{"date", date}, {"datetime64", datetime64}, {"decimal", decimal}, {"uuid", uuid}});
+    ArrowArray array;
+    ExportArrowArray(block, &array);
+
+    EXPECT_EQ(3, static_cast<const int32_t*>(array.children[0]->buffers[1])[0]);
+    // Precision 2 is exported in milliseconds.
+    EXPECT_EQ(123450, static_cast<const int64_t*>(array.children[1]->buffers[1])[0]);
+    EXPECT_EQ(Int128(-125), static_cast<const Int128*>(array.children[2]->buffers[1])[0]);
+
+    const auto uuid_bytes = static_cast<const uint8_t*>(array.children[3]->buffers[1]);
+    for (uint8_t i = 0; i < 16; ++i) {
+        EXPECT_EQ(i + 1, uuid_bytes[i]);
+    }
+
+    array.release(&array);
+}
+
+TEST(ArrowTest, Arrays) {
+    auto column = std::make_shared<ColumnArrayT<ColumnInt32>>();
+    column->Append(std::vector<int32_t>{1, 2});
+    column->Append(std::vector<int32_t>{});
+    column->Append(std::vector<int32_t>{3});
+
+    ExportedColumn exported(column);
+    const auto & array = exported.Column();
+    ASSERT_EQ(2, array.n_buffers);
+    const auto offsets = static_cast<const int32_t*>(array.buffers[1]);
+    EXPECT_EQ(std::vector<int32_t>({0, 2, 2, 3}), std::vector<int32_t>(offsets, offsets + 4));
+
+    ASSERT_EQ(1, array.n_children);
+    EXPECT_EQ(3, array.children[0]->length);
+    const auto items = static_cast<const int32_t*>(array.children[0]->buffers[1]);
+    EXPECT_EQ(std::vector<int32_t>({1, 2, 3}), std::vector<int32_t>(items, items + 3));
+}
+
+TEST(ArrowTest, LowCardinality) {
+    auto column = std::make_shared<ColumnLowCardinalityT<ColumnNullableT<ColumnString>>>();
+    column->Append("foo");
+    column->Append(std::nullopt);
+    column->Append("bar");
+    column->Append("foo");
+
+    ExportedColumn exported(column);
+    const auto & array = exported.Column();
+    EXPECT_EQ(1, array.null_count);
+    EXPECT_FALSE(IsValid(array, 1));
+
+    ASSERT_NE(nullptr, array.dictionary);
+    const auto & dictionary = *array.dictionary;
+    const auto indices = static_cast<const int32_t*>(array.buffers[1]);
+    const auto offsets = static_cast<const int32_t*>(dictionary.buffers[1]);
+    const auto chars = static_cast<const char*>(dictionary.buffers[2]);
+    const auto item = [&](size_t row) {
+        return std::string(chars + offsets[indices[row]], offsets[indices[row] + 1] - offsets[indices[row]]);
+    };
+    EXPECT_EQ("foo", item(0));
+    EXPECT_EQ("bar", item(2));
+    EXPECT_EQ(indices[0], indices[3]);
+}
+
+TEST(ArrowTest, ImportExported) {
+    auto nullable = std::make_shared<ColumnNullableT<ColumnInt32>>();
+    nullable->Append(1);
+    nullable->Append(std::nullopt);
+    nullable->Append(3);
+    auto strings = std::make_shared<ColumnString>(std::vector<std::string>{"a", "", "\xFF\xFE" "bcd"});
+    auto arrays = std::make_shared<ColumnArrayT<ColumnUInt8>>();
+    arrays->Append(std::vector<uint8_t>{1});
+    arrays->Append(std::vector<uint8_t>{});
+    arrays->Append(std::vector<uint8_t>{2, 3});
+    auto datetime64 = std::make_shared<ColumnDateTime64>(6, "UTC");
+    datetime64->AppendMany(std::vector<Int64>{1, 2, 3});
+    auto decimal = std::make_shared<ColumnDecimal>(20, 4);
+    decimal->AppendMany(std::vector<Int128>{-1, 0, Int128(1) << 100});
+
+    const auto block = MakeBlock({{"n", nullable}, {"s", strings}, {"a", arrays}, {"t", datetime64}, {"d", decimal}});
+    ArrowSchema schema;
+    ArrowArray array;
+    ExportArrowSchema(block, &schema);
+    ExportArrowArray(block, &array);
+
+    const auto imported = ImportArrowArray(schema, array);
+    schema.release(&schema);
+    array.release(&array);
+
+    ASSERT_EQ(block.GetColumnCount(), imported.GetColumnCount());
+    ASSERT_EQ(3u, imported.GetRowCount());
+    for (size_t i = 0; i < block.GetColumnCount(); ++i) {
+        SCOPED_TRACE(block.GetColumnName(i));
+        EXPECT_EQ(block.GetColumnName(i), imported.GetColumnName(i));
+        EXPECT_EQ(block[i]->Type()->GetName(), imported[i]->Type()->GetName());
+        if (const auto expected = block[i]->AsPtr<ColumnArray>()) {
+            const auto & result = imported[i]->AsRef<ColumnArray>();
+            EXPECT_EQ(std::vector<uint64_t>(expected->GetOffsets().begin(), expected->GetOffsets().end()),
+                      std::vector<uint64_t>(result.GetOffsets().begin(), result.GetOffsets().end()));
+            for (size_t item = 0; item < 3; ++item) {
+                EXPECT_TRUE(SameItems(*expected->GetNestedColumn(), *result.GetNestedColumn(), item));
+            }
+            continue;
+        }
+        for (size_t row = 0; row < 3; ++row) {
+            EXPECT_TRUE(SameItems(*block[i], *imported[i], row));
+        }
+    }
+}
+
+TEST(ArrowTest, ImportSlice) {
+    auto column = std::make_shared<ColumnNullableT<ColumnString>>();
+    for (size_t i = 0; i < 20; ++i) {
+        if (i % 3) {
+            column->Append(std::to_string(i));
+        } else {
+            column->Append(std::nullopt);
+        }
+    }
+
+    const auto block = MakeBlock({{"x", column}});
+    ArrowSchema schema;
+    ArrowArray array;
+    ExportArrowSchema(block, &schema);
+    ExportArrowArray(block, &array);
+
+    // Slice of rows [5, 15), offset of bitmaps is not a multiple of 8.
+    array.offset = 5;
+    array.length = 10;
+    const auto imported = ImportArrowArray(schema, array);
+    schema.release(&schema);
+    array.release(&array);
+
+    ASSERT_EQ(10u, imported.GetRowCount());
+    const auto & result = imported[0]->AsRef<ColumnNullable>();
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_TRUE(SameItems(*column->Slice(5, 10), result, i));
+    }
+}
+
+TEST(ArrowTest, ImportDictionary) {
+    auto column = std::make_shared<ColumnLowCardinalityT<ColumnNullableT<ColumnString>>>();
+    for (const auto & value : {"b", "a", "", "b"}) {
+        column->Append(value);
+    }
+    column->Append(std::nullopt);
+
+    const auto block = MakeBlock({{"lc", column}});
+    ArrowSchema schema;
+    ArrowArray array;
+    ExportArrowSchema(block, &schema);
+    ExportArrowArray(block, &array);
+
+    const auto imported = ImportArrowArray(schema, array);
+    schema.release(&schema);
+    array.release(&array);
+
+    EXPECT_EQ("LowCardinality(Nullable(String))", imported[0]->Type()->GetName());
+    const auto & result = imported[0]->AsRef<ColumnLowCardinality>();
+    ASSERT_EQ(5u, result.Size());
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_TRUE(SameItems(*column, result, i));
+    }
+    // NULL, default, "b" and "a".
+    EXPECT_EQ(4u, result.GetDictionarySize());
+}
+
+TEST(ArrowTest, ImportUnsupportedFormat) {
+    const char* formats[] = {"+s", "e"};
+    ArrowSchema field{formats[1], "x", nullptr, 0, 0, nullptr, nullptr, nullptr, nullptr};
+    ArrowSchema* fields[] = {&field};
+    ArrowSchema schema{formats[0], "", nullptr, 0, 1, fields, nullptr, nullptr, nullptr};
+
+    const void* buffers[] = {nullptr, nullptr};
+    ArrowArray child{0, 0, 0, 2, 0, buffers, nullptr, nullptr, nullptr, nullptr};
+    ArrowArray* children[] = {&child};
+    ArrowArray array{0, 0, 0, 1, 1, buffers, children, nullptr, nullptr, nullptr};
+
+    EXPECT_THROW(ImportArrowArray(schema, array), UnimplementedError);
+}
+
+TEST(ArrowTest, ImportSecondsOutOfRange) {
+    const char* formats[] = {"+s", "tss:UTC"};
+    ArrowSchema field{formats[1], "t", nullptr, ARROW_FLAG_NULLABLE, 0, nullptr, nullptr, nullptr, nullptr};
+    ArrowSchema* fields[] = {&field};
+    ArrowSchema schema{formats[0], "", nullptr, 0, 1, fields, nullptr, nullptr, nullptr};
+
+    // Second row is NULL, its value is not checked.
+    int64_t seconds[] = {0, -1, 4294967295};
+    uint8_t validity[] = {0b101};
+    const void* child_buffers[] = {validity, seconds};
+    ArrowArray child{3, 1, 0, 2, 0, child_buffers, nullptr, nullptr, nullptr, nullptr};
+    ArrowArray* children[] = {&child};
+    const void* buffers[] = {nullptr};
+    ArrowArray array{3, 0, 0, 1, 1, buffers, children, nullptr, nullptr, nullptr};
+
+    const auto imported = ImportArrowArray(schema, array);
+    EXPECT_EQ("Nullable(DateTime('UTC'))", imported[0]->Type()->GetName());
+    const auto & result = imported[0]->AsRef<ColumnNullable>();
+    EXPECT_TRUE(result.IsNull(1));
+    EXPECT_EQ(4294967295u, result.Nested()->AsRef<ColumnDateTime>().RawAt(2));
+
+    validity[0] = 0b111;
+    child.null_count = 0;
+    EXPECT_THROW(ImportArrowArray(schema, array), ValidationError);
+
+    validity[0] = 0b101;
+    seconds[2] = 4294967296;
+    EXPECT_THROW(ImportArrowArray(schema, array), ValidationError);
+}
+
+TEST(ArrowTest, ImportMalformedParameters) {
+    for (const char* format : {"w:", "w:x", "w:-1", "w:99999999999999999999999", "d:10,", "d:10,,2", "d:10,2,"}) {
+        SCOPED_TRACE(format);
+        ArrowSchema field{format, "x", nullptr, 0, 0, nullptr, nullptr, nullptr, nullptr};
+        ArrowSchema* fields[] = {&field};
+        ArrowSchema schema{"+s", "", nullptr, 0, 1, fields, nullptr, nullptr, nullptr};
+
+        const void* buffers[] = {nullptr, nullptr};
+        ArrowArray child{0, 0, 0, 2, 0, buffers, nullptr, nullptr, nullptr, nullptr};
+        ArrowArray* children[] = {&child};
+        ArrowArray array{0, 0, 0, 1, 1, buffers, children, nullptr, nullptr, nullptr};
+
+        EXPECT_THROW(ImportArrowArray(schema, array), ValidationError);
+    }
+}
@@ -1,4 +1,5 @@
 #include <clickhouse/client.h>
+#include <clickhouse/columns/factory.h>
 #include "readonly_client_test.h"
 #include "connection_failed_client_test.h"
 #include "utils.h"
@@ -83,3 +84,154 @@ TEST(BlockTest, Iterators) {
     ASSERT_NE(block.cbegin(), block.cend());
 }
 
+
+TEST(BlockTest, TypedBlockBuilder) {
+    TypedBlockBuilder<ColumnUInt64, ColumnString, ColumnNullableT<ColumnFloat64>, ColumnDateTime64> builder(
+            {"id", "name", "score", "time"},
+            std::make_shared<ColumnUInt64>(),
+            std::make_shared<ColumnString>(),
+            std::make_shared<ColumnNullableT<ColumnFloat64>>(),
+            std::make_shared<ColumnDateTime64>(3));
+    builder.Reserve(10);
+
+    builder.AppendRow(1u, "one", std::optional<double>(0.5), 1000);
+    builder.AppendTuple(std::make_tuple(2u, std::string("two"), std::optional<double>(), 2000));
+    ASSERT_EQ(builder.Size(), 2u);
+
+    const auto block = builder.Build();
+    EXPECT_EQ(builder.Size(), 0u);
+    EXPECT_EQ(builder.GetColumn<0>()->Size(), 0u);
+    EXPECT_EQ(builder.GetColumn<3>()->GetPrecision(), 3u);
+
+    ASSERT_EQ(block.GetColumnCount(), 4u);
+    ASSERT_EQ(block.GetRowCount(), 2u);
+    EXPECT_EQ(block.GetColumnName(2), "score");
+    EXPECT_EQ(block[0]->As<ColumnUInt64>()->At(1), 2u);
+    EXPECT_EQ(block[1]->As<ColumnString>()->At(0), "one");
+    EXPECT_TRUE(block[2]->As<ColumnNullable>()->IsNull(1));
+    EXPECT_EQ(block[3]->GetType().GetName(), "DateTime64(3)");
+    EXPECT_EQ(block[3]->As<ColumnDateTime64>()->At(1), 2000);
+
+    // Columns of the built block are not touched by further rows.
+    builder.AppendRow(3u, "three", std::nullopt, 3000);
+    EXPECT_EQ(block[0]->Size(), 2u);
+    EXPECT_EQ(block.GetRowCount(), 2u);
+
+    const auto header = MakeBlock({
+        {"id", CreateColumnByType("UInt64")},
+        {"name", CreateColumnByType("String")},
+        {"score", CreateColumnByType("Nullable(Float64)")},
+        {"time", CreateColumnByType("DateTime64(3)")},
+    });
+    EXPECT_NO_THROW(builder.Validate(header));
+
+    EXPECT_THROW(builder.Validate(MakeBlock({{"id", CreateColumnByType("UInt64")}})), ValidationError);
+    EXPECT_THROW(builder.Validate(MakeBlock({
+        {"id", CreateColumnByType("UInt64")},
+        {"name", CreateColumnByType("String")},
+        {"score", CreateColumnByType("Nullable(Float64)")},
+        {"time", CreateColumnByType("DateTime64(6)")},
+    })), ValidationError);
+    EXPECT_THROW(builder.Validate(MakeBlock({
+        {"id", CreateColumnByType("UInt64")},
+        {"title", CreateColumnByType("String")},
+        {"score", CreateColumnByType("Nullable(Float64)")},
+        {"time", CreateColumnByType("DateTime64(3)")},
+    })), ValidationError);
+
+    using Builder = TypedBlockBuilder<ColumnUInt8>;
+    EXPECT_THROW(Builder({"x"}, std::make_shared<ColumnUInt8>(std::vector<uint8_t>{1})), ValidationError);
+}
+
+TEST(BlockTest, TypedBlockReader) {
+    auto sparse = std::make_shared<ColumnSparse>(std::make_shared<ColumnInt32>());
+    sparse->AppendDefaults(2);
+    sparse->AppendToValues()->As<ColumnInt32>()->Append(-3);
+
+    const auto block = MakeBlock({
+        {"id", std::make_shared<ColumnUInt64>(std::vector<uint64_t>{1, 2, 3})},
+        {"name", std::make_shared<ColumnString>(std::vector<std::string>{"a", "b", "c"})},
+        {"score", std::make_shared<ColumnNullableT<ColumnFloat64>>(
+                std::make_shared<ColumnFloat64>(std::vector<double>{0.5, 0, 1.5}),
+                std::make_shared<ColumnUInt8>(std::vector<uint8_t>{0, 1, 0}))},
+        {"delta", sparse},
+    });
+
+    const TypedBlockReader<ColumnUInt64, ColumnString, ColumnNullableT<ColumnFloat64>, ColumnInt32> reader(block);
+    ASSERT_EQ(reader.Size(), 3u);
+    EXPECT_EQ(reader.Get<1>(2), "c");
+    EXPECT_EQ(reader.Get<2>(1), std::nullopt);
+    EXPECT_EQ(reader.Get<3>(2), -3);
+
+    size_t row = 0;
+    for (const auto & [id, name, score, delta] : reader) {
+        EXPECT_EQ(id, row + 1);
+        EXPECT_EQ(name, std::string(1, static_cast<char>('a' + row)));
+        EXPECT_EQ(score.has_value(), row != 1);
+        EXPECT_EQ(delta, row == 2 ? -3 : 0);
+        ++row;
+    }
+    EXPECT_EQ(row, 3u);
+    EXPECT_EQ(std::get<2>(reader[2]), 1.5);
+
+    using WrongClass = TypedBlockReader<ColumnUInt64, ColumnString, ColumnNullableT<ColumnFloat64>, ColumnUInt32>;
+    EXPECT_THROW(WrongClass{block}, ValidationError);
+    using WrongCount = TypedBlockReader<ColumnUInt64, ColumnString>;
+    EXPECT_THROW(WrongCount{block}, ValidationError);
+}
+
+TEST(BlockTest, TypedBlockReaderOfGenericColumns) {
+    // Columns as created for a Select(), read by typed wrappers.
+    auto score = CreateColumnByType("Nullable(Float64)");
+    score->Append(std::make_shared<ColumnNullableT<ColumnFloat64>>(
+            std::make_shared<ColumnFloat64>(std::vector<double>{0.5, 0}),
+            std::make_shared<ColumnUInt8>(std::vector<uint8_t>{0, 1})));
+
+    auto ids = CreateColumnByType("Array(UInt64)");
+    auto typed_ids = std::make_shared<ColumnArrayT<ColumnUInt64>>();
+    typed_ids->Append(std::vector<uint64_t>{1, 2});
+    typed_ids->Append(std::vector<uint64_t>{});
+    ids->Append(typed_ids);
+
+    auto pair = CreateColumnByType("Tuple(UInt8, String)");
+    auto typed_pair = std::make_shared<ColumnTupleT<ColumnUInt8, ColumnString>>(
+            std::make_tuple(std::make_shared<ColumnUInt8>(), std::make_shared<ColumnString>()));
+    typed_pair->Append(std::make_tuple(uint8_t(1), std::string("a")));
+    typed_pair->Append(std::make_tuple(uint8_t(2), std::string("b")));
+    pair->Append(typed_pair);
+
+    auto attributes = CreateColumnByType("Map(String, UInt64)");
+    auto typed_attributes = std::make_shared<ColumnMapT<ColumnString, ColumnUInt64>>(
+            std::make_shared<ColumnString>(), std::make_shared<ColumnUInt64>());
+    typed_attributes->Append(std::map<std::string, uint64_t>{{"x", 7}});
+    typed_attributes->Append(std::map<std::string, uint64_t>{});
+    attributes->Append(typed_attributes);
+
+    const auto block = MakeBlock({{"score", score}, {"ids", ids}, {"pair", pair}, {"attributes", attributes}});
+
+    using Reader = TypedBlockReader<ColumnNullableT<ColumnFloat64>, ColumnArrayT<ColumnUInt64>,
+            ColumnTupleT<ColumnUInt8, ColumnString>, ColumnMapT<ColumnString, ColumnUInt64>>;
+    const Reader reader(block);
+    ASSERT_EQ(reader.Size(), 2u);
+    EXPECT_EQ(reader.Get<0>(0), 0.5);
+    EXPECT_EQ(reader.Get<0>(1), std::nullopt);
+    EXPECT_EQ(reader.Get<1>(0).size(), 2u);
+    EXPECT_EQ(reader.Get<1>(0)[1], 2u);
+    EXPECT_EQ(reader.Get<1>(1).size(), 0u);
+    EXPECT_EQ(std::get<1>(reader.Get<2>(1)), "b");
+    EXPECT_EQ(reader.Get<3>(0).At("x"), 7u);
+    EXPECT_EQ(reader.Get<3>(1).size(), 0u);
+
+    // Columns of the block are not taken over by the wrappers.
+    ASSERT_EQ(block[2]->Size(), 2u);
+    EXPECT_EQ(block[2]->As<ColumnTuple>()->At(1)->As<ColumnString>()->At(0), "a");
+    ASSERT_EQ(block[3]->Size(), 2u);
+    EXPECT_EQ(Reader(block).Get<3>(0).At("x"), 7u);
+
+    using WrongNested = TypedBlockReader<ColumnNullableT<ColumnFloat32>, ColumnArrayT<ColumnUInt64>,
+            ColumnTupleT<ColumnUInt8, ColumnString>, ColumnMapT<ColumnString, ColumnUInt64>>;
+    EXPECT_THROW(WrongNested{block}, ValidationError);
+    using WrongTupleSize = TypedBlockReader<ColumnNullableT<ColumnFloat64>, ColumnArrayT<ColumnUInt64>,
+            ColumnTupleT<ColumnUInt8>, ColumnMapT<ColumnString, ColumnUInt64>>;
+    EXPECT_THROW(WrongTupleSize{block}, ValidationError);
+}
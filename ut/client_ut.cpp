@@ -1,5 +1,7 @@
 #include <clickhouse/client.h>
+#include <clickhouse/native.h>
 
+#include "clickhouse/base/compressed.h"
 #include "clickhouse/base/socket.h"
 #include "clickhouse/version.h"
 #include "clickhouse/error_codes.h"
@@ -1204,6 +1206,203 @@ TEST_P(ClientCase, SelectAggregateFunction) {
     }), clickhouse::UnimplementedError);
 }
 
+TEST_P(ClientCase, UniqCombinedStates) {
+    // States built on the client match states of the server, in each of small array, hash set and HyperLogLog counter.
+    const auto reserialize = [](const TypeRef & type, const auto & state) {
+        ColumnAggregateFunction col(type);
+        col.Append(state);
+        return std::string(col.GetSerializedState(0));
+    };
+
+    for (const uint64_t rows : {10, 1000, 100000}) {
+        SCOPED_TRACE(rows);
+        UniqCombinedState<> numbers;
+        UniqCombinedState<uint64_t> strings;
+        for (uint64_t i = 0; i < rows; ++i) {
+            numbers.Add(i);
+            strings.Add(std::string_view(std::to_string(i)));
+        }
+
+        size_t total_rows = 0;
+        client_->Select("SELECT uniqCombinedState(number), uniqCombinedState(toString(number)) FROM numbers(" + std::to_string(rows) + ")",
+        [&](const Block& block) {
+            for (size_t row = 0; row < block.GetRowCount(); ++row) {
+                ++total_rows;
+                const auto server_numbers = block[0]->As<ColumnAggregateFunction>();
+                const auto server_strings = block[1]->As<ColumnAggregateFunction>();
+                ASSERT_NE(server_numbers, nullptr);
+                ASSERT_NE(server_strings, nullptr);
+
+                EXPECT_EQ(reserialize(block[0]->Type(), server_numbers->At<UniqCombinedState<>>(row)), reserialize(block[0]->Type(), numbers));
+                EXPECT_EQ(reserialize(block[1]->Type(), server_strings->At<UniqCombinedState<uint64_t>>(row)), reserialize(block[1]->Type(), strings));
+            }
+        });
+        EXPECT_EQ(total_rows, 1u);
+
+        // Server counts values of the states built on the client.
+        client_->Execute("DROP TEMPORARY TABLE IF EXISTS test_clickhouse_cpp_uniq_combined");
+        client_->Execute("CREATE TEMPORARY TABLE test_clickhouse_cpp_uniq_combined "
+                "(n AggregateFunction(uniqCombined, UInt64), s AggregateFunction(uniqCombined, String))");
+
+        auto n = std::make_shared<ColumnAggregateFunction>(Type::CreateAggregateFunction("uniqCombined", {Type::CreateSimple<uint64_t>()}));
+        auto s = std::make_shared<ColumnAggregateFunction>(Type::CreateAggregateFunction("uniqCombined", {Type::CreateString()}));
+        n->Append(numbers);
+        s->Append(strings);
+        Block block;
+        block.AppendColumn("n", n);
+        block.AppendColumn("s", s);
+        client_->Insert("test_clickhouse_cpp_uniq_combined", block);
+
+        client_->Select("SELECT finalizeAggregation(n) = (SELECT uniqCombined(number) FROM numbers(" + std::to_string(rows) + ")), "
+                "finalizeAggregation(s) = (SELECT uniqCombined(toString(number)) FROM numbers(" + std::to_string(rows) + ")) "
+                "FROM test_clickhouse_cpp_uniq_combined",
+        [&](const Block& block) {
+            for (size_t row = 0; row < block.GetRowCount(); ++row) {
+                EXPECT_EQ(block[0]->As<ColumnUInt8>()->At(row), 1u);
+                EXPECT_EQ(block[1]->As<ColumnUInt8>()->At(row), 1u);
+            }
+        });
+    }
+}
+
+TEST_P(ClientCase, SelectArrowStream) {
+    ArrowArrayStream stream;
+    client_->SelectArrowStream("SELECT number, toString(number) AS s FROM system.numbers LIMIT 100000", &stream);
+
+    ArrowSchema schema;
+    ASSERT_EQ(0, stream.get_schema(&stream, &schema));
+    ASSERT_EQ(2, schema.n_children);
+    EXPECT_STREQ("L", schema.children[0]->format);
+    EXPECT_STREQ("s", schema.children[1]->name);
+    schema.release(&schema);
+
+    uint64_t rows = 0;
+    while (true) {
+        ArrowArray array;
+        ASSERT_EQ(0, stream.get_next(&stream, &array));
+        if (!array.release) {
+            break;
+        }
+        const auto numbers = static_cast<const uint64_t*>(array.children[0]->buffers[1]);
+        for (int64_t i = 0; i < array.length; ++i) {
+            ASSERT_EQ(rows + i, numbers[i]);
+        }
+        rows += array.length;
+        array.release(&array);
+    }
+    EXPECT_EQ(100000u, rows);
+    stream.release(&stream);
+
+    // A stream released before the end cancels the query, the client remains usable.
+    client_->SelectArrowStream("SELECT number FROM system.numbers LIMIT 10000000", &stream);
+    ArrowArray array;
+    ASSERT_EQ(0, stream.get_next(&stream, &array));
+    array.release(&array);
+    stream.release(&stream);
+
+    size_t count = 0;
+    client_->Select("SELECT 1", [&count](const Block& block) { count += block.GetRowCount(); });
+    EXPECT_EQ(1u, count);
+}
+
+TEST_P(ClientCase, InsertArrowStream) {
+    client_->Execute("CREATE TEMPORARY TABLE IF NOT EXISTS test_clickhouse_cpp_arrow (n UInt64, s LowCardinality(String))");
+
+    // Result of a query of another client is streamed into the table.
+    Client source(GetParam());
+    ArrowArrayStream stream;
+    source.SelectArrowStream("SELECT number AS n, toLowCardinality(toString(number % 7)) AS s FROM system.numbers LIMIT 100000", &stream);
+    client_->InsertArrowStream("test_clickhouse_cpp_arrow", &stream);
+    EXPECT_EQ(nullptr, stream.release);
+
+    client_->Select("SELECT count(), sum(n), uniqExact(s) FROM test_clickhouse_cpp_arrow", [](const Block& block) {
+        if (block.GetRowCount() == 0) {
+            return;
+        }
+        EXPECT_EQ(100000u, block[0]->AsRef<ColumnUInt64>().At(0));
+        EXPECT_EQ(4999950000u, block[1]->AsRef<ColumnUInt64>().At(0));
+        EXPECT_EQ(7u, block[2]->AsRef<ColumnUInt64>().At(0));
+    });
+}
+
+
+TEST_P(ClientCase, InsertNative) {
+    client_->Execute("CREATE TEMPORARY TABLE IF NOT EXISTS test_clickhouse_cpp_native (n UInt64, s String)");
+
+    const auto revision = client_->GetServerInfo().revision;
+    const auto serialize = [revision](const Block& block, CompressionMethod compression_method) {
+        Buffer buffer;
+        BufferOutput output(&buffer);
+        if (compression_method != CompressionMethod::None) {
+            std::unique_ptr<OutputStream> compressed = std::make_unique<CompressedOutput>(&output, 65535, compression_method);
+            BufferedOutput buffered(std::move(compressed), 65535);
+            WriteNativeBlock(buffered, block, revision);
+        } else {
+            WriteNativeBlock(output, block, revision);
+        }
+        output.Flush();
+        return buffer;
+    };
+
+    std::vector<Buffer> raw_blocks;
+    std::vector<Buffer> compressed_blocks;
+    for (size_t i = 0; i < 4; ++i) {
+        auto n = std::make_shared<ColumnUInt64>();
+        auto s = std::make_shared<ColumnString>();
+        for (size_t j = 0; j < 1000; ++j) {
+            n->Append(i * 1000 + j);
+            s->Append(std::to_string(j % 10));
+        }
+        Block block;
+        block.AppendColumn("n", n);
+        block.AppendColumn("s", s);
+
+        raw_blocks.push_back(serialize(block, CompressionMethod::None));
+        if (GetParam().compression_method != CompressionMethod::None) {
+            compressed_blocks.push_back(serialize(block, GetParam().compression_method));
+        }
+    }
+
+    const auto insert = [this](const std::vector<Buffer>& blocks, bool compressed) {
+        size_t next = 0;
+        client_->InsertNative("test_clickhouse_cpp_native", [&](std::string_view& data) {
+            if (next == blocks.size()) {
+                return false;
+            }
+            data = std::string_view(reinterpret_cast<const char*>(blocks[next].data()), blocks[next].size());
+            ++next;
+            return true;
+        }, compressed);
+    };
+    insert(raw_blocks, false);
+    if (!compressed_blocks.empty()) {
+        insert(compressed_blocks, true);
+    }
+
+    client_->Select("SELECT count(), sum(n), uniqExact(s) FROM test_clickhouse_cpp_native", [&](const Block& block) {
+        if (block.GetRowCount() == 0) {
+            return;
+        }
+        const uint64_t copies = compressed_blocks.empty() ? 1 : 2;
+        EXPECT_EQ(copies * 4000u, block[0]->AsRef<ColumnUInt64>().At(0));
+        EXPECT_EQ(copies * 7998000u, block[1]->AsRef<ColumnUInt64>().At(0));
+        EXPECT_EQ(10u, block[2]->AsRef<ColumnUInt64>().At(0));
+    });
+
+    // Block of other structure is rejected before it is sent, and the connection stays usable.
+    Block block;
+    block.AppendColumn("n", std::make_shared<ColumnUInt64>(std::vector<uint64_t>{1}));
+    EXPECT_THROW(insert({serialize(block, CompressionMethod::None)}, false), ValidationError);
+
+    size_t count = 0;
+    client_->Select("SELECT count() FROM test_clickhouse_cpp_native", [&count](const Block& block) {
+        if (block.GetRowCount()) {
+            count = block[0]->AsRef<ColumnUInt64>().At(0);
+        }
+    });
+    EXPECT_EQ(compressed_blocks.empty() ? 4000u : 8000u, count);
+}
+
 
 const auto LocalHostEndpoint = ClientOptions()
         .SetHost(           getEnvOrDefault("CLICKHOUSE_HOST",     "localhost"))
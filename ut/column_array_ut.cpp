@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include "utils.h"
 
+#include <list>
 #include <string_view>
 #include <sstream>
 #include <vector>
@@ -69,6 +70,70 @@ TEST(ColumnArray, Append) {
     ASSERT_EQ(col->As<ColumnUInt64>()->At(1), 3u);
 }
 
+TEST(ColumnArray, Append_Bulk) {
+    const std::vector<std::vector<std::string>> values1 = {{"a", "bc"}, {}, {"def"}};
+    const std::vector<std::vector<std::string>> values2 = {{}, {"g", "hi", "jkl"}, {"m"}};
+
+    auto arr1 = CreateArray<ColumnString>(values1);
+    auto arr2 = CreateArray<ColumnString>(values2);
+
+    arr1->Append(arr2);
+    // Append a slice, which shares nothing with the source's first rows.
+    arr1->Append(arr2->Slice(1, 2));
+
+    auto expected = values1;
+    expected.insert(expected.end(), values2.begin(), values2.end());
+    expected.insert(expected.end(), values2.begin() + 1, values2.end());
+
+    ASSERT_EQ(arr1->Size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        SCOPED_TRACE(i);
+        EXPECT_TRUE(CompareRecursive(expected[i], *arr1->GetAsColumnTyped<ColumnString>(i)));
+    }
+
+    // Appending to self doubles the column.
+    arr1->Append(arr1);
+    ASSERT_EQ(arr1->Size(), expected.size() * 2);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        SCOPED_TRACE(i);
+        EXPECT_TRUE(CompareRecursive(expected[i], *arr1->GetAsColumnTyped<ColumnString>(expected.size() + i)));
+    }
+}
+
+TEST(ColumnArray, Append_Bulk_2D) {
+    const std::vector<std::vector<std::vector<uint64_t>>> values = {
+        {{1, 2}, {}},
+        {},
+        {{3}, {4, 5, 6}},
+    };
+
+    auto arr1 = Create2DArray<ColumnUInt64>(values);
+    auto arr2 = Create2DArray<ColumnUInt64>(values);
+    arr1->Append(arr2);
+
+    ASSERT_EQ(arr1->Size(), values.size() * 2);
+    for (size_t i = 0; i < arr1->Size(); ++i) {
+        SCOPED_TRACE(i);
+        const auto & expected_row = values[i % values.size()];
+        const auto row = arr1->GetAsColumnTyped<ColumnArray>(i);
+        ASSERT_EQ(row->Size(), expected_row.size());
+        for (size_t j = 0; j < expected_row.size(); ++j) {
+            EXPECT_TRUE(CompareRecursive(expected_row[j], *row->GetAsColumnTyped<ColumnUInt64>(j)));
+        }
+    }
+}
+
+TEST(ColumnArray, Append_Bulk_WrongNestedType) {
+    auto arr1 = std::make_shared<ColumnArray>(std::make_shared<ColumnFixedString>(1));
+    arr1->AppendAsColumn(std::make_shared<ColumnFixedString>(1, std::vector<std::string>{"a"}));
+
+    auto arr2 = std::make_shared<ColumnArray>(std::make_shared<ColumnFixedString>(3));
+    arr2->AppendAsColumn(std::make_shared<ColumnFixedString>(3, std::vector<std::string>{"abc"}));
+
+    EXPECT_THROW(arr1->Append(arr2), ValidationError);
+    EXPECT_EQ(arr1->Size(), 1u);
+}
+
 TEST(ColumnArray, ArrayOfDecimal) {
     auto column = std::make_shared<clickhouse::ColumnDecimal>(18, 10);
     auto array = std::make_shared<clickhouse::ColumnArray>(column->CloneEmpty());
@@ -227,6 +292,29 @@ TEST(ColumnArrayT, SimpleFixedString) {
     EXPECT_EQ("world\0"sv, (*array)[0][1]);
 }
 
+TEST(ColumnArrayT, AppendMany) {
+    // Rows of std::vector are appended with AppendMany() of the nested column, rows of std::list item by item.
+    static_assert(clickhouse::details::HasAppendManyOf<ColumnUInt64, std::vector<uint64_t>>);
+    static_assert(!clickhouse::details::HasAppendManyOf<ColumnUInt64, std::list<uint64_t>>);
+
+    const std::vector<std::vector<uint64_t>> rows{{0}, {}, {1, 2}, {3, 4, 5}};
+    const std::vector<std::list<uint64_t>> lists{{6, 7}, {}};
+
+    ColumnArrayT<ColumnUInt64> array;
+    array.AppendMany(Span<const std::vector<uint64_t>>(rows));
+    array.AppendMany(Span<const std::list<uint64_t>>(lists));
+
+    ASSERT_EQ(rows.size() + lists.size(), array.Size());
+    EXPECT_EQ(8u, array.GetNestedColumn().Size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const auto row = array.At(i);
+        ASSERT_EQ(rows[i].size(), row.Size());
+        EXPECT_TRUE(std::equal(rows[i].begin(), rows[i].end(), row.begin()));
+    }
+    EXPECT_EQ(7u, array.At(rows.size())[1]);
+    EXPECT_EQ(0u, array.At(rows.size() + 1).Size());
+}
+
 TEST(ColumnArrayT, SimpleUInt64_2D) {
     // Nested 2D-arrays are supported too:
     auto array = std::make_shared<ColumnArrayT<ColumnArrayT<ColumnUInt64>>>();
@@ -1,28 +1,41 @@
+#include <clickhouse/columns/aggregate_function.h>
 #include <clickhouse/columns/array.h>
 #include <clickhouse/columns/tuple.h>
 #include <clickhouse/columns/date.h>
+#include <clickhouse/columns/decimal.h>
+#include <clickhouse/columns/dynamic.h>
 #include <clickhouse/columns/enum.h>
 #include <clickhouse/columns/factory.h>
+#include <clickhouse/columns/geo.h>
+#include <clickhouse/columns/ix-json.h>
+#include <clickhouse/columns/json.h>
 #include <clickhouse/columns/lowcardinality.h>
 #include <clickhouse/columns/nullable.h>
 #include <clickhouse/columns/numeric.h>
 #include <clickhouse/columns/map.h>
+#include <clickhouse/columns/sparse.h>
 #include <clickhouse/columns/string.h>
 #include <clickhouse/columns/uuid.h>
+#include <clickhouse/columns/variant.h>
+#include <clickhouse/columns/visit.h>
 #include <clickhouse/columns/ip4.h>
 #include <clickhouse/columns/ip6.h>
 #include <clickhouse/base/input.h>
 #include <clickhouse/base/output.h>
+#include <clickhouse/base/buffer.h>
 #include <clickhouse/base/socket.h> // for ipv4-ipv6 platform-specific stuff
 
 #include <gtest/gtest.h>
 #include "utils.h"
 #include "value_generators.h"
 
+#include <limits>
+#include <numeric>
 #include <string_view>
 #include <sstream>
 #include <vector>
 #include <random>
+#include <thread>
 
 namespace {
 
@@ -59,6 +72,44 @@ TEST(ColumnsCase, NumericSlice) {
 }
 
 
+TEST(ColumnsCase, NumericAppendMany) {
+    const auto values = MakeNumbers();
+    auto col = std::make_shared<ColumnUInt32>();
+
+    col->AppendMany(values);
+    col->AppendMany(values.begin(), values.begin() + 3);
+
+    ASSERT_EQ(col->Size(), values.size() + 3);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(col->At(i), values[i]);
+    }
+    EXPECT_EQ(col->At(values.size() + 2), values[2]);
+
+    // Appending column's own data doubles it.
+    const auto size = col->Size();
+    col->AppendMany(col->GetData());
+    ASSERT_EQ(col->Size(), size * 2);
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(col->At(i), col->At(size + i));
+    }
+}
+
+TEST(ColumnsCase, NumericGetDataAndCopyTo) {
+    const auto values = MakeNumbers();
+    auto col = std::make_shared<ColumnUInt32>(values);
+
+    const auto data = col->GetData();
+    ASSERT_EQ(data.size(), values.size());
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), values.begin()));
+
+    std::vector<uint32_t> dest(3);
+    col->CopyTo(dest, 2);
+    EXPECT_EQ(dest, std::vector<uint32_t>(values.begin() + 2, values.begin() + 5));
+
+    EXPECT_THROW(col->CopyTo(dest, values.size() - 2), ValidationError);
+}
+
+
 TEST(ColumnsCase, FixedStringInit) {
     const auto column_data = MakeFixedStrings(3);
     auto col = std::make_shared<ColumnFixedString>(3, column_data);
@@ -137,6 +188,65 @@ TEST(ColumnsCase, StringAppend) {
     ASSERT_EQ(col->At(2), "11");
 }
 
+TEST(ColumnsCase, StringAppendMany) {
+    const auto values = MakeStrings();
+    const std::vector<std::string_view> views(values.begin(), values.end());
+
+    auto col = std::make_shared<ColumnString>();
+    col->Append("first");
+    col->AppendMany(views);
+    col->AppendMany(values.begin(), values.end());
+
+    ASSERT_EQ(col->Size(), 1 + values.size() * 2);
+    const auto data = col->GetData();
+    ASSERT_EQ(data.size(), col->Size());
+    EXPECT_EQ(data[0], "first");
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(data[1 + i], values[i]);
+        EXPECT_EQ(col->At(1 + values.size() + i), values[i]);
+    }
+
+    std::vector<std::string_view> dest(values.size());
+    col->CopyTo(dest, 1);
+    EXPECT_EQ(dest, views);
+
+    // Appending column's own data doubles it.
+    const auto size = col->Size();
+    col->AppendMany(col->GetData());
+    ASSERT_EQ(col->Size(), size * 2);
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(col->At(i), col->At(size + i));
+    }
+}
+
+TEST(ColumnsCase, FixedStringAppendMany) {
+    const auto values = MakeFixedStrings(3);
+    const std::vector<std::string_view> views(values.begin(), values.end());
+
+    auto col = std::make_shared<ColumnFixedString>(5);
+    col->AppendMany(views);
+
+    ASSERT_EQ(col->Size(), values.size());
+    std::vector<std::string_view> dest(values.size());
+    col->CopyTo(dest);
+    for (size_t i = 0; i < values.size(); ++i) {
+        std::string expected = values[i];
+        expected.resize(5, char(0));
+        EXPECT_EQ(dest[i], expected);
+    }
+
+    const std::vector<std::string_view> too_long{"123456"};
+    EXPECT_THROW(col->AppendMany(too_long), ValidationError);
+    EXPECT_EQ(col->Size(), values.size());
+
+    // Views on column's own items, which are moved when the column grows.
+    col->AppendMany(dest);
+    ASSERT_EQ(col->Size(), values.size() * 2);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(col->At(i), col->At(values.size() + i));
+    }
+}
+
 TEST(ColumnsCase, TupleAppend){
     auto tuple1 = std::make_shared<ColumnTuple>(std::vector<ColumnRef>({
                                 std::make_shared<ColumnUInt64>(),
@@ -154,6 +264,38 @@ TEST(ColumnsCase, TupleAppend){
     ASSERT_EQ((*tuple2)[1]->As<ColumnString>()->At(0), "2");
 }
 
+TEST(ColumnsCase, TupleClear) {
+    using Tuple = ColumnTupleT<ColumnUInt64, ColumnString>;
+    Tuple col(std::make_tuple(std::make_shared<ColumnUInt64>(), std::make_shared<ColumnString>()));
+    col.Append(std::make_tuple(1u, std::string("a")));
+
+    col.Clear();
+    ASSERT_EQ(col.Size(), 0u);
+    ASSERT_EQ(col.TupleSize(), 2u);
+    EXPECT_EQ(col.Type()->GetName(), "Tuple(UInt64, String)");
+
+    // Typed columns are still those of the tuple.
+    col.Append(std::make_tuple(2u, std::string("b")));
+    ASSERT_EQ(col.Size(), 1u);
+    EXPECT_EQ(col.At(0), Tuple::ValueType(2u, "b"));
+    EXPECT_EQ(col.ColumnTuple::At(1)->Size(), 1u);
+}
+
+TEST(ColumnsCase, TupleAppendMany) {
+    using Tuple = ColumnTupleT<ColumnUInt64, ColumnString>;
+    const std::vector<Tuple::ValueType> values{{1u, "a"}, {2u, ""}, {3u, "ccc"}};
+
+    Tuple col(std::make_tuple(std::make_shared<ColumnUInt64>(), std::make_shared<ColumnString>()));
+    col.Append(std::make_tuple(0u, std::string("first")));
+    col.AppendMany(values);
+
+    ASSERT_EQ(col.Size(), values.size() + 1);
+    EXPECT_EQ(col.At(0), Tuple::ValueType(0u, "first"));
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(col.At(1 + i), values[i]);
+    }
+}
+
 TEST(ColumnsCase, TupleSlice){
     auto tuple1 = std::make_shared<ColumnTuple>(std::vector<ColumnRef>({
                                 std::make_shared<ColumnUInt64>(),
@@ -184,6 +326,30 @@ TEST(ColumnsCase, DateAppend) {
 }
 
 
+TEST(ColumnsCase, DateAppendMany) {
+    const std::vector<std::time_t> values{0, 86400, 86400 * 365 + 3600, std::time(nullptr)};
+
+    ColumnDate col;
+    col.AppendMany(values);
+    col.AppendRawMany(std::vector<uint16_t>{1, 2});
+
+    ASSERT_EQ(col.Size(), values.size() + 2);
+    std::vector<std::time_t> dest(values.size());
+    col.CopyTo(dest);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(dest[i], col.At(i));
+        EXPECT_EQ(dest[i], (values[i] / 86400) * 86400);
+    }
+    EXPECT_EQ(col.GetData()[values.size() + 1], 2u);
+
+    ColumnDateTime dt;
+    dt.AppendMany(values);
+    ASSERT_EQ(dt.Size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(dt.At(i), values[i]);
+    }
+}
+
 TEST(ColumnsCase, Date_UInt16_interface) {
     auto col1 = std::make_shared<ColumnDate>();
 
@@ -420,6 +586,24 @@ TEST(ColumnsCase, EnumTest) {
     ASSERT_TRUE(CreateColumnByType("Enum8('Hi' = 1, 'Hello' = 2)")->Type()->IsEqual(Type::CreateEnum8(enum_items)));
 }
 
+TEST(ColumnsCase, EnumAppendMany) {
+    std::vector<Type::EnumItem> enum_items = {{"Hi", 1}, {"Hello", 2}};
+    const std::vector<int8_t> values{1, 2, 2, 1};
+
+    ColumnEnum8 col(Type::CreateEnum8(enum_items));
+    col.AppendMany(values);
+    ASSERT_EQ(col.Size(), values.size());
+    EXPECT_EQ(col.NameAt(1), "Hello");
+
+    // Appending column's own data doubles it.
+    col.AppendMany(col.GetData());
+    ASSERT_EQ(col.Size(), values.size() * 2);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(col.At(i), values[i]);
+        EXPECT_EQ(col.At(values.size() + i), values[i]);
+    }
+}
+
 TEST(ColumnsCase, NullableSlice) {
     auto data = std::make_shared<ColumnUInt32>(MakeNumbers());
     auto nulls = std::make_shared<ColumnUInt8>(MakeBools());
@@ -435,6 +619,85 @@ TEST(ColumnsCase, NullableSlice) {
     ASSERT_EQ(subData->At(3), 17u);
 }
 
+TEST(ColumnsCase, NullableNullCountAndBitmap) {
+    // Size that is not a multiple of 8 nor 64, to check tails.
+    const size_t size = 203;
+    ColumnNullableT<ColumnUInt32> col;
+    for (size_t i = 0; i < size; ++i) {
+        col.Append(i % 3 == 0 || i == 150 ? std::nullopt : std::optional<uint32_t>(static_cast<uint32_t>(i)));
+    }
+
+    size_t expected_null_count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        expected_null_count += col.IsNull(i);
+    }
+    EXPECT_EQ(col.NullCount(), expected_null_count);
+    EXPECT_TRUE(col.HasNull());
+
+    std::vector<uint64_t> bitmap(4, ~0ull);
+    col.CopyNullBitmap(bitmap, 0, size);
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(((bitmap[i / 64] >> (i % 64)) & 1) != 0, col.IsNull(i)) << " at pos: " << i;
+    }
+    EXPECT_EQ(bitmap[3] >> (size % 64), 0u);
+
+    // Unaligned range.
+    std::vector<uint64_t> sub_bitmap(2);
+    col.CopyNullBitmap(sub_bitmap, 5, 100);
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(((sub_bitmap[i / 64] >> (i % 64)) & 1) != 0, col.IsNull(i + 5)) << " at pos: " << i;
+    }
+    EXPECT_THROW(col.CopyNullBitmap(sub_bitmap, 150, 100), ValidationError);
+    EXPECT_THROW(col.CopyNullBitmap(sub_bitmap, 0, 129), ValidationError);
+
+    ColumnNullable restored(std::make_shared<ColumnUInt32>(), std::make_shared<ColumnUInt8>());
+    restored.AppendNullBitmap(bitmap, size);
+    ASSERT_EQ(restored.Size(), size);
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(restored.IsNull(i), col.IsNull(i)) << " at pos: " << i;
+    }
+
+    size_t not_null_count = 0;
+    col.ForEachNotNull([&](size_t i, uint32_t value) {
+        EXPECT_FALSE(col.IsNull(i));
+        EXPECT_EQ(value, i);
+        ++not_null_count;
+    });
+    EXPECT_EQ(not_null_count, size - expected_null_count);
+}
+
+TEST(ColumnsCase, NullableHasNull) {
+    ColumnNullableT<ColumnUInt32> col;
+    EXPECT_FALSE(col.HasNull());
+    EXPECT_EQ(col.NullCount(), 0u);
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        col.Append(i);
+    }
+    EXPECT_FALSE(col.HasNull());
+
+    col.Append(std::nullopt);
+    EXPECT_TRUE(col.HasNull());
+    EXPECT_EQ(col.NullCount(), 1u);
+}
+
+TEST(ColumnsCase, NullableAppendMany) {
+    using NullableString = ColumnNullableT<ColumnString>;
+    const std::vector<NullableString::ValueType> values{"a", std::nullopt, "", std::nullopt, "eee"};
+
+    NullableString col;
+    col.Append("first");
+    col.AppendMany(values);
+
+    ASSERT_EQ(col.Size(), values.size() + 1);
+    EXPECT_EQ(col.Nested()->Size(), col.Size());
+    EXPECT_EQ(col.NullCount(), 2u);
+    EXPECT_EQ(col.At(0), "first");
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(col.At(1 + i), values[i]);
+    }
+}
+
 // internal representation of UUID data in ColumnUUID
 std::vector<uint64_t> MakeUUID_data() {
     return {
@@ -452,6 +715,17 @@ TEST(ColumnsCase, UUIDInit) {
     ASSERT_EQ(col->At(2), UUID(0x3507213c178649f9llu, 0x9faf035d662f60aellu));
 }
 
+TEST(ColumnsCase, UUIDAppendMany) {
+    const auto values = MakeUUIDs();
+    auto col = std::make_shared<ColumnUUID>();
+    col->AppendMany(values);
+
+    ASSERT_EQ(col->Size(), values.size());
+    std::vector<UUID> dest(values.size());
+    col->CopyTo(dest);
+    EXPECT_EQ(dest, values);
+}
+
 TEST(ColumnsCase, UUIDSlice) {
     auto col = std::make_shared<ColumnUUID>(std::make_shared<ColumnUInt64>(MakeUUID_data()));
     auto sub = col->Slice(1, 2)->As<ColumnUUID>();
@@ -705,6 +979,23 @@ TEST(ColumnsCase, ColumnDecimal128_from_string) {
     }
 }
 
+TEST(ColumnsCase, ColumnDecimal_AppendMany) {
+    const std::vector<Int128> values{0, 1, -1, 123456789, -987654321};
+
+    for (auto precision : {9u, 18u, 38u}) {
+        SCOPED_TRACE(precision);
+        ColumnDecimal col(precision, 2);
+        col.AppendMany(values);
+        col.AppendMany(std::vector<Int64>{42});
+
+        ASSERT_EQ(col.Size(), values.size() + 1);
+        std::vector<Int128> dest(values.size());
+        col.CopyTo(dest);
+        EXPECT_EQ(dest, values);
+        EXPECT_EQ(col.At(values.size()), 42);
+    }
+}
+
 TEST(ColumnsCase, ColumnDecimal128_from_string_overflow) {
     auto col = std::make_shared<ColumnDecimal>(38, 0);
 
@@ -719,6 +1010,175 @@ TEST(ColumnsCase, ColumnDecimal128_from_string_overflow) {
 #endif
 }
 
+TEST(ColumnsCase, ColumnDecimal_from_string) {
+    const std::vector<std::pair<std::string, Int128>> values{
+        {"0", 0},
+        {"-0", 0},
+        {"", 0},
+        {"1", 10000},
+        {"-1.5", -15000},
+        {"12345678901234.1234", Int128(123456789012341234ll)},
+        {"1.23456789", 12345},
+        {"-.25", -2500},
+        {"100.", 1000000},
+        {"1.2345-6", 12345},
+        {"00000000000000000000000042", 420000},
+    };
+
+    ColumnDecimal col(38, 4);
+    for (const auto & [str, expected] : values) {
+        col.Append(str);
+        EXPECT_EQ(col.At(col.Size() - 1), expected) << " for: \"" << str << "\"";
+    }
+
+    EXPECT_THROW(col.Append("1-"), ValidationError);
+    EXPECT_THROW(col.Append("1.2-3"), ValidationError);
+    EXPECT_THROW(col.Append("--1"), ValidationError);
+    EXPECT_THROW(col.Append("1.2.3"), ValidationError);
+    EXPECT_THROW(col.Append("123456789x"), ValidationError);
+    EXPECT_THROW(col.Append("1e5"), ValidationError);
+    EXPECT_EQ(col.Size(), values.size());
+}
+
+TEST(ColumnsCase, ColumnDecimalT) {
+    ColumnDecimal64 col(18, 2);
+    col.Append(int64_t(12345));
+    col.Append("-0.5");
+    col.AppendMany(std::vector<int64_t>{1, 2, 3});
+    // values of other width go through generic conversion
+    col.AppendMany(std::vector<Int128>{4});
+
+    EXPECT_EQ(col.Type()->GetName(), "Decimal(18,2)");
+    ASSERT_EQ(col.Size(), 6u);
+    EXPECT_EQ(col.At(0), 12345);
+    EXPECT_EQ(col[1], -50);
+    EXPECT_EQ(std::vector<int64_t>(col.GetData().begin(), col.GetData().end()),
+            (std::vector<int64_t>{12345, -50, 1, 2, 3, 4}));
+    EXPECT_EQ(col.ColumnDecimal::At(0), Int128(12345));
+
+    auto slice = col.Slice(1, 2)->AsStrict<ColumnDecimal64>();
+    EXPECT_EQ(slice->At(0), -50);
+    EXPECT_EQ(slice->At(1), 1);
+
+    ColumnRef generic = std::make_shared<ColumnDecimal>(18, 2);
+    generic->Append(col.Slice(0, 6));
+    auto wrapped = ColumnDecimal64::Wrap(std::move(generic));
+    EXPECT_EQ(wrapped->Size(), 6u);
+    EXPECT_EQ(wrapped->At(5), 4);
+
+    EXPECT_THROW(ColumnDecimal32::Wrap(std::make_shared<ColumnDecimal>(18, 2)), ValidationError);
+    EXPECT_THROW(ColumnDecimal32(10, 2), ValidationError);
+    EXPECT_THROW(ColumnDecimal128(18, 2), ValidationError);
+    EXPECT_NO_THROW(ColumnDecimal32(9, 2));
+    EXPECT_NO_THROW(ColumnDecimal128(38, 2));
+}
+
+TEST(ColumnsCase, ColumnDecimalT_AppendWider) {
+    ColumnDecimal32 col(9, 2);
+    col.Append(Int128(-12345));
+    col.Append(int64_t(std::numeric_limits<int32_t>::max()));
+    EXPECT_THROW(col.Append(Int128(1) << 40), ValidationError);
+    EXPECT_THROW(col.Append(int64_t(std::numeric_limits<int32_t>::min()) - 1), ValidationError);
+
+    ColumnDecimal64 col64(18, 2);
+    col64.Append(Int128(std::numeric_limits<int64_t>::min()));
+    EXPECT_THROW(col64.Append(Int128(1) << 64), ValidationError);
+
+    ASSERT_EQ(col.Size(), 2u);
+    EXPECT_EQ(col.At(0), -12345);
+    EXPECT_EQ(col.At(1), std::numeric_limits<int32_t>::max());
+    ASSERT_EQ(col64.Size(), 1u);
+    EXPECT_EQ(col64.At(0), std::numeric_limits<int64_t>::min());
+}
+
+TEST(ColumnsCase, ColumnDecimal256) {
+    ColumnDecimal col(76, 10);
+    col.Append("-123456789012345678901234567890123456789012345678901234567890.5");
+    col.Append(Int128(42));
+    EXPECT_EQ(col.GetItem(0).data.size(), 32u);
+    EXPECT_EQ(col.At(1), Int128(42));
+    EXPECT_THROW(col.Append("1" + std::string(76, '0')), AssertionError);
+
+    auto typed = ColumnDecimal256::Wrap(col.Slice(0, 2));
+    EXPECT_EQ(typed->At(0).ToString(), "-1234567890123456789012345678901234567890123456789012345678905000000000");
+    EXPECT_EQ(typed->At(1), Int256(42));
+
+    EXPECT_EQ(CreateColumnByType("Decimal256(10)")->GetType().GetName(), "Decimal(76,10)");
+    EXPECT_THROW(ColumnDecimal256(38, 2), ValidationError);
+}
+
+TEST(ColumnsCase, WideIntegers) {
+    const Int256 minus_one = -1;
+    EXPECT_TRUE(minus_one.IsNegative());
+    EXPECT_EQ(minus_one.GetLimbs(), (Int256::Limbs{~0ull, ~0ull, ~0ull, ~0ull}));
+    EXPECT_EQ(minus_one + Int256(1), Int256(0));
+    EXPECT_EQ(static_cast<Int128>(minus_one), Int128(-1));
+    EXPECT_EQ(Int256(std::numeric_limits<Int128>::min()).ToString(), "-170141183460469231731687303715884105728");
+    EXPECT_EQ(UInt256(absl::Uint128Max()).ToString(), "340282366920938463463374607431768211455");
+
+    // 2^255 - 1, product of two numbers wider than 64 bits
+    Int256 max = Int256::FromLimbs({~0ull, ~0ull, ~0ull, ~0ull >> 1});
+    EXPECT_EQ(max.ToString(), "57896044618658097711785492504343953926634992332820282019728792003956564819967");
+    EXPECT_EQ((max + Int256(1)).ToString(), "-57896044618658097711785492504343953926634992332820282019728792003956564819968");
+    EXPECT_EQ((Int256(absl::MakeUint128(1, 0)) * Int256(absl::MakeUint128(1, 0))).GetLimbs(), (Int256::Limbs{0, 0, 1, 0}));
+    EXPECT_EQ((Int256(-3) * Int256(7)).ToString(), "-21");
+    EXPECT_EQ(Int256(10000000000000000000ull).ToString(), "10000000000000000000");
+
+    EXPECT_LT(Int256(-5), Int256(3));
+    EXPECT_LT(Int256(3), max);
+    EXPECT_LT(UInt256(3), UInt256(-1));
+    EXPECT_DOUBLE_EQ(static_cast<double>(Int256(-1000)), -1000.0);
+    EXPECT_DOUBLE_EQ(static_cast<double>(UInt256::FromLimbs({0, 0, 0, 1})), std::ldexp(1.0, 192));
+}
+
+TEST(ColumnsCase, BFloat16) {
+    EXPECT_EQ(static_cast<float>(BFloat16(1.5f)), 1.5f);
+    EXPECT_EQ(BFloat16(-2.0f).GetBits(), 0xC000);
+    // Lower 16 bits of mantissa are dropped.
+    EXPECT_EQ(static_cast<float>(BFloat16(1.00001f)), 1.0f);
+
+    const std::vector<float> floats{0.f, -1.f, 3.140625f, 1e30f};
+    std::vector<BFloat16> values(floats.size());
+    ConvertFloatToBFloat16(floats, values);
+
+    std::vector<float> converted(floats.size());
+    ConvertBFloat16ToFloat(values, converted);
+    EXPECT_EQ(converted[0], 0.f);
+    EXPECT_EQ(converted[1], -1.f);
+    EXPECT_EQ(converted[2], 3.140625f);
+    EXPECT_NEAR(converted[3], 1e30f, 1e28f);
+
+    EXPECT_THROW(ConvertBFloat16ToFloat(values, Span<float>(converted.data(), 1)), ValidationError);
+}
+
+TEST(ColumnsCase, WideNumericColumns_SaveLoad) {
+    // Values are stored in wire format, column data is written and read as-is.
+    auto check = [](auto col, const auto & values, size_t value_size) {
+        using ValueType = typename std::decay_t<decltype(*col)>::ValueType;
+        col->AppendMany(Span<const ValueType>(values.data(), values.size()));
+
+        std::vector<uint8_t> buffer(values.size() * value_size);
+        {
+            ArrayOutput output(buffer.data(), buffer.size());
+            col->SaveBody(&output);
+            EXPECT_EQ(output.Avail(), 0u);
+        }
+        EXPECT_EQ(0, std::memcmp(buffer.data(), values.data(), buffer.size()));
+
+        auto loaded = col->CloneEmpty()->template As<std::decay_t<decltype(*col)>>();
+        ArrayInput input(buffer.data(), buffer.size());
+        ASSERT_TRUE(loaded->LoadBody(&input, values.size()));
+        for (size_t i = 0; i < values.size(); ++i) {
+            EXPECT_EQ(loaded->At(i), values[i]) << " at pos: " << i;
+        }
+    };
+
+    check(std::make_shared<ColumnInt256>(), std::vector<Int256>{0, -1, Int256::FromLimbs({1, 2, 3, 4})}, 32);
+    check(std::make_shared<ColumnUInt256>(), std::vector<UInt256>{0, 1, UInt256::FromLimbs({1, 2, 3, 4})}, 32);
+    check(std::make_shared<ColumnUInt128>(), std::vector<absl::uint128>{0, 1, absl::Uint128Max()}, 16);
+    check(std::make_shared<ColumnBFloat16>(), std::vector<BFloat16>{BFloat16(0.5f), BFloat16(-3.f)}, 2);
+}
+
 TEST(ColumnsCase, ColumnLowCardinalityString_Append_and_Read) {
     const size_t items_count = 11;
     ColumnLowCardinalityT<ColumnString> col;
@@ -883,6 +1343,352 @@ TEST(ColumnsCase, ColumnLowCardinalityFixedString_Type_Size_Eq) {
     ASSERT_EQ(fixed_size, col->GetNestedType()->As<FixedStringType>()->GetSize());
 }
 
+TEST(ColumnsCase, ColumnLowCardinalityString_ManyUniqueItems) {
+    // Enough unique items to make unique items index grow several times.
+    const size_t unique_items = 10'000;
+    ColumnLowCardinalityT<ColumnString> col;
+    for (size_t round = 0; round < 3; ++round) {
+        for (size_t i = 0; i < unique_items; ++i) {
+            col.Append(std::to_string(i));
+        }
+    }
+
+    ASSERT_EQ(col.Size(), unique_items * 3);
+    ASSERT_EQ(col.GetDictionarySize(), unique_items + 1); // + 1 null-item
+
+    for (size_t i = 0; i < col.Size(); ++i) {
+        ASSERT_EQ(col.At(i), std::to_string(i % unique_items)) << " at pos: " << i;
+    }
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_AppendMany) {
+    const auto values = GenerateVector(3000, [](size_t i) { return std::to_string(i % 100); });
+    ColumnLowCardinalityT<ColumnString> col;
+    col.AppendMany(values);
+
+    ASSERT_EQ(col.Size(), values.size());
+    ASSERT_EQ(col.GetDictionarySize(), 100u + 1); // + 1 null-item
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(col.At(i), values[i]) << " at pos: " << i;
+    }
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_AppendManyBatches) {
+    // Strings and string views are referenced by ItemView in place, so they are appended in batches.
+    using LCString = ColumnLowCardinalityT<ColumnString>;
+    static_assert(LCString::AppendsInBatches<std::vector<std::string>>);
+    static_assert(LCString::AppendsInBatches<std::vector<std::string_view>>);
+    static_assert(!LCString::AppendsInBatches<std::vector<int>>);
+    static_assert(ColumnLowCardinalityT<ColumnUInt32>::AppendsInBatches<std::vector<uint32_t>>);
+    // Converted items would be referenced after destruction of a temporary.
+    static_assert(!ColumnLowCardinalityT<ColumnUInt32>::AppendsInBatches<std::vector<int>>);
+
+    const auto strings = GenerateVector(3000, [](size_t i) { return std::to_string(i % 100); });
+    const std::vector<std::string_view> views(strings.begin(), strings.end());
+
+    static_assert(LCString::AppendsInBatches<Span<const std::string_view>>);
+
+    LCString col;
+    col.AppendMany(strings);
+    col.AppendMany(views);
+    col.AppendMany(Span<const std::string_view>(views));
+
+    ASSERT_EQ(col.Size(), strings.size() * 3);
+    ASSERT_EQ(col.GetDictionarySize(), 100u + 1); // + 1 null-item
+    for (size_t i = 0; i < col.Size(); ++i) {
+        ASSERT_EQ(col.At(i), strings[i % strings.size()]) << " at pos: " << i;
+    }
+}
+
+TEST(ColumnsCase, ColumnLowCardinality_AppendManyConverted) {
+    // Items of other types than ValueType are converted one by one, rather than referenced by a batch.
+    const auto values = GenerateVector(3000, [](size_t i) { return static_cast<int>(i % 100); });
+    ColumnLowCardinalityT<ColumnUInt32> col;
+    col.AppendMany(values);
+
+    ASSERT_EQ(col.Size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(col.At(i), static_cast<uint32_t>(values[i])) << " at pos: " << i;
+    }
+
+    ColumnLowCardinalityT<ColumnString> strings;
+    strings.AppendMany(std::vector<std::string>{"abc", "def", "abc"});
+    ASSERT_EQ(strings.Size(), 3u);
+    EXPECT_EQ(strings.At(2), "abc");
+    EXPECT_EQ(strings.At(1), "def");
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_AppendAfterLoad) {
+    // Items loaded from the stream must be found in dictionary on subsequent appends.
+    ColumnLowCardinalityT<ColumnString> col;
+
+    const auto & data = LOWCARDINALITY_STRING_FOOBAR_10_ITEMS_BINARY;
+    ArrayInput buffer(data.data(), data.size());
+    ASSERT_TRUE(col.Load(&buffer, 10));
+
+    const auto dictionary_size = col.GetDictionarySize();
+    for (const auto & item : GenerateVector(10, &FooBarGenerator)) {
+        col.Append(item);
+    }
+
+    EXPECT_EQ(col.Size(), 20u);
+    EXPECT_EQ(col.GetDictionarySize(), dictionary_size);
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(col.At(i + 10), FooBarGenerator(i)) << " at pos: " << i;
+    }
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_AppendAfterLoadWidensIndex) {
+    // Loaded column has UInt8 index, which must be widened once the dictionary has more than 256 items.
+    const auto values = GenerateVector(70000, [](size_t i) { return "item" + std::to_string(i); });
+    const auto load = []() {
+        auto col = std::make_shared<ColumnLowCardinalityT<ColumnString>>();
+        const auto & data = LOWCARDINALITY_STRING_FOOBAR_10_ITEMS_BINARY;
+        ArrayInput buffer(data.data(), data.size());
+        EXPECT_TRUE(col->Load(&buffer, 10));
+        return col;
+    };
+    const auto check = [&values](const ColumnLowCardinalityT<ColumnString> & col, size_t count) {
+        ASSERT_EQ(col.Size(), 10 + count);
+        for (size_t i = 0; i < 10; ++i) {
+            ASSERT_EQ(col.At(i), FooBarGenerator(i)) << " at pos: " << i;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(col.At(10 + i), values[i]) << " at pos: " << 10 + i;
+        }
+    };
+
+    // One by one.
+    auto col = load();
+    for (size_t i = 0; i < 300; ++i) {
+        col->Append(values[i]);
+    }
+    check(*col, 300);
+
+    // Merging dictionaries, past the range of UInt16 as well.
+    auto source = std::make_shared<ColumnLowCardinalityT<ColumnString>>();
+    source->AppendMany(values);
+    col = load();
+    col->Append(source);
+    check(*col, values.size());
+
+    // Appending indices of a dictionary.
+    ColumnString dictionary(values);
+    std::vector<uint64_t> indices(300);
+    std::iota(indices.begin(), indices.end(), 0);
+    col = load();
+    col->AppendIndices(dictionary, indices);
+    check(*col, indices.size());
+
+    // Wide index is saved and loaded back.
+    Buffer buffer;
+    BufferOutput output(&buffer);
+    col->Save(&output);
+    output.Flush();
+    ArrayInput input(buffer.data(), buffer.size());
+    ColumnLowCardinalityT<ColumnString> loaded;
+    ASSERT_TRUE(loaded.Load(&input, col->Size()));
+    check(loaded, indices.size());
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_AppendAfterLoadAndSwap) {
+    // Dictionary index of loaded column is built lazily, make sure that it follows the dictionary on Swap().
+    ColumnLowCardinalityT<ColumnString> loaded;
+
+    const auto & data = LOWCARDINALITY_STRING_FOOBAR_10_ITEMS_BINARY;
+    ArrayInput buffer(data.data(), data.size());
+    ASSERT_TRUE(loaded.Load(&buffer, 10));
+
+    ColumnLowCardinalityT<ColumnString> col;
+    col.Append("foo");
+    col.Swap(loaded);
+
+    const auto dictionary_size = col.GetDictionarySize();
+    col.Append("Foo");
+    col.Append("Bar");
+    EXPECT_EQ(col.Size(), 12u);
+    EXPECT_EQ(col.GetDictionarySize(), dictionary_size);
+    EXPECT_EQ(col.At(10), "Foo");
+    EXPECT_EQ(col.At(11), "Bar");
+
+    loaded.Append("foo");
+    loaded.Append("bar");
+    EXPECT_EQ(loaded.Size(), 3u);
+    EXPECT_EQ(loaded.GetDictionarySize(), 3u);
+    EXPECT_EQ(loaded.At(1), "foo");
+    EXPECT_EQ(loaded.At(2), "bar");
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_AppendLowCardinality) {
+    ColumnLowCardinalityT<ColumnString> col;
+    col.Append("a");
+    col.Append("b");
+
+    auto other = std::make_shared<ColumnLowCardinalityT<ColumnString>>();
+    for (const auto & item : {"c", "b", "c", "", "d", "a"}) {
+        other->Append(item);
+    }
+
+    col.Append(other);
+    const std::vector<std::string> expected{"a", "b", "c", "b", "c", "", "d", "a"};
+    ASSERT_EQ(col.Size(), expected.size());
+    EXPECT_EQ(col.GetDictionarySize(), 5u); // default item + "a", "b", "c", "d"
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(col.At(i), expected[i]) << " at pos: " << i;
+    }
+
+    // Appending column to itself.
+    auto self = std::make_shared<ColumnLowCardinalityT<ColumnString>>();
+    self->Swap(col);
+    self->Append(self);
+    ASSERT_EQ(self->Size(), expected.size() * 2);
+    EXPECT_EQ(self->GetDictionarySize(), 5u);
+    for (size_t i = 0; i < self->Size(); ++i) {
+        EXPECT_EQ(self->At(i), expected[i % expected.size()]) << " at pos: " << i;
+    }
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityString_AppendLoadedLowCardinality) {
+    // Loaded column has UInt8 index column and unique items index that is not built yet.
+    auto loaded = std::make_shared<ColumnLowCardinalityT<ColumnString>>();
+
+    const auto & data = LOWCARDINALITY_STRING_FOOBAR_10_ITEMS_BINARY;
+    ArrayInput buffer(data.data(), data.size());
+    ASSERT_TRUE(loaded->Load(&buffer, 10));
+
+    ColumnLowCardinalityT<ColumnString> col;
+    col.Append("Bar");
+    col.Append(loaded);
+    col.Append(loaded);
+
+    ASSERT_EQ(col.Size(), 21u);
+    EXPECT_EQ(col.GetDictionarySize(), loaded->GetDictionarySize());
+    EXPECT_EQ(col.At(0), "Bar");
+    for (size_t i = 0; i < 20; ++i) {
+        EXPECT_EQ(col.At(i + 1), FooBarGenerator(i % 10)) << " at pos: " << i;
+    }
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityNullableString_AppendLowCardinality) {
+    ColumnLowCardinalityT<ColumnNullableT<ColumnString>> col;
+    col.Append("a");
+    col.Append(std::nullopt);
+
+    auto other = std::make_shared<ColumnLowCardinalityT<ColumnNullableT<ColumnString>>>();
+    other->Append(std::nullopt);
+    other->Append("");
+    other->Append("b");
+    other->Append("a");
+
+    col.Append(other);
+    ASSERT_EQ(col.Size(), 6u);
+    EXPECT_EQ(col.GetDictionarySize(), 4u); // null-item + default item + "a", "b"
+    EXPECT_EQ(col.At(0), std::optional<std::string_view>("a"));
+    EXPECT_EQ(col.At(1), std::nullopt);
+    EXPECT_EQ(col.At(2), std::nullopt);
+    EXPECT_EQ(col.At(3), std::optional<std::string_view>(""));
+    EXPECT_EQ(col.At(4), std::optional<std::string_view>("b"));
+    EXPECT_EQ(col.At(5), std::optional<std::string_view>("a"));
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityUInt32_SaveAndLoad) {
+    ColumnLowCardinalityT<ColumnUInt32> col;
+    const std::vector<uint32_t> values{1, 0, 42, 1, 0, 42, std::numeric_limits<uint32_t>::max()};
+    col.AppendMany(values);
+
+    ASSERT_EQ(col.Size(), values.size());
+    EXPECT_EQ(col.GetDictionarySize(), 4u); // default item 0 + 1, 42, max
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(col.At(i), values[i]) << " at pos: " << i;
+    }
+
+    char buffer[256] = {'\0'};
+    ArrayOutput output(buffer, sizeof(buffer));
+    col.Save(&output);
+
+    ColumnLowCardinalityT<ColumnUInt32> loaded;
+    ArrayInput input(buffer, sizeof(buffer));
+    ASSERT_TRUE(loaded.Load(&input, values.size()));
+
+    ASSERT_EQ(loaded.Size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(loaded.At(i), values[i]) << " at pos: " << i;
+    }
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityDate) {
+    ColumnLowCardinalityT<ColumnDate> col;
+    const std::time_t day = 86400;
+    const std::vector<std::time_t> values{day * 100, day * 200, day * 100, 0};
+    col.AppendMany(values);
+
+    ASSERT_EQ(col.Size(), values.size());
+    EXPECT_EQ(col.GetDictionarySize(), 3u);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(col.At(i), values[i]) << " at pos: " << i;
+    }
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityNullableInt64) {
+    ColumnLowCardinalityT<ColumnNullableT<ColumnInt64>> col;
+    col.Append(-1);
+    col.Append(std::nullopt);
+    col.Append(std::optional<int64_t>(0));
+    col.Append(-1);
+
+    ASSERT_EQ(col.Size(), 4u);
+    EXPECT_EQ(col.GetDictionarySize(), 3u); // null-item + default item 0 + -1
+    EXPECT_EQ(col.At(0), std::optional<int64_t>(-1));
+    EXPECT_EQ(col.At(1), std::nullopt);
+    EXPECT_EQ(col.At(2), std::optional<int64_t>(0));
+    EXPECT_EQ(col.At(3), std::optional<int64_t>(-1));
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityFixedString_ShortValues) {
+    // Values shorter than fixed size are zero-padded in dictionary, but still must be deduplicated.
+    ColumnLowCardinalityT<ColumnFixedString> col(8);
+    col.Append("abc");
+    col.Append("abc");
+    col.Append(std::string_view("abc\0\0", 5));
+    col.Append("");
+
+    EXPECT_EQ(col.Size(), 4u);
+    EXPECT_EQ(col.GetDictionarySize(), 2u); // default item + "abc"
+    EXPECT_EQ(col.At(0), std::string_view("abc\0\0\0\0\0", 8));
+    EXPECT_EQ(col.At(3), std::string_view("\0\0\0\0\0\0\0\0", 8));
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityFixedString_AppendInvalidValue) {
+    // Value that is too long is rejected, and column remains usable afterwards.
+    ColumnLowCardinalityT<ColumnFixedString> col(3);
+    col.Append("abc");
+    EXPECT_ANY_THROW(col.Append("abcdef"));
+
+    EXPECT_EQ(col.Size(), 1u);
+    EXPECT_EQ(col.GetDictionarySize(), 2u);
+
+    col.Append("def");
+    col.Append("abc");
+    EXPECT_EQ(col.Size(), 3u);
+    EXPECT_EQ(col.GetDictionarySize(), 3u);
+    EXPECT_EQ(col.At(1), "def");
+    EXPECT_EQ(col.At(2), "abc");
+}
+
+TEST(ColumnsCase, ColumnLowCardinalityNullableString_NullAndEmpty) {
+    ColumnLowCardinalityT<ColumnNullableT<ColumnString>> col;
+    col.Append(std::nullopt);
+    col.Append("");
+    col.Append(std::nullopt);
+    col.Append("");
+
+    EXPECT_EQ(col.GetDictionarySize(), 2u); // null-item + default item
+    EXPECT_EQ(col.At(0), std::nullopt);
+    EXPECT_EQ(col.At(1), std::optional<std::string_view>(""));
+    EXPECT_EQ(col.At(2), std::nullopt);
+    EXPECT_EQ(col.At(3), std::optional<std::string_view>(""));
+}
+
 TEST(ColumnsCase, ColumnTupleT) {
     using TestTuple = ColumnTupleT<ColumnUInt64, ColumnString, ColumnFixedString>;
 
@@ -953,6 +1759,94 @@ TEST(ColumnsCase, ColumnMapT) {
     EXPECT_EQ(val[2], map.at(2));
 }
 
+TEST(ColumnsCase, ColumnMapT_Append) {
+    using TestMap = ColumnMapT<ColumnUInt64, ColumnString>;
+    TestMap col1(std::make_shared<ColumnUInt64>(), std::make_shared<ColumnString>());
+    auto col2 = std::make_shared<TestMap>(std::make_shared<ColumnUInt64>(), std::make_shared<ColumnString>());
+
+    col1.Append(std::map<uint64_t, std::string>{{1, "a"}});
+    col2->Append(std::map<uint64_t, std::string>{});
+    col2->Append(std::map<uint64_t, std::string>{{2, "b"}, {3, "c"}});
+
+    col1.Append(ColumnRef(col2));
+
+    ASSERT_EQ(col1.Size(), 3u);
+    EXPECT_EQ(col1.At(0).At(1), "a");
+    EXPECT_EQ(col1.At(1).Size(), 0u);
+    EXPECT_EQ(col1.At(2).Size(), 2u);
+    EXPECT_EQ(col1.At(2).At(2), "b");
+    EXPECT_EQ(col1.At(2).At(3), "c");
+}
+
+TEST(ColumnsCase, ColumnMapT_FindValue) {
+    using TestMap = ColumnMapT<ColumnString, ColumnUInt64>;
+    TestMap col(std::make_shared<ColumnString>(), std::make_shared<ColumnUInt64>());
+
+    const size_t rows = 100;
+    for (size_t row = 0; row < rows; ++row) {
+        std::vector<std::tuple<std::string_view, uint64_t>> tuples;
+        // Same keys in all rows, but row-specific values and number of keys.
+        for (size_t i = 0; i < row % 10; ++i) {
+            tuples.emplace_back(i % 2 ? "odd" : "even", row * 100 + i);
+        }
+        tuples.emplace_back("row", row);
+        col.Append(tuples);
+    }
+
+    for (size_t row = 0; row < rows; ++row) {
+        EXPECT_EQ(col.FindValue(row, "row"), std::optional<uint64_t>(row)) << " at row: " << row;
+        // First of duplicate keys is found, same as with MapValueView::Find().
+        if (row % 10 > 0) {
+            EXPECT_EQ(col.FindValue(row, "even"), (*col.At(row).Find("even")).second) << " at row: " << row;
+            EXPECT_EQ(col.FindValue(row, "even"), std::optional<uint64_t>(row * 100)) << " at row: " << row;
+        } else {
+            EXPECT_EQ(col.FindValue(row, "even"), std::nullopt) << " at row: " << row;
+        }
+        if (row % 10 > 1) {
+            EXPECT_EQ(col.FindValue(row, "odd"), std::optional<uint64_t>(row * 100 + 1)) << " at row: " << row;
+        } else {
+            EXPECT_EQ(col.FindValue(row, "odd"), std::nullopt) << " at row: " << row;
+        }
+        EXPECT_EQ(col.FindValue(row, "none"), std::nullopt) << " at row: " << row;
+    }
+    EXPECT_THROW(col.FindValue(rows, "row"), ValidationError);
+
+    // Index is rebuilt after column is modified.
+    col.Append(std::map<std::string, uint64_t>{{"new", 42}});
+    EXPECT_EQ(col.FindValue(rows, "new"), std::optional<uint64_t>(42));
+    EXPECT_EQ(col.FindValue(0, "new"), std::nullopt);
+
+    col.Clear();
+    col.Append(std::map<std::string, uint64_t>{{"row", 7}});
+    EXPECT_EQ(col.FindValue(0, "row"), std::optional<uint64_t>(7));
+}
+
+TEST(ColumnsCase, ColumnMapT_FindValueConcurrently) {
+    using TestMap = ColumnMapT<ColumnUInt64, ColumnUInt64>;
+    TestMap col(std::make_shared<ColumnUInt64>(), std::make_shared<ColumnUInt64>());
+    for (uint64_t row = 0; row < 1000; ++row) {
+        col.Append(std::map<uint64_t, uint64_t>{{row, row * 2}, {row + 1, 0}});
+    }
+
+    // The index is built by one of the threads, others wait for it.
+    std::vector<std::thread> threads;
+    std::vector<size_t> found(4);
+    for (size_t t = 0; t < found.size(); ++t) {
+        threads.emplace_back([&col, &found, t]() {
+            for (uint64_t row = 0; row < col.Size(); ++row) {
+                found[t] += col.FindValue(row, row) == std::optional<uint64_t>(row * 2);
+            }
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    for (size_t t = 0; t < found.size(); ++t) {
+        EXPECT_EQ(found[t], col.Size()) << " in thread: " << t;
+    }
+}
+
 TEST(ColumnsCase, ColumnMapT_Wrap) {
     auto tupls = std::make_shared<ColumnTuple>(std::vector<ColumnRef>{
             std::make_shared<ColumnUInt64>(),
@@ -981,3 +1875,972 @@ TEST(ColumnsCase, ColumnMapT_Wrap) {
     EXPECT_EQ("123", map_view.At(1));
     EXPECT_EQ("abc", map_view.At(2));
 }
+
+TEST(ColumnsCase, ColumnIPv4_FromStrings) {
+    ColumnString strings(std::vector<std::string>{"255.255.255.255", "127.0.0.1", "62.204.180.213", "0.0.0.0", "1.10.100.9"});
+
+    ColumnIPv4 col;
+    col.AppendFromStrings(strings);
+    ASSERT_EQ(strings.Size(), col.Size());
+    for (size_t i = 0; i < col.Size(); ++i) {
+        EXPECT_EQ(strings[i], col.AsString(i));
+    }
+
+    // Matches inet_ntop() on arbitrary addresses.
+    std::mt19937 random(42);
+    for (size_t i = 0; i < 1000; ++i) {
+        col.Append(static_cast<uint32_t>(random()));
+    }
+
+    ColumnString formatted;
+    col.FormatToStrings(formatted);
+    ASSERT_EQ(col.Size(), formatted.Size());
+    for (size_t i = 0; i < col.Size(); ++i) {
+        EXPECT_EQ(col.AsString(i), formatted[i]);
+    }
+
+    for (const auto & invalid : {"", "1.2.3", "1.2.3.4.5", "1.2.3.256", "01.2.3.4", "1.2.3.4 ", "1..2.3", "a.b.c.d"}) {
+        ColumnString invalid_strings(std::vector<std::string>{"1.2.3.4", invalid});
+        EXPECT_THROW(col.AppendFromStrings(invalid_strings), ValidationError) << invalid;
+        EXPECT_EQ(1005u, col.Size());
+    }
+}
+
+TEST(ColumnsCase, ColumnIPv6_FromStrings) {
+    ColumnString strings(std::vector<std::string>{
+        "::", "::1", "2001:db8::ff00:42:8329", "fe80::1:0:0:1", "::ffff:192.168.0.1", "::1.2.3.4",
+        "1:0:0:1:0:0:0:1", "2001:db8:85a3:8d3:1319:8a2e:370:7348", "1::", "1:2:3:4:5:6:7::"});
+
+    ColumnIPv6 col;
+    col.AppendFromStrings(strings);
+    ASSERT_EQ(strings.Size(), col.Size());
+
+    ColumnString formatted;
+    col.FormatToStrings(formatted);
+    ASSERT_EQ(col.Size(), formatted.Size());
+    for (size_t i = 0; i < col.Size(); ++i) {
+        EXPECT_EQ(col.AsString(i), formatted[i]);
+    }
+    EXPECT_EQ("2001:db8::ff00:42:8329", formatted[2]);
+    EXPECT_EQ("1:0:0:1::1", formatted[6]);
+    EXPECT_EQ("1:2:3:4:5:6:7:0", formatted[9]);
+
+    // Full, uppercase and mixed forms are parsed same as by inet_pton().
+    ColumnString other_forms(std::vector<std::string>{"0:0:0:0:0:0:0:1", "2001:DB8:0:0:0:FF00:42:8329", "0:0:0:0:0:ffff:c0a8:1"});
+    ColumnIPv6 parsed;
+    parsed.AppendFromStrings(other_forms);
+    EXPECT_EQ(col.At(1), parsed.At(0));
+    EXPECT_EQ(col.At(2), parsed.At(1));
+    EXPECT_EQ(col.At(4), parsed.At(2));
+
+    for (const auto & invalid : {"", ":", ":::", "1:2", "1::2::3", "1:2:3:4:5:6:7:8:9", "1:2:3:4:5:6:7:8::", "12345::",
+                                 "::1.2.3", "::1.2.3.4:1", "1:", ":1", "g::1"}) {
+        ColumnString invalid_strings(std::vector<std::string>{invalid});
+        EXPECT_THROW(col.AppendFromStrings(invalid_strings), ValidationError) << invalid;
+        EXPECT_EQ(strings.Size(), col.Size());
+    }
+}
+
+TEST(ColumnsCase, ColumnUUID_FromStrings) {
+    ColumnString strings(std::vector<std::string>{
+        "01020304-0506-0708-090a-0b0c0d0e0f10", "bb6a8c69-9ab2-414c-8669-7b7fd27f0825", "00000000-0000-0000-0000-000000000000"});
+
+    ColumnUUID col;
+    col.AppendFromStrings(strings);
+    ASSERT_EQ(3u, col.Size());
+    EXPECT_EQ(UUID(0x0102030405060708llu, 0x090a0b0c0d0e0f10llu), col.At(0));
+    EXPECT_EQ(UUID(0xbb6a8c699ab2414cllu, 0x86697b7fd27f0825llu), col.At(1));
+    EXPECT_EQ(UUID(0, 0), col.At(2));
+
+    ColumnString uppercase(std::vector<std::string>{"BB6A8C69-9AB2-414C-8669-7B7FD27F0825"});
+    col.AppendFromStrings(uppercase);
+    EXPECT_EQ(col.At(1), col.At(3));
+
+    for (const auto & value : MakeUUIDs()) {
+        col.Append(value);
+    }
+
+    ColumnString formatted;
+    col.FormatToStrings(formatted);
+    ASSERT_EQ(col.Size(), formatted.Size());
+    EXPECT_EQ(strings[1], formatted[3]);
+    for (size_t i = 0; i < col.Size(); ++i) {
+        EXPECT_EQ(ToString(col.At(i)), formatted[i]);
+    }
+
+    for (const auto & invalid : {"", "01020304-0506-0708-090a-0b0c0d0e0f1", "01020304-0506-0708-090a-0b0c0d0e0f1g",
+                                 "01020304+0506-0708-090a-0b0c0d0e0f10", "0102030405060708090a0b0c0d0e0f10",
+                                 "01020304-0506-0708-090a-0b0c0d0e0f:0", "01020304-0506-0708-090a-0b0c0d0e0f/0"}) {
+        ColumnString invalid_strings(std::vector<std::string>{invalid});
+        EXPECT_THROW(col.AppendFromStrings(invalid_strings), ValidationError) << invalid;
+    }
+}
+
+TEST(ColumnsCase, ColumnDecimal_FromStrings) {
+    ColumnString strings(std::vector<std::string>{"0", "1.5", "-1.25", "12345.6789", "-0.0001", "100"});
+
+    ColumnDecimal64 col(18, 4);
+    col.AppendFromStrings(strings);
+    EXPECT_EQ((std::vector<int64_t>{0, 15000, -12500, 123456789, -1, 1000000}),
+              std::vector<int64_t>(col.GetData().begin(), col.GetData().end()));
+
+    ColumnString formatted;
+    col.FormatToStrings(formatted);
+    ASSERT_EQ(col.Size(), formatted.Size());
+    for (size_t i = 0; i < col.Size(); ++i) {
+        EXPECT_EQ(strings[i], formatted[i]);
+    }
+
+    ColumnString invalid_strings(std::vector<std::string>{"1.5", "1.2.3"});
+    EXPECT_THROW(col.AppendFromStrings(invalid_strings), ValidationError);
+    EXPECT_EQ(strings.Size(), col.Size());
+
+    // Wide values and scale 0.
+    ColumnString wide(std::vector<std::string>{"-99999999999999999999999999999999999999", "12345678901234567890123"});
+    ColumnDecimal decimal128(38, 0);
+    decimal128.AppendFromStrings(wide);
+    ColumnString decimal128_formatted;
+    decimal128.FormatToStrings(decimal128_formatted);
+    EXPECT_EQ(wide[0], decimal128_formatted[0]);
+    EXPECT_EQ(wide[1], decimal128_formatted[1]);
+
+    ColumnString wide256(std::vector<std::string>{"-1234567890123456789012345678901234567890.123456789012345678", "0.000000000000000001"});
+    ColumnDecimal256 decimal256(76, 18);
+    decimal256.AppendFromStrings(wide256);
+    ColumnString decimal256_formatted;
+    decimal256.FormatToStrings(decimal256_formatted);
+    EXPECT_EQ(wide256[0], decimal256_formatted[0]);
+    EXPECT_EQ(wide256[1], decimal256_formatted[1]);
+}
+
+TEST(ColumnsCase, ColumnDate_FromStrings) {
+    ColumnString strings(std::vector<std::string>{"1970-01-01", "2000-02-29", "2023-12-31", "2149-06-06"});
+
+    ColumnDate date;
+    date.AppendFromStrings(strings);
+    EXPECT_EQ((std::vector<uint16_t>{0, 11016, 19722, 65535}),
+              std::vector<uint16_t>(date.GetData().begin(), date.GetData().end()));
+
+    ColumnString formatted;
+    date.FormatToStrings(formatted);
+    ASSERT_EQ(strings.Size(), formatted.Size());
+    for (size_t i = 0; i < formatted.Size(); ++i) {
+        EXPECT_EQ(strings[i], formatted[i]);
+    }
+
+    for (const auto & invalid : {"1969-12-31", "2149-06-07", "2023-02-29", "2023-13-01", "2023-00-10", "2023-1-01", "2023/01/01", "20230101  "}) {
+        ColumnString invalid_strings(std::vector<std::string>{invalid});
+        EXPECT_THROW(date.AppendFromStrings(invalid_strings), ValidationError) << invalid;
+        EXPECT_EQ(strings.Size(), date.Size());
+    }
+
+    ColumnDate32 date32;
+    ColumnString strings32(std::vector<std::string>{"1900-01-01", "1969-12-31", "2299-12-31"});
+    date32.AppendFromStrings(strings32);
+    EXPECT_EQ(-25567, date32.RawAt(0));
+    EXPECT_EQ(-1, date32.RawAt(1));
+
+    // More rows than a single chunk of conversion.
+    for (int32_t day = -25567; day < 0; day += 7) {
+        date32.AppendRaw(day);
+    }
+
+    ColumnString formatted32;
+    date32.FormatToStrings(formatted32);
+    ASSERT_EQ(date32.Size(), formatted32.Size());
+    EXPECT_EQ(strings32[2], formatted32[2]);
+
+    ColumnDate32 reparsed;
+    reparsed.AppendFromStrings(formatted32);
+    EXPECT_TRUE(CompareRecursive(date32.GetData(), reparsed.GetData()));
+}
+
+TEST(ColumnsCase, ColumnGeo_FlatAccess) {
+    ColumnPoint points;
+    points.Append(std::make_tuple(1.0, 2.0));
+    points.Append(std::make_tuple(3.0, 4.0));
+    EXPECT_EQ(0u, ColumnPoint::NestingDepth);
+    EXPECT_EQ((std::vector<double>{1.0, 3.0}), std::vector<double>(points.GetX().begin(), points.GetX().end()));
+    EXPECT_EQ((std::vector<double>{2.0, 4.0}), std::vector<double>(points.GetY().begin(), points.GetY().end()));
+    EXPECT_THROW(points.GetOffsets(0), ValidationError);
+
+    using Ring = std::vector<std::tuple<double, double>>;
+    using Polygon = std::vector<Ring>;
+    ColumnMultiPolygon multi_polygons;
+    multi_polygons.Append(std::vector<Polygon>{
+        Polygon{Ring{{0, 0}, {0, 1}, {1, 1}}, Ring{{0.5, 0.5}}},
+        Polygon{Ring{{2, 2}, {3, 3}}}
+    });
+    multi_polygons.Append(std::vector<Polygon>{});
+    multi_polygons.Append(std::vector<Polygon>{Polygon{Ring{{5, 6}}}});
+
+    EXPECT_EQ(3u, ColumnMultiPolygon::NestingDepth);
+    const auto x = multi_polygons.GetX();
+    const auto y = multi_polygons.GetY();
+    EXPECT_EQ((std::vector<double>{0, 0, 1, 0.5, 2, 3, 5}), std::vector<double>(x.begin(), x.end()));
+    EXPECT_EQ((std::vector<double>{0, 1, 1, 0.5, 2, 3, 6}), std::vector<double>(y.begin(), y.end()));
+
+    const auto to_vector = [](Span<const uint64_t> offsets) {
+        return std::vector<uint64_t>(offsets.begin(), offsets.end());
+    };
+    EXPECT_EQ((std::vector<uint64_t>{2, 2, 3}), to_vector(multi_polygons.GetOffsets(0)));
+    EXPECT_EQ((std::vector<uint64_t>{2, 3, 4}), to_vector(multi_polygons.GetOffsets(1)));
+    EXPECT_EQ((std::vector<uint64_t>{3, 4, 6, 7}), to_vector(multi_polygons.GetOffsets(2)));
+    EXPECT_THROW(multi_polygons.GetOffsets(3), ValidationError);
+
+    // Views are consistent with rows of a sliced column too.
+    const auto slice = multi_polygons.Slice(2, 1)->As<ColumnMultiPolygon>();
+    EXPECT_EQ((std::vector<uint64_t>{1}), to_vector(slice->GetOffsets(0)));
+    EXPECT_EQ((std::vector<uint64_t>{1}), to_vector(slice->GetOffsets(2)));
+    EXPECT_EQ(5.0, slice->GetX()[0]);
+    EXPECT_EQ(6.0, slice->GetY()[0]);
+
+    ColumnRing rings;
+    rings.Append(Ring{{1, 1}, {2, 2}});
+    EXPECT_EQ((std::vector<uint64_t>{2}), to_vector(rings.GetOffsets(0)));
+    EXPECT_EQ(2u, rings.GetX().size());
+}
+
+TEST(ColumnsCase, ColumnIxJson_ExtractPaths) {
+    ColumnIxJson col;
+    col.Append(R"({"id": 1, "user": {"name": "a\"b", "tags": ["{", "}"], "city": "Zürich"}, "score": 1.5})");
+    col.Append(std::string(R"({"user": {"name": "{not \\ an object}", "age": null}, "id": -20, "score": 3e2 })"));
+    col.Append(R"({"id": "7", "extra": {"user": {"name": "nested"}}, "user": [1, 2]})");
+    col.Append("{}");
+
+    const auto result = col.ExtractPaths({
+        {"id", Type::CreateNullable(Type::CreateSimple<int64_t>())},
+        {"user.name", Type::CreateString()},
+        {"user.city", Type::CreateNullable(Type::CreateString())},
+        {"score", Type::CreateSimple<double>()},
+        {"user", Type::CreateString()},
+    });
+    ASSERT_EQ(result.size(), 5u);
+
+    const auto id = result[0]->As<ColumnNullable>();
+    ASSERT_EQ(id->Size(), 4u);
+    EXPECT_EQ(id->Nested()->As<ColumnInt64>()->At(0), 1);
+    EXPECT_EQ(id->Nested()->As<ColumnInt64>()->At(1), -20);
+    EXPECT_TRUE(id->IsNull(2));
+    EXPECT_TRUE(id->IsNull(3));
+
+    const auto name = result[1]->As<ColumnString>();
+    EXPECT_EQ(name->At(0), "a\"b");
+    EXPECT_EQ(name->At(1), "{not \\ an object}");
+    EXPECT_EQ(name->At(2), "");
+    EXPECT_EQ(name->At(3), "");
+
+    const auto city = result[2]->As<ColumnNullable>();
+    EXPECT_EQ(city->Nested()->As<ColumnString>()->At(0), "Z\xC3\xBCrich");
+    EXPECT_TRUE(city->IsNull(1));
+
+    const auto score = result[3]->As<ColumnFloat64>();
+    EXPECT_EQ(score->At(0), 1.5);
+    EXPECT_EQ(score->At(1), 300.0);
+    EXPECT_EQ(score->At(2), 0.0);
+
+    const auto user = result[4]->As<ColumnString>();
+    EXPECT_EQ(user->At(2), "[1, 2]");
+
+    // Index is extended with appended rows and reset on Clear().
+    col.Append(R"({"id": 9223372036854775807, "score": 0.1})");
+    auto appended = col.ExtractPaths({{"id", Type::CreateSimple<int64_t>()}, {"score", Type::CreateSimple<double>()}});
+    EXPECT_EQ(appended[0]->As<ColumnInt64>()->At(4), std::numeric_limits<int64_t>::max());
+    EXPECT_EQ(appended[1]->As<ColumnFloat64>()->At(4), 0.1);
+
+    col.Clear();
+    col.Append(R"({"id": 2})");
+    appended = col.ExtractPaths({{"id", Type::CreateSimple<int64_t>()}});
+    ASSERT_EQ(appended[0]->Size(), 1u);
+    EXPECT_EQ(appended[0]->As<ColumnInt64>()->At(0), 2);
+
+    EXPECT_THROW(col.ExtractPaths({{"id", Type::CreateSimple<int32_t>()}}), ValidationError);
+    EXPECT_THROW(col.ExtractPaths({{"user..name", Type::CreateString()}}), ValidationError);
+
+    col.Append(R"({"id": 1, "user": {"name": "x")");
+    EXPECT_THROW(col.ExtractPaths({{"user.name", Type::CreateString()}}), ValidationError);
+}
+
+TEST(ColumnsCase, ColumnIxJson_ExtractFloats) {
+    // Numbers out of the exact fast path are parsed with correct rounding.
+    const std::vector<std::pair<std::string, double>> numbers{
+        {"0.1234567890123456789012", 0.1234567890123456789012},
+        {"123456789012345678901234567890", 123456789012345678901234567890.0},
+        {"1.7976931348623157e308", std::numeric_limits<double>::max()},
+        {"4.9e-324", std::numeric_limits<double>::denorm_min()},
+        {"1e400", std::numeric_limits<double>::infinity()},
+        {"-1e-400", -0.0},
+    };
+
+    ColumnIxJson col;
+    for (const auto & [text, _] : numbers) {
+        col.Append(R"({"x": )" + text + "}");
+    }
+    col.Append(R"({"x": 1e})");
+
+    const auto result = col.ExtractPaths({{"x", Type::CreateNullable(Type::CreateSimple<double>())}});
+    const auto x = result[0]->As<ColumnNullable>();
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        ASSERT_FALSE(x->IsNull(i)) << numbers[i].first;
+        EXPECT_EQ(x->Nested()->As<ColumnFloat64>()->At(i), numbers[i].second) << numbers[i].first;
+    }
+    EXPECT_TRUE(x->IsNull(numbers.size()));
+}
+
+TEST(ColumnsCase, ColumnIxJson_ExtractInts) {
+    ColumnIxJson col;
+    col.Append(R"({"x": -9223372036854775808})");
+    col.Append(R"({"x": 9223372036854775807})");
+    col.Append(R"({"x": 9223372036854775808})");
+    col.Append(R"({"x": -9223372036854775809})");
+    col.Append(R"({"x": 99999999999999999999})");
+    col.Append(R"({"x": 1.5})");
+
+    const auto result = col.ExtractPaths({{"x", Type::CreateNullable(Type::CreateSimple<int64_t>())}});
+    const auto x = result[0]->As<ColumnNullable>();
+    EXPECT_EQ(x->Nested()->As<ColumnInt64>()->At(0), std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(x->Nested()->As<ColumnInt64>()->At(1), std::numeric_limits<int64_t>::max());
+    for (size_t i = 2; i < x->Size(); ++i) {
+        EXPECT_TRUE(x->IsNull(i)) << i;
+    }
+}
+
+TEST(ColumnsCase, ColumnIxJson_ExtractPathsLongRows) {
+    // Rows longer than the 64-byte chunks of the index, with escapes and strings crossing chunk boundaries.
+    std::string padding(100, 'x');
+    std::string json = R"({"pad": ")" + padding + R"(\\\"}", "a": {"b": ")" + padding + R"(\"", "c": 42}})";
+
+    ColumnIxJson col;
+    for (size_t i = 0; i < 3; ++i) {
+        col.Append(json);
+        json.insert(2, " ");
+    }
+
+    const auto result = col.ExtractPaths({{"a.b", Type::CreateString()}, {"a.c", Type::CreateSimple<int64_t>()}});
+    for (size_t i = 0; i < col.Size(); ++i) {
+        EXPECT_EQ(result[0]->As<ColumnString>()->At(i), padding + "\"");
+        EXPECT_EQ(result[1]->As<ColumnInt64>()->At(i), 42);
+    }
+}
+
+namespace {
+
+// Native format of semi-structured columns, as written by ClickHouse.
+struct WireBytes {
+    Buffer data;
+
+    WireBytes& UInt64(uint64_t value) { return Fixed(value); }
+
+    WireBytes& UInt32(uint32_t value) { return Fixed(value); }
+
+    template <typename T>
+    WireBytes& Fixed(T value) {
+        const auto * bytes = reinterpret_cast<const uint8_t *>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(value));
+        return *this;
+    }
+
+    WireBytes& VarUInt(uint64_t value) {
+        for (; value >= 0x80; value >>= 7) {
+            data.push_back(static_cast<uint8_t>(value | 0x80));
+        }
+        data.push_back(static_cast<uint8_t>(value));
+        return *this;
+    }
+
+    WireBytes& Bytes(std::initializer_list<uint8_t> values) {
+        data.insert(data.end(), values);
+        return *this;
+    }
+
+    WireBytes& String(std::string_view value) {
+        data.push_back(static_cast<uint8_t>(value.size()));
+        data.insert(data.end(), value.begin(), value.end());
+        return *this;
+    }
+};
+
+Buffer SaveColumn(Column & col) {
+    Buffer buffer;
+    BufferOutput output(&buffer);
+    col.Save(&output);
+    return buffer;
+}
+
+ColumnRef LoadColumn(const std::string & type, const Buffer & buffer, size_t rows) {
+    CreateColumnByTypeSettings settings;
+    settings.native_json = true;
+    auto col = CreateColumnByType(type, settings);
+    ArrayInput input(buffer.data(), buffer.size());
+    EXPECT_TRUE(col->Load(&input, rows));
+    EXPECT_TRUE(input.Exhausted());
+    return col;
+}
+
+}
+
+TEST(ColumnsCase, ColumnVariant_Load) {
+    const auto data = WireBytes{}
+        .UInt64(0)                  // basic mode of discriminators
+        .Bytes({0, 255, 1, 0})      // "a", NULL, 42, "b"
+        .String("a").String("b")
+        .UInt64(42)
+        .data;
+
+    const auto col = LoadColumn("Variant(String, UInt64)", data, 4)->As<ColumnVariant>();
+    ASSERT_NE(col, nullptr);
+    ASSERT_EQ(col->Size(), 4u);
+    EXPECT_EQ(col->GetVariantCount(), 2u);
+    EXPECT_TRUE(col->IsNull(1));
+    EXPECT_EQ(col->GetDiscriminator(2), 1);
+    EXPECT_EQ(col->GetVariant(0)->As<ColumnString>()->At(col->GetVariantOffset(3)), "b");
+    EXPECT_EQ(col->GetVariant(1)->As<ColumnUInt64>()->At(col->GetVariantOffset(2)), 42u);
+    EXPECT_EQ(col->GetItem(0).get<std::string_view>(), "a");
+    EXPECT_EQ(col->GetItem(1).type, Type::Void);
+
+    EXPECT_EQ(SaveColumn(*col), data);
+
+    const auto slice = col->Slice(1, 3)->As<ColumnVariant>();
+    ASSERT_EQ(slice->Size(), 3u);
+    EXPECT_EQ(slice->GetVariant(0)->Size(), 1u);
+    EXPECT_EQ(slice->GetItem(2).get<std::string_view>(), "b");
+    EXPECT_EQ(slice->GetItem(1).get<uint64_t>(), 42u);
+
+    // Compact mode: granule of 3 rows of discriminator 1 and granule of 1 row as is.
+    const auto compact = WireBytes{}
+        .UInt64(1)
+        .Bytes({3, 1, 1}).Bytes({1, 0, 255})
+        .UInt64(1).UInt64(2).UInt64(3)
+        .data;
+    const auto loaded = LoadColumn("Variant(String, UInt64)", compact, 4)->As<ColumnVariant>();
+    EXPECT_EQ(loaded->GetItem(2).get<uint64_t>(), 3u);
+    EXPECT_TRUE(loaded->IsNull(3));
+}
+
+TEST(ColumnsCase, ColumnVariant_Append) {
+    ColumnVariant col({std::make_shared<ColumnString>(), std::make_shared<ColumnUInt64>()});
+    EXPECT_EQ(col.GetType().GetName(), "Variant(String, UInt64)");
+
+    col.AppendToVariant(1)->As<ColumnUInt64>()->Append(1);
+    col.AppendNull();
+    col.AppendToVariant(0)->As<ColumnString>()->Append("x");
+    col.AppendToVariant(1)->As<ColumnUInt64>()->Append(2);
+
+    auto other = col.CloneEmpty()->As<ColumnVariant>();
+    other->AppendToVariant(1)->As<ColumnUInt64>()->Append(3);
+    col.Append(other);
+
+    ASSERT_EQ(col.Size(), 5u);
+    EXPECT_EQ(col.GetVariantOffset(4), 2u);
+    EXPECT_EQ(col.GetItem(4).get<uint64_t>(), 3u);
+
+    EXPECT_THROW(col.AppendToVariant(2), ValidationError);
+    EXPECT_THROW(col.Append(std::make_shared<ColumnVariant>(std::vector<ColumnRef>{std::make_shared<ColumnString>()})), ValidationError);
+
+    // Value was not appended to the variant column.
+    col.AppendToVariant(0);
+    EXPECT_THROW(SaveColumn(col), ValidationError);
+}
+
+TEST(ColumnsCase, ColumnDynamic_Load) {
+    const auto data = WireBytes{}
+        .UInt64(2)                          // structure version
+        .Bytes({2}).String("String").String("Int64")
+        .UInt64(0)                          // basic mode of discriminators
+        .Bytes({0, 2, 255})                 // variants are Int64, SharedVariant, String
+        .UInt64(7)
+        .String("x")
+        .data;
+
+    const auto col = LoadColumn("Dynamic", data, 3)->As<ColumnDynamic>();
+    ASSERT_NE(col, nullptr);
+    EXPECT_EQ(col->GetVariantNames(), (std::vector<std::string>{"Int64", "SharedVariant", "String"}));
+    EXPECT_EQ(col->FindVariant("String"), 2);
+    EXPECT_EQ(col->FindVariant("UInt8"), ColumnVariant::NullDiscriminator);
+    EXPECT_EQ(col->GetItem(0).get<int64_t>(), 7);
+    EXPECT_EQ(col->GetItem(1).get<std::string_view>(), "x");
+    EXPECT_EQ(col->GetItem(2).type, Type::Void);
+
+    // Written in version 1 with max_types, understood by all servers supporting Dynamic.
+    const auto expected = WireBytes{}
+        .UInt64(1)
+        .Bytes({32, 2}).String("Int64").String("String")
+        .UInt64(0)
+        .Bytes({0, 2, 255})
+        .UInt64(7)
+        .String("x")
+        .data;
+    EXPECT_EQ(SaveColumn(*col), expected);
+}
+
+TEST(ColumnsCase, ColumnDynamic_AppendToType) {
+    ColumnDynamic col(2);
+    EXPECT_EQ(col.GetType().GetName(), "Dynamic(max_types=2)");
+
+    col.AppendToType("String")->As<ColumnString>()->Append("a");
+    col.AppendNull();
+    col.AppendToType("Int64")->As<ColumnInt64>()->Append(-1);
+    col.AppendToType("String")->As<ColumnString>()->Append("b");
+
+    // Adding Int64 moved String after it.
+    EXPECT_EQ(col.GetVariantNames(), (std::vector<std::string>{"Int64", "SharedVariant", "String"}));
+    EXPECT_EQ(col.GetItem(0).get<std::string_view>(), "a");
+    EXPECT_EQ(col.GetItem(2).get<int64_t>(), -1);
+    EXPECT_EQ(col.GetItem(3).get<std::string_view>(), "b");
+    EXPECT_THROW(col.AppendToType("UInt8"), ValidationError);
+
+    ColumnDynamic other;
+    other.AppendToType("Float64")->As<ColumnFloat64>()->Append(0.5);
+    other.AppendToType("String")->As<ColumnString>()->Append("c");
+
+    ColumnDynamic merged;
+    merged.Append(col.Slice(0, 4));
+    merged.Append(other.Slice(0, 2));
+    ASSERT_EQ(merged.Size(), 6u);
+    EXPECT_EQ(merged.GetItem(3).get<std::string_view>(), "b");
+    EXPECT_EQ(merged.GetItem(4).get<double>(), 0.5);
+    EXPECT_EQ(merged.GetItem(5).get<std::string_view>(), "c");
+
+    const auto loaded = LoadColumn("Dynamic", SaveColumn(merged), merged.Size())->As<ColumnDynamic>();
+    EXPECT_EQ(loaded->GetVariantNames(), merged.GetVariantNames());
+    for (size_t i = 0; i < merged.Size(); ++i) {
+        EXPECT_EQ(loaded->GetVariantColumn()->GetDiscriminator(i), merged.GetVariantColumn()->GetDiscriminator(i)) << " at pos: " << i;
+    }
+}
+
+TEST(ColumnsCase, ColumnJSON_Load) {
+    const auto data = WireBytes{}
+        .UInt64(2)                              // serialization version
+        .Bytes({1}).String("c")                 // dynamic paths
+        .UInt64(2).Bytes({1}).String("String")  // prefix of Dynamic of path "c"
+        .UInt64(0)
+        .UInt32(1).UInt32(2)                    // typed path "a.b"
+        .Bytes({1, 255}).String("hi")           // dynamic path "c": "hi", NULL
+        .UInt64(1).UInt64(1)                    // shared data: single path in the first row
+        .String("d").String("\x0a\x05")
+        .data;
+
+    const auto col = LoadColumn("JSON(a.b UInt32)", data, 2)->As<ColumnJSON>();
+    ASSERT_NE(col, nullptr);
+    ASSERT_EQ(col->Size(), 2u);
+    EXPECT_EQ(col->GetTypedPath("a.b")->As<ColumnUInt32>()->At(1), 2u);
+    EXPECT_EQ(col->GetTypedPath("c"), nullptr);
+
+    const auto c = col->GetDynamicPath("c");
+    ASSERT_NE(c, nullptr);
+    EXPECT_EQ(c->GetItem(0).get<std::string_view>(), "hi");
+    EXPECT_EQ(c->GetItem(1).type, Type::Void);
+
+    const auto shared = col->GetSharedData()->As<ColumnArray>();
+    EXPECT_EQ(shared->GetOffsets()[0], 1u);
+    EXPECT_EQ(shared->GetOffsets()[1], 1u);
+
+    // JSON sent as text.
+    const auto text = WireBytes{}.UInt64(1).String(R"({"a":1})").data;
+    const auto text_col = LoadColumn("JSON", text, 1)->As<ColumnJSON>();
+    ASSERT_NE(text_col->GetText(), nullptr);
+    EXPECT_EQ(text_col->GetText()->At(0), R"({"a":1})");
+    EXPECT_EQ(SaveColumn(*text_col), text);
+
+    EXPECT_THROW(LoadColumn("JSON", WireBytes{}.UInt64(3).data, 1), UnimplementedError);
+}
+
+TEST(ColumnsCase, ColumnJSON_Build) {
+    ColumnJSON col({{"id", std::make_shared<ColumnUInt64>()}}, 2);
+    EXPECT_EQ(col.GetType().GetName(), "JSON(max_dynamic_paths=2, id UInt64)");
+
+    col.GetTypedPath("id")->As<ColumnUInt64>()->Append(1);
+    col.CommitRow();
+
+    auto name = col.AddDynamicPath("user.name");
+    col.GetTypedPath("id")->As<ColumnUInt64>()->Append(2);
+    name->AppendToType("String")->As<ColumnString>()->Append("x");
+    col.CommitRow();
+
+    EXPECT_THROW(col.CommitRow(), ValidationError);
+    EXPECT_THROW(col.AddDynamicPath("id"), ValidationError);
+    col.AddDynamicPath("a");
+    EXPECT_THROW(col.AddDynamicPath("b"), ValidationError);
+
+    ASSERT_EQ(col.Size(), 2u);
+    EXPECT_EQ(name->Size(), 2u);
+    EXPECT_EQ(name->GetItem(0).type, Type::Void);
+
+    const auto loaded = LoadColumn(col.GetType().GetName(), SaveColumn(col), col.Size())->As<ColumnJSON>();
+    ASSERT_EQ(loaded->Size(), 2u);
+    ASSERT_EQ(loaded->GetDynamicPaths().size(), 2u);
+    EXPECT_EQ(loaded->GetDynamicPaths()[0].first, "a");
+    EXPECT_EQ(loaded->GetDynamicPath("user.name")->GetItem(1).get<std::string_view>(), "x");
+    EXPECT_EQ(loaded->GetTypedPath("id")->As<ColumnUInt64>()->At(1), 2u);
+
+    auto appended = col.CloneEmpty()->As<ColumnJSON>();
+    appended->Append(loaded->Slice(1, 1));
+    appended->Append(loaded);
+    ASSERT_EQ(appended->Size(), 3u);
+    EXPECT_EQ(appended->GetDynamicPath("user.name")->GetItem(0).get<std::string_view>(), "x");
+    EXPECT_EQ(appended->GetDynamicPath("a")->Size(), 3u);
+}
+
+TEST(ColumnsCase, ColumnSparse_Load) {
+    constexpr uint64_t end_of_granule = 1ULL << 62;
+    const auto data = WireBytes{}
+        .VarUInt(2).VarUInt(0).VarUInt(3)   // values at rows 2, 3 and 7
+        .VarUInt(1 | end_of_granule)        // followed by one default row
+        .UInt32(5).UInt32(6).UInt32(7)
+        .data;
+
+    ColumnRef col = std::make_shared<ColumnUInt32>();
+    const auto kinds = WireBytes{}.Bytes({1}).data;
+    ArrayInput kinds_input(kinds.data(), kinds.size());
+    ASSERT_TRUE(LoadSerializationKinds(&kinds_input, &col));
+
+    ArrayInput input(data.data(), data.size());
+    ASSERT_TRUE(col->Load(&input, 9));
+    EXPECT_TRUE(input.Exhausted());
+
+    const auto sparse = col->As<ColumnSparse>();
+    ASSERT_NE(sparse, nullptr);
+    EXPECT_EQ(sparse->GetType().GetName(), "UInt32");
+    ASSERT_EQ(sparse->Size(), 9u);
+    EXPECT_EQ(sparse->GetValues()->Size(), 3u);
+    EXPECT_TRUE(sparse->IsDefault(0));
+    EXPECT_FALSE(sparse->IsDefault(7));
+    EXPECT_EQ(sparse->GetItem(3).get<uint32_t>(), 6u);
+    EXPECT_EQ(sparse->GetItem(8).get<uint32_t>(), 0u);
+
+    const auto dense = sparse->Densify()->As<ColumnUInt32>();
+    ASSERT_NE(dense, nullptr);
+    const std::vector<uint32_t> expected{0, 0, 5, 6, 0, 0, 0, 7, 0};
+    ASSERT_EQ(dense->Size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(dense->At(i), expected[i]) << i;
+    }
+
+    EXPECT_EQ(SaveColumn(*sparse), data);
+
+    const auto slice = sparse->Slice(3, 5)->As<ColumnSparse>();
+    ASSERT_EQ(slice->Size(), 5u);
+    EXPECT_EQ(slice->GetOffsets().size(), 2u);
+    EXPECT_EQ(slice->GetItem(4).get<uint32_t>(), 7u);
+}
+
+TEST(ColumnsCase, ColumnSparse_FromDense) {
+    auto strings = std::make_shared<ColumnString>(std::vector<std::string>{"", "a", "", "", "b", "c"});
+    const auto sparse = ColumnSparse::FromDense(strings);
+    ASSERT_EQ(sparse->Size(), 6u);
+    EXPECT_EQ(sparse->GetValues()->Size(), 3u);
+
+    sparse->AppendDefaults(2);
+    sparse->AppendToValues()->As<ColumnString>()->Append("d");
+    sparse->Append(sparse->Slice(0, 2));
+    ASSERT_EQ(sparse->Size(), 11u);
+
+    auto reloaded = sparse->CloneEmpty();
+    const auto saved = SaveColumn(*sparse);
+    ArrayInput input(saved.data(), saved.size());
+    ASSERT_TRUE(reloaded->Load(&input, sparse->Size()));
+
+    const auto dense = reloaded->As<ColumnSparse>()->Densify()->As<ColumnString>();
+    const std::vector<std::string> expected{"", "a", "", "", "b", "c", "", "", "d", "", "a"};
+    ASSERT_EQ(dense->Size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(dense->At(i), expected[i]) << i;
+    }
+
+    // Default of Nullable is NULL, not zero.
+    auto nullable = std::make_shared<ColumnNullable>(
+            std::make_shared<ColumnUInt64>(std::vector<uint64_t>{0, 1, 0}),
+            std::make_shared<ColumnUInt8>(std::vector<uint8_t>{0, 1, 1}));
+    const auto sparse_nullable = ColumnSparse::FromDense(nullable);
+    EXPECT_EQ(sparse_nullable->GetOffsets().size(), 1u);
+    const auto dense_nullable = sparse_nullable->Densify()->As<ColumnNullable>();
+    ASSERT_EQ(dense_nullable->Size(), 3u);
+    EXPECT_FALSE(dense_nullable->IsNull(0));
+    EXPECT_TRUE(dense_nullable->IsNull(1));
+    EXPECT_TRUE(dense_nullable->IsNull(2));
+}
+
+TEST(ColumnsCase, ColumnSparse_SerializationKinds) {
+    auto tuple = std::make_shared<ColumnTuple>(std::vector<ColumnRef>{
+        std::make_shared<ColumnString>(),
+        std::make_shared<ColumnSparse>(std::make_shared<ColumnUInt64>()),
+    });
+    EXPECT_TRUE(HasCustomSerialization(*tuple));
+    EXPECT_FALSE(HasCustomSerialization(ColumnUInt64()));
+
+    Buffer kinds;
+    BufferOutput output(&kinds);
+    SaveSerializationKinds(&output, *tuple);
+    output.Flush();
+    EXPECT_EQ(kinds, (Buffer{0, 0, 1}));
+
+    ColumnRef loaded = CreateColumnByType("Tuple(String, UInt64)");
+    ArrayInput input(kinds.data(), kinds.size());
+    ASSERT_TRUE(LoadSerializationKinds(&input, &loaded));
+    const auto loaded_tuple = loaded->As<ColumnTuple>();
+    ASSERT_NE(loaded_tuple, nullptr);
+    EXPECT_EQ(loaded_tuple->At(0)->As<ColumnSparse>(), nullptr);
+    EXPECT_NE(loaded_tuple->At(1)->As<ColumnSparse>(), nullptr);
+
+    const auto unsupported = WireBytes{}.Bytes({2}).data;
+    ArrayInput unsupported_input(unsupported.data(), unsupported.size());
+    EXPECT_THROW(LoadSerializationKinds(&unsupported_input, &loaded), UnimplementedError);
+}
+
+TEST(ColumnsCase, ColumnAggregateFunction_Load) {
+    const auto data = WireBytes{}
+        .Bytes({1}).Fixed<int32_t>(-5)      // min of -5
+        .Bytes({0})                         // no value
+        .data;
+
+    const auto col = LoadColumn("AggregateFunction(min, Int32)", data, 2)->As<ColumnAggregateFunction>();
+    ASSERT_NE(col, nullptr);
+    ASSERT_EQ(col->Size(), 2u);
+    EXPECT_EQ(col->At<MinState<int32_t>>(0).GetValue(), -5);
+    EXPECT_EQ(col->At<MinState<int32_t>>(1).GetValue(), std::nullopt);
+    EXPECT_THROW(col->At<MaxState<int32_t>>(0), ValidationError);
+    EXPECT_THROW(col->At<MinState<int64_t>>(0), ValidationError);
+    EXPECT_EQ(SaveColumn(*col), data);
+
+    ColumnAggregateFunction avg(Type::CreateAggregateFunction("avg", {Type::CreateSimple<uint16_t>()}));
+    AvgState<uint64_t> state;
+    state.Add(1);
+    state.Add(4);
+    avg.Append(state);
+    EXPECT_EQ(Buffer(avg.GetSerializedState(0).begin(), avg.GetSerializedState(0).end()),
+            WireBytes{}.UInt64(5).Bytes({2}).data);
+    EXPECT_THROW(avg.Append(SumState<uint64_t>{}), ValidationError);
+    EXPECT_THROW(avg.AppendSerializedState(std::string_view("\x05\x00", 2)), ValidationError);
+
+    EXPECT_THROW(ColumnAggregateFunction(Type::CreateAggregateFunction("argMax", {})), UnimplementedError);
+}
+
+TEST(ColumnsCase, ColumnAggregateFunction_Append) {
+    ColumnAggregateFunction col(Type::CreateAggregateFunction("sum", {Type::CreateSimple<int8_t>()}));
+    EXPECT_EQ(col.GetType().GetName(), "AggregateFunction(sum, Int8)");
+
+    CountState count;
+    EXPECT_THROW(col.Append(count), ValidationError);
+
+    for (int64_t i = 0; i < 3; ++i) {
+        SumState<int64_t> state;
+        state.Add(i);
+        state.Add(-10);
+        col.Append(state);
+    }
+
+    auto other = col.CloneEmpty();
+    other->Append(col.Slice(1, 2));
+    ASSERT_EQ(other->Size(), 2u);
+    EXPECT_EQ(other->As<ColumnAggregateFunction>()->At<SumState<int64_t>>(1).GetSum(), -8);
+
+    const auto loaded = LoadColumn(col.GetType().GetName(), SaveColumn(col), col.Size())->As<ColumnAggregateFunction>();
+    ASSERT_EQ(loaded->Size(), 3u);
+    EXPECT_EQ(loaded->At<SumState<int64_t>>(0).GetSum(), -10);
+
+    // Columns are appended as columns, not as states.
+    col.Append(loaded);
+    EXPECT_EQ(col.Size(), 6u);
+}
+
+TEST(ColumnsCase, UniqState) {
+    UniqState state;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        state.Add(i % 100);
+    }
+    EXPECT_EQ(state.GetHashCount(), 100u);
+
+    UniqState strings;
+    strings.Add(std::string_view("a"));
+    strings.Add(std::string_view("b"));
+    strings.Add(std::string_view("a"));
+    EXPECT_EQ(strings.GetHashCount(), 2u);
+
+    // Hashes with non-zero low bits are dropped once there are too many of them.
+    UniqState large;
+    for (uint64_t i = 0; i < 200000; ++i) {
+        large.Add(i);
+    }
+    EXPECT_LE(large.GetHashCount(), 65536u);
+    EXPECT_GT(large.GetHashCount(), 200000u / 8);
+
+    large.Merge(state);
+    ColumnAggregateFunction col(Type::CreateAggregateFunction("uniq", {Type::CreateSimple<uint64_t>()}));
+    col.Append(large);
+    col.Append(state);
+
+    const auto loaded = LoadColumn(col.GetType().GetName(), SaveColumn(col), col.Size())->As<ColumnAggregateFunction>();
+    EXPECT_EQ(loaded->At<UniqState>(0).GetHashCount(), large.GetHashCount());
+    EXPECT_EQ(loaded->GetSerializedState(1), col.GetSerializedState(1));
+}
+
+TEST(ColumnsCase, UniqCombinedState) {
+    UniqCombinedState<> state;
+    for (uint32_t i = 0; i < 100; ++i) {
+        state.Add(i % 16);
+    }
+    EXPECT_FALSE(state.IsApproximate());
+    EXPECT_EQ(state.GetHashCount(), 16u);
+
+    // 16 hashes are kept in order of insertion, more in a hash set and at most 2^(17 - 4) of them.
+    const auto serialized = [](const auto & s) {
+        Buffer buffer;
+        BufferOutput output(&buffer);
+        s.Serialize(output);
+        output.Flush();
+        return buffer;
+    };
+    EXPECT_EQ(serialized(state).size(), 2u + 16 * 4);
+    EXPECT_EQ(serialized(state)[0], 1u);
+
+    UniqCombinedState<> medium;
+    for (uint32_t i = 0; i < 8192; ++i) {
+        medium.Add(i);
+    }
+    EXPECT_FALSE(medium.IsApproximate());
+    EXPECT_EQ(medium.GetHashCount(), 8192u);
+    EXPECT_EQ(serialized(medium)[0], 2u);
+
+    // A full set is replaced by HyperLogLog counter of 2^17 5-bit ranks.
+    UniqCombinedState<> large = medium;
+    large.Add(uint32_t(0));
+    EXPECT_TRUE(large.IsApproximate());
+    EXPECT_EQ(serialized(large)[0], 3u);
+    EXPECT_EQ(serialized(large).size(), 1u + (1u << 17) * 5 / 8);
+
+    // Hashes of strings are 64-bit, with 6-bit ranks and at most 2^(17 - 5) of them in the set.
+    UniqCombinedState<uint64_t> strings;
+    for (size_t i = 0; i < 4096; ++i) {
+        strings.Add(std::string_view(std::to_string(i)));
+    }
+    EXPECT_FALSE(strings.IsApproximate());
+    strings.Add(std::string_view("x"));
+    EXPECT_TRUE(strings.IsApproximate());
+    EXPECT_EQ(serialized(strings).size(), 1u + (1u << 17) * 6 / 8);
+
+    // Merging into a smaller container converts it.
+    UniqCombinedState<> merged = state;
+    merged.Merge(large);
+    EXPECT_TRUE(merged.IsApproximate());
+    EXPECT_EQ(serialized(merged), serialized(large));
+
+    ColumnAggregateFunction col(Type::CreateAggregateFunction("uniqCombined", {Type::CreateSimple<uint32_t>()}));
+    col.Append(state);
+    col.Append(medium);
+    col.Append(large);
+    EXPECT_THROW(col.Append(strings), ValidationError);
+    EXPECT_THROW(col.Append(UniqCombinedState<uint32_t, 15>{}), ValidationError);
+
+    const auto loaded = LoadColumn(col.GetType().GetName(), SaveColumn(col), col.Size())->As<ColumnAggregateFunction>();
+    ASSERT_EQ(loaded->Size(), 3u);
+    EXPECT_EQ(loaded->At<UniqCombinedState<>>(0).GetHashCount(), 16u);
+    EXPECT_EQ(loaded->At<UniqCombinedState<>>(1).GetHashCount(), 8192u);
+    EXPECT_EQ(serialized(loaded->At<UniqCombinedState<>>(1)), serialized(medium));
+    EXPECT_EQ(serialized(loaded->At<UniqCombinedState<>>(2)), serialized(large));
+
+    ColumnAggregateFunction precise(Type::CreateAggregateFunction("uniqCombined", {Type::CreateSimple<uint64_t>()}, {"20"}));
+    EXPECT_THROW(precise.Append(state), ValidationError);
+    precise.Append(UniqCombinedState<uint32_t, 20>{});
+
+    ColumnAggregateFunction strings_col(Type::CreateAggregateFunction("uniqCombined64", {Type::CreateString()}));
+    strings_col.Append(strings);
+    EXPECT_EQ(LoadColumn(strings_col.GetType().GetName(), SaveColumn(strings_col), 1)->As<ColumnAggregateFunction>()
+            ->GetSerializedState(0), strings_col.GetSerializedState(0));
+
+    EXPECT_THROW(ColumnAggregateFunction(Type::CreateAggregateFunction("uniqCombined", {Type::CreateString()}, {"21"})), UnimplementedError);
+    EXPECT_THROW(ColumnAggregateFunction(Type::CreateAggregateFunction("uniqCombined", {Type::CreateString()}, {"273"})), UnimplementedError);
+    EXPECT_THROW(ColumnAggregateFunction(Type::CreateAggregateFunction("uniqCombined", {Type::CreateString()}, {"1x"})), UnimplementedError);
+}
+
+TEST(ColumnsCase, TDigestState) {
+    TDigestState state;
+    for (int i = 0; i < 100000; ++i) {
+        state.Add(static_cast<float>(i % 1000));
+    }
+    state.Add(std::nanf(""));
+
+    TDigestState other;
+    other.Add(5000);
+    state.Merge(other);
+    state.Compress();
+
+    const auto & centroids = state.GetCentroids();
+    EXPECT_LE(centroids.size(), 2048u);
+    double count = 0;
+    for (size_t i = 0; i < centroids.size(); ++i) {
+        count += centroids[i].count;
+        if (i) {
+            EXPECT_LE(centroids[i - 1].mean, centroids[i].mean);
+        }
+    }
+    EXPECT_DOUBLE_EQ(count, 100001);
+    EXPECT_EQ(centroids.back().mean, 5000);
+
+    ColumnAggregateFunction col(Type::CreateAggregateFunction("quantileTDigest", {Type::CreateSimple<double>()}, {"0.9"}));
+    EXPECT_EQ(col.GetType().GetName(), "AggregateFunction(quantileTDigest(0.9), Float64)");
+    col.Append(state);
+    const auto loaded = col.At<TDigestState>(0);
+    EXPECT_EQ(loaded.GetCentroids().size(), centroids.size());
+}
+
+TEST(ColumnsCase, AsPtr) {
+    const ColumnRef nullable = std::make_shared<ColumnNullableT<ColumnString>>();
+    EXPECT_EQ(nullable->AsPtr<ColumnNullable>(), nullable->As<ColumnNullable>().get());
+    EXPECT_EQ(nullable->AsPtr<ColumnNullableT<ColumnString>>(), nullable.get());
+    EXPECT_EQ(nullable->AsPtr<ColumnString>(), nullptr);
+    EXPECT_EQ(nullable->AsPtr<ColumnArray>(), nullptr);
+    EXPECT_EQ(&nullable->AsRef<Column>(), nullable.get());
+    EXPECT_THROW(nullable->AsRef<ColumnUInt8>(), ValidationError);
+
+    // Sparse column has the type of its values, but is not of their class.
+    const ColumnRef sparse = std::make_shared<ColumnSparse>(std::make_shared<ColumnNullable>(
+            std::make_shared<ColumnString>(), std::make_shared<ColumnUInt8>()));
+    EXPECT_EQ(sparse->AsPtr<ColumnNullable>(), nullptr);
+    EXPECT_EQ(sparse->AsPtr<ColumnSparse>(), sparse.get());
+
+    const ColumnRef uint8 = std::make_shared<ColumnUInt8>();
+    const Column & const_column = *uint8;
+    EXPECT_EQ(const_column.AsPtr<ColumnUInt8>(), uint8.get());
+    EXPECT_EQ(const_column.AsPtr<ColumnInt8>(), nullptr);
+}
+
+TEST(ColumnsCase, VisitColumn) {
+    const auto name_of = [](const Column & column) {
+        return VisitColumn(column, [](const auto & col) -> std::string {
+            using ColumnType = std::decay_t<decltype(col)>;
+            if constexpr (std::is_same_v<ColumnType, ColumnUInt64>) {
+                return "UInt64:" + std::to_string(col.Size());
+            } else if constexpr (std::is_same_v<ColumnType, ColumnString>) {
+                return "String:" + std::to_string(col.Size());
+            } else if constexpr (std::is_same_v<ColumnType, ColumnArray>) {
+                return "Array";
+            } else if constexpr (std::is_same_v<ColumnType, ColumnLowCardinality>) {
+                return "LowCardinality";
+            } else if constexpr (std::is_same_v<ColumnType, ColumnDecimal>) {
+                return "Decimal";
+            } else if constexpr (std::is_same_v<ColumnType, Column>) {
+                return "Column";
+            } else {
+                return "Other";
+            }
+        });
+    };
+
+    EXPECT_EQ(name_of(ColumnUInt64({1, 2})), "UInt64:2");
+    EXPECT_EQ(name_of(ColumnString(std::vector<std::string>{"a"})), "String:1");
+    EXPECT_EQ(name_of(ColumnArrayT<ColumnUInt8>()), "Array");
+    EXPECT_EQ(name_of(*CreateColumnByType("LowCardinality(String)")), "LowCardinality");
+    EXPECT_EQ(name_of(*CreateColumnByType("Decimal64(3)")), "Decimal");
+    EXPECT_EQ(name_of(ColumnDate()), "Other");
+    EXPECT_EQ(name_of(ColumnSparse(std::make_shared<ColumnUInt64>())), "Column");
+
+    // Visitor gets mutable columns of non-const ones.
+    ColumnRef column = std::make_shared<ColumnUInt32>();
+    VisitColumn(*column, [](auto & col) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(col)>, ColumnUInt32>) {
+            col.Append(7);
+        }
+    });
+    ASSERT_EQ(column->Size(), 1u);
+    EXPECT_EQ(column->AsRef<ColumnUInt32>().At(0), 7u);
+}
@@ -39,6 +39,13 @@ TEST(ItemView, StorableTypes) {
     TEST_ITEMVIEW_TYPE_VALUES(Type::Code::UInt16, uint16_t);
     TEST_ITEMVIEW_TYPE_VALUES(Type::Code::UInt32, uint32_t);
     TEST_ITEMVIEW_TYPE_VALUES(Type::Code::UInt64, uint64_t);
+    TEST_ITEMVIEW_TYPE_VALUES(Type::Code::UInt128, absl::uint128);
+
+    TEST_ITEMVIEW_TYPE_VALUE(Type::Code::Int256, Int256, -1);
+    TEST_ITEMVIEW_TYPE_VALUE(Type::Code::Int256, Int256, Int256::FromLimbs({1, 2, 3, 4}));
+    TEST_ITEMVIEW_TYPE_VALUE(Type::Code::UInt256, UInt256, UInt256::FromLimbs({1, 2, 3, 4}));
+    TEST_ITEMVIEW_TYPE_VALUE(Type::Code::Decimal256, Int256, Int256::FromLimbs({1, 2, 3, 4}));
+    TEST_ITEMVIEW_TYPE_VALUE(Type::Code::BFloat16, BFloat16, BFloat16(1.5f));
 
     TEST_ITEMVIEW_TYPE_VALUES(Type::Code::Float32, float);
     TEST_ITEMVIEW_TYPE_VALUE(Type::Code::Float32, float, 0.5);
@@ -0,0 +1,257 @@
+#include <clickhouse/native.h>
+#include <clickhouse/columns/array.h>
+#include <clickhouse/columns/lowcardinality.h>
+#include <clickhouse/columns/nullable.h>
+#include <clickhouse/columns/numeric.h>
+#include <clickhouse/columns/sparse.h>
+#include <clickhouse/columns/string.h>
+#include <clickhouse/columns/tuple.h>
+#include <clickhouse/base/wire_format.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+namespace {
+using namespace clickhouse;
+
+Block MakeBlock(size_t rows, const std::string& prefix) {
+    auto numbers = std::make_shared<ColumnUInt64>();
+    auto strings = std::make_shared<ColumnString>();
+    auto nullable = std::make_shared<ColumnNullableT<ColumnString>>();
+    auto arrays = std::make_shared<ColumnArrayT<ColumnUInt32>>();
+    auto lc = std::make_shared<ColumnLowCardinalityT<ColumnString>>();
+
+    for (size_t i = 0; i < rows; ++i) {
+        numbers->Append(i * 1000);
+        strings->Append(prefix + std::to_string(i));
+        if (i % 3) {
+            nullable->Append(prefix + std::string(i, 'x'));
+        } else {
+            nullable->Append(std::nullopt);
+        }
+        arrays->Append(std::vector<uint32_t>(i % 4, static_cast<uint32_t>(i)));
+        lc->Append(prefix + std::to_string(i % 5));
+    }
+
+    Block block;
+    block.AppendColumn("number", numbers);
+    block.AppendColumn("string", strings);
+    block.AppendColumn("nullable", nullable);
+    block.AppendColumn("array", arrays);
+    block.AppendColumn("lc", lc);
+    return block;
+}
+
+Buffer Serialize(Column& column) {
+    Buffer buffer;
+    BufferOutput output(&buffer);
+    column.Save(&output);
+    output.Flush();
+    return buffer;
+}
+
+void ExpectSameBlocks(const Block& expected, const Block& actual) {
+    ASSERT_EQ(expected.GetColumnCount(), actual.GetColumnCount());
+    ASSERT_EQ(expected.GetRowCount(), actual.GetRowCount());
+
+    for (size_t i = 0; i < expected.GetColumnCount(); ++i) {
+        EXPECT_EQ(expected.GetColumnName(i), actual.GetColumnName(i));
+        EXPECT_EQ(expected[i]->Type()->GetName(), actual[i]->Type()->GetName());
+        EXPECT_EQ(Serialize(*expected[i]), Serialize(*actual[i])) << "column " << expected.GetColumnName(i);
+    }
+}
+
+class NativeFileCase : public testing::TestWithParam<CompressionMethod> {
+protected:
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    const std::string path_ = ::testing::TempDir() + "clickhouse_cpp_native_ut.native";
+};
+
+}
+
+TEST(NativeTest, WriteAndReadBlock) {
+    const auto block = MakeBlock(10, "value");
+
+    for (uint64_t revision : {uint64_t(0), uint64_t(54454)}) {
+        Buffer buffer;
+        BufferOutput output(&buffer);
+        WriteNativeBlock(output, block, revision);
+
+        ArrayInput input(buffer.data(), buffer.size());
+        Block result;
+        ASSERT_TRUE(ReadNativeBlock(input, &result, revision));
+        EXPECT_TRUE(input.Exhausted());
+        ExpectSameBlocks(block, result);
+    }
+}
+
+TEST(NativeTest, ReadSparseColumns) {
+    auto numbers = std::make_shared<ColumnUInt64>(std::vector<uint64_t>{0, 0, 7, 0, 0, 0, 9, 0});
+    auto strings = std::make_shared<ColumnString>(std::vector<std::string>{"", "a", "", "", "", "", "", "b"});
+    auto tuple = std::make_shared<ColumnTuple>(std::vector<ColumnRef>{ColumnSparse::FromDense(strings), numbers});
+
+    Block block;
+    block.AppendColumn("sparse", ColumnSparse::FromDense(numbers));
+    block.AppendColumn("tuple", tuple);
+
+    Buffer buffer;
+    BufferOutput output(&buffer);
+    WriteNativeBlock(output, block, 54454);
+
+    // Sparse columns are read as their dense classes by default.
+    {
+        ArrayInput input(buffer.data(), buffer.size());
+        Block result;
+        ASSERT_TRUE(ReadNativeBlock(input, &result, 54454));
+        const auto dense = result[0]->AsPtr<ColumnUInt64>();
+        ASSERT_NE(nullptr, dense);
+        EXPECT_EQ(numbers->GetWritableData(), dense->GetWritableData());
+        const auto dense_tuple = result[1]->AsPtr<ColumnTuple>();
+        ASSERT_NE(nullptr, dense_tuple);
+        ASSERT_NE(nullptr, dense_tuple->At(0)->AsPtr<ColumnString>());
+        EXPECT_EQ("b", dense_tuple->At(0)->AsPtr<ColumnString>()->At(7));
+    }
+
+    // They are kept sparse only if asked.
+    {
+        ArrayInput input(buffer.data(), buffer.size());
+        Block result;
+        ASSERT_TRUE(ReadNativeBlock(input, &result, 54454, {}, true));
+        EXPECT_NE(nullptr, result[0]->AsPtr<ColumnSparse>());
+        EXPECT_NE(nullptr, result[1]->AsStrict<ColumnTuple>()->At(0)->AsPtr<ColumnSparse>());
+        ExpectSameBlocks(block, result);
+    }
+}
+
+TEST(NativeTest, BlockInfoOnlyInProtocol) {
+    Block block;
+    block.AppendColumn("number", std::make_shared<ColumnUInt8>(std::vector<uint8_t>{1}));
+
+    Buffer file_format;
+    BufferOutput file_output(&file_format);
+    WriteNativeBlock(file_output, block);
+
+    Buffer protocol_format;
+    BufferOutput protocol_output(&protocol_format);
+    WriteNativeBlock(protocol_output, block, 54454);
+
+    // Block info takes 3 field numbers, overflows flag and bucket number; custom serialization flag follows the type.
+    EXPECT_EQ(file_format.size() + 3 + 1 + 4 + 1, protocol_format.size());
+}
+
+TEST(NativeTest, ReadBlockColumns) {
+    const auto block = MakeBlock(0, "");
+    Buffer buffer;
+    BufferOutput output(&buffer);
+    WriteNativeBlock(output, block, 54454);
+
+    ArrayInput input(buffer.data(), buffer.size());
+    std::vector<NativeColumnHeader> columns;
+    ASSERT_TRUE(ReadNativeBlockColumns(input, &columns, 54454));
+    EXPECT_TRUE(input.Exhausted());
+    ASSERT_EQ(block.GetColumnCount(), columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+        EXPECT_EQ(block.GetColumnName(i), columns[i].name);
+        EXPECT_EQ(block[i]->Type()->GetName(), columns[i].type);
+    }
+
+    // Types are kept as they are written, even if the client doesn't support them.
+    Buffer unsupported;
+    BufferOutput unsupported_output(&unsupported);
+    WireFormat::WriteUInt64(unsupported_output, 1);
+    WireFormat::WriteUInt64(unsupported_output, 0);
+    WireFormat::WriteString(unsupported_output, "x");
+    WireFormat::WriteString(unsupported_output, "Unknown( Type)");
+    unsupported_output.Flush();
+
+    ArrayInput unsupported_input(unsupported.data(), unsupported.size());
+    ASSERT_TRUE(ReadNativeBlockColumns(unsupported_input, &columns));
+    ASSERT_EQ(1u, columns.size());
+    EXPECT_EQ("x", columns[0].name);
+    EXPECT_EQ("Unknown( Type)", columns[0].type);
+
+    // Blocks with rows are rejected.
+    Buffer rows;
+    BufferOutput rows_output(&rows);
+    WriteNativeBlock(rows_output, MakeBlock(1, ""));
+    ArrayInput rows_input(rows.data(), rows.size());
+    EXPECT_THROW(ReadNativeBlockColumns(rows_input, &columns), ProtocolError);
+}
+
+TEST(NativeTest, ReadTruncatedBlock) {
+    Buffer buffer;
+    BufferOutput output(&buffer);
+    WriteNativeBlock(output, MakeBlock(10, "value"));
+
+    // Cut inside of the header, where the reader can't tell the column is incomplete.
+    ArrayInput input(buffer.data(), 10);
+    Block result;
+    EXPECT_FALSE(ReadNativeBlock(input, &result));
+}
+
+TEST_P(NativeFileCase, WriteAndRead) {
+    const std::vector<Block> blocks = {MakeBlock(10, "first"), MakeBlock(0, ""), MakeBlock(1000, "second")};
+    {
+        NativeFileWriter writer(path_, GetParam());
+        for (const auto& block : blocks) {
+            writer.Write(block);
+        }
+        writer.Close();
+        EXPECT_THROW(writer.Write(blocks[0]), ValidationError);
+    }
+
+    // Read all blocks before checking, so strings of the first block must stay valid while next ones are read.
+    NativeFileReader reader(path_, GetParam() != CompressionMethod::None);
+    std::vector<Block> result(blocks.size());
+    for (auto& block : result) {
+        ASSERT_TRUE(reader.Next(&block));
+    }
+    Block block;
+    EXPECT_FALSE(reader.Next(&block));
+
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        ExpectSameBlocks(blocks[i], result[i]);
+    }
+}
+
+TEST_P(NativeFileCase, ReadEmptyFile) {
+    NativeFileWriter(path_, GetParam()).Close();
+
+    NativeFileReader reader(path_, GetParam() != CompressionMethod::None);
+    Block block;
+    EXPECT_FALSE(reader.Next(&block));
+}
+
+TEST_P(NativeFileCase, ReadTruncatedFile) {
+    {
+        NativeFileWriter writer(path_, GetParam());
+        writer.Write(MakeBlock(100, "value"));
+    }
+
+    std::string data;
+    {
+        std::ifstream file(path_, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size() - 1);
+    }
+
+    NativeFileReader reader(path_, GetParam() != CompressionMethod::None);
+    Block block;
+    EXPECT_ANY_THROW(reader.Next(&block));
+}
+
+TEST(NativeTest, OpenMissingFile) {
+    EXPECT_THROW(NativeFileReader("/nonexistent/clickhouse_cpp_native_ut.native"), std::system_error);
+    EXPECT_THROW(NativeFileWriter("/nonexistent/clickhouse_cpp_native_ut.native"), std::system_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(Compression, NativeFileCase,
+    ::testing::Values(CompressionMethod::None, CompressionMethod::LZ4, CompressionMethod::ZSTD));
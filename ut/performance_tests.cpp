@@ -1,7 +1,11 @@
 #include <clickhouse/columns/array.h>
 #include <clickhouse/columns/date.h>
+#include <clickhouse/columns/decimal.h>
 #include <clickhouse/columns/enum.h>
+#include <clickhouse/columns/ip4.h>
+#include <clickhouse/columns/ip6.h>
 #include <clickhouse/columns/lowcardinality.h>
+#include <clickhouse/columns/map.h>
 #include <clickhouse/columns/nullable.h>
 #include <clickhouse/columns/numeric.h>
 #include <clickhouse/columns/string.h>
@@ -11,8 +15,11 @@
 #include <clickhouse/base/input.h>
 
 #include <gtest/gtest.h>
+#include <city.h>
 
+#include <random>
 #include <string>
+#include <unordered_map>
 
 #include "utils.h"
 #include "utils_performance.h"
@@ -261,3 +268,364 @@ INSTANTIATE_TYPED_TEST_SUITE_P(SimpleColumns, ColumnPerformanceTest, SimpleColum
 
 using LowCardinalityColumnTypes = ::testing::Types<ColumnLowCardinalityT<ColumnString>, ColumnLowCardinalityT<ColumnFixedString>>;
 INSTANTIATE_TYPED_TEST_SUITE_P(LowCardinality, ColumnPerformanceTest, LowCardinalityColumnTypes);
+
+namespace {
+
+// Unique items index of ColumnLowCardinality as it used to be implemented: node-based hash map
+// keyed by pair of hashes (std::hash and CityHash64) of the value, kept here as a baseline for comparison.
+struct NodeBasedUniqueItemsIndex {
+    using Key = std::pair<std::uint64_t, std::uint64_t>;
+    struct KeyHash {
+        std::size_t operator()(const Key & key) const noexcept { return key.first; }
+    };
+
+    ColumnString dictionary;
+    ColumnUInt32 index;
+    std::unordered_map<Key, size_t, KeyHash> unique_items;
+
+    void Append(std::string_view value) {
+        const Key key{std::hash<std::string_view>{}(value), CityHash64(value.data(), value.size())};
+        const auto [iterator, is_new_item] = unique_items.try_emplace(key, dictionary.Size());
+        index.Append(static_cast<uint32_t>(iterator->second));
+        if (is_new_item)
+            dictionary.Append(value);
+    }
+};
+
+// Same as above, but with flat open-addressing index currently used by ColumnLowCardinality.
+struct FlatUniqueItemsIndex {
+    ColumnString dictionary;
+    ColumnUInt32 index;
+    ColumnLowCardinality::UniqueItems unique_items;
+
+    void Append(std::string_view value) {
+        const auto hash = ColumnLowCardinality::computeHashKey(ItemView{Type::String, value});
+        auto dictionary_index = unique_items.Find(hash, [this, value](std::uint64_t i) {
+            return dictionary[i] == value;
+        });
+        if (dictionary_index == ColumnLowCardinality::UniqueItems::NotFound) {
+            dictionary_index = dictionary.Size();
+            unique_items.Insert(hash, dictionary_index);
+            dictionary.Append(value);
+        }
+        index.Append(static_cast<uint32_t>(dictionary_index));
+    }
+};
+
+}
+
+TEST(LowCardinalityPerformance, UniqueItemsIndex) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t ITEMS_COUNT = 1'000'000;
+
+    for (const size_t unique_items_count : {100, 10'000, 100'000}) {
+        std::vector<std::string> values;
+        values.reserve(ITEMS_COUNT);
+        for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+            values.push_back("value_" + std::to_string((i * 7919) % unique_items_count));
+        }
+
+        std::cerr << "\n===========================================================" << std::endl;
+        std::cerr << "\t" << ITEMS_COUNT << " items, " << unique_items_count << " unique" << std::endl;
+
+        NodeBasedUniqueItemsIndex node_based;
+        {
+            Timer timer;
+            for (const auto & value : values) {
+                node_based.Append(value);
+            }
+            std::cerr << "Node-based index:\t" << timer.Elapsed() << std::endl;
+        }
+
+        FlatUniqueItemsIndex flat;
+        {
+            Timer timer;
+            for (const auto & value : values) {
+                flat.Append(value);
+            }
+            std::cerr << "Flat index:\t" << timer.Elapsed() << std::endl;
+        }
+
+        ColumnLowCardinalityT<ColumnString> column;
+        {
+            Timer timer;
+            for (const auto & value : values) {
+                column.Append(value);
+            }
+            std::cerr << "LC Append:\t" << timer.Elapsed() << std::endl;
+        }
+
+        ColumnLowCardinalityT<ColumnString> bulk_column;
+        {
+            Timer timer;
+            bulk_column.AppendMany(values);
+            std::cerr << "LC AppendMany:\t" << timer.Elapsed() << std::endl;
+        }
+
+        EXPECT_EQ(unique_items_count, node_based.dictionary.Size());
+        EXPECT_EQ(unique_items_count, flat.dictionary.Size());
+        // + 1 for "invisible" default item in dictionary.
+        EXPECT_EQ(unique_items_count + 1, column.GetDictionarySize());
+        EXPECT_EQ(unique_items_count + 1, bulk_column.GetDictionarySize());
+        ASSERT_EQ(ITEMS_COUNT, column.Size());
+        ASSERT_EQ(ITEMS_COUNT, bulk_column.Size());
+        for (size_t i = 0; i < ITEMS_COUNT; i += 997) {
+            ASSERT_EQ(values[i], column.At(i));
+            ASSERT_EQ(values[i], bulk_column.At(i));
+        }
+    }
+}
+
+TEST(LowCardinalityPerformance, AppendLowCardinality) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t ITEMS_COUNT = 1'000'000;
+    const size_t UNIQUE_ITEMS_COUNT = 10'000;
+
+    auto source = std::make_shared<ColumnLowCardinalityT<ColumnString>>();
+    for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+        source->Append("value_" + std::to_string((i * 7919) % UNIQUE_ITEMS_COUNT));
+    }
+
+    std::cerr << "\n===========================================================" << std::endl;
+    std::cerr << "\t" << ITEMS_COUNT << " items, " << UNIQUE_ITEMS_COUNT << " unique" << std::endl;
+
+    ColumnLowCardinalityT<ColumnString> per_item;
+    {
+        Timer timer;
+        for (size_t i = 0; i < source->Size(); ++i) {
+            per_item.Append(source->At(i));
+        }
+        std::cerr << "Append item by item:\t" << timer.Elapsed() << std::endl;
+    }
+
+    ColumnLowCardinalityT<ColumnString> merged;
+    {
+        Timer timer;
+        merged.Append(source);
+        std::cerr << "Append column:\t" << timer.Elapsed() << std::endl;
+    }
+
+    ASSERT_EQ(ITEMS_COUNT, merged.Size());
+    EXPECT_EQ(per_item.GetDictionarySize(), merged.GetDictionarySize());
+    for (size_t i = 0; i < ITEMS_COUNT; i += 997) {
+        ASSERT_EQ(source->At(i), merged.At(i));
+    }
+}
+
+TEST(MapPerformance, FindValue) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+    using TestMap = ColumnMapT<ColumnString, ColumnString>;
+
+    const size_t ROWS = 10'000;
+    const size_t KEYS_PER_ROW = 200;
+
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < KEYS_PER_ROW; ++i) {
+        keys.push_back("tag_" + std::to_string(i));
+    }
+
+    TestMap col(std::make_shared<ColumnString>(), std::make_shared<ColumnString>());
+    for (size_t row = 0; row < ROWS; ++row) {
+        std::vector<std::tuple<std::string_view, std::string_view>> tuples;
+        for (const auto & key : keys) {
+            tuples.emplace_back(key, key);
+        }
+        col.Append(tuples);
+    }
+
+    const std::vector<std::string> lookup_keys{"tag_10", "tag_100", "tag_190", "missing"};
+
+    std::cerr << "\n===========================================================" << std::endl;
+    std::cerr << "\t" << ROWS << " rows, " << KEYS_PER_ROW << " keys per row, "
+              << lookup_keys.size() << " lookups per row" << std::endl;
+
+    size_t found_linear = 0;
+    {
+        Timer timer;
+        for (size_t row = 0; row < ROWS; ++row) {
+            const auto map = col.At(row);
+            for (const auto & key : lookup_keys) {
+                found_linear += map.Find(key) != map.end();
+            }
+        }
+        std::cerr << "MapValueView::Find:\t" << timer.Elapsed() << std::endl;
+    }
+
+    size_t found_indexed = 0;
+    {
+        Timer timer;
+        for (size_t row = 0; row < ROWS; ++row) {
+            for (const auto & key : lookup_keys) {
+                found_indexed += col.FindValue(row, key).has_value();
+            }
+        }
+        std::cerr << "FindValue (including index build):\t" << timer.Elapsed() << std::endl;
+    }
+
+    EXPECT_EQ(found_linear, ROWS * 3);
+    EXPECT_EQ(found_indexed, found_linear);
+}
+
+TEST(DecimalPerformance, Append) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    using Timer = Timer<std::chrono::microseconds>;
+
+    const size_t ITEMS_COUNT = 10'000'000;
+
+    std::vector<int64_t> values(ITEMS_COUNT);
+    for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+        values[i] = static_cast<int64_t>(i * 7919) - 1'000'000;
+    }
+
+    std::cerr << "\n===========================================================" << std::endl;
+    std::cerr << "\t" << ITEMS_COUNT << " items of Decimal(18, 4)" << std::endl;
+
+    ColumnDecimal generic(18, 4);
+    {
+        Timer timer;
+        for (const auto & value : values) {
+            generic.Append(Int128(value));
+        }
+        std::cerr << "ColumnDecimal::Append:\t" << timer.Elapsed() << std::endl;
+    }
+
+    ColumnDecimal64 typed(18, 4);
+    {
+        Timer timer;
+        for (const auto & value : values) {
+            typed.Append(value);
+        }
+        std::cerr << "ColumnDecimal64::Append:\t" << timer.Elapsed() << std::endl;
+    }
+
+    ColumnDecimal64 bulk(18, 4);
+    {
+        Timer timer;
+        bulk.AppendMany(values);
+        std::cerr << "ColumnDecimal64::AppendMany:\t" << timer.Elapsed() << std::endl;
+    }
+
+    const size_t STRINGS_COUNT = 1'000'000;
+    std::vector<std::string> strings;
+    strings.reserve(STRINGS_COUNT);
+    for (size_t i = 0; i < STRINGS_COUNT; ++i) {
+        strings.push_back(std::to_string(values[i] / 10000) + "." + std::to_string(1000 + i % 9000));
+    }
+
+    ColumnDecimal64 parsed(18, 4);
+    {
+        Timer timer;
+        for (const auto & str : strings) {
+            parsed.Append(str);
+        }
+        std::cerr << "Append " << STRINGS_COUNT << " strings:\t" << timer.Elapsed() << std::endl;
+    }
+
+    ASSERT_EQ(ITEMS_COUNT, generic.Size());
+    ASSERT_EQ(ITEMS_COUNT, typed.Size());
+    ASSERT_EQ(ITEMS_COUNT, bulk.Size());
+    ASSERT_EQ(STRINGS_COUNT, parsed.Size());
+    for (size_t i = 0; i < ITEMS_COUNT; i += 997) {
+        ASSERT_EQ(generic.At(i), Int128(typed.At(i)));
+        ASSERT_EQ(values[i], bulk.At(i));
+    }
+}
+
+// Compares bulk text parsing and formatting of `column` with row-by-row one, done by `append_one(column, text)`
+// and `format_one(column, row)`, either of which may be nullptr if the column has no such method.
+template <typename ColumnType, typename AppendOne, typename FormatOne>
+void MeasureTextConversion(const ColumnType & column, AppendOne && append_one, FormatOne && format_one) {
+    using Timer = Timer<std::chrono::microseconds>;
+
+    std::cerr << "\n===========================================================" << std::endl;
+    std::cerr << "\t" << column.Size() << " items of " << column.GetType().GetName() << std::endl;
+
+    ColumnString formatted;
+    {
+        Timer timer;
+        column.FormatToStrings(formatted);
+        std::cerr << "FormatToStrings:\t" << timer.Elapsed() << std::endl;
+    }
+    ASSERT_EQ(column.Size(), formatted.Size());
+
+    if constexpr (!std::is_same_v<std::decay_t<FormatOne>, std::nullptr_t>) {
+        std::vector<std::string> strings;
+        strings.reserve(column.Size());
+        Timer timer;
+        for (size_t i = 0; i < column.Size(); ++i) {
+            strings.push_back(format_one(column, i));
+        }
+        std::cerr << "Format row by row:\t" << timer.Elapsed() << std::endl;
+
+        for (size_t i = 0; i < column.Size(); i += 997) {
+            ASSERT_EQ(strings[i], formatted[i]);
+        }
+    }
+
+    auto parsed = column.CloneEmpty()->template As<ColumnType>();
+    {
+        Timer timer;
+        parsed->AppendFromStrings(formatted);
+        std::cerr << "AppendFromStrings:\t" << timer.Elapsed() << std::endl;
+    }
+    ASSERT_EQ(column.Size(), parsed->Size());
+
+    if constexpr (!std::is_same_v<std::decay_t<AppendOne>, std::nullptr_t>) {
+        auto appended = column.CloneEmpty()->template As<ColumnType>();
+        const std::vector<std::string> strings(formatted.GetData().begin(), formatted.GetData().end());
+        Timer timer;
+        for (const auto & str : strings) {
+            append_one(*appended, str);
+        }
+        std::cerr << "Append row by row:\t" << timer.Elapsed() << std::endl;
+        ASSERT_EQ(column.Size(), appended->Size());
+    }
+}
+
+TEST(TextPerformance, ParseAndFormat) {
+    SKIP_IN_DEBUG_BUILDS();
+
+    const size_t ITEMS_COUNT = 1'000'000;
+    std::mt19937_64 random(42);
+
+    ColumnIPv4 ipv4;
+    ColumnIPv6 ipv6;
+    ColumnUUID uuid;
+    ColumnDecimal64 decimal(18, 4);
+    ColumnDate date;
+    for (size_t i = 0; i < ITEMS_COUNT; ++i) {
+        const uint64_t value = random();
+        ipv4.Append(static_cast<uint32_t>(value));
+
+        in6_addr addr{};
+        std::memcpy(addr.s6_addr, &value, sizeof(value));
+        ipv6.Append(addr);
+
+        uuid.Append(UUID(value, random()));
+        decimal.Append(static_cast<int64_t>(value % 10'000'000'000'000) - 5'000'000'000'000);
+        date.AppendRaw(static_cast<uint16_t>(value % 50000));
+    }
+
+    MeasureTextConversion(ipv4,
+        [](ColumnIPv4 & col, const std::string & str) { col.Append(str); },
+        [](const ColumnIPv4 & col, size_t i) { return col.AsString(i); });
+    MeasureTextConversion(ipv6,
+        [](ColumnIPv6 & col, const std::string & str) { col.Append(str); },
+        [](const ColumnIPv6 & col, size_t i) { return col.AsString(i); });
+    MeasureTextConversion(uuid,
+        nullptr,
+        [](const ColumnUUID & col, size_t i) { return ToString(col.At(i)); });
+    MeasureTextConversion(decimal,
+        [](ColumnDecimal64 & col, const std::string & str) { col.Append(str); },
+        nullptr);
+    MeasureTextConversion(date, nullptr, nullptr);
+}
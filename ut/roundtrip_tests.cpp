@@ -216,6 +216,19 @@ TEST_P(RoundtripCase, LowCardinalityTString) {
     EXPECT_TRUE(CompareRecursive(*col, *result_typed));
 }
 
+TEST_P(RoundtripCase, LowCardinalityTUInt32) {
+    using TestColumn = ColumnLowCardinalityT<ColumnUInt32>;
+    auto col = std::make_shared<TestColumn>();
+
+    col->Append(42);
+    col->Append(uint32_t(1));
+    col->Append(42);
+    col->Append(std::numeric_limits<uint32_t>::max());
+
+    auto result_typed = RoundtripColumnValues(*client_, col)->As<TestColumn>();
+    EXPECT_TRUE(CompareRecursive(*col, *result_typed));
+}
+
 TEST_P(RoundtripCase, LowCardinalityTNullableString) {
     using TestColumn = ColumnLowCardinalityT<ColumnNullableT<ColumnString>>;
     auto col = std::make_shared<TestColumn>();
@@ -0,0 +1,209 @@
+#include <clickhouse/base/platform.h>
+#include <clickhouse/base/time_zone.h>
+#include <clickhouse/columns/date.h>
+#include <clickhouse/exceptions.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if !defined(_win_)
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+using namespace clickhouse;
+
+namespace {
+
+std::shared_ptr<const TimeZone> GetTimeZoneOrNull(const std::string & name) {
+    try {
+        return TimeZone::Get(name);
+    } catch (const ValidationError &) {
+        return nullptr;
+    }
+}
+
+#define GET_TIME_ZONE_OR_SKIP(var, name) \
+    const auto var = GetTimeZoneOrNull(name); \
+    if (!var) GTEST_SKIP() << "No tz database entry for " << name
+
+}
+
+TEST(TimeZoneCase, UTC) {
+    const auto utc = TimeZone::Get("");
+    EXPECT_EQ(utc, TimeZone::UTC());
+    EXPECT_EQ(TimeZone::Get("UTC"), utc);
+    EXPECT_EQ(utc->GetOffset(1615705200), 0);
+    EXPECT_EQ(utc->ToLocalSeconds(-1), -1);
+
+    EXPECT_THROW(TimeZone::Get("No/Such_Zone"), ValidationError);
+    EXPECT_THROW(TimeZone::Get("../../etc/passwd"), ValidationError);
+}
+
+#if !defined(_win_)
+TEST(TimeZoneCase, DatabaseFromTZDIR) {
+    // A zone that exists only in the database of $TZDIR.
+    const std::string tzdir = ::testing::TempDir() + "/clickhouse_cpp_tzdir";
+    const std::string zone_path = tzdir + "/Custom/Kolkata";
+    mkdir(tzdir.c_str(), 0755);
+    mkdir((tzdir + "/Custom").c_str(), 0755);
+
+    std::string content;
+    if (FILE * source = std::fopen("/usr/share/zoneinfo/Asia/Kolkata", "rb")) {
+        char buffer[4096];
+        for (size_t size; (size = std::fread(buffer, 1, sizeof(buffer), source)) > 0;) {
+            content.append(buffer, size);
+        }
+        std::fclose(source);
+    }
+    bool copied = false;
+    if (FILE * target = content.empty() ? nullptr : std::fopen(zone_path.c_str(), "wb")) {
+        copied = std::fwrite(content.data(), 1, content.size(), target) == content.size();
+        copied = std::fclose(target) == 0 && copied;
+    }
+
+    const auto cleanup = [&] {
+        std::remove(zone_path.c_str());
+        rmdir((tzdir + "/Custom").c_str());
+        rmdir(tzdir.c_str());
+    };
+    if (!copied) {
+        cleanup();
+        GTEST_SKIP() << "No tz database entry for Asia/Kolkata";
+    }
+
+    const char * old_tzdir = std::getenv("TZDIR");
+    const std::string saved_tzdir = old_tzdir ? old_tzdir : "";
+    setenv("TZDIR", tzdir.c_str(), 1);
+    const auto custom = GetTimeZoneOrNull("Custom/Kolkata");
+    if (old_tzdir) {
+        setenv("TZDIR", saved_tzdir.c_str(), 1);
+    } else {
+        unsetenv("TZDIR");
+    }
+    cleanup();
+
+    ASSERT_NE(custom, nullptr);
+    EXPECT_EQ(custom->GetOffset(1577836800), 19800);
+}
+#endif
+
+TEST(TimeZoneCase, Offsets) {
+    GET_TIME_ZONE_OR_SKIP(new_york, "America/New_York");
+    EXPECT_EQ(new_york, TimeZone::Get("America/New_York"));
+    EXPECT_EQ(new_york->Name(), "America/New_York");
+
+    // DST transitions of 2021
+    EXPECT_EQ(new_york->GetOffset(1615705200 - 1), -5 * 3600);
+    EXPECT_EQ(new_york->GetOffset(1615705200), -4 * 3600);
+    EXPECT_EQ(new_york->GetOffset(1636264800 - 1), -4 * 3600);
+    EXPECT_EQ(new_york->GetOffset(1636264800), -5 * 3600);
+
+    // Beyond explicit transitions of the tz database, produced by the POSIX rule.
+    EXPECT_EQ(new_york->GetOffset(4118126400), -4 * 3600); // 2100-07-01
+    EXPECT_EQ(new_york->GetOffset(4102488000), -5 * 3600); // 2100-01-01
+
+    GET_TIME_ZONE_OR_SKIP(sydney, "Australia/Sydney");
+    EXPECT_EQ(sydney->GetOffset(7259328000), 11 * 3600); // 2200-01-15
+    EXPECT_EQ(sydney->GetOffset(7274966400), 10 * 3600); // 2200-07-15
+
+    GET_TIME_ZONE_OR_SKIP(moscow, "Europe/Moscow");
+    EXPECT_EQ(moscow->GetOffset(1325376000), 4 * 3600); // 2012-01-01
+    EXPECT_EQ(moscow->GetOffset(1420070400), 3 * 3600); // 2015-01-01
+
+    GET_TIME_ZONE_OR_SKIP(kolkata, "Asia/Kolkata");
+    EXPECT_EQ(kolkata->GetOffset(1577836800), 5 * 3600 + 1800);
+}
+
+TEST(TimeZoneCase, ToCivilTime) {
+    GET_TIME_ZONE_OR_SKIP(new_york, "America/New_York");
+
+    const std::vector<int64_t> values{1615705200 - 1, 1615705200, 1704067199, 0};
+    std::vector<uint16_t> year(values.size());
+    std::vector<uint8_t> month(values.size()), day(values.size()), hour(values.size()), minute(values.size());
+
+    new_york->ToCivilTime(values, CivilTimeFields{year, month, day, hour, minute, {}});
+    EXPECT_EQ(year, (std::vector<uint16_t>{2021, 2021, 2023, 1969}));
+    EXPECT_EQ(month, (std::vector<uint8_t>{3, 3, 12, 12}));
+    EXPECT_EQ(day, (std::vector<uint8_t>{14, 14, 31, 31}));
+    EXPECT_EQ(hour, (std::vector<uint8_t>{1, 3, 18, 19}));
+    EXPECT_EQ(minute, (std::vector<uint8_t>{59, 0, 59, 0}));
+
+    std::vector<int64_t> local(values.size());
+    new_york->ToLocalSeconds(values, local);
+    EXPECT_EQ(local[1], 1615705200 - 4 * 3600);
+    EXPECT_EQ(local[3], -5 * 3600);
+
+    EXPECT_THROW(new_york->ToCivilTime(values, CivilTimeFields{Span<uint16_t>(year.data(), 1), {}, {}, {}, {}, {}}), ValidationError);
+    EXPECT_THROW(new_york->ToLocalSeconds(values, Span<int64_t>(local.data(), 1)), ValidationError);
+}
+
+TEST(TimeZoneCase, DateColumns) {
+    ColumnDate32 date32;
+    date32.AppendRaw(-25567); // 1900-01-01
+    date32.AppendRaw(19358);  // 2023-01-01
+    date32.AppendRaw(0);
+
+    std::vector<uint16_t> year(2);
+    std::vector<uint8_t> month(2), day(2);
+    date32.CopyCivilDate(CivilTimeFields{year, month, day, {}, {}, {}}, 1);
+    EXPECT_EQ(year, (std::vector<uint16_t>{2023, 1970}));
+    EXPECT_EQ(month, (std::vector<uint8_t>{1, 1}));
+    EXPECT_EQ(day, (std::vector<uint8_t>{1, 1}));
+
+    std::vector<uint16_t> first_year(1);
+    date32.CopyCivilDate(CivilTimeFields{first_year, {}, {}, {}, {}, {}});
+    EXPECT_EQ(first_year[0], 1900);
+    EXPECT_THROW(date32.CopyCivilDate(CivilTimeFields{year, {}, {}, {}, {}, {}}, 2), ValidationError);
+
+    ColumnDate date;
+    date.AppendRaw(19783); // 2024-03-01
+    date.CopyCivilDate(CivilTimeFields{Span<uint16_t>(year.data(), 1), Span<uint8_t>(month.data(), 1), Span<uint8_t>(day.data(), 1), {}, {}, {}});
+    EXPECT_EQ(year[0], 2024);
+    EXPECT_EQ(month[0], 3);
+    EXPECT_EQ(day[0], 1);
+}
+
+TEST(TimeZoneCase, DateTimeColumns) {
+    GET_TIME_ZONE_OR_SKIP(kolkata, "Asia/Kolkata");
+
+    ColumnDateTime datetime("Asia/Kolkata");
+    datetime.Append(1577836800); // 2020-01-01 00:00:00 UTC
+    EXPECT_EQ(datetime.GetTimeZone(), kolkata);
+
+    std::vector<uint8_t> hour(1), minute(1);
+    datetime.CopyCivilTime(CivilTimeFields{{}, {}, {}, hour, minute, {}});
+    EXPECT_EQ(hour[0], 5);
+    EXPECT_EQ(minute[0], 30);
+
+    datetime.CopyCivilTime(*TimeZone::UTC(), CivilTimeFields{{}, {}, {}, hour, minute, {}});
+    EXPECT_EQ(hour[0], 0);
+    EXPECT_EQ(minute[0], 0);
+
+    std::vector<int64_t> local(1);
+    datetime.CopyLocalTime(*kolkata, local);
+    EXPECT_EQ(local[0], 1577836800 + 19800);
+
+    // Column without time zone is in UTC.
+    EXPECT_EQ(ColumnDateTime().GetTimeZone(), TimeZone::UTC());
+
+    ColumnDateTime64 datetime64(3, "Asia/Kolkata");
+    datetime64.Append(Int64(1577836800) * 1000 + 999);
+    datetime64.Append(-1); // 1969-12-31 23:59:59.999 UTC
+
+    std::vector<uint16_t> year(2);
+    std::vector<uint8_t> hours(2), seconds(2);
+    datetime64.CopyCivilTime(CivilTimeFields{year, {}, {}, hours, {}, seconds});
+    EXPECT_EQ(year, (std::vector<uint16_t>{2020, 1970}));
+    EXPECT_EQ(hours, (std::vector<uint8_t>{5, 5}));
+    EXPECT_EQ(seconds, (std::vector<uint8_t>{0, 59}));
+
+    std::vector<Int64> local64(2);
+    datetime64.CopyLocalTime(*kolkata, local64);
+    EXPECT_EQ(local64[0], (Int64(1577836800) + 19800) * 1000 + 999);
+    EXPECT_EQ(local64[1], Int64(19800) * 1000 - 1);
+}
@@ -80,7 +80,10 @@ TEST(TypesCase, IsEqual) {
     const std::string type_names[] = {
         "UInt8",
         "Int8",
-//        "UInt128",
+        "UInt128",
+        "Int256",
+        "UInt256",
+        "BFloat16",
         "String",
         "FixedString(0)",
         "FixedString(10000)",
@@ -88,6 +91,7 @@ TEST(TypesCase, IsEqual) {
         "DateTime64(3, 'UTC')",
         "Decimal(9,3)",
         "Decimal(18,3)",
+        "Decimal(50,3)",
         "Enum8('ONE' = 1)",
         "Enum8('ONE' = 1, 'TWO' = 2)",
         "Enum16('ONE' = 1, 'TWO' = 2, 'THREE' = 3, 'FOUR' = 4)",
@@ -141,6 +145,47 @@ TEST(TypesCase, IsEqual) {
     }
 }
 
+TEST(TypesCase, Interning) {
+    // Equal types made in any way share one instance.
+    EXPECT_EQ(Type::CreateSimple<int32_t>().get(), Type::CreateSimple<int32_t>().get());
+    EXPECT_EQ(Type::CreateString().get(), CreateColumnByType("String")->Type().get());
+
+    const auto array = Type::CreateArray(Type::CreateNullable(Type::CreateDateTime("UTC")));
+    EXPECT_EQ(array.get(), CreateColumnByType("Array(Nullable(DateTime('UTC')))")->Type().get());
+
+    // Name is built once.
+    EXPECT_EQ(&array->GetName(), &array->GetName());
+    EXPECT_EQ(array->GetName(), "Array(Nullable(DateTime('UTC')))");
+
+    // Released types are removed from the table, so they can be made again.
+    std::weak_ptr<Type> released = Type::CreateEnum8({{"interned", 1}});
+    EXPECT_TRUE(released.expired());
+    const auto enum8 = Type::CreateEnum8({{"interned", 1}});
+    EXPECT_EQ(enum8->GetName(), "Enum8('interned' = 1)");
+    EXPECT_TRUE(enum8->IsEqual(CreateColumnByType("Enum8('interned' = 1)")->Type()));
+    EXPECT_FALSE(enum8->IsEqual(Type::CreateEnum8({{"interned", 2}})));
+
+    // Types made without Create*() are not interned, but are still compared by name.
+    const auto nullable = std::make_shared<NullableType>(Type::CreateSimple<int32_t>());
+    EXPECT_TRUE(nullable->IsEqual(Type::CreateNullable(Type::CreateSimple<int32_t>())));
+    EXPECT_TRUE(Type::CreateNullable(Type::CreateSimple<int32_t>())->IsEqual(nullable));
+    EXPECT_FALSE(nullable->IsEqual(Type::CreateNullable(Type::CreateSimple<int64_t>())));
+}
+
+TEST(TypesCase, InterningReleasesNestedTypes) {
+    // Interned types are destroyed as their own class, so nested types are released with them.
+    std::weak_ptr<Type> nested;
+    std::weak_ptr<Type> tuple;
+    {
+        const auto enum16 = Type::CreateEnum16({{"nested", 1}, {"released", 2}});
+        const auto tuple_type = Type::CreateTuple({enum16, Type::CreateDateTime64(3, "UTC")});
+        nested = enum16;
+        tuple = tuple_type;
+    }
+    EXPECT_TRUE(tuple.expired());
+    EXPECT_TRUE(nested.expired());
+}
+
 TEST(TypesCase, ErrorEnumContent) {
     const std::string type_names[] = {
         "Enum8()",
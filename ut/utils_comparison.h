@@ -143,7 +143,11 @@ struct PrintContainer;
 
 template <typename Left, typename Right>
 ::testing::AssertionResult CompareRecursive(const Left & left, const Right & right) {
-    if constexpr (!is_string_v<Left> && !is_string_v<Right>
+    if constexpr (std::is_array_v<Left> && std::is_array_v<Right>
+            && std::is_same_v<std::remove_extent_t<Left>, char> && std::is_same_v<std::remove_extent_t<Right>, char>) {
+        // String literals: compare contents, not addresses.
+        return CompareRecursive(std::string_view(left), std::string_view(right));
+    } else if constexpr (!is_string_v<Left> && !is_string_v<Right>
             && (is_container_v<Left> || std::is_base_of_v<clickhouse::Column, std::decay_t<Left>>)
             && (is_container_v<Right> || std::is_base_of_v<clickhouse::Column, std::decay_t<Right>>) ) {
 